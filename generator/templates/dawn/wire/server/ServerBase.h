@@ -62,6 +62,13 @@ namespace dawn::wire::server {
             {% endfor %}
         }
 
+        //* Sets the number of IDs the client may skip when allocating objects of any type.
+        void SetMaxSkippedObjectIds(ObjectId maxSkippedIds) {
+            {% for type in by_category["object"] %}
+                mKnown{{type.name.CamelCase()}}.SetMaxSkippedIds(maxSkippedIds);
+            {% endfor %}
+        }
+
         {% for type in by_category["object"] %}
             const KnownObjects<{{as_cType(type.name)}}>& {{type.name.CamelCase()}}Objects() const {
                 return mKnown{{type.name.CamelCase()}};
@@ -89,7 +89,25 @@ namespace dawn::wire::server {
     const volatile char* Server::HandleCommandsImpl(const volatile char* commands, size_t size) {
         DeserializeBuffer deserializeBuffer(commands, size);
 
-        while (deserializeBuffer.AvailableSize() >= sizeof(CmdHeader) + sizeof(WireCmd)) {
+        while (deserializeBuffer.AvailableSize() >= kWireBufferAlignment) {
+            // Forward the callbacks that other threads deferred while this server was busy.
+            if (mHasDeferredCallbacks.load(std::memory_order_relaxed)) {
+                RunDeferredCallbacks();
+            }
+
+            // Compact commands are never chunked since they are smaller than any allocation. They
+            // are recognized even when the compact encoding is disabled, so that a client using it
+            // is rejected instead of having its commands misparsed.
+            if (IsCompactCommand(deserializeBuffer.Buffer())) {
+                if (HandleCompactCommand(&deserializeBuffer) != WireResult::Success) {
+                    return nullptr;
+                }
+                continue;
+            }
+            if (deserializeBuffer.AvailableSize() < sizeof(CmdHeader) + sizeof(WireCmd)) {
+                break;
+            }
+
             // Start by chunked command handling, if it is done, then it means the whole buffer
             // was consumed by it, so we return a pointer to the end of the commands.
             switch (HandleChunkedCommands(deserializeBuffer.Buffer(), deserializeBuffer.AvailableSize())) {
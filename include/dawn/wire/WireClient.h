@@ -68,6 +68,15 @@ struct ReservedInstance {
 struct DAWN_WIRE_EXPORT WireClientDescriptor {
     CommandSerializer* serializer;
     client::MemoryTransferService* memoryTransferService = nullptr;
+    // Serialize the most frequent pass encoder commands with the compact encoding, which is
+    // smaller to transfer. Must match WireServerDescriptor::useCompactEncoding.
+    bool useCompactEncoding = false;
+    // Allow commands to be encoded concurrently from multiple threads. Each thread serializes its
+    // commands in its own buffer, and the buffers are merged in the serializer in the order the
+    // commands were encoded by WireClient::Flush, which must then be used instead of flushing the
+    // serializer directly. useCompactEncoding is ignored when this is enabled. Must match
+    // WireServerDescriptor::enableMultithreadedEncoding.
+    bool enableMultithreadedEncoding = false;
 };
 
 class DAWN_WIRE_EXPORT WireClient : public CommandHandler {
@@ -87,6 +96,10 @@ class DAWN_WIRE_EXPORT WireClient : public CommandHandler {
     void ReclaimDeviceReservation(const ReservedDevice& reservation);
     void ReclaimInstanceReservation(const ReservedInstance& reservation);
 
+    // Flushes the serializer after merging the commands encoded by each thread when
+    // multithreaded encoding is enabled. Returns the result of CommandSerializer::Flush.
+    bool Flush();
+
     // Disconnects the client.
     // Commands allocated after this point will not be sent.
     void Disconnect();
@@ -45,6 +45,14 @@ struct DAWN_WIRE_EXPORT WireServerDescriptor {
     const DawnProcTable* procs;
     CommandSerializer* serializer;
     server::MemoryTransferService* memoryTransferService = nullptr;
+    // Whether the client serializes the most frequent pass encoder commands with the compact
+    // encoding. Must match WireClientDescriptor::useCompactEncoding. Compact commands are always
+    // recognized, and are a fatal error when this is false.
+    bool useCompactEncoding = false;
+    // Whether the client encodes commands from multiple threads, in which case the IDs of new
+    // objects can be received out of order. Must match
+    // WireClientDescriptor::enableMultithreadedEncoding.
+    bool enableMultithreadedEncoding = false;
 };
 
 class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
@@ -496,6 +496,19 @@ static constexpr ToggleEnumAndInfoList kToggleNameAndInfoList = {{
     {Toggle::UseTintIR,
      {"use_tint_ir", "Enable the use of the Tint IR for backend codegen.",
       "https://crbug.com/tint/1718", ToggleStage::Device}},
+    {Toggle::UseTintIROptimizationLevel1,
+     {"use_tint_ir_optimization_level_1",
+      "Run the cheap Tint IR optimizations (constant propagation, common subexpression elimination "
+      "and dead code elimination) when generating shaders from the Tint IR. Trades some compile "
+      "time for better shaders. Only used by the Vulkan backend.",
+      "https://crbug.com/tint", ToggleStage::Device}},
+    {Toggle::UseTintIROptimizationLevel2,
+     {"use_tint_ir_optimization_level_2",
+      "Run all the Tint IR optimizations when generating shaders from the Tint IR, adding function "
+      "inlining, the promotion of variables to values and loop-invariant code motion to the "
+      "optimizations of use_tint_ir_optimization_level_1. Takes precedence over "
+      "use_tint_ir_optimization_level_1. Only used by the Vulkan backend.",
+      "https://crbug.com/tint", ToggleStage::Device}},
     {Toggle::D3DDisableIEEEStrictness,
      {"d3d_disable_ieee_strictness",
       "Disable IEEE strictness when compiling shaders. It is otherwise enabled by default to "
@@ -123,6 +123,8 @@ enum class Toggle {
     D3D12CreateNotZeroedHeap,
     D3D12DontUseNotZeroedHeapFlagOnTexturesAsCommitedResources,
     UseTintIR,
+    UseTintIROptimizationLevel1,
+    UseTintIROptimizationLevel2,
     D3DDisableIEEEStrictness,
     PolyFillPacked4x8DotProduct,
     D3D12PolyFillPackUnpack4x8,
@@ -347,6 +347,11 @@ ResultOrError<ShaderModule::ModuleAndSpirv> ShaderModule::GetHandleAndSpirv(
     req.use_tint_ir = GetDevice()->IsToggleEnabled(Toggle::UseTintIR);
     req.tintOptions.disable_polyfill_integer_div_mod =
         GetDevice()->IsToggleEnabled(Toggle::DisablePolyfillsOnIntegerDivisonAndModulo);
+    if (GetDevice()->IsToggleEnabled(Toggle::UseTintIROptimizationLevel2)) {
+        req.tintOptions.optimization_level = tint::OptimizationLevel::kO2;
+    } else if (GetDevice()->IsToggleEnabled(Toggle::UseTintIROptimizationLevel1)) {
+        req.tintOptions.optimization_level = tint::OptimizationLevel::kO1;
+    }
 
     // Set subgroup uniform control flow flag for subgroup experiment, if device has
     // Chromium-experimental-subgroup-uniform-control-flow feature. (dawn:464)
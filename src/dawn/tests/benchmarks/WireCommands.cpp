@@ -0,0 +1,489 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Log.h"
+#include "dawn/dawn_proc.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/utils/WGPUHelpers.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn {
+namespace {
+
+// Command handler sitting between the client's command buffer and the server. Depending on the
+// mode, commands are either forwarded to the server, dropped (to measure only the client-side
+// serialization), or recorded so that they can be replayed into the server later (to measure only
+// the server-side deserialization and execution). The number of bytes going through the handler
+// is counted in all modes.
+class BenchmarkCommandHandler : public dawn::wire::CommandHandler {
+  public:
+    enum class Mode {
+        Forward,
+        Drop,
+        Record,
+    };
+
+    void SetServer(dawn::wire::CommandHandler* server) { mServer = server; }
+    void SetMode(Mode mode) { mMode = mode; }
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        mByteCount += size;
+        switch (mMode) {
+            case Mode::Forward:
+                return mServer->HandleCommands(commands, size);
+            case Mode::Drop:
+                break;
+            case Mode::Record: {
+                if (size == 0) {
+                    break;
+                }
+                const char* begin = const_cast<const char*>(commands);
+                mRecording.insert(mRecording.end(), begin, begin + size);
+                mRecordedChunkEnds.push_back(mRecording.size());
+                break;
+            }
+        }
+        return commands + size;
+    }
+
+    // Forwards the recorded commands to the server, preserving the boundaries of the flushes they
+    // were recorded with so that chunked commands are handled as they would be when forwarded.
+    bool ReplayRecording() {
+        size_t offset = 0;
+        bool success = true;
+        for (size_t end : mRecordedChunkEnds) {
+            success &= mServer->HandleCommands(mRecording.data() + offset, end - offset) != nullptr;
+            offset = end;
+        }
+        mRecording.clear();
+        mRecordedChunkEnds.clear();
+        return success;
+    }
+
+    uint64_t GetByteCount() const { return mByteCount; }
+    void ResetByteCount() { mByteCount = 0; }
+
+  private:
+    Mode mMode = Mode::Forward;
+    dawn::wire::CommandHandler* mServer = nullptr;
+    uint64_t mByteCount = 0;
+    std::vector<char> mRecording;
+    std::vector<size_t> mRecordedChunkEnds;
+};
+
+// Benchmarks for the serialization and deserialization of commands on the wire. A wire client and
+// server are connected through TerribleCommandBuffers on top of a Null device, so that only the
+// cost of the wire (and the Null backend's frontend validation) is measured.
+class WireCommands : public benchmark::Fixture {
+  public:
+    void SetUp(const benchmark::State& state) override {
+        // Static initialization that only happens on the first time that a fixture is created.
+        static std::unique_ptr<dawn::native::Instance> nativeInstance =
+            std::make_unique<dawn::native::Instance>();
+        mNativeInstance = nativeInstance.get();
+
+        mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>(&mC2sHandler);
+        mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+        dawn::wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &dawn::native::GetProcs();
+        serverDesc.serializer = mS2cBuf.get();
+        serverDesc.useCompactEncoding = UseCompactEncoding();
+        mWireServer = std::make_unique<dawn::wire::WireServer>(serverDesc);
+        mC2sHandler.SetServer(mWireServer.get());
+
+        dawn::wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = mC2sBuf.get();
+        clientDesc.useCompactEncoding = UseCompactEncoding();
+        mWireClient = std::make_unique<dawn::wire::WireClient>(clientDesc);
+        mS2cBuf->SetHandler(mWireClient.get());
+
+        dawnProcSetProcs(&dawn::wire::client::GetProcs());
+
+        auto reservation = mWireClient->ReserveInstance();
+        mWireServer->InjectInstance(mNativeInstance->Get(), reservation.handle);
+        instance = wgpu::Instance::Acquire(reservation.instance);
+
+        wgpu::RequestAdapterOptions options = {};
+        options.backendType = wgpu::BackendType::Null;
+        instance.RequestAdapter(
+            &options,
+            [](WGPURequestAdapterStatus status, WGPUAdapter cAdapter, char const*,
+               void* userdata) {
+                DAWN_ASSERT(status == WGPURequestAdapterStatus_Success);
+                *reinterpret_cast<wgpu::Adapter*>(userdata) = wgpu::Adapter::Acquire(cAdapter);
+            },
+            &adapter);
+        while (!adapter) {
+            FlushWire();
+        }
+
+        wgpu::DeviceDescriptor deviceDesc = {};
+        adapter.RequestDevice(
+            &deviceDesc,
+            [](WGPURequestDeviceStatus status, WGPUDevice cDevice, char const*, void* userdata) {
+                DAWN_ASSERT(status == WGPURequestDeviceStatus_Success);
+                *reinterpret_cast<wgpu::Device*>(userdata) = wgpu::Device::Acquire(cDevice);
+            },
+            &device);
+        while (!device) {
+            FlushWire();
+        }
+
+        device.SetUncapturedErrorCallback(
+            [](WGPUErrorType, char const* message, void*) {
+                dawn::ErrorLog() << message;
+                DAWN_UNREACHABLE();
+            },
+            nullptr);
+        queue = device.GetQueue();
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        // Objects created while commands were dropped are unknown to the server, so their release
+        // must be dropped as well.
+        mC2sHandler.SetMode(BenchmarkCommandHandler::Mode::Drop);
+
+        renderPass = utils::BasicRenderPass();
+        bindGroup = nullptr;
+        uniformBuffer = nullptr;
+        pipeline = nullptr;
+        queue = nullptr;
+        device = nullptr;
+        adapter = nullptr;
+        instance = nullptr;
+        mC2sBuf->Flush();
+
+        mWireClient = nullptr;
+        mWireServer = nullptr;
+        mC2sBuf = nullptr;
+        mS2cBuf = nullptr;
+
+        dawnProcSetProcs(&dawn::native::GetProcs());
+    }
+
+  protected:
+    virtual bool UseCompactEncoding() const { return false; }
+
+    // Flushes both directions of the wire and lets the native instance and the client make
+    // progress on their asynchronous operations.
+    void FlushWire() {
+        bool c2sFlushed = mC2sBuf->Flush();
+        DAWN_ASSERT(c2sFlushed);
+        dawn::native::GetProcs().instanceProcessEvents(mNativeInstance->Get());
+        bool s2cFlushed = mS2cBuf->Flush();
+        DAWN_ASSERT(s2cFlushed);
+        instance.ProcessEvents();
+    }
+
+    // Flushes the setup commands so that they aren't counted in the reported throughput.
+    void StartMeasuring() {
+        FlushWire();
+        mC2sHandler.ResetByteCount();
+    }
+
+    // Only serialize client commands from now on, without sending them to the server.
+    void BeginSerializeOnly() {
+        StartMeasuring();
+        mC2sHandler.SetMode(BenchmarkCommandHandler::Mode::Drop);
+    }
+
+    // Record the client commands serialized until the next ReplayToServer call.
+    void BeginRecording() {
+        FlushWire();
+        mC2sHandler.SetMode(BenchmarkCommandHandler::Mode::Record);
+    }
+
+    // Sends the commands recorded since BeginRecording to the server.
+    void ReplayToServer() {
+        bool replayed = mC2sHandler.ReplayRecording();
+        DAWN_ASSERT(replayed);
+    }
+
+    // Records the number of commands processed and the number of bytes they used on the wire.
+    void ReportThroughput(benchmark::State& state, uint64_t commandsPerIteration) {
+        bool c2sFlushed = mC2sBuf->Flush();
+        DAWN_ASSERT(c2sFlushed);
+        state.SetItemsProcessed(state.iterations() * commandsPerIteration);
+        state.SetBytesProcessed(mC2sHandler.GetByteCount());
+        state.counters["bytes_per_command"] =
+            static_cast<double>(mC2sHandler.GetByteCount()) /
+            static_cast<double>(state.iterations() * commandsPerIteration);
+    }
+
+    // Creates a pipeline, bind group and render pass that are representative of a typical draw
+    // loop.
+    void CreateDrawResources() {
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            struct Uniforms {
+                offset : vec4f,
+            }
+            @group(0) @binding(0) var<uniform> uniforms : Uniforms;
+            @vertex fn main() -> @builtin(position) vec4f {
+                return uniforms.offset;
+            })");
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @fragment fn main() -> @location(0) vec4f {
+                return vec4f(0.0, 1.0, 0.0, 1.0);
+            })");
+        pipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        wgpu::BufferDescriptor bufferDesc = {};
+        bufferDesc.size = 256;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+        uniformBuffer = device.CreateBuffer(&bufferDesc);
+
+        bindGroup = utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0),
+                                         {{0, uniformBuffer, 0, 16}});
+        renderPass = utils::CreateBasicRenderPass(device, 4, 4);
+    }
+
+    // Encodes a full frame using the draw resources: a render pass with |drawCount| pairs of
+    // SetBindGroup and Draw, that is then submitted.
+    void EncodeFrame(uint32_t drawCount) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(pipeline);
+        for (uint32_t i = 0; i < drawCount; ++i) {
+            pass.SetBindGroup(0, bindGroup);
+            pass.Draw(3);
+        }
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    // Client-side cost of serializing the SetBindGroup and Draw commands of a render loop.
+    void SerializeSetBindGroupAndDraw(benchmark::State& state) {
+        CreateDrawResources();
+        BeginSerializeOnly();
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(pipeline);
+        for (auto _ : state) {
+            pass.SetBindGroup(0, bindGroup);
+            pass.Draw(3);
+        }
+        ReportThroughput(state, 2);
+    }
+
+    // Server-side cost of deserializing and executing a frame of SetBindGroup and Draw commands.
+    void HandleSetBindGroupAndDraw(benchmark::State& state) {
+        const uint32_t drawCount = state.range(0);
+        CreateDrawResources();
+        StartMeasuring();
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            BeginRecording();
+            EncodeFrame(drawCount);
+            FlushWire();
+            state.ResumeTiming();
+
+            ReplayToServer();
+        }
+        ReportThroughput(state, 2 * drawCount);
+    }
+
+    wgpu::Instance instance;
+    wgpu::Adapter adapter;
+    wgpu::Device device;
+    wgpu::Queue queue;
+
+    wgpu::RenderPipeline pipeline;
+    wgpu::Buffer uniformBuffer;
+    wgpu::BindGroup bindGroup;
+    utils::BasicRenderPass renderPass;
+
+  private:
+    dawn::native::Instance* mNativeInstance = nullptr;
+    BenchmarkCommandHandler mC2sHandler;
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<dawn::wire::WireServer> mWireServer;
+    std::unique_ptr<dawn::wire::WireClient> mWireClient;
+};
+
+// The same benchmarks with the compact encoding of the pass encoder commands, to compare the
+// number of bytes per command and the cost of encoding and decoding them.
+class WireCommandsCompact : public WireCommands {
+  protected:
+    bool UseCompactEncoding() const override { return true; }
+};
+
+BENCHMARK_DEFINE_F(WireCommands, SerializeSetBindGroupAndDraw)
+(benchmark::State& state) {
+    SerializeSetBindGroupAndDraw(state);
+}
+BENCHMARK_REGISTER_F(WireCommands, SerializeSetBindGroupAndDraw);
+
+BENCHMARK_DEFINE_F(WireCommandsCompact, SerializeSetBindGroupAndDraw)
+(benchmark::State& state) {
+    SerializeSetBindGroupAndDraw(state);
+}
+BENCHMARK_REGISTER_F(WireCommandsCompact, SerializeSetBindGroupAndDraw);
+
+// Client-side cost of serializing WriteBuffer commands of various sizes.
+BENCHMARK_DEFINE_F(WireCommands, SerializeWriteBuffer)
+(benchmark::State& state) {
+    const uint64_t size = state.range(0);
+    std::vector<uint8_t> data(size, 0x5A);
+
+    wgpu::BufferDescriptor bufferDesc = {};
+    bufferDesc.size = size;
+    bufferDesc.usage = wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+    BeginSerializeOnly();
+
+    for (auto _ : state) {
+        queue.WriteBuffer(buffer, 0, data.data(), size);
+    }
+    ReportThroughput(state, 1);
+}
+BENCHMARK_REGISTER_F(WireCommands, SerializeWriteBuffer)->RangeMultiplier(16)->Range(16, 64 << 10);
+
+BENCHMARK_DEFINE_F(WireCommands, HandleSetBindGroupAndDraw)
+(benchmark::State& state) {
+    HandleSetBindGroupAndDraw(state);
+}
+BENCHMARK_REGISTER_F(WireCommands, HandleSetBindGroupAndDraw)->Arg(100)->Arg(1000);
+
+BENCHMARK_DEFINE_F(WireCommandsCompact, HandleSetBindGroupAndDraw)
+(benchmark::State& state) {
+    HandleSetBindGroupAndDraw(state);
+}
+BENCHMARK_REGISTER_F(WireCommandsCompact, HandleSetBindGroupAndDraw)->Arg(100)->Arg(1000);
+
+// Server-side cost of deserializing and executing WriteBuffer commands of various sizes.
+BENCHMARK_DEFINE_F(WireCommands, HandleWriteBuffer)
+(benchmark::State& state) {
+    const uint64_t size = state.range(0);
+    std::vector<uint8_t> data(size, 0x5A);
+
+    wgpu::BufferDescriptor bufferDesc = {};
+    bufferDesc.size = size;
+    bufferDesc.usage = wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+    StartMeasuring();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        BeginRecording();
+        queue.WriteBuffer(buffer, 0, data.data(), size);
+        FlushWire();
+        state.ResumeTiming();
+
+        ReplayToServer();
+    }
+    ReportThroughput(state, 1);
+}
+BENCHMARK_REGISTER_F(WireCommands, HandleWriteBuffer)->RangeMultiplier(16)->Range(16, 64 << 10);
+
+// End-to-end cost of WriteBuffer commands that are larger than the maximum allocation size of the
+// command buffer, and so are chunked by the client and reassembled by the server.
+BENCHMARK_DEFINE_F(WireCommands, LargeWriteBuffer)
+(benchmark::State& state) {
+    const uint64_t size = state.range(0);
+    std::vector<uint8_t> data(size, 0x5A);
+
+    wgpu::BufferDescriptor bufferDesc = {};
+    bufferDesc.size = size;
+    bufferDesc.usage = wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+    StartMeasuring();
+
+    for (auto _ : state) {
+        queue.WriteBuffer(buffer, 0, data.data(), size);
+        FlushWire();
+    }
+    ReportThroughput(state, 1);
+}
+BENCHMARK_REGISTER_F(WireCommands, LargeWriteBuffer)
+    ->Arg(1 << 20)
+    ->Arg(4 << 20)
+    ->Arg(16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+// End-to-end cost of creating and releasing objects through the wire.
+BENCHMARK_DEFINE_F(WireCommands, CreateAndReleaseBuffer)
+(benchmark::State& state) {
+    const uint32_t objectCount = state.range(0);
+
+    wgpu::BufferDescriptor bufferDesc = {};
+    bufferDesc.size = 256;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+
+    std::vector<wgpu::Buffer> buffers(objectCount);
+    StartMeasuring();
+    for (auto _ : state) {
+        for (wgpu::Buffer& buffer : buffers) {
+            buffer = device.CreateBuffer(&bufferDesc);
+        }
+        for (wgpu::Buffer& buffer : buffers) {
+            buffer = nullptr;
+        }
+        FlushWire();
+    }
+    ReportThroughput(state, 2 * objectCount);
+}
+BENCHMARK_REGISTER_F(WireCommands, CreateAndReleaseBuffer)->Arg(1)->Arg(100);
+
+BENCHMARK_DEFINE_F(WireCommands, CreateAndReleaseBindGroup)
+(benchmark::State& state) {
+    const uint32_t objectCount = state.range(0);
+    CreateDrawResources();
+    wgpu::BindGroupLayout layout = pipeline.GetBindGroupLayout(0);
+
+    std::vector<wgpu::BindGroup> bindGroups(objectCount);
+    StartMeasuring();
+    for (auto _ : state) {
+        for (wgpu::BindGroup& bg : bindGroups) {
+            bg = utils::MakeBindGroup(device, layout, {{0, uniformBuffer, 0, 16}});
+        }
+        for (wgpu::BindGroup& bg : bindGroups) {
+            bg = nullptr;
+        }
+        FlushWire();
+    }
+    ReportThroughput(state, 2 * objectCount);
+}
+BENCHMARK_REGISTER_F(WireCommands, CreateAndReleaseBindGroup)->Arg(1)->Arg(100);
+
+}  // namespace
+}  // namespace dawn
@@ -0,0 +1,272 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/dawn_proc.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/utils/WGPUHelpers.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn {
+namespace {
+
+// Command handler that records the client commands so that they can be replayed into the server
+// later, from another thread.
+class RecordingCommandHandler : public dawn::wire::CommandHandler {
+  public:
+    void SetServer(dawn::wire::CommandHandler* server) { mServer = server; }
+    void SetRecording(bool recording) { mRecording = recording; }
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        if (!mRecording) {
+            return mServer->HandleCommands(commands, size);
+        }
+        if (size != 0) {
+            const char* begin = const_cast<const char*>(commands);
+            mCommands.insert(mCommands.end(), begin, begin + size);
+            mChunkEnds.push_back(mCommands.size());
+        }
+        return commands + size;
+    }
+
+    bool Replay() {
+        size_t offset = 0;
+        bool success = true;
+        for (size_t end : mChunkEnds) {
+            success &= mServer->HandleCommands(mCommands.data() + offset, end - offset) != nullptr;
+            offset = end;
+        }
+        mCommands.clear();
+        mChunkEnds.clear();
+        return success;
+    }
+
+  private:
+    bool mRecording = false;
+    dawn::wire::CommandHandler* mServer = nullptr;
+    std::vector<char> mCommands;
+    std::vector<size_t> mChunkEnds;
+};
+
+// A wire client and server pair driving its own device. All the streams share the same native
+// instance, like the streams of the different devices of a GPU process would.
+class WireStream {
+  public:
+    explicit WireStream(dawn::native::Instance* nativeInstance) : mNativeInstance(nativeInstance) {
+        mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>(&mC2sHandler);
+        mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+        dawn::wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &dawn::native::GetProcs();
+        serverDesc.serializer = mS2cBuf.get();
+        mWireServer = std::make_unique<dawn::wire::WireServer>(serverDesc);
+        mC2sHandler.SetServer(mWireServer.get());
+
+        dawn::wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = mC2sBuf.get();
+        mWireClient = std::make_unique<dawn::wire::WireClient>(clientDesc);
+        mS2cBuf->SetHandler(mWireClient.get());
+
+        auto reservation = mWireClient->ReserveInstance();
+        mWireServer->InjectInstance(mNativeInstance->Get(), reservation.handle);
+        mInstance = wgpu::Instance::Acquire(reservation.instance);
+
+        wgpu::RequestAdapterOptions options = {};
+        options.backendType = wgpu::BackendType::Null;
+        mInstance.RequestAdapter(
+            &options,
+            [](WGPURequestAdapterStatus status, WGPUAdapter cAdapter, char const*,
+               void* userdata) {
+                DAWN_ASSERT(status == WGPURequestAdapterStatus_Success);
+                *reinterpret_cast<wgpu::Adapter*>(userdata) = wgpu::Adapter::Acquire(cAdapter);
+            },
+            &mAdapter);
+        while (!mAdapter) {
+            FlushWire();
+        }
+
+        wgpu::DeviceDescriptor deviceDesc = {};
+        mAdapter.RequestDevice(
+            &deviceDesc,
+            [](WGPURequestDeviceStatus status, WGPUDevice cDevice, char const*, void* userdata) {
+                DAWN_ASSERT(status == WGPURequestDeviceStatus_Success);
+                *reinterpret_cast<wgpu::Device*>(userdata) = wgpu::Device::Acquire(cDevice);
+            },
+            &mDevice);
+        while (!mDevice) {
+            FlushWire();
+        }
+        mQueue = mDevice.GetQueue();
+
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = utils::CreateShaderModule(mDevice, R"(
+            struct Uniforms {
+                offset : vec4f,
+            }
+            @group(0) @binding(0) var<uniform> uniforms : Uniforms;
+            @vertex fn main() -> @builtin(position) vec4f {
+                return uniforms.offset;
+            })");
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(mDevice, R"(
+            @fragment fn main() -> @location(0) vec4f {
+                return vec4f(0.0, 1.0, 0.0, 1.0);
+            })");
+        mPipeline = mDevice.CreateRenderPipeline(&pipelineDesc);
+
+        wgpu::BufferDescriptor bufferDesc = {};
+        bufferDesc.size = 256;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+        mUniformBuffer = mDevice.CreateBuffer(&bufferDesc);
+
+        mBindGroup = utils::MakeBindGroup(mDevice, mPipeline.GetBindGroupLayout(0),
+                                          {{0, mUniformBuffer, 0, 16}});
+        mRenderPass = utils::CreateBasicRenderPass(mDevice, 4, 4);
+        FlushWire();
+    }
+
+    ~WireStream() {
+        mRenderPass = utils::BasicRenderPass();
+        mBindGroup = nullptr;
+        mUniformBuffer = nullptr;
+        mPipeline = nullptr;
+        mQueue = nullptr;
+        mDevice = nullptr;
+        mAdapter = nullptr;
+        mInstance = nullptr;
+        mC2sBuf->Flush();
+
+        mWireClient = nullptr;
+        mWireServer = nullptr;
+    }
+
+    // Records a frame with |drawCount| pairs of SetBindGroup and Draw, to be replayed later.
+    void RecordFrame(uint32_t drawCount) {
+        mC2sHandler.SetRecording(true);
+        wgpu::CommandEncoder encoder = mDevice.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+        pass.SetPipeline(mPipeline);
+        for (uint32_t i = 0; i < drawCount; ++i) {
+            pass.SetBindGroup(0, mBindGroup);
+            pass.Draw(3);
+        }
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        mQueue.Submit(1, &commands);
+        bool c2sFlushed = mC2sBuf->Flush();
+        DAWN_ASSERT(c2sFlushed);
+        mC2sHandler.SetRecording(false);
+    }
+
+    // Sends the recorded frame to the server. May be called on any thread.
+    void ReplayFrame() {
+        bool replayed = mC2sHandler.Replay();
+        DAWN_ASSERT(replayed);
+    }
+
+    // Flushes both directions of the wire and lets the native instance and the client make
+    // progress on their asynchronous operations.
+    void FlushWire() {
+        bool c2sFlushed = mC2sBuf->Flush();
+        DAWN_ASSERT(c2sFlushed);
+        dawn::native::GetProcs().instanceProcessEvents(mNativeInstance->Get());
+        bool s2cFlushed = mS2cBuf->Flush();
+        DAWN_ASSERT(s2cFlushed);
+        mInstance.ProcessEvents();
+    }
+
+  private:
+    dawn::native::Instance* mNativeInstance;
+    RecordingCommandHandler mC2sHandler;
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<dawn::wire::WireServer> mWireServer;
+    std::unique_ptr<dawn::wire::WireClient> mWireClient;
+
+    wgpu::Instance mInstance;
+    wgpu::Adapter mAdapter;
+    wgpu::Device mDevice;
+    wgpu::Queue mQueue;
+    wgpu::RenderPipeline mPipeline;
+    wgpu::Buffer mUniformBuffer;
+    wgpu::BindGroup mBindGroup;
+    utils::BasicRenderPass mRenderPass;
+};
+
+// Server-side cost of handling one frame of SetBindGroup and Draw commands on each of
+// |streamCount| devices, with one thread per WireServer. With servers that don't contend with
+// each other, the wall time per iteration stays flat as the number of streams grows.
+void HandleFramesConcurrently(benchmark::State& state) {
+    const size_t streamCount = state.range(0);
+    const uint32_t drawCount = state.range(1);
+
+    static std::unique_ptr<dawn::native::Instance> nativeInstance =
+        std::make_unique<dawn::native::Instance>();
+    dawnProcSetProcs(&dawn::wire::client::GetProcs());
+
+    std::vector<std::unique_ptr<WireStream>> streams;
+    for (size_t i = 0; i < streamCount; ++i) {
+        streams.push_back(std::make_unique<WireStream>(nativeInstance.get()));
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (auto& stream : streams) {
+            stream->FlushWire();
+            stream->RecordFrame(drawCount);
+        }
+        state.ResumeTiming();
+
+        std::vector<std::thread> threads;
+        for (auto& stream : streams) {
+            threads.emplace_back([&stream] { stream->ReplayFrame(); });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * streamCount * 2 * drawCount);
+
+    streams.clear();
+    dawnProcSetProcs(&dawn::native::GetProcs());
+}
+BENCHMARK(HandleFramesConcurrently)
+    ->ArgsProduct({{1, 2, 4, 8}, {1000}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace dawn
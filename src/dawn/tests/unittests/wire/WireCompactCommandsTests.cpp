@@ -0,0 +1,288 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <array>
+#include <limits>
+#include <utility>
+
+#include "dawn/tests/unittests/wire/WireTest.h"
+#include "dawn/wire/CompactCommands.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn::wire {
+namespace {
+
+using testing::_;
+using testing::InSequence;
+using testing::Return;
+
+class WireCompactCommandsTests : public WireTest {
+  public:
+    WireCompactCommandsTests() {}
+    ~WireCompactCommandsTests() override = default;
+
+    void SetUp() override {
+        WireTest::SetUp();
+
+        encoder = wgpuDeviceCreateCommandEncoder(device, nullptr);
+        apiEncoder = api.GetNewCommandEncoder();
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+            .WillOnce(Return(apiEncoder));
+        FlushClient();
+    }
+
+  protected:
+    // Begins a render pass on |encoder| and returns the client and the mock pass encoders.
+    std::pair<WGPURenderPassEncoder, WGPURenderPassEncoder> BeginRenderPass() {
+        WGPURenderPassDescriptor descriptor = {};
+        WGPURenderPassEncoder pass = wgpuCommandEncoderBeginRenderPass(encoder, &descriptor);
+        WGPURenderPassEncoder apiPass = api.GetNewRenderPassEncoder();
+        EXPECT_CALL(api, CommandEncoderBeginRenderPass(apiEncoder, _))
+            .WillOnce(Return(apiPass))
+            .RetiresOnSaturation();
+        return {pass, apiPass};
+    }
+
+    std::pair<WGPUComputePassEncoder, WGPUComputePassEncoder> BeginComputePass() {
+        WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, nullptr);
+        WGPUComputePassEncoder apiPass = api.GetNewComputePassEncoder();
+        EXPECT_CALL(api, CommandEncoderBeginComputePass(apiEncoder, nullptr))
+            .WillOnce(Return(apiPass))
+            .RetiresOnSaturation();
+        return {pass, apiPass};
+    }
+
+    std::pair<WGPUBuffer, WGPUBuffer> CreateBuffer() {
+        WGPUBufferDescriptor descriptor = {};
+        descriptor.size = 256;
+        descriptor.usage = static_cast<WGPUBufferUsage>(WGPUBufferUsage_Vertex |
+                                                        WGPUBufferUsage_Index);
+        WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+        WGPUBuffer apiBuffer = api.GetNewBuffer();
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _))
+            .WillOnce(Return(apiBuffer))
+            .RetiresOnSaturation();
+        return {buffer, apiBuffer};
+    }
+
+    std::pair<WGPUBindGroup, WGPUBindGroup> CreateBindGroup() {
+        WGPUBindGroupLayoutDescriptor bglDescriptor = {};
+        WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDescriptor);
+        WGPUBindGroupLayout apiBgl = api.GetNewBindGroupLayout();
+        EXPECT_CALL(api, DeviceCreateBindGroupLayout(apiDevice, _)).WillOnce(Return(apiBgl));
+
+        WGPUBindGroupDescriptor descriptor = {};
+        descriptor.layout = bgl;
+        WGPUBindGroup bindGroup = wgpuDeviceCreateBindGroup(device, &descriptor);
+        WGPUBindGroup apiBindGroup = api.GetNewBindGroup();
+        EXPECT_CALL(api, DeviceCreateBindGroup(apiDevice, _)).WillOnce(Return(apiBindGroup));
+        return {bindGroup, apiBindGroup};
+    }
+
+    WGPUCommandEncoder encoder;
+    WGPUCommandEncoder apiEncoder;
+
+  private:
+    bool UseCompactEncoding() override { return true; }
+};
+
+// Test that draws are forwarded with all their arguments.
+TEST_F(WireCompactCommandsTests, Draw) {
+    auto [pass, apiPass] = BeginRenderPass();
+
+    wgpuRenderPassEncoderDraw(pass, 3, 1, 0, 0);
+    wgpuRenderPassEncoderDraw(pass, 0xFFFF'FFFFu, 0x8000'0000u, 127, 128);
+    wgpuRenderPassEncoderDrawIndexed(pass, 6, 2, 1, -1, 4);
+    wgpuRenderPassEncoderDrawIndexed(pass, 6, 2, 1, std::numeric_limits<int32_t>::min(), 4);
+    wgpuRenderPassEncoderDrawIndexed(pass, 6, 2, 1, std::numeric_limits<int32_t>::max(), 4);
+
+    InSequence s;
+    EXPECT_CALL(api, RenderPassEncoderDraw(apiPass, 3, 1, 0, 0));
+    EXPECT_CALL(api, RenderPassEncoderDraw(apiPass, 0xFFFF'FFFFu, 0x8000'0000u, 127, 128));
+    EXPECT_CALL(api, RenderPassEncoderDrawIndexed(apiPass, 6, 2, 1, -1, 4));
+    EXPECT_CALL(api, RenderPassEncoderDrawIndexed(apiPass, 6, 2, 1,
+                                                  std::numeric_limits<int32_t>::min(), 4));
+    EXPECT_CALL(api, RenderPassEncoderDrawIndexed(apiPass, 6, 2, 1,
+                                                  std::numeric_limits<int32_t>::max(), 4));
+
+    FlushClient();
+}
+
+// Test that the vertex and index buffers are forwarded, including WGPU_WHOLE_SIZE and a null
+// vertex buffer.
+TEST_F(WireCompactCommandsTests, SetVertexAndIndexBuffer) {
+    auto [buffer, apiBuffer] = CreateBuffer();
+    auto [pass, apiPass] = BeginRenderPass();
+
+    wgpuRenderPassEncoderSetVertexBuffer(pass, 0, buffer, 0, WGPU_WHOLE_SIZE);
+    wgpuRenderPassEncoderSetVertexBuffer(pass, 7, buffer, 64, 128);
+    wgpuRenderPassEncoderSetVertexBuffer(pass, 1, nullptr, 0, 0);
+    wgpuRenderPassEncoderSetIndexBuffer(pass, buffer, WGPUIndexFormat_Uint32, 16, WGPU_WHOLE_SIZE);
+    wgpuRenderPassEncoderSetIndexBuffer(pass, buffer, WGPUIndexFormat_Uint16, 0, 32);
+
+    InSequence s;
+    EXPECT_CALL(api, RenderPassEncoderSetVertexBuffer(apiPass, 0, apiBuffer, 0, WGPU_WHOLE_SIZE));
+    EXPECT_CALL(api, RenderPassEncoderSetVertexBuffer(apiPass, 7, apiBuffer, 64, 128));
+    EXPECT_CALL(api, RenderPassEncoderSetVertexBuffer(apiPass, 1, nullptr, 0, 0));
+    EXPECT_CALL(api, RenderPassEncoderSetIndexBuffer(apiPass, apiBuffer, WGPUIndexFormat_Uint32,
+                                                     16, WGPU_WHOLE_SIZE));
+    EXPECT_CALL(api, RenderPassEncoderSetIndexBuffer(apiPass, apiBuffer, WGPUIndexFormat_Uint16,
+                                                     0, 32));
+
+    FlushClient();
+}
+
+// Test that bind groups are forwarded, and that the commands with dynamic offsets, which don't
+// have a compact form, are still ordered correctly with the compact commands.
+TEST_F(WireCompactCommandsTests, SetBindGroup) {
+    auto [bindGroup, apiBindGroup] = CreateBindGroup();
+    auto [pass, apiPass] = BeginRenderPass();
+
+    std::array<uint32_t, 2> offsets = {256, 512};
+    wgpuRenderPassEncoderSetBindGroup(pass, 0, bindGroup, 0, nullptr);
+    wgpuRenderPassEncoderSetBindGroup(pass, 1, bindGroup, offsets.size(), offsets.data());
+    wgpuRenderPassEncoderSetBindGroup(pass, 2, nullptr, 0, nullptr);
+    wgpuRenderPassEncoderDraw(pass, 3, 1, 0, 0);
+
+    InSequence s;
+    EXPECT_CALL(api, RenderPassEncoderSetBindGroup(apiPass, 0, apiBindGroup, 0, nullptr));
+    EXPECT_CALL(api, RenderPassEncoderSetBindGroup(apiPass, 1, apiBindGroup, offsets.size(),
+                                                   MatchesLambda([](const uint32_t* o) {
+                                                       return o[0] == 256 && o[1] == 512;
+                                                   })));
+    EXPECT_CALL(api, RenderPassEncoderSetBindGroup(apiPass, 2, nullptr, 0, nullptr));
+    EXPECT_CALL(api, RenderPassEncoderDraw(apiPass, 3, 1, 0, 0));
+
+    FlushClient();
+}
+
+// Test the compute pass commands that have a compact form.
+TEST_F(WireCompactCommandsTests, ComputePass) {
+    WGPUShaderModuleDescriptor moduleDescriptor = {};
+    WGPUShaderModule module = wgpuDeviceCreateShaderModule(device, &moduleDescriptor);
+    WGPUShaderModule apiModule = api.GetNewShaderModule();
+    EXPECT_CALL(api, DeviceCreateShaderModule(apiDevice, _)).WillOnce(Return(apiModule));
+
+    WGPUComputePipelineDescriptor pipelineDescriptor = {};
+    pipelineDescriptor.compute.module = module;
+    WGPUComputePipeline pipeline = wgpuDeviceCreateComputePipeline(device, &pipelineDescriptor);
+    WGPUComputePipeline apiPipeline = api.GetNewComputePipeline();
+    EXPECT_CALL(api, DeviceCreateComputePipeline(apiDevice, _)).WillOnce(Return(apiPipeline));
+
+    auto [bindGroup, apiBindGroup] = CreateBindGroup();
+    auto [pass, apiPass] = BeginComputePass();
+
+    wgpuComputePassEncoderSetPipeline(pass, pipeline);
+    wgpuComputePassEncoderSetBindGroup(pass, 3, bindGroup, 0, nullptr);
+    wgpuComputePassEncoderDispatchWorkgroups(pass, 1, 2, 65535);
+
+    InSequence s;
+    EXPECT_CALL(api, ComputePassEncoderSetPipeline(apiPass, apiPipeline));
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiPass, 3, apiBindGroup, 0, nullptr));
+    EXPECT_CALL(api, ComputePassEncoderDispatchWorkgroups(apiPass, 1, 2, 65535));
+
+    FlushClient();
+}
+
+// Test that the encoder of each command is right when commands of several encoders are
+// interleaved, including across flushes.
+TEST_F(WireCompactCommandsTests, InterleavedEncoders) {
+    // Flush after each pass is created since their expectations are otherwise equivalent.
+    auto [pass1, apiPass1] = BeginRenderPass();
+    FlushClient();
+    auto [pass2, apiPass2] = BeginRenderPass();
+    FlushClient();
+    auto [computePass, apiComputePass] = BeginComputePass();
+
+    wgpuRenderPassEncoderDraw(pass1, 1, 1, 0, 0);
+    wgpuRenderPassEncoderDraw(pass1, 2, 1, 0, 0);
+    wgpuComputePassEncoderDispatchWorkgroups(computePass, 1, 1, 1);
+    wgpuRenderPassEncoderDraw(pass1, 3, 1, 0, 0);
+    wgpuRenderPassEncoderDraw(pass2, 4, 1, 0, 0);
+    wgpuRenderPassEncoderDraw(pass1, 5, 1, 0, 0);
+
+    {
+        InSequence s;
+        EXPECT_CALL(api, RenderPassEncoderDraw(apiPass1, 1, 1, 0, 0));
+        EXPECT_CALL(api, RenderPassEncoderDraw(apiPass1, 2, 1, 0, 0));
+        EXPECT_CALL(api, ComputePassEncoderDispatchWorkgroups(apiComputePass, 1, 1, 1));
+        EXPECT_CALL(api, RenderPassEncoderDraw(apiPass1, 3, 1, 0, 0));
+        EXPECT_CALL(api, RenderPassEncoderDraw(apiPass2, 4, 1, 0, 0));
+        EXPECT_CALL(api, RenderPassEncoderDraw(apiPass1, 5, 1, 0, 0));
+    }
+    FlushClient();
+
+    wgpuRenderPassEncoderDraw(pass1, 6, 1, 0, 0);
+    wgpuComputePassEncoderDispatchWorkgroups(computePass, 2, 2, 2);
+    EXPECT_CALL(api, RenderPassEncoderDraw(apiPass1, 6, 1, 0, 0));
+    EXPECT_CALL(api, ComputePassEncoderDispatchWorkgroups(apiComputePass, 2, 2, 2));
+    FlushClient();
+}
+
+// Test that a compact command repeating the previous encoder is rejected when there is none.
+TEST_F(WireCompactCommandsTests, SameEncoderWithoutPreviousEncoderIsError) {
+    std::array<char, 8> command = {};
+    command[0] = static_cast<char>((1 << 1) | kCompactCmdMarker);
+    command[1] = static_cast<char>(static_cast<uint8_t>(CompactCmd::RenderPassEncoderDraw) |
+                                   kCompactCmdSameEncoder);
+    ASSERT_EQ(GetWireServer()->HandleCommands(command.data(), command.size()), nullptr);
+}
+
+// Test that an unknown compact command is rejected.
+TEST_F(WireCompactCommandsTests, UnknownCommandIsError) {
+    std::array<char, 8> command = {};
+    command[0] = static_cast<char>((1 << 1) | kCompactCmdMarker);
+    command[1] = 0x7F;
+    ASSERT_EQ(GetWireServer()->HandleCommands(command.data(), command.size()), nullptr);
+}
+
+// Test that a compact command larger than the commands is rejected.
+TEST_F(WireCompactCommandsTests, TruncatedCommandIsError) {
+    std::array<char, 8> command = {};
+    command[0] = static_cast<char>((2 << 1) | kCompactCmdMarker);
+    command[1] = static_cast<char>(CompactCmd::RenderPassEncoderDraw);
+    ASSERT_EQ(GetWireServer()->HandleCommands(command.data(), command.size()), nullptr);
+}
+
+using WireCompactCommandsDisabledTests = WireTest;
+
+// Test that a compact command is rejected, instead of being parsed as a regular command, when the
+// server doesn't use the compact encoding.
+TEST_F(WireCompactCommandsDisabledTests, CompactCommandIsError) {
+    // A Draw(3, 1, 0, 0) on the encoder with ID 1.
+    std::array<char, 8> command = {};
+    command[0] = static_cast<char>((1 << 1) | kCompactCmdMarker);
+    command[1] = static_cast<char>(CompactCmd::RenderPassEncoderDraw);
+    command[2] = 1;
+    command[3] = 3;
+    command[4] = 1;
+    ASSERT_EQ(GetWireServer()->HandleCommands(command.data(), command.size()), nullptr);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
@@ -26,6 +26,8 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <memory>
+#include <string>
+#include <thread>
 #include <utility>
 
 #include "dawn/common/FutureUtils.h"
@@ -38,6 +40,7 @@ namespace {
 
 using testing::_;
 using testing::DoAll;
+using testing::InSequence;
 using testing::InvokeWithoutArgs;
 using testing::Mock;
 using testing::Return;
@@ -123,6 +126,64 @@ TEST_F(WireErrorCallbackTests, DeviceValidationErrorCallback) {
     FlushServer();
 }
 
+// Test that device error callbacks called on another thread while the server handles commands are
+// forwarded once the server is done with them.
+TEST_F(WireErrorCallbackTests, DeviceErrorCallbackOnOtherThread) {
+    wgpuDeviceSetUncapturedErrorCallback(device, ToMockDeviceErrorCallback, this);
+
+    wgpuDeviceCreateCommandEncoder(device, nullptr);
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(InvokeWithoutArgs([&] {
+            // The message is destroyed before the server can forward the error, so it must be
+            // copied.
+            std::thread([&] {
+                std::string message = "Some error message";
+                api.CallDeviceSetUncapturedErrorCallbackCallback(
+                    apiDevice, WGPUErrorType_Validation, message.c_str());
+            }).join();
+            return apiEncoder;
+        }));
+    FlushClient();
+
+    EXPECT_CALL(*mockDeviceErrorCallback,
+                Call(WGPUErrorType_Validation, StrEq("Some error message"), this))
+        .Times(1);
+
+    FlushServer();
+}
+
+// Test that a callback called while the server handles a command is forwarded after the callbacks
+// that were deferred before it.
+TEST_F(WireErrorCallbackTests, DeferredCallbacksRunInOrder) {
+    wgpuDeviceSetUncapturedErrorCallback(device, ToMockDeviceErrorCallback, this);
+
+    wgpuDeviceCreateCommandEncoder(device, nullptr);
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(InvokeWithoutArgs([&] {
+            // Deferred, since this thread is using the server.
+            std::thread([&] {
+                api.CallDeviceSetUncapturedErrorCallbackCallback(
+                    apiDevice, WGPUErrorType_Validation, "First error message");
+            }).join();
+            // Called synchronously by the native API while the command is handled.
+            api.CallDeviceSetUncapturedErrorCallbackCallback(apiDevice, WGPUErrorType_Validation,
+                                                             "Second error message");
+            return apiEncoder;
+        }));
+    FlushClient();
+
+    {
+        InSequence s;
+        EXPECT_CALL(*mockDeviceErrorCallback,
+                    Call(WGPUErrorType_Validation, StrEq("First error message"), this));
+        EXPECT_CALL(*mockDeviceErrorCallback,
+                    Call(WGPUErrorType_Validation, StrEq("Second error message"), this));
+    }
+    FlushServer();
+}
+
 // Test the return wire for device OOM error callbacks
 TEST_F(WireErrorCallbackTests, DeviceOutOfMemoryErrorCallback) {
     wgpuDeviceSetUncapturedErrorCallback(device, ToMockDeviceErrorCallback, this);
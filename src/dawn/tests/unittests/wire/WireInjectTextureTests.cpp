@@ -121,6 +121,46 @@ TEST_F(WireInjectTextureTests, ReuseIDAndGeneration) {
     ASSERT_TRUE(GetWireServer()->InjectTexture(apiTexture, reserved.handle, reserved.deviceHandle));
 }
 
+// Test that an ID can't be injected past the end of the known IDs, as the client allocates its IDs
+// in order when it doesn't encode commands from multiple threads.
+TEST_F(WireInjectTextureTests, InjectAfterLargerIDIsError) {
+    auto reserved1 = GetWireClient()->ReserveTexture(device, &placeholderDesc);
+    auto reserved2 = GetWireClient()->ReserveTexture(device, &placeholderDesc);
+    ASSERT_GT(reserved2.handle.id, reserved1.handle.id);
+
+    WGPUTexture apiTexture2 = api.GetNewTexture();
+    EXPECT_CALL(api, TextureReference(apiTexture2)).Times(0);
+    ASSERT_FALSE(
+        GetWireServer()->InjectTexture(apiTexture2, reserved2.handle, reserved2.deviceHandle));
+}
+
+class WireInjectTextureMultithreadTests : public WireInjectTextureTests {
+  protected:
+    bool UseMultithreadedEncoding() override { return true; }
+};
+
+// Test that IDs can be injected after a larger ID was allocated, like when objects are created
+// concurrently by multiple threads of the client.
+TEST_F(WireInjectTextureMultithreadTests, InjectAfterLargerID) {
+    auto reserved1 = GetWireClient()->ReserveTexture(device, &placeholderDesc);
+    auto reserved2 = GetWireClient()->ReserveTexture(device, &placeholderDesc);
+    ASSERT_GT(reserved2.handle.id, reserved1.handle.id);
+
+    WGPUTexture apiTexture2 = api.GetNewTexture();
+    EXPECT_CALL(api, TextureReference(apiTexture2));
+    ASSERT_TRUE(
+        GetWireServer()->InjectTexture(apiTexture2, reserved2.handle, reserved2.deviceHandle));
+
+    WGPUTexture apiTexture1 = api.GetNewTexture();
+    EXPECT_CALL(api, TextureReference(apiTexture1));
+    ASSERT_TRUE(
+        GetWireServer()->InjectTexture(apiTexture1, reserved1.handle, reserved1.deviceHandle));
+
+    // The skipped ID can only be allocated once.
+    ASSERT_FALSE(
+        GetWireServer()->InjectTexture(apiTexture1, reserved1.handle, reserved1.deviceHandle));
+}
+
 // Test that the server only borrows the texture and does a single reference-release
 TEST_F(WireInjectTextureTests, InjectedTextureLifetime) {
     auto reserved = GetWireClient()->ReserveTexture(device, &placeholderDesc);
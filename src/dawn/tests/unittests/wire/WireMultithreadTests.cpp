@@ -0,0 +1,219 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "dawn/tests/unittests/wire/WireTest.h"
+
+namespace dawn::wire {
+namespace {
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+using testing::Invoke;
+using testing::Return;
+using testing::StrEq;
+
+class WireMultithreadTests : public WireTest {
+  public:
+    WireMultithreadTests() {}
+    ~WireMultithreadTests() override = default;
+
+  protected:
+    bool UseMultithreadedEncoding() override { return true; }
+};
+
+// Test that objects can be created and released concurrently, and that the commands of each thread
+// are received in order.
+TEST_F(WireMultithreadTests, ConcurrentObjectCreation) {
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kObjectsPerThread = 200;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([this, t] {
+            for (uint32_t i = 0; i < kObjectsPerThread; ++i) {
+                WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(device, nullptr);
+                std::string label = std::to_string(t) + " " + std::to_string(i);
+                wgpuCommandEncoderInsertDebugMarker(encoder, label.c_str());
+                wgpuCommandEncoderRelease(encoder);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Each marker must target the encoder created just before by the same thread, which is still
+    // alive on the server.
+    absl::flat_hash_map<WGPUCommandEncoder, bool> liveEncoders;
+    std::vector<uint32_t> nextIndices(kThreadCount, 0);
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .Times(kThreadCount * kObjectsPerThread)
+        .WillRepeatedly(Invoke([&](WGPUDevice, const WGPUCommandEncoderDescriptor*) {
+            WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+            liveEncoders[apiEncoder] = true;
+            return apiEncoder;
+        }));
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(_, _))
+        .Times(kThreadCount * kObjectsPerThread)
+        .WillRepeatedly(Invoke([&](WGPUCommandEncoder apiEncoder, const char* label) {
+            EXPECT_TRUE(liveEncoders[apiEncoder]);
+            uint32_t t;
+            uint32_t i;
+            ASSERT_EQ(sscanf(label, "%u %u", &t, &i), 2);
+            ASSERT_LT(t, kThreadCount);
+            EXPECT_EQ(i, nextIndices[t]++);
+        }));
+    EXPECT_CALL(api, CommandEncoderRelease(_))
+        .Times(kThreadCount * kObjectsPerThread)
+        .WillRepeatedly(
+            Invoke([&](WGPUCommandEncoder apiEncoder) { liveEncoders[apiEncoder] = false; }));
+    FlushClient();
+
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        EXPECT_EQ(nextIndices[t], kObjectsPerThread);
+    }
+}
+
+// Test that the commands of different threads are received in the order they were encoded when the
+// threads are synchronized.
+TEST_F(WireMultithreadTests, SynchronizedThreadsKeepOrder) {
+    constexpr uint32_t kMarkerCount = 50;
+
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(device, nullptr);
+
+    // Two threads take turns to insert the markers in the encoder.
+    std::mutex mutex;
+    std::condition_variable turnChanged;
+    uint32_t nextMarker = 0;
+    auto insertMarkers = [&](uint32_t parity) {
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            turnChanged.wait(lock, [&] {
+                return nextMarker >= kMarkerCount || nextMarker % 2 == parity;
+            });
+            if (nextMarker >= kMarkerCount) {
+                return;
+            }
+            wgpuCommandEncoderInsertDebugMarker(encoder, std::to_string(nextMarker).c_str());
+            nextMarker++;
+            turnChanged.notify_all();
+        }
+    };
+    std::thread even(insertMarkers, 0);
+    std::thread odd(insertMarkers, 1);
+    even.join();
+    odd.join();
+
+    WGPUCommandBuffer commandBuffer = wgpuCommandEncoderFinish(encoder, nullptr);
+
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    WGPUCommandBuffer apiCommandBuffer = api.GetNewCommandBuffer();
+    {
+        InSequence s;
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+            .WillOnce(Return(apiEncoder));
+        for (uint32_t i = 0; i < kMarkerCount; ++i) {
+            EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder,
+                                                             StrEq(std::to_string(i).c_str())));
+        }
+        EXPECT_CALL(api, CommandEncoderFinish(apiEncoder, nullptr))
+            .WillOnce(Return(apiCommandBuffer));
+    }
+    FlushClient();
+
+    wgpuCommandBufferRelease(commandBuffer);
+    wgpuCommandEncoderRelease(encoder);
+    EXPECT_CALL(api, CommandBufferRelease(apiCommandBuffer));
+    EXPECT_CALL(api, CommandEncoderRelease(apiEncoder));
+    FlushClient();
+}
+
+// Test that commands encoded after a Flush are sent by the next one.
+TEST_F(WireMultithreadTests, CommandsAfterFlush) {
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(device, nullptr);
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr)).WillOnce(Return(apiEncoder));
+    FlushClient();
+
+    std::thread([&] { wgpuCommandEncoderInsertDebugMarker(encoder, "marker"); }).join();
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder, StrEq("marker")));
+    FlushClient();
+
+    wgpuCommandEncoderRelease(encoder);
+    EXPECT_CALL(api, CommandEncoderRelease(apiEncoder));
+    FlushClient();
+}
+
+// Test that the client can be disconnected while other threads encode and flush commands.
+TEST_F(WireMultithreadTests, DisconnectWhileEncoding) {
+    constexpr uint32_t kThreadCount = 4;
+
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(device, nullptr);
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr)).WillOnce(Return(apiEncoder));
+    FlushClient();
+
+    // The markers encoded before the disconnection may be received.
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder, StrEq("marker")))
+        .Times(AnyNumber());
+
+    std::atomic<bool> disconnected = false;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&] {
+            while (!disconnected) {
+                wgpuCommandEncoderInsertDebugMarker(encoder, "marker");
+                GetWireClient()->Flush();
+            }
+            // Commands can still be encoded after the disconnection, but they are dropped.
+            wgpuCommandEncoderInsertDebugMarker(encoder, "marker");
+        });
+    }
+    GetWireClient()->Disconnect();
+    disconnected = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Nothing is sent after the disconnection.
+    FlushClient(false);
+
+    wgpuCommandEncoderRelease(encoder);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
@@ -25,7 +25,10 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <cstring>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "dawn/tests/unittests/wire/WireFutureTest.h"
 #include "dawn/tests/unittests/wire/WireTest.h"
@@ -36,6 +39,7 @@ namespace dawn::wire {
 namespace {
 
 using testing::_;
+using testing::Invoke;
 using testing::InvokeWithoutArgs;
 using testing::Return;
 
@@ -210,6 +214,163 @@ TEST_F(WireQueueTests, DeviceThenDefaultQueueReleased) {
     DefaultApiDeviceWasReleased();
 }
 
+class WireQueueWriteTests : public WireTest {
+  protected:
+    // Creates a buffer of |size| bytes and returns the client and mock buffers.
+    std::pair<WGPUBuffer, WGPUBuffer> CreateBuffer(uint64_t size, WGPUBufferUsageFlags usage) {
+        WGPUBufferDescriptor descriptor = {};
+        descriptor.size = size;
+        descriptor.usage = usage;
+        WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+        WGPUBuffer apiBuffer = api.GetNewBuffer();
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+        FlushClient();
+        return {buffer, apiBuffer};
+    }
+
+    // Returns data that is larger than the command buffer used by the tests, so that it can't be
+    // sent in a single command. The expectations must be set before the data is written since the
+    // command buffer is flushed when it is full.
+    std::vector<uint8_t> MakeLargeData(size_t size) {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<uint8_t>(i * 7 + i / 251);
+        }
+        return data;
+    }
+
+    // Expects WriteBuffer calls on |apiBuffer| and reassembles their data in |received|, checking
+    // that each call starts where the previous one ended.
+    void ExpectWrites(WGPUBuffer apiBuffer,
+                      uint64_t bufferOffset,
+                      std::vector<uint8_t>* received,
+                      size_t* callCount) {
+        EXPECT_CALL(api, QueueWriteBuffer(apiQueue, apiBuffer, _, _, _))
+            .WillRepeatedly(Invoke([=](WGPUQueue, WGPUBuffer, uint64_t offset, const void* data,
+                                       size_t size) {
+                EXPECT_EQ(offset, bufferOffset + received->size());
+                const uint8_t* bytes = static_cast<const uint8_t*>(data);
+                received->insert(received->end(), bytes, bytes + size);
+                ++*callCount;
+            }));
+    }
+};
+
+// Test that a WriteBuffer too large for a single command is forwarded as a single write with all
+// its data.
+TEST_F(WireQueueWriteTests, LargeWriteBuffer) {
+    constexpr size_t kSize = 2500000;
+    std::vector<uint8_t> data = MakeLargeData(kSize);
+    auto [buffer, apiBuffer] = CreateBuffer(kSize + 256, WGPUBufferUsage_CopyDst);
+    std::vector<uint8_t> received;
+    size_t callCount = 0;
+    ExpectWrites(apiBuffer, 256, &received, &callCount);
+    wgpuQueueWriteBuffer(queue, buffer, 256, data.data(), kSize);
+    FlushClient();
+
+    EXPECT_EQ(callCount, 1u);
+    EXPECT_EQ(received, data);
+}
+
+// Test that large WriteBuffers that fail validation are not split, so that they generate a single
+// validation error.
+TEST_F(WireQueueWriteTests, LargeInvalidWriteBufferIsNotSplit) {
+    constexpr size_t kSize = 2500000;
+    std::vector<uint8_t> data = MakeLargeData(kSize);
+
+    // Unaligned size.
+    {
+        auto [buffer, apiBuffer] = CreateBuffer(kSize, WGPUBufferUsage_CopyDst);
+        std::vector<uint8_t> received;
+        size_t callCount = 0;
+        ExpectWrites(apiBuffer, 0, &received, &callCount);
+        wgpuQueueWriteBuffer(queue, buffer, 0, data.data(), kSize - 2);
+        FlushClient();
+
+        EXPECT_EQ(callCount, 1u);
+        EXPECT_EQ(received, std::vector<uint8_t>(data.begin(), data.end() - 2));
+    }
+
+    // Out of bounds.
+    {
+        auto [buffer, apiBuffer] = CreateBuffer(kSize - 4, WGPUBufferUsage_CopyDst);
+        std::vector<uint8_t> received;
+        size_t callCount = 0;
+        ExpectWrites(apiBuffer, 0, &received, &callCount);
+        wgpuQueueWriteBuffer(queue, buffer, 0, data.data(), kSize);
+        FlushClient();
+
+        EXPECT_EQ(callCount, 1u);
+        EXPECT_EQ(received, data);
+    }
+
+    // Missing CopyDst usage.
+    {
+        auto [buffer, apiBuffer] = CreateBuffer(kSize, WGPUBufferUsage_Vertex);
+        std::vector<uint8_t> received;
+        size_t callCount = 0;
+        ExpectWrites(apiBuffer, 0, &received, &callCount);
+        wgpuQueueWriteBuffer(queue, buffer, 0, data.data(), kSize);
+        FlushClient();
+
+        EXPECT_EQ(callCount, 1u);
+        EXPECT_EQ(received, data);
+    }
+
+    // Destroyed buffer, which the client can't tell apart from a valid one.
+    {
+        auto [buffer, apiBuffer] = CreateBuffer(kSize, WGPUBufferUsage_CopyDst);
+        wgpuBufferDestroy(buffer);
+        EXPECT_CALL(api, BufferDestroy(apiBuffer));
+        FlushClient();
+
+        std::vector<uint8_t> received;
+        size_t callCount = 0;
+        ExpectWrites(apiBuffer, 0, &received, &callCount);
+        wgpuQueueWriteBuffer(queue, buffer, 0, data.data(), kSize);
+        FlushClient();
+
+        EXPECT_EQ(callCount, 1u);
+        EXPECT_EQ(received, data);
+    }
+}
+
+// Test that a WriteTexture too large for a single command is forwarded with all its data.
+TEST_F(WireQueueWriteTests, LargeWriteTexture) {
+    constexpr size_t kSize = 2500003;
+    std::vector<uint8_t> data = MakeLargeData(kSize);
+
+    WGPUTextureDescriptor textureDesc = {};
+    textureDesc.size = {1024, 1024, 1};
+    textureDesc.format = WGPUTextureFormat_RGBA8Unorm;
+    textureDesc.usage = WGPUTextureUsage_CopyDst;
+    WGPUTexture texture = wgpuDeviceCreateTexture(device, &textureDesc);
+    WGPUTexture apiTexture = api.GetNewTexture();
+    EXPECT_CALL(api, DeviceCreateTexture(apiDevice, _)).WillOnce(Return(apiTexture));
+    FlushClient();
+
+    WGPUImageCopyTexture destination = {};
+    destination.texture = texture;
+    WGPUTextureDataLayout dataLayout = {};
+    dataLayout.offset = 3;
+    dataLayout.bytesPerRow = 4096;
+    dataLayout.rowsPerImage = 610;
+    WGPUExtent3D writeSize = {1024, 610, 1};
+
+    EXPECT_CALL(api, QueueWriteTexture(apiQueue, _, _, kSize, _, _))
+        .WillOnce(Invoke([&](WGPUQueue, const WGPUImageCopyTexture* apiDestination,
+                             const void* apiData, size_t, const WGPUTextureDataLayout* apiLayout,
+                             const WGPUExtent3D* apiWriteSize) {
+            EXPECT_EQ(apiDestination->texture, apiTexture);
+            EXPECT_EQ(apiLayout->offset, 3u);
+            EXPECT_EQ(apiLayout->bytesPerRow, 4096u);
+            EXPECT_EQ(apiWriteSize->height, 610u);
+            EXPECT_EQ(memcmp(apiData, data.data(), kSize), 0);
+        }));
+    wgpuQueueWriteTexture(queue, &destination, data.data(), kSize, &dataLayout, &writeSize);
+    FlushClient();
+}
+
 // Only one default queue is supported now so we cannot test ~Queue triggering ClearAllCallbacks
 // since it is always destructed after the test TearDown, and we cannot create a new queue obj
 // with wgpuDeviceGetQueue
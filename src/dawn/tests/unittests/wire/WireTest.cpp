@@ -56,6 +56,14 @@ dawn::wire::server::MemoryTransferService* WireTest::GetServerMemoryTransferServ
     return nullptr;
 }
 
+bool WireTest::UseCompactEncoding() {
+    return false;
+}
+
+bool WireTest::UseMultithreadedEncoding() {
+    return false;
+}
+
 void WireTest::SetUp() {
     DawnProcTable mockProcs;
     api.GetProcTable(&mockProcs);
@@ -68,6 +76,8 @@ void WireTest::SetUp() {
     serverDesc.procs = &mockProcs;
     serverDesc.serializer = mS2cBuf.get();
     serverDesc.memoryTransferService = GetServerMemoryTransferService();
+    serverDesc.useCompactEncoding = UseCompactEncoding();
+    serverDesc.enableMultithreadedEncoding = UseMultithreadedEncoding();
 
     mWireServer.reset(new dawn::wire::WireServer(serverDesc));
     mC2sBuf->SetHandler(mWireServer.get());
@@ -75,6 +85,8 @@ void WireTest::SetUp() {
     dawn::wire::WireClientDescriptor clientDesc = {};
     clientDesc.serializer = mC2sBuf.get();
     clientDesc.memoryTransferService = GetClientMemoryTransferService();
+    clientDesc.useCompactEncoding = UseCompactEncoding();
+    clientDesc.enableMultithreadedEncoding = UseMultithreadedEncoding();
 
     mWireClient.reset(new dawn::wire::WireClient(clientDesc));
     mS2cBuf->SetHandler(mWireClient.get());
@@ -208,7 +220,12 @@ void WireTest::DefaultApiAdapterWasReleased() {
 }
 
 void WireTest::FlushClient(bool success) {
-    ASSERT_EQ(mC2sBuf->Flush(), success);
+    // With multithreaded encoding, the commands must be merged by the client before the flush.
+    if (UseMultithreadedEncoding()) {
+        ASSERT_EQ(mWireClient->Flush(), success);
+    } else {
+        ASSERT_EQ(mC2sBuf->Flush(), success);
+    }
 
     Mock::VerifyAndClearExpectations(&api);
     SetupIgnoredCallExpectations();
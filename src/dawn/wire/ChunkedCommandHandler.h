@@ -55,6 +55,10 @@ class ChunkedCommandHandler : public CommandHandler {
     // Returns |true| if the commands were entirely consumed into the chunked command vector
     // and should be handled later once we receive all the command data.
     // Returns |false| if commands should be handled now immediately.
+    // A command that is received whole is handled directly from the transport memory, so its
+    // data-only members (like the data of WriteBuffer) are given to the handler without a copy.
+    // Only a command that is split across several calls to HandleCommands() is reassembled,
+    // since its data is not contiguous in memory.
     ChunkedCommandsResult HandleChunkedCommands(const volatile char* commands, size_t size) {
         uint64_t commandSize64 = reinterpret_cast<const volatile CmdHeader*>(commands)->commandSize;
 
@@ -27,6 +27,8 @@
 
 #include "dawn/wire/ChunkedCommandSerializer.h"
 
+#include "dawn/common/Assert.h"
+
 namespace dawn::wire {
 
 ChunkedCommandSerializer::ChunkedCommandSerializer(CommandSerializer* serializer)
@@ -47,4 +49,30 @@ void ChunkedCommandSerializer::SerializeChunkedCommand(const char* allocatedBuff
     }
 }
 
+void ChunkedCommandSerializer::SerializeChunkedData(char* chunk,
+                                                    size_t chunkSize,
+                                                    const char* data,
+                                                    size_t dataSize,
+                                                    size_t remainingSize) {
+    while (true) {
+        size_t copySize = std::min(chunkSize, dataSize);
+        memcpy(chunk, data, copySize);
+        memset(chunk + copySize, 0, chunkSize - copySize);
+        data += copySize;
+        dataSize -= copySize;
+
+        if (remainingSize == 0) {
+            DAWN_ASSERT(dataSize == 0);
+            return;
+        }
+
+        chunkSize = std::min(remainingSize, mMaxAllocationSize);
+        chunk = static_cast<char*>(mSerializer->GetCmdSpace(chunkSize));
+        if (chunk == nullptr) {
+            return;
+        }
+        remainingSize -= chunkSize;
+    }
+}
+
 }  // namespace dawn::wire
@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <cstring>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <utility>
 
@@ -51,6 +52,15 @@ struct CommandExtension {
     std::function<void(char*)> serialize;
 };
 
+// Command extension for a block of data that is copied as-is after the command, like the data of
+// WriteBuffer and WriteTexture. Unlike CommandExtension it doesn't need a single contiguous
+// allocation, so large data is copied directly in successive chunks of the command stream instead
+// of going through a temporary allocation.
+struct CommandDataExtension {
+    const void* data;
+    size_t size;
+};
+
 namespace detail {
 
 inline WireResult SerializeCommandExtension(SerializeBuffer* serializeBuffer) {
@@ -106,6 +116,44 @@ class ChunkedCommandSerializer {
             std::forward<Extensions>(extensions)...);
     }
 
+    template <typename Cmd>
+    void SerializeCommand(const Cmd& cmd,
+                          const ObjectIdProvider& objectIdProvider,
+                          CommandDataExtension&& extension) {
+        size_t commandSize = cmd.GetRequiredSize();
+        if (extension.size >
+            std::numeric_limits<size_t>::max() - commandSize - kWireBufferAlignment) {
+            return;
+        }
+        size_t requiredSize = commandSize + Align(extension.size, kWireBufferAlignment);
+
+        // Small commands, and the unlikely case of a command that doesn't fit in an allocation by
+        // itself, use the regular path.
+        if (requiredSize <= mMaxAllocationSize || commandSize > mMaxAllocationSize) {
+            SerializeCommand(cmd, objectIdProvider,
+                             CommandExtension{extension.size, [&](char* buffer) {
+                                                  memcpy(buffer, extension.data, extension.size);
+                                              }});
+            return;
+        }
+
+        // Serialize the command at the start of the first chunk, then stream the data after it.
+        size_t chunkSize = mMaxAllocationSize;
+        char* chunk = static_cast<char*>(mSerializer->GetCmdSpace(chunkSize));
+        if (chunk == nullptr) {
+            return;
+        }
+        SerializeBuffer serializeBuffer(chunk, commandSize);
+        if (DAWN_UNLIKELY(cmd.Serialize(requiredSize, &serializeBuffer, objectIdProvider) !=
+                          WireResult::Success)) {
+            mSerializer->OnSerializeError();
+            return;
+        }
+        SerializeChunkedData(chunk + commandSize, chunkSize - commandSize,
+                             static_cast<const char*>(extension.data), extension.size,
+                             requiredSize - chunkSize);
+    }
+
   private:
     template <typename Cmd, typename SerializeCmdFn, typename... Extensions>
     void SerializeCommandImpl(const Cmd& cmd,
@@ -143,6 +191,13 @@ class ChunkedCommandSerializer {
     }
 
     void SerializeChunkedCommand(const char* allocatedBuffer, size_t remainingSize);
+    // Copies |data| in the |chunkSize| bytes left in |chunk|, then in new chunks for the
+    // |remainingSize| bytes left in the command. The space after the data is zeroed.
+    void SerializeChunkedData(char* chunk,
+                              size_t chunkSize,
+                              const char* data,
+                              size_t dataSize,
+                              size_t remainingSize);
 
     raw_ptr<CommandSerializer> mSerializer;
     size_t mMaxAllocationSize;
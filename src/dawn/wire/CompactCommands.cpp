@@ -0,0 +1,157 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/wire/CompactCommands.h"
+
+#include <cstring>
+#include <limits>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+#include "dawn/wire/BufferConsumer_impl.h"
+
+namespace dawn::wire {
+
+namespace {
+
+static constexpr CompactCmd kLastCompactCmd = CompactCmd::ComputePassEncoderDispatchWorkgroups;
+
+}  // anonymous namespace
+
+CompactCommandWriter::CompactCommandWriter(CompactCmd cmd, ObjectId encoder, bool sameEncoder) {
+    mData[1] = static_cast<uint8_t>(cmd) | (sameEncoder ? kCompactCmdSameEncoder : 0);
+    if (!sameEncoder) {
+        WriteId(encoder);
+    }
+}
+
+void CompactCommandWriter::WriteId(ObjectId id) {
+    WriteVarint(id);
+}
+
+void CompactCommandWriter::WriteU32(uint32_t value) {
+    WriteVarint(value);
+}
+
+void CompactCommandWriter::WriteI32(int32_t value) {
+    // Zigzag encoding so that small negative values stay small.
+    uint32_t bits = static_cast<uint32_t>(value);
+    WriteVarint((bits << 1) ^ (value < 0 ? 0xFFFF'FFFFu : 0u));
+}
+
+void CompactCommandWriter::WriteU64(uint64_t value) {
+    WriteVarint(value);
+}
+
+void CompactCommandWriter::WriteVarint(uint64_t value) {
+    do {
+        DAWN_ASSERT(mSize < kMaxCompactCmdSize);
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        mData[mSize++] = byte | (value != 0 ? 0x80 : 0);
+    } while (value != 0);
+}
+
+size_t CompactCommandWriter::GetRequiredSize() const {
+    return Align(mSize, kWireBufferAlignment);
+}
+
+void CompactCommandWriter::Serialize(char* buffer) const {
+    size_t size = GetRequiredSize();
+    memcpy(buffer, mData, size);
+    buffer[0] = static_cast<char>(((size / kWireBufferAlignment) << 1) | kCompactCmdMarker);
+}
+
+WireResult CompactCommandReader::Begin(DeserializeBuffer* deserializeBuffer) {
+    if (deserializeBuffer->AvailableSize() < kWireBufferAlignment) {
+        return WireResult::FatalError;
+    }
+
+    // Read each byte of the header only once since the memory may be modified concurrently.
+    const volatile char* header = deserializeBuffer->Buffer();
+    uint8_t sizeByte = static_cast<uint8_t>(header[0]);
+    uint8_t cmdByte = static_cast<uint8_t>(header[1]);
+    DAWN_ASSERT((sizeByte & kCompactCmdMarker) != 0);
+
+    mSize = (sizeByte >> 1) * kWireBufferAlignment;
+    if (mSize == 0) {
+        return WireResult::FatalError;
+    }
+    WIRE_TRY(deserializeBuffer->ReadN(mSize, &mData));
+
+    mSameEncoder = (cmdByte & kCompactCmdSameEncoder) != 0;
+    uint8_t cmd = cmdByte & ~kCompactCmdSameEncoder;
+    if (cmd > static_cast<uint8_t>(kLastCompactCmd)) {
+        return WireResult::FatalError;
+    }
+    mCmd = static_cast<CompactCmd>(cmd);
+    mOffset = 2;
+    return WireResult::Success;
+}
+
+WireResult CompactCommandReader::ReadId(ObjectId* id) {
+    return ReadU32(id);
+}
+
+WireResult CompactCommandReader::ReadU32(uint32_t* value) {
+    uint64_t varint;
+    WIRE_TRY(ReadVarint(&varint));
+    if (varint > std::numeric_limits<uint32_t>::max()) {
+        return WireResult::FatalError;
+    }
+    *value = static_cast<uint32_t>(varint);
+    return WireResult::Success;
+}
+
+WireResult CompactCommandReader::ReadI32(int32_t* value) {
+    uint32_t zigzag;
+    WIRE_TRY(ReadU32(&zigzag));
+    *value = static_cast<int32_t>((zigzag >> 1) ^ (0u - (zigzag & 1)));
+    return WireResult::Success;
+}
+
+WireResult CompactCommandReader::ReadU64(uint64_t* value) {
+    return ReadVarint(value);
+}
+
+WireResult CompactCommandReader::ReadVarint(uint64_t* value) {
+    uint64_t result = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+        if (mOffset >= mSize) {
+            return WireResult::FatalError;
+        }
+        uint8_t byte = static_cast<uint8_t>(mData[mOffset++]);
+        result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return WireResult::Success;
+        }
+    }
+    return WireResult::FatalError;
+}
+
+}  // namespace dawn::wire
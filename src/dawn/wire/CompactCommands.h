@@ -0,0 +1,129 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_WIRE_COMPACTCOMMANDS_H_
+#define SRC_DAWN_WIRE_COMPACTCOMMANDS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dawn/common/Constants.h"
+#include "dawn/wire/BufferConsumer.h"
+#include "dawn/wire/ObjectHandle.h"
+#include "dawn/wire/WireResult.h"
+
+namespace dawn::wire {
+
+// The compact encoding is an opt-in alternative serialization for the most frequent render and
+// compute pass encoder commands. A regular command is at least a 8-byte CmdHeader, a 4-byte
+// WireCmd and one 4-byte ObjectId per object, followed by every member at its full size. Instead,
+// a compact command is laid out as:
+//
+//   byte 0:  ((size / kWireBufferAlignment) << 1) | kCompactCmdMarker
+//   byte 1:  the CompactCmd, or'ed with kCompactCmdSameEncoder if the command targets the same
+//            encoder as the previous compact command for that type of encoder.
+//   then:    the ObjectId of the encoder unless kCompactCmdSameEncoder is set, followed by the
+//            members of the command, each encoded as an unsigned LEB128 varint.
+//   padding: zeroes up to the next multiple of kWireBufferAlignment.
+//
+// The commandSize of a regular command is always a multiple of kWireBufferAlignment, so the lowest
+// bit of the first byte of a command is enough to tell the two encodings apart.
+enum class CompactCmd : uint8_t {
+    RenderPassEncoderSetPipeline,
+    RenderPassEncoderSetBindGroup,
+    RenderPassEncoderSetVertexBuffer,
+    RenderPassEncoderSetIndexBuffer,
+    RenderPassEncoderDraw,
+    RenderPassEncoderDrawIndexed,
+    ComputePassEncoderSetPipeline,
+    ComputePassEncoderSetBindGroup,
+    ComputePassEncoderDispatchWorkgroups,
+};
+
+static constexpr uint8_t kCompactCmdMarker = 0x01;
+static constexpr uint8_t kCompactCmdSameEncoder = 0x80;
+
+// Large enough for the biggest compact command: two header bytes, the encoder ID and up to two
+// 32-bit and two 64-bit varints.
+static constexpr size_t kMaxCompactCmdSize = 48;
+static_assert(kMaxCompactCmdSize % kWireBufferAlignment == 0);
+static_assert(kMaxCompactCmdSize / kWireBufferAlignment <= 0x7F);
+
+inline bool IsCompactCommand(const volatile char* command) {
+    return (static_cast<uint8_t>(command[0]) & kCompactCmdMarker) != 0;
+}
+
+// Builds a compact command in a scratch buffer until it is copied in the command stream.
+class CompactCommandWriter {
+  public:
+    CompactCommandWriter(CompactCmd cmd, ObjectId encoder, bool sameEncoder);
+
+    void WriteId(ObjectId id);
+    void WriteU32(uint32_t value);
+    void WriteI32(int32_t value);
+    void WriteU64(uint64_t value);
+
+    // Returns the size of the command padded to kWireBufferAlignment.
+    size_t GetRequiredSize() const;
+    // Writes the command in |buffer| that must contain at least GetRequiredSize() bytes.
+    void Serialize(char* buffer) const;
+
+  private:
+    void WriteVarint(uint64_t value);
+
+    uint8_t mData[kMaxCompactCmdSize] = {};
+    size_t mSize = 2;
+};
+
+// Decodes a compact command from the command stream. Every read is bounds-checked against the size
+// of the command.
+class CompactCommandReader {
+  public:
+    // Consumes the compact command at the start of |deserializeBuffer| and decodes its header.
+    WireResult Begin(DeserializeBuffer* deserializeBuffer);
+
+    CompactCmd GetCmd() const { return mCmd; }
+    bool IsSameEncoder() const { return mSameEncoder; }
+
+    WireResult ReadId(ObjectId* id);
+    WireResult ReadU32(uint32_t* value);
+    WireResult ReadI32(int32_t* value);
+    WireResult ReadU64(uint64_t* value);
+
+  private:
+    WireResult ReadVarint(uint64_t* value);
+
+    const volatile char* mData = nullptr;
+    size_t mSize = 0;
+    size_t mOffset = 0;
+    CompactCmd mCmd = CompactCmd::RenderPassEncoderSetPipeline;
+    bool mSameEncoder = false;
+};
+
+}  // namespace dawn::wire
+
+#endif  // SRC_DAWN_WIRE_COMPACTCOMMANDS_H_
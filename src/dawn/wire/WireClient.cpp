@@ -31,7 +31,10 @@
 namespace dawn::wire {
 
 WireClient::WireClient(const WireClientDescriptor& descriptor)
-    : mImpl(new client::Client(descriptor.serializer, descriptor.memoryTransferService)) {}
+    : mImpl(new client::Client(descriptor.serializer,
+                               descriptor.memoryTransferService,
+                               descriptor.useCompactEncoding,
+                               descriptor.enableMultithreadedEncoding)) {}
 
 WireClient::~WireClient() {
     mImpl.reset();
@@ -71,6 +74,10 @@ void WireClient::ReclaimInstanceReservation(const ReservedInstance& reservation)
     mImpl->ReclaimInstanceReservation(reservation);
 }
 
+bool WireClient::Flush() {
+    return mImpl->Flush();
+}
+
 void WireClient::Disconnect() {
     mImpl->Disconnect();
 }
@@ -33,7 +33,9 @@ namespace dawn::wire {
 WireServer::WireServer(const WireServerDescriptor& descriptor)
     : mImpl(server::Server::Create(*descriptor.procs,
                                    descriptor.serializer,
-                                   descriptor.memoryTransferService)) {}
+                                   descriptor.memoryTransferService,
+                                   descriptor.useCompactEncoding,
+                                   descriptor.enableMultithreadedEncoding)) {}
 
 WireServer::~WireServer() {
     mImpl.reset();
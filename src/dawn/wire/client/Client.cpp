@@ -50,8 +50,21 @@ class NoopCommandSerializer final : public CommandSerializer {
 
 }  // anonymous namespace
 
-Client::Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService)
-    : ClientBase(), mSerializer(serializer), mMemoryTransferService(memoryTransferService) {
+Client::Client(CommandSerializer* serializer,
+               MemoryTransferService* memoryTransferService,
+               bool useCompactEncoding,
+               bool enableMultithreadedEncoding)
+    : ClientBase(),
+      mSerializer(serializer),
+      mCommandSerializer(serializer),
+      mMemoryTransferService(memoryTransferService) {
+    // The compact encoding refers to the encoder of the previous compact command in the stream,
+    // which isn't known when the commands of multiple threads are merged, so it isn't used then.
+    if (enableMultithreadedEncoding) {
+        mShardedSerializer = std::make_unique<ShardedCommandSerializer>(serializer);
+    } else if (useCompactEncoding) {
+        mCompactSerializer = std::make_unique<CompactCommandSerializer>(serializer);
+    }
     if (mMemoryTransferService == nullptr) {
         // If a MemoryTransferService is not provided, fall back to inline memory.
         mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
@@ -155,9 +168,29 @@ EventManager& Client::GetEventManager(const ObjectHandle& instance) {
     return *it->second;
 }
 
+void Client::RemoveObjectFromList(ObjectBase* object) {
+    std::lock_guard<std::mutex> lock(mObjectListsMutex);
+    object->RemoveFromList();
+}
+
+bool Client::Flush() {
+    if (mShardedSerializer != nullptr) {
+        return mShardedSerializer->Flush();
+    }
+    return mCommandSerializer->Flush();
+}
+
 void Client::Disconnect() {
     mDisconnected = true;
-    mSerializer = ChunkedCommandSerializer(NoopCommandSerializer::GetInstance());
+    if (mShardedSerializer != nullptr) {
+        // Other threads may be serializing commands or flushing concurrently, so the sharded
+        // serializer is kept alive and redirected to the no-op serializer under its locks.
+        mShardedSerializer->Disconnect(NoopCommandSerializer::GetInstance());
+    } else {
+        mSerializer = ChunkedCommandSerializer(NoopCommandSerializer::GetInstance());
+        mCommandSerializer = NoopCommandSerializer::GetInstance();
+        mCompactSerializer = nullptr;
+    }
 
     auto& deviceList = mObjects[ObjectType::Device];
     {
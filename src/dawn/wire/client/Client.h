@@ -28,7 +28,9 @@
 #ifndef SRC_DAWN_WIRE_CLIENT_CLIENT_H_
 #define SRC_DAWN_WIRE_CLIENT_CLIENT_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include "absl/container/flat_hash_map.h"
@@ -41,8 +43,10 @@
 #include "dawn/wire/WireCmd_autogen.h"
 #include "dawn/wire/WireDeserializeAllocator.h"
 #include "dawn/wire/client/ClientBase_autogen.h"
+#include "dawn/wire/client/CompactCommandSerializer.h"
 #include "dawn/wire/client/EventManager.h"
 #include "dawn/wire/client/ObjectStore.h"
+#include "dawn/wire/client/ShardedCommandSerializer.h"
 #include "partition_alloc/pointers/raw_ptr.h"
 
 namespace dawn::wire::client {
@@ -53,7 +57,10 @@ class EventManager;
 
 class Client : public ClientBase {
   public:
-    Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService);
+    Client(CommandSerializer* serializer,
+           MemoryTransferService* memoryTransferService,
+           bool useCompactEncoding = false,
+           bool enableMultithreadedEncoding = false);
     ~Client() override;
 
     // Make<T>(arg1, arg2, arg3) creates a new T, calling a constructor of the form:
@@ -66,7 +73,10 @@ class Client : public ClientBase {
         ObjectBaseParams params = {this, mObjectStores[type].ReserveHandle()};
         T* object = new T(params, std::forward<Args>(args)...);
 
-        mObjects[type].Append(object);
+        {
+            std::lock_guard<std::mutex> lock(mObjectListsMutex);
+            mObjects[type].Append(object);
+        }
         mObjectStores[type].Insert(std::unique_ptr<T>(object));
         return object;
     }
@@ -99,16 +109,35 @@ class Client : public ClientBase {
 
     template <typename Cmd>
     void SerializeCommand(const Cmd& cmd) {
+        if (mShardedSerializer != nullptr) {
+            mShardedSerializer->BeginCommand()->SerializeCommand(cmd, *this);
+            return;
+        }
+        if (mCompactSerializer != nullptr && mCompactSerializer->SerializeCommand(cmd, *this)) {
+            return;
+        }
         mSerializer.SerializeCommand(cmd, *this);
     }
 
     template <typename Cmd, typename... Extensions>
     void SerializeCommand(const Cmd& cmd, Extensions&&... es) {
+        if (mShardedSerializer != nullptr) {
+            mShardedSerializer->BeginCommand()->SerializeCommand(cmd, *this,
+                                                                 std::forward<Extensions>(es)...);
+            return;
+        }
         mSerializer.SerializeCommand(cmd, *this, std::forward<Extensions>(es)...);
     }
 
+    // Removes the object from the list of objects of its type. Called when the object is destroyed.
+    void RemoveObjectFromList(ObjectBase* object);
+
     EventManager& GetEventManager(const ObjectHandle& instance);
 
+    // Merges the commands serialized by the threads when multithreaded encoding is enabled, then
+    // flushes the serializer.
+    bool Flush();
+
     void Disconnect();
     bool IsDisconnected() const;
 
@@ -118,10 +147,21 @@ class Client : public ClientBase {
 #include "dawn/wire/client/ClientPrototypes_autogen.inc"
 
     ChunkedCommandSerializer mSerializer;
+    // Only set when the compact encoding is used. Takes precedence over mSerializer for the
+    // commands that have a compact form.
+    std::unique_ptr<CompactCommandSerializer> mCompactSerializer;
+    // Only set when multithreaded encoding is enabled. All the commands are then serialized in the
+    // shard of the calling thread instead of mSerializer. It is never reset, as other threads may
+    // be using it.
+    std::unique_ptr<ShardedCommandSerializer> mShardedSerializer;
+    raw_ptr<CommandSerializer> mCommandSerializer;
     WireDeserializeAllocator mWireCommandAllocator;
     PerObjectType<ObjectStore> mObjectStores;
     std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
     raw_ptr<MemoryTransferService> mMemoryTransferService = nullptr;
+    // Protects the insertion and removal of objects in mObjects when they are created and destroyed
+    // concurrently. Iterating the lists isn't thread-safe.
+    std::mutex mObjectListsMutex;
     PerObjectType<LinkedList<ObjectBase>> mObjects;
     // Map of instance object handles to a corresponding event manager. Note that for now because we
     // do not have an internal refcount on the instances, i.e. we don't know when the last object
@@ -131,7 +171,7 @@ class Client : public ClientBase {
     // spontaneous mode callbacks outlive the instance. We also can't reuse the ObjectStore for the
     // EventManagers because we need to track old instance handles even after they are reclaimed.
     absl::flat_hash_map<ObjectHandle, std::unique_ptr<EventManager>> mEventManagers;
-    bool mDisconnected = false;
+    std::atomic<bool> mDisconnected = false;
 };
 
 std::unique_ptr<MemoryTransferService> CreateInlineMemoryTransferService();
@@ -0,0 +1,215 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/wire/client/CompactCommandSerializer.h"
+
+#include "dawn/common/Assert.h"
+
+namespace dawn::wire::client {
+
+namespace {
+
+// WGPU_WHOLE_SIZE is the most common value for the sizes of the vertex and index buffer bindings
+// so sizes are offset by one to make it encode as 0.
+uint64_t EncodeBindingSize(uint64_t size) {
+    return size + 1;
+}
+
+}  // anonymous namespace
+
+CompactCommandSerializer::CompactCommandSerializer(CommandSerializer* serializer)
+    : mSerializer(serializer) {
+    DAWN_ASSERT(mSerializer->GetMaximumAllocationSize() >= kMaxCompactCmdSize);
+}
+
+bool CompactCommandSerializer::SerializeCommand(const RenderPassEncoderSetPipelineCmd& cmd,
+                                                const ObjectIdProvider& provider) {
+    ObjectId self;
+    ObjectId pipeline;
+    if (provider.GetId(cmd.self, &self) != WireResult::Success ||
+        provider.GetId(cmd.pipeline, &pipeline) != WireResult::Success) {
+        return false;
+    }
+
+    CompactCommandWriter writer(CompactCmd::RenderPassEncoderSetPipeline, self,
+                                self == mLastRenderPassEncoder);
+    writer.WriteId(pipeline);
+    Write(writer, self, &mLastRenderPassEncoder);
+    return true;
+}
+
+bool CompactCommandSerializer::SerializeCommand(const RenderPassEncoderSetBindGroupCmd& cmd,
+                                                const ObjectIdProvider& provider) {
+    ObjectId self;
+    ObjectId group;
+    if (cmd.dynamicOffsetCount != 0 || provider.GetId(cmd.self, &self) != WireResult::Success ||
+        provider.GetOptionalId(cmd.group, &group) != WireResult::Success) {
+        return false;
+    }
+
+    CompactCommandWriter writer(CompactCmd::RenderPassEncoderSetBindGroup, self,
+                                self == mLastRenderPassEncoder);
+    writer.WriteU32(cmd.groupIndex);
+    writer.WriteId(group);
+    Write(writer, self, &mLastRenderPassEncoder);
+    return true;
+}
+
+bool CompactCommandSerializer::SerializeCommand(const RenderPassEncoderSetVertexBufferCmd& cmd,
+                                                const ObjectIdProvider& provider) {
+    ObjectId self;
+    ObjectId buffer;
+    if (provider.GetId(cmd.self, &self) != WireResult::Success ||
+        provider.GetOptionalId(cmd.buffer, &buffer) != WireResult::Success) {
+        return false;
+    }
+
+    CompactCommandWriter writer(CompactCmd::RenderPassEncoderSetVertexBuffer, self,
+                                self == mLastRenderPassEncoder);
+    writer.WriteU32(cmd.slot);
+    writer.WriteId(buffer);
+    writer.WriteU64(cmd.offset);
+    writer.WriteU64(EncodeBindingSize(cmd.size));
+    Write(writer, self, &mLastRenderPassEncoder);
+    return true;
+}
+
+bool CompactCommandSerializer::SerializeCommand(const RenderPassEncoderSetIndexBufferCmd& cmd,
+                                                const ObjectIdProvider& provider) {
+    ObjectId self;
+    ObjectId buffer;
+    if (provider.GetId(cmd.self, &self) != WireResult::Success ||
+        provider.GetId(cmd.buffer, &buffer) != WireResult::Success) {
+        return false;
+    }
+
+    CompactCommandWriter writer(CompactCmd::RenderPassEncoderSetIndexBuffer, self,
+                                self == mLastRenderPassEncoder);
+    writer.WriteId(buffer);
+    writer.WriteU32(static_cast<uint32_t>(cmd.format));
+    writer.WriteU64(cmd.offset);
+    writer.WriteU64(EncodeBindingSize(cmd.size));
+    Write(writer, self, &mLastRenderPassEncoder);
+    return true;
+}
+
+bool CompactCommandSerializer::SerializeCommand(const RenderPassEncoderDrawCmd& cmd,
+                                                const ObjectIdProvider& provider) {
+    ObjectId self;
+    if (provider.GetId(cmd.self, &self) != WireResult::Success) {
+        return false;
+    }
+
+    CompactCommandWriter writer(CompactCmd::RenderPassEncoderDraw, self,
+                                self == mLastRenderPassEncoder);
+    writer.WriteU32(cmd.vertexCount);
+    writer.WriteU32(cmd.instanceCount);
+    writer.WriteU32(cmd.firstVertex);
+    writer.WriteU32(cmd.firstInstance);
+    Write(writer, self, &mLastRenderPassEncoder);
+    return true;
+}
+
+bool CompactCommandSerializer::SerializeCommand(const RenderPassEncoderDrawIndexedCmd& cmd,
+                                                const ObjectIdProvider& provider) {
+    ObjectId self;
+    if (provider.GetId(cmd.self, &self) != WireResult::Success) {
+        return false;
+    }
+
+    CompactCommandWriter writer(CompactCmd::RenderPassEncoderDrawIndexed, self,
+                                self == mLastRenderPassEncoder);
+    writer.WriteU32(cmd.indexCount);
+    writer.WriteU32(cmd.instanceCount);
+    writer.WriteU32(cmd.firstIndex);
+    writer.WriteI32(cmd.baseVertex);
+    writer.WriteU32(cmd.firstInstance);
+    Write(writer, self, &mLastRenderPassEncoder);
+    return true;
+}
+
+bool CompactCommandSerializer::SerializeCommand(const ComputePassEncoderSetPipelineCmd& cmd,
+                                                const ObjectIdProvider& provider) {
+    ObjectId self;
+    ObjectId pipeline;
+    if (provider.GetId(cmd.self, &self) != WireResult::Success ||
+        provider.GetId(cmd.pipeline, &pipeline) != WireResult::Success) {
+        return false;
+    }
+
+    CompactCommandWriter writer(CompactCmd::ComputePassEncoderSetPipeline, self,
+                                self == mLastComputePassEncoder);
+    writer.WriteId(pipeline);
+    Write(writer, self, &mLastComputePassEncoder);
+    return true;
+}
+
+bool CompactCommandSerializer::SerializeCommand(const ComputePassEncoderSetBindGroupCmd& cmd,
+                                                const ObjectIdProvider& provider) {
+    ObjectId self;
+    ObjectId group;
+    if (cmd.dynamicOffsetCount != 0 || provider.GetId(cmd.self, &self) != WireResult::Success ||
+        provider.GetOptionalId(cmd.group, &group) != WireResult::Success) {
+        return false;
+    }
+
+    CompactCommandWriter writer(CompactCmd::ComputePassEncoderSetBindGroup, self,
+                                self == mLastComputePassEncoder);
+    writer.WriteU32(cmd.groupIndex);
+    writer.WriteId(group);
+    Write(writer, self, &mLastComputePassEncoder);
+    return true;
+}
+
+bool CompactCommandSerializer::SerializeCommand(const ComputePassEncoderDispatchWorkgroupsCmd& cmd,
+                                                const ObjectIdProvider& provider) {
+    ObjectId self;
+    if (provider.GetId(cmd.self, &self) != WireResult::Success) {
+        return false;
+    }
+
+    CompactCommandWriter writer(CompactCmd::ComputePassEncoderDispatchWorkgroups, self,
+                                self == mLastComputePassEncoder);
+    writer.WriteU32(cmd.workgroupCountX);
+    writer.WriteU32(cmd.workgroupCountY);
+    writer.WriteU32(cmd.workgroupCountZ);
+    Write(writer, self, &mLastComputePassEncoder);
+    return true;
+}
+
+void CompactCommandSerializer::Write(const CompactCommandWriter& writer,
+                                     ObjectId encoder,
+                                     ObjectId* lastEncoder) {
+    char* buffer = static_cast<char*>(mSerializer->GetCmdSpace(writer.GetRequiredSize()));
+    if (buffer == nullptr) {
+        return;
+    }
+    writer.Serialize(buffer);
+    *lastEncoder = encoder;
+}
+
+}  // namespace dawn::wire::client
@@ -0,0 +1,82 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_WIRE_CLIENT_COMPACTCOMMANDSERIALIZER_H_
+#define SRC_DAWN_WIRE_CLIENT_COMPACTCOMMANDSERIALIZER_H_
+
+#include "dawn/wire/CompactCommands.h"
+#include "dawn/wire/Wire.h"
+#include "dawn/wire/WireCmd_autogen.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::wire::client {
+
+// Serializes the commands that have a compact form (see CompactCommands.h) directly in the command
+// stream. SerializeCommand returns false for all other commands, and for the commands whose
+// arguments aren't supported by the compact form, which must then be serialized as usual.
+class CompactCommandSerializer {
+  public:
+    explicit CompactCommandSerializer(CommandSerializer* serializer);
+
+    template <typename Cmd>
+    bool SerializeCommand(const Cmd&, const ObjectIdProvider&) {
+        return false;
+    }
+
+    bool SerializeCommand(const RenderPassEncoderSetPipelineCmd& cmd,
+                          const ObjectIdProvider& provider);
+    bool SerializeCommand(const RenderPassEncoderSetBindGroupCmd& cmd,
+                          const ObjectIdProvider& provider);
+    bool SerializeCommand(const RenderPassEncoderSetVertexBufferCmd& cmd,
+                          const ObjectIdProvider& provider);
+    bool SerializeCommand(const RenderPassEncoderSetIndexBufferCmd& cmd,
+                          const ObjectIdProvider& provider);
+    bool SerializeCommand(const RenderPassEncoderDrawCmd& cmd, const ObjectIdProvider& provider);
+    bool SerializeCommand(const RenderPassEncoderDrawIndexedCmd& cmd,
+                          const ObjectIdProvider& provider);
+    bool SerializeCommand(const ComputePassEncoderSetPipelineCmd& cmd,
+                          const ObjectIdProvider& provider);
+    bool SerializeCommand(const ComputePassEncoderSetBindGroupCmd& cmd,
+                          const ObjectIdProvider& provider);
+    bool SerializeCommand(const ComputePassEncoderDispatchWorkgroupsCmd& cmd,
+                          const ObjectIdProvider& provider);
+
+  private:
+    // Copies the command in the command stream and remembers its encoder for the following
+    // commands.
+    void Write(const CompactCommandWriter& writer, ObjectId encoder, ObjectId* lastEncoder);
+
+    raw_ptr<CommandSerializer> mSerializer;
+
+    // The encoders of the last compact commands written to the stream, per type of encoder.
+    ObjectId mLastRenderPassEncoder = 0;
+    ObjectId mLastComputePassEncoder = 0;
+};
+
+}  // namespace dawn::wire::client
+
+#endif  // SRC_DAWN_WIRE_CLIENT_COMPACTCOMMANDSERIALIZER_H_
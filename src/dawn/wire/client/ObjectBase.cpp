@@ -36,7 +36,7 @@ ObjectBase::ObjectBase(const ObjectBaseParams& params)
     : mClient(params.client), mHandle(params.handle), mRefcount(1) {}
 
 ObjectBase::~ObjectBase() {
-    RemoveFromList();
+    mClient->RemoveObjectFromList(this);
 }
 
 const ObjectHandle& ObjectBase::GetWireHandle() const {
@@ -56,14 +56,14 @@ Client* ObjectBase::GetClient() const {
 }
 
 void ObjectBase::Reference() {
-    mRefcount++;
+    mRefcount.fetch_add(1, std::memory_order_relaxed);
 }
 
 void ObjectBase::Release() {
-    DAWN_ASSERT(mRefcount != 0);
-    mRefcount--;
+    uint32_t previousRefcount = mRefcount.fetch_sub(1, std::memory_order_acq_rel);
+    DAWN_ASSERT(previousRefcount != 0);
 
-    if (mRefcount == 0) {
+    if (previousRefcount == 1) {
         DestroyObjectCmd cmd;
         cmd.objectType = GetObjectType();
         cmd.objectId = GetWireId();
@@ -28,6 +28,8 @@
 #ifndef SRC_DAWN_WIRE_CLIENT_OBJECTBASE_H_
 #define SRC_DAWN_WIRE_CLIENT_OBJECTBASE_H_
 
+#include <atomic>
+
 #include "dawn/webgpu.h"
 #include "partition_alloc/pointers/raw_ptr.h"
 
@@ -67,12 +69,13 @@ class ObjectBase : public LinkNode<ObjectBase> {
     void Release();
 
   protected:
-    uint32_t GetRefcount() const { return mRefcount; }
+    uint32_t GetRefcount() const { return mRefcount.load(std::memory_order_acquire); }
 
   private:
     const raw_ptr<Client> mClient;
     const ObjectHandle mHandle;
-    uint32_t mRefcount;
+    // Atomic so that objects can be referenced and released by the threads encoding commands.
+    std::atomic<uint32_t> mRefcount;
 };
 
 // Compositable functionality for objects on the client side that need to have access to the event
@@ -30,36 +30,70 @@
 #include <limits>
 #include <utility>
 
+#include "dawn/common/Math.h"
+
 namespace dawn::wire::client {
 
-ObjectStore::ObjectStore() {
-    // ID 0 is nullptr
-    mObjects.emplace_back(nullptr);
-    mCurrentId = 1;
+namespace {
+
+uint64_t PackFreeListHead(ObjectId id, uint32_t tag) {
+    return (uint64_t(tag) << 32) | id;
+}
+
+ObjectId GetFreeListHeadId(uint64_t head) {
+    return static_cast<ObjectId>(head & 0xFFFF'FFFF);
+}
+
+uint32_t GetFreeListHeadTag(uint64_t head) {
+    return static_cast<uint32_t>(head >> 32);
+}
+
+}  // anonymous namespace
+
+// ID 0 is nullptr so it is never reserved and marks the end of the free list.
+ObjectStore::ObjectStore() = default;
+
+ObjectStore::~ObjectStore() {
+    for (size_t i = 0; i < kSegmentCount; ++i) {
+        Slot* segment = mSegments[i].load(std::memory_order_relaxed);
+        if (segment == nullptr) {
+            continue;
+        }
+        for (uint64_t j = 0; j < (kFirstSegmentSize << i); ++j) {
+            delete segment[j].object.load(std::memory_order_relaxed);
+        }
+        delete[] segment;
+    }
 }
 
 ObjectHandle ObjectStore::ReserveHandle() {
-    if (mFreeHandles.empty()) {
-        return {mCurrentId++, 0};
+    uint64_t head = mFreeListHead.load(std::memory_order_acquire);
+    while (true) {
+        ObjectId id = GetFreeListHeadId(head);
+        if (id == 0) {
+            return {mCurrentId.fetch_add(1, std::memory_order_relaxed), 0};
+        }
+
+        // The slot may be concurrently popped and pushed back by other threads, in which case
+        // nextFreeId is stale but the tag of the head changed so the exchange fails.
+        Slot* slot = GetSlot(id, false);
+        uint64_t next = PackFreeListHead(slot->nextFreeId.load(std::memory_order_relaxed),
+                                         GetFreeListHeadTag(head) + 1);
+        if (mFreeListHead.compare_exchange_weak(head, next, std::memory_order_acquire)) {
+            return {id, slot->freeGeneration.load(std::memory_order_relaxed)};
+        }
     }
-    ObjectHandle handle = mFreeHandles.back();
-    mFreeHandles.pop_back();
-    return handle;
 }
 
 void ObjectStore::Insert(std::unique_ptr<ObjectBase> obj) {
     ObjectId id = obj->GetWireId();
+    DAWN_ASSERT(id != 0 && id < mCurrentId.load(std::memory_order_relaxed));
 
-    if (id >= mObjects.size()) {
-        DAWN_ASSERT(id == mObjects.size());
-        mObjects.emplace_back(std::move(obj));
-    } else {
-        // The generation should never overflow. We don't recycle ObjectIds that would
-        // overflow their next generation.
-        DAWN_ASSERT(obj->GetWireGeneration() != 0);
-        DAWN_ASSERT(mObjects[id] == nullptr);
-        mObjects[id] = std::move(obj);
-    }
+    // IDs may be inserted in a different order than they were reserved when objects are created
+    // concurrently, so the segment of the ID may not be allocated yet.
+    Slot* slot = GetSlot(id, true);
+    DAWN_ASSERT(slot->object.load(std::memory_order_relaxed) == nullptr);
+    slot->object.store(obj.release(), std::memory_order_release);
 }
 
 void ObjectStore::Free(ObjectBase* obj) {
@@ -68,18 +102,54 @@ void ObjectStore::Free(ObjectBase* obj) {
     // To avoid issues with asynchronous server->client communication referring to an ID that's
     // already reused, each handle also has a generation that's increment by one on each reuse.
     // Avoid overflows by only reusing the ID if the increment of the generation won't overflow.
-    const ObjectHandle& currentHandle = obj->GetWireHandle();
+    const ObjectHandle currentHandle = obj->GetWireHandle();
+    Slot* slot = GetSlot(currentHandle.id, false);
+    DAWN_ASSERT(slot != nullptr && slot->object.load(std::memory_order_relaxed) == obj);
+
+    // Destroy the object before the ID can be reserved again.
+    slot->object.store(nullptr, std::memory_order_relaxed);
+    delete obj;
+
     if (DAWN_LIKELY(currentHandle.generation != std::numeric_limits<ObjectGeneration>::max())) {
-        mFreeHandles.push_back({currentHandle.id, currentHandle.generation + 1});
+        slot->freeGeneration.store(currentHandle.generation + 1, std::memory_order_relaxed);
+        uint64_t head = mFreeListHead.load(std::memory_order_relaxed);
+        uint64_t newHead;
+        do {
+            slot->nextFreeId.store(GetFreeListHeadId(head), std::memory_order_relaxed);
+            newHead = PackFreeListHead(currentHandle.id, GetFreeListHeadTag(head) + 1);
+        } while (!mFreeListHead.compare_exchange_weak(head, newHead, std::memory_order_release,
+                                                      std::memory_order_relaxed));
     }
-    mObjects[currentHandle.id] = nullptr;
 }
 
 ObjectBase* ObjectStore::Get(ObjectId id) const {
-    if (id >= mObjects.size()) {
+    Slot* slot = GetSlot(id, false);
+    if (slot == nullptr) {
         return nullptr;
     }
-    return mObjects[id].get();
+    return slot->object.load(std::memory_order_acquire);
+}
+
+ObjectStore::Slot* ObjectStore::GetSlot(ObjectId id, bool allocate) const {
+    uint64_t segmentIndex = Log2(uint64_t(id) / kFirstSegmentSize + 1);
+    uint64_t segmentStart = kFirstSegmentSize * ((uint64_t(1) << segmentIndex) - 1);
+    DAWN_ASSERT(segmentIndex < kSegmentCount);
+
+    Slot* segment = mSegments[segmentIndex].load(std::memory_order_acquire);
+    if (segment == nullptr) {
+        if (!allocate) {
+            return nullptr;
+        }
+        // Another thread may allocate the segment concurrently, in which case its segment is used.
+        Slot* newSegment = new Slot[kFirstSegmentSize << segmentIndex];
+        if (mSegments[segmentIndex].compare_exchange_strong(segment, newSegment,
+                                                            std::memory_order_acq_rel)) {
+            segment = newSegment;
+        } else {
+            delete[] newSegment;
+        }
+    }
+    return &segment[id - segmentStart];
 }
 
 }  // namespace dawn::wire::client
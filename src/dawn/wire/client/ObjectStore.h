@@ -28,8 +28,9 @@
 #ifndef SRC_DAWN_WIRE_CLIENT_OBJECTSTORE_H_
 #define SRC_DAWN_WIRE_CLIENT_OBJECTSTORE_H_
 
+#include <array>
+#include <atomic>
 #include <memory>
-#include <vector>
 
 #include "dawn/wire/client/ObjectBase.h"
 
@@ -44,9 +45,15 @@ class Client;
 // Since the wire has one "ID" namespace per type of object, each ObjectStore should contain a
 // single type of objects. However no templates are used because Client wraps ObjectStore and is
 // type-generic, so ObjectStore is type-erased to only work on ObjectBase.
+//
+// All the methods are thread-safe, and ReserveHandle and Free are lock-free so that objects can
+// be created and destroyed concurrently by the threads encoding commands. The objects are stored
+// in slots that are never moved or freed until the ObjectStore is destroyed, and the free handles
+// form a linked list through these slots whose head is updated with compare-and-swap.
 class ObjectStore {
   public:
     ObjectStore();
+    ~ObjectStore();
 
     ObjectHandle ReserveHandle();
     void Insert(std::unique_ptr<ObjectBase> obj);
@@ -54,9 +61,26 @@ class ObjectStore {
     ObjectBase* Get(ObjectId id) const;
 
   private:
-    uint32_t mCurrentId;
-    std::vector<ObjectHandle> mFreeHandles;
-    std::vector<std::unique_ptr<ObjectBase>> mObjects;
+    struct Slot {
+        std::atomic<ObjectBase*> object = nullptr;
+        // Only used while the ID is in the free list.
+        std::atomic<ObjectId> nextFreeId = 0;
+        std::atomic<ObjectGeneration> freeGeneration = 0;
+    };
+
+    // The slots are allocated in segments of growing size: segment N contains the slots of the
+    // kFirstSegmentSize * 2^N IDs following the IDs of segment N - 1.
+    static constexpr uint64_t kFirstSegmentSize = 256;
+    static constexpr size_t kSegmentCount = 25;
+
+    // Returns the slot of |id|, or nullptr if its segment isn't allocated and |allocate| is false.
+    Slot* GetSlot(ObjectId id, bool allocate) const;
+
+    // The ID of the first free handle in the low 32 bits, 0 if there are none, and a tag in the
+    // high 32 bits that's incremented on each update to avoid the ABA problem.
+    std::atomic<uint64_t> mFreeListHead = 0;
+    std::atomic<ObjectId> mCurrentId = 1;
+    mutable std::array<std::atomic<Slot*>, kSegmentCount> mSegments = {};
 };
 
 }  // namespace dawn::wire::client
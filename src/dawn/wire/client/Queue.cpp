@@ -126,7 +126,10 @@ void Queue::WriteBuffer(WGPUBuffer cBuffer, uint64_t bufferOffset, const void* d
     cmd.data = static_cast<const uint8_t*>(data);
     cmd.size = size;
 
-    GetClient()->SerializeCommand(cmd);
+    // The write is never split in multiple commands, even when it doesn't fit in a single
+    // allocation of the command serializer, since the client can't tell whether the buffer is
+    // valid, and splitting an invalid write would produce one error per command.
+    GetClient()->SerializeCommand(cmd, CommandDataExtension{data, size});
 }
 
 void Queue::WriteTexture(const WGPUImageCopyTexture* destination,
@@ -142,7 +145,7 @@ void Queue::WriteTexture(const WGPUImageCopyTexture* destination,
     cmd.dataLayout = dataLayout;
     cmd.writeSize = writeSize;
 
-    GetClient()->SerializeCommand(cmd);
+    GetClient()->SerializeCommand(cmd, CommandDataExtension{data, dataSize});
 }
 
 }  // namespace dawn::wire::client
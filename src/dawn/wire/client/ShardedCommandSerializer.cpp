@@ -0,0 +1,273 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/wire/client/ShardedCommandSerializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Constants.h"
+#include "dawn/common/Math.h"
+
+namespace dawn::wire::client {
+
+namespace {
+
+// The minimum size of the blocks of memory of a shard.
+constexpr size_t kMinShardBlockSize = 64 * 1024;
+
+std::atomic<uint64_t> gNextSerializerId = 1;
+
+// Caches the shard last used by the thread, which is the common case when a single client is used.
+struct ThreadShardCache {
+    uint64_t serializerId = 0;
+    void* shard = nullptr;
+};
+thread_local ThreadShardCache tShardCache;
+
+}  // anonymous namespace
+
+// A shard buffers the commands of a single thread, tagged with the serials of the commands they
+// belong to. The memory returned by GetCmdSpace stays valid until the shard is merged.
+class ShardedCommandSerializer::Shard final : public CommandSerializer {
+  public:
+    explicit Shard(CommandSerializer* serializer)
+        : mSerializer(serializer),
+          mMaxAllocationSize(serializer->GetMaximumAllocationSize()),
+          mChunkedSerializer(this) {}
+    ~Shard() override = default;
+
+    void* GetCmdSpace(size_t size) override {
+        size_t alignedSize = Align(size, kWireBufferAlignment);
+        if (mCurrentBlock == mBlocks.size() ||
+            mBlocks[mCurrentBlock].size - mBlockOffset < alignedSize) {
+            if (!NextBlock(alignedSize)) {
+                return nullptr;
+            }
+        }
+
+        char* data = mBlocks[mCurrentBlock].data.get() + mBlockOffset;
+        mBlockOffset += alignedSize;
+        mAllocations.push_back({mCurrentSerial, data, size});
+        return data;
+    }
+
+    bool Flush() override {
+        // Shards are only flushed by ShardedCommandSerializer::Flush.
+        DAWN_UNREACHABLE();
+        return false;
+    }
+
+    size_t GetMaximumAllocationSize() const override { return mMaxAllocationSize; }
+
+    void OnSerializeError() override { mSerializer->OnSerializeError(); }
+
+    void SetSerializer(CommandSerializer* serializer) { mSerializer = serializer; }
+
+    std::mutex& GetMutex() { return mMutex; }
+    ChunkedCommandSerializer* GetChunkedSerializer() { return &mChunkedSerializer; }
+
+    void SetCurrentSerial(uint64_t serial) { mCurrentSerial = serial; }
+
+    // Returns the serial of the next command to merge, or the maximum serial if there is none.
+    uint64_t GetNextMergeSerial() const {
+        if (mMergeIndex == mAllocations.size()) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return mAllocations[mMergeIndex].serial;
+    }
+
+    // Copies the next command of the shard in |serializer|.
+    bool MergeNextCommand(CommandSerializer* serializer) {
+        uint64_t serial = mAllocations[mMergeIndex].serial;
+        for (; mMergeIndex < mAllocations.size() && mAllocations[mMergeIndex].serial == serial;
+             ++mMergeIndex) {
+            const Allocation& allocation = mAllocations[mMergeIndex];
+            void* data = serializer->GetCmdSpace(allocation.size);
+            if (data == nullptr) {
+                return false;
+            }
+            memcpy(data, allocation.data, allocation.size);
+        }
+        return true;
+    }
+
+    // Drops all the commands of the shard, keeping its memory for the next commands.
+    void Reset() {
+        mAllocations.clear();
+        mMergeIndex = 0;
+        mCurrentBlock = 0;
+        mBlockOffset = 0;
+    }
+
+  private:
+    struct Allocation {
+        uint64_t serial;
+        char* data;
+        size_t size;
+    };
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    bool NextBlock(size_t minSize) {
+        // Reuse the next block if it's large enough, otherwise insert a new one in its place.
+        size_t nextBlock = mCurrentBlock == mBlocks.size() ? mCurrentBlock : mCurrentBlock + 1;
+        if (nextBlock == mBlocks.size() || mBlocks[nextBlock].size < minSize) {
+            size_t size = std::max(kMinShardBlockSize, minSize);
+            std::unique_ptr<char[]> data(new (std::nothrow) char[size]);
+            if (data == nullptr) {
+                return false;
+            }
+            mBlocks.insert(mBlocks.begin() + nextBlock, Block{std::move(data), size});
+        }
+        mCurrentBlock = nextBlock;
+        mBlockOffset = 0;
+        return true;
+    }
+
+    raw_ptr<CommandSerializer> mSerializer;
+    size_t mMaxAllocationSize;
+    ChunkedCommandSerializer mChunkedSerializer;
+
+    std::mutex mMutex;
+    uint64_t mCurrentSerial = 0;
+    std::vector<Allocation> mAllocations;
+    size_t mMergeIndex = 0;
+    std::vector<Block> mBlocks;
+    size_t mCurrentBlock = 0;
+    size_t mBlockOffset = 0;
+};
+
+ShardedCommandSerializer::CommandScope::CommandScope(Shard* shard, uint64_t serial)
+    : mShard(shard) {
+    mShard->SetCurrentSerial(serial);
+}
+
+ShardedCommandSerializer::CommandScope::~CommandScope() {
+    mShard->GetMutex().unlock();
+}
+
+ChunkedCommandSerializer* ShardedCommandSerializer::CommandScope::operator->() {
+    return mShard->GetChunkedSerializer();
+}
+
+ShardedCommandSerializer::ShardedCommandSerializer(CommandSerializer* serializer)
+    : mSerializer(serializer), mId(gNextSerializerId.fetch_add(1, std::memory_order_relaxed)) {}
+
+ShardedCommandSerializer::~ShardedCommandSerializer() {
+    if (tShardCache.serializerId == mId) {
+        tShardCache = {};
+    }
+}
+
+ShardedCommandSerializer::CommandScope ShardedCommandSerializer::BeginCommand() {
+    Shard* shard = GetShardForCurrentThread();
+    shard->GetMutex().lock();
+    // The serial is taken while the shard is locked so that Flush, which locks all the shards,
+    // never merges a command without merging all the commands with smaller serials.
+    uint64_t serial = mNextCommandSerial.fetch_add(1, std::memory_order_relaxed);
+    return CommandScope(shard, serial);
+}
+
+bool ShardedCommandSerializer::Flush() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto shardLocks = LockShards();
+    bool success = MergeShards();
+    return success && mSerializer->Flush();
+}
+
+void ShardedCommandSerializer::Disconnect(CommandSerializer* serializer) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto shardLocks = LockShards();
+
+    // Like with the other serializers of the client, the commands serialized before the
+    // disconnection are still sent if the wrapped serializer is flushed.
+    MergeShards();
+
+    mSerializer = serializer;
+    for (auto& shard : mShards) {
+        shard->SetSerializer(serializer);
+    }
+}
+
+std::vector<std::unique_lock<std::mutex>> ShardedCommandSerializer::LockShards() {
+    std::vector<std::unique_lock<std::mutex>> shardLocks;
+    shardLocks.reserve(mShards.size());
+    for (auto& shard : mShards) {
+        shardLocks.emplace_back(shard->GetMutex());
+    }
+    return shardLocks;
+}
+
+bool ShardedCommandSerializer::MergeShards() {
+    // Merge the commands in the order of their serials. There is one shard per thread, so a linear
+    // search of the shard with the next command is fast enough.
+    bool success = true;
+    while (success) {
+        Shard* next = nullptr;
+        uint64_t nextSerial = std::numeric_limits<uint64_t>::max();
+        for (auto& shard : mShards) {
+            uint64_t serial = shard->GetNextMergeSerial();
+            if (serial < nextSerial) {
+                next = shard.get();
+                nextSerial = serial;
+            }
+        }
+        if (next == nullptr) {
+            break;
+        }
+        success = next->MergeNextCommand(mSerializer);
+    }
+
+    for (auto& shard : mShards) {
+        shard->Reset();
+    }
+    return success;
+}
+
+ShardedCommandSerializer::Shard* ShardedCommandSerializer::GetShardForCurrentThread() {
+    if (tShardCache.serializerId == mId) {
+        return static_cast<Shard*>(tShardCache.shard);
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Shard*& shard = mShardsByThread[std::this_thread::get_id()];
+    if (shard == nullptr) {
+        mShards.push_back(std::make_unique<Shard>(mSerializer));
+        shard = mShards.back().get();
+    }
+    tShardCache = {mId, shard};
+    return shard;
+}
+
+}  // namespace dawn::wire::client
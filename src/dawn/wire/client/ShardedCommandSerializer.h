@@ -0,0 +1,108 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_WIRE_CLIENT_SHARDEDCOMMANDSERIALIZER_H_
+#define SRC_DAWN_WIRE_CLIENT_SHARDEDCOMMANDSERIALIZER_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "dawn/common/NonCopyable.h"
+#include "dawn/wire/ChunkedCommandSerializer.h"
+#include "dawn/wire/Wire.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::wire::client {
+
+// Lets multiple threads serialize commands concurrently. Each thread serializes its commands in its
+// own shard with little contention, and the shards are merged in the wrapped serializer on Flush.
+// Each command is tagged with a serial taken from a shared counter when it is started, and the
+// merge copies the commands in the order of their serials. If a command happens-before another one
+// (for example because the application synchronized the two threads encoding them), it gets a
+// smaller serial, so the server sees the commands in an order consistent with the client's.
+class ShardedCommandSerializer {
+  private:
+    class Shard;
+
+  public:
+    // Serializes a single command in the shard of the calling thread. The shard is locked for the
+    // lifetime of the CommandScope, which shouldn't outlive the serialization of the command.
+    class CommandScope : NonMovable {
+      public:
+        ~CommandScope();
+
+        ChunkedCommandSerializer* operator->();
+
+      private:
+        friend class ShardedCommandSerializer;
+        CommandScope(Shard* shard, uint64_t serial);
+
+        raw_ptr<Shard> mShard;
+    };
+
+    explicit ShardedCommandSerializer(CommandSerializer* serializer);
+    ~ShardedCommandSerializer();
+
+    CommandScope BeginCommand();
+
+    // Copies the commands of all the shards in the wrapped serializer in the order they were
+    // started, then flushes it. Commands started concurrently with Flush may be left in their
+    // shard until the next Flush.
+    bool Flush();
+
+    // Copies the commands of all the shards in the wrapped serializer without flushing it, then
+    // wraps |serializer| instead for the next commands. Waits for the commands being serialized by
+    // other threads, which may keep using the ShardedCommandSerializer after it is disconnected.
+    void Disconnect(CommandSerializer* serializer);
+
+  private:
+    Shard* GetShardForCurrentThread();
+
+    // Locks all the shards. mMutex must be held.
+    std::vector<std::unique_lock<std::mutex>> LockShards();
+    // Copies the commands of all the shards in the wrapped serializer in the order they were
+    // started, and empties the shards. mMutex and all the shards must be locked.
+    bool MergeShards();
+
+    raw_ptr<CommandSerializer> mSerializer;
+    // Used to find the shard of a thread without locking in the common case.
+    const uint64_t mId;
+    std::atomic<uint64_t> mNextCommandSerial = 0;
+
+    // Protects the list of shards. Locked before the shards themselves.
+    std::mutex mMutex;
+    std::vector<std::unique_ptr<Shard>> mShards;
+    absl::flat_hash_map<std::thread::id, Shard*> mShardsByThread;
+};
+
+}  // namespace dawn::wire::client
+
+#endif  // SRC_DAWN_WIRE_CLIENT_SHARDEDCOMMANDSERIALIZER_H_
@@ -47,8 +47,19 @@ enum class AllocationState : uint32_t {
     Free,
     Reserved,
     Allocated,
+    // The ID was skipped by the client and hasn't been allocated yet.
+    Unused,
 };
 
+// IDs can be received out of order when the client encodes commands from multiple threads, so
+// in that mode allocating an ID past the end of the known objects is allowed, within this limit.
+// An ID is reserved by the client when its object is created, and is sent when the creation
+// command is serialized into the thread's shard. The IDs skipped by the server are the fresh IDs
+// reserved by other threads in between, which is a handful per thread in practice. 1024 leaves a
+// wide margin for that, while bounding the number of Unused slots a single command can add, so
+// that a corrupt ID is still rejected early. Objects created beyond this margin are a fatal error.
+static constexpr ObjectId kMaxSkippedObjectIds = 1024;
+
 template <typename T>
 struct ObjectDataBase {
     // The backend-provided handle and generation to this object.
@@ -163,13 +174,18 @@ class KnownObjectsBase {
         return {id, data};
     }
 
+    // Sets the number of IDs that can be skipped when allocating past the end of the known
+    // objects. Defaults to 0, as IDs are only received out of order with multithreaded encoding.
+    void SetMaxSkippedIds(ObjectId maxSkippedIds) { mMaxSkippedIds = maxSkippedIds; }
+
     // Allocates the data for a given ID and returns it in result.
     // Returns false if the ID is already allocated, or too far ahead, or if ID is 0 (ID 0 is
     // reserved for nullptr). Invalidates all the Data*
     WireResult Allocate(Known<T>* result,
                         ObjectHandle handle,
                         AllocationState state = AllocationState::Allocated) {
-        if (handle.id == 0 || handle.id > mKnown.size()) {
+        if (handle.id == 0 ||
+            (handle.id > mKnown.size() && handle.id - mKnown.size() > mMaxSkippedIds)) {
             return WireResult::FatalError;
         }
 
@@ -178,17 +194,26 @@ class KnownObjectsBase {
         data.handle = nullptr;
 
         if (handle.id >= mKnown.size()) {
+            while (mKnown.size() < handle.id) {
+                Data unused;
+                unused.handle = nullptr;
+                unused.state = AllocationState::Unused;
+                mKnown.push_back(std::move(unused));
+            }
+            data.generation = handle.generation;
             mKnown.push_back(std::move(data));
             *result = {handle.id, &mKnown.back()};
             return WireResult::Success;
         }
 
-        if (mKnown[handle.id].state != AllocationState::Free) {
+        if (mKnown[handle.id].state != AllocationState::Free &&
+            mKnown[handle.id].state != AllocationState::Unused) {
             return WireResult::FatalError;
         }
 
         // The generation should be strictly increasing.
-        if (handle.generation <= mKnown[handle.id].generation) {
+        if (mKnown[handle.id].state == AllocationState::Free &&
+            handle.generation <= mKnown[handle.id].generation) {
             return WireResult::FatalError;
         }
         // update the generation in the slot
@@ -232,6 +257,7 @@ class KnownObjectsBase {
 
   protected:
     std::vector<Data> mKnown;
+    ObjectId mMaxSkippedIds = 0;
 };
 
 template <typename T>
@@ -32,24 +32,167 @@ namespace dawn::wire::server {
 
 CallbackUserdata::CallbackUserdata(const std::weak_ptr<Server>& server) : server(server) {}
 
+DeferredCallbackArg<const char*>::Storage DeferredCallbackArg<const char*>::Save(const char* value) {
+    if (value == nullptr) {
+        return std::nullopt;
+    }
+    return std::string(value);
+}
+
+const char* DeferredCallbackArg<const char*>::Get(Storage& storage) {
+    return storage.has_value() ? storage->c_str() : nullptr;
+}
+
+DeferredCallbackArg<const WGPUCompilationInfo*>::Storage
+DeferredCallbackArg<const WGPUCompilationInfo*>::Save(const WGPUCompilationInfo* value) {
+    Storage storage = {};
+    storage.isNull = value == nullptr;
+    if (value == nullptr) {
+        return storage;
+    }
+    storage.messages.assign(value->messages, value->messages + value->messageCount);
+    for (WGPUCompilationMessage& message : storage.messages) {
+        message.nextInChain = nullptr;
+        storage.strings.push_back(DeferredCallbackArg<const char*>::Save(message.message));
+    }
+    return storage;
+}
+
+const WGPUCompilationInfo* DeferredCallbackArg<const WGPUCompilationInfo*>::Get(Storage& storage) {
+    if (storage.isNull) {
+        return nullptr;
+    }
+    // The pointers are only set now since the strings may have moved with the storage.
+    for (size_t i = 0; i < storage.messages.size(); ++i) {
+        storage.messages[i].message = DeferredCallbackArg<const char*>::Get(storage.strings[i]);
+    }
+    storage.info = {};
+    storage.info.messageCount = storage.messages.size();
+    storage.info.messages = storage.messages.data();
+    return &storage.info;
+}
+
+Server::ScopedLock::ScopedLock(const Server* server) : mServer(server) {
+    mServer->Lock();
+}
+
+Server::ScopedLock::~ScopedLock() {
+    mServer->Unlock();
+}
+
 // static
 std::shared_ptr<Server> Server::Create(const DawnProcTable& procs,
                                        CommandSerializer* serializer,
-                                       MemoryTransferService* memoryTransferService) {
-    auto server = std::shared_ptr<Server>(new Server(procs, serializer, memoryTransferService));
+                                       MemoryTransferService* memoryTransferService,
+                                       bool useCompactEncoding,
+                                       bool enableMultithreadedEncoding) {
+    auto server = std::shared_ptr<Server>(new Server(
+        procs, serializer, memoryTransferService, useCompactEncoding, enableMultithreadedEncoding));
     server->mSelf = server;
     return server;
 }
 
 Server::Server(const DawnProcTable& procs,
                CommandSerializer* serializer,
-               MemoryTransferService* memoryTransferService)
-    : mSerializer(serializer), mProcs(procs), mMemoryTransferService(memoryTransferService) {
+               MemoryTransferService* memoryTransferService,
+               bool useCompactEncoding,
+               bool enableMultithreadedEncoding)
+    : mSerializer(serializer),
+      mProcs(procs),
+      mMemoryTransferService(memoryTransferService),
+      mUseCompactEncoding(useCompactEncoding) {
     if (mMemoryTransferService == nullptr) {
         // If a MemoryTransferService is not provided, fallback to inline memory.
         mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
         mMemoryTransferService = mOwnedMemoryTransferService.get();
     }
+    // Only a client encoding from multiple threads can send object IDs out of order.
+    if (enableMultithreadedEncoding) {
+        SetMaxSkippedObjectIds(kMaxSkippedObjectIds);
+    }
+}
+
+const volatile char* Server::HandleCommands(const volatile char* commands, size_t size) {
+    ScopedLock lock(this);
+    return ChunkedCommandHandler::HandleCommands(commands, size);
+}
+
+void Server::Lock() const {
+    if (mLockOwner.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+        mLockDepth++;
+        return;
+    }
+    mMutex.lock();
+    mLockOwner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    mLockDepth = 1;
+}
+
+bool Server::TryLock() const {
+    if (mLockOwner.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+        mLockDepth++;
+        return true;
+    }
+    if (!mMutex.try_lock()) {
+        return false;
+    }
+    mLockOwner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    mLockDepth = 1;
+    return true;
+}
+
+void Server::Unlock() const {
+    DAWN_ASSERT(mLockOwner.load(std::memory_order_relaxed) == std::this_thread::get_id());
+    if (mLockDepth > 1) {
+        mLockDepth--;
+        return;
+    }
+
+    while (true) {
+        // The deferred callbacks run before the lock depth drops to 0 since they may lock the
+        // server recursively.
+        RunDeferredCallbacks();
+        mLockDepth = 0;
+        mLockOwner.store(std::thread::id(), std::memory_order_relaxed);
+        mMutex.unlock();
+
+        // A callback may have been deferred after the last check but before the unlock, in which
+        // case nobody else may run it.
+        if (!mHasDeferredCallbacks.load(std::memory_order_acquire) || !mMutex.try_lock()) {
+            return;
+        }
+        mLockOwner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        mLockDepth = 1;
+    }
+}
+
+void Server::DeferCallback(std::unique_ptr<DeferredCallback> callback) {
+    mDeferredCallbacks.Use([&](auto deferredCallbacks) {
+        deferredCallbacks->push_back(std::move(callback));
+        mHasDeferredCallbacks.store(true, std::memory_order_release);
+    });
+
+    // Run the callback now if the other thread released the server in the meantime.
+    if (TryLock()) {
+        Unlock();
+    }
+}
+
+void Server::RunDeferredCallbacks() const {
+    // The callbacks are taken one at a time, so that a callback that runs the deferred callbacks
+    // recursively still runs them in order.
+    while (mHasDeferredCallbacks.load(std::memory_order_acquire)) {
+        std::unique_ptr<DeferredCallback> callback;
+        mDeferredCallbacks.Use([&](auto deferredCallbacks) {
+            if (!deferredCallbacks->empty()) {
+                callback = std::move(deferredCallbacks->front());
+                deferredCallbacks->pop_front();
+            }
+            mHasDeferredCallbacks.store(!deferredCallbacks->empty(), std::memory_order_relaxed);
+        });
+        if (callback != nullptr) {
+            callback->Run();
+        }
+    }
 }
 
 Server::~Server() {
@@ -64,6 +207,7 @@ Server::~Server() {
 WireResult Server::InjectTexture(WGPUTexture texture,
                                  const Handle& handle,
                                  const Handle& deviceHandle) {
+    ScopedLock lock(this);
     DAWN_ASSERT(texture != nullptr);
     Known<WGPUDevice> device;
     WIRE_TRY(DeviceObjects().Get(deviceHandle.id, &device));
@@ -88,6 +232,7 @@ WireResult Server::InjectTexture(WGPUTexture texture,
 WireResult Server::InjectSwapChain(WGPUSwapChain swapchain,
                                    const Handle& handle,
                                    const Handle& deviceHandle) {
+    ScopedLock lock(this);
     DAWN_ASSERT(swapchain != nullptr);
     Known<WGPUDevice> device;
     WIRE_TRY(DeviceObjects().Get(deviceHandle.id, &device));
@@ -110,6 +255,7 @@ WireResult Server::InjectSwapChain(WGPUSwapChain swapchain,
 }
 
 WireResult Server::InjectInstance(WGPUInstance instance, const Handle& handle) {
+    ScopedLock lock(this);
     DAWN_ASSERT(instance != nullptr);
     Known<WGPUInstance> data;
     WIRE_TRY(InstanceObjects().Allocate(&data, handle));
@@ -126,6 +272,7 @@ WireResult Server::InjectInstance(WGPUInstance instance, const Handle& handle) {
 }
 
 WGPUDevice Server::GetDevice(uint32_t id, uint32_t generation) {
+    ScopedLock lock(this);
     Known<WGPUDevice> device;
     if (DeviceObjects().Get(id, &device) != WireResult::Success ||
         device->generation != generation) {
@@ -135,6 +282,7 @@ WGPUDevice Server::GetDevice(uint32_t id, uint32_t generation) {
 }
 
 bool Server::IsDeviceKnown(WGPUDevice device) const {
+    ScopedLock lock(this);
     return DeviceObjects().IsKnown(device);
 }
 
@@ -150,7 +298,12 @@ void Server::SetForwardingDeviceCallbacks(Known<WGPUDevice> device) {
         device->handle,
         [](WGPUErrorType type, const char* message, void* userdata) {
             DeviceInfo* info = static_cast<DeviceInfo*>(userdata);
-            info->server->OnUncapturedError(info->self, type, message);
+            Server* server = info->server;
+            server->RunCallback(
+                [server, device = info->self](WGPUErrorType type, const char* message) {
+                    server->OnUncapturedError(device, type, message);
+                },
+                type, message);
         },
         device->info.get());
     // Set callback to post warning and other infomation to client.
@@ -159,14 +312,24 @@ void Server::SetForwardingDeviceCallbacks(Known<WGPUDevice> device) {
         device->handle,
         [](WGPULoggingType type, const char* message, void* userdata) {
             DeviceInfo* info = static_cast<DeviceInfo*>(userdata);
-            info->server->OnLogging(info->self, type, message);
+            Server* server = info->server;
+            server->RunCallback(
+                [server, device = info->self](WGPULoggingType type, const char* message) {
+                    server->OnLogging(device, type, message);
+                },
+                type, message);
         },
         device->info.get());
     mProcs.deviceSetDeviceLostCallback(
         device->handle,
         [](WGPUDeviceLostReason reason, const char* message, void* userdata) {
             DeviceInfo* info = static_cast<DeviceInfo*>(userdata);
-            info->server->OnDeviceLost(info->self, reason, message);
+            Server* server = info->server;
+            server->RunCallback(
+                [server, device = info->self](WGPUDeviceLostReason reason, const char* message) {
+                    server->OnDeviceLost(device, reason, message);
+                },
+                reason, message);
         },
         device->info.get());
 }
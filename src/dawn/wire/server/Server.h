@@ -28,11 +28,21 @@
 #ifndef SRC_DAWN_WIRE_SERVER_SERVER_H_
 #define SRC_DAWN_WIRE_SERVER_SERVER_H_
 
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include "dawn/common/MutexProtected.h"
+#include "dawn/common/NonCopyable.h"
 #include "dawn/wire/ChunkedCommandSerializer.h"
+#include "dawn/wire/CompactCommands.h"
 #include "dawn/wire/server/ServerBase_autogen.h"
 #include "partition_alloc/pointers/raw_ptr.h"
 
@@ -72,6 +82,61 @@ struct CallbackUserdata {
     explicit CallbackUserdata(const std::weak_ptr<Server>& server);
 };
 
+// Copies the arguments of a callback so that it can be forwarded to the server after the native
+// callback returned. Arguments are copied by value by default, and the data behind pointers is
+// deep-copied for the pointer types used by the callbacks.
+template <typename T>
+struct DeferredCallbackArg {
+    using Storage = T;
+    static Storage Save(T value) { return value; }
+    static T Get(Storage& storage) { return storage; }
+};
+
+template <>
+struct DeferredCallbackArg<const char*> {
+    using Storage = std::optional<std::string>;
+    static Storage Save(const char* value);
+    static const char* Get(Storage& storage);
+};
+
+// The chained structs of the compilation info and its messages are not copied.
+template <>
+struct DeferredCallbackArg<const WGPUCompilationInfo*> {
+    struct Storage {
+        bool isNull;
+        WGPUCompilationInfo info;
+        std::vector<WGPUCompilationMessage> messages;
+        std::vector<std::optional<std::string>> strings;
+    };
+    static Storage Save(const WGPUCompilationInfo* value);
+    static const WGPUCompilationInfo* Get(Storage& storage);
+};
+
+// A callback deferred until the server is no longer used by another thread.
+class DeferredCallback {
+  public:
+    virtual ~DeferredCallback() = default;
+    virtual void Run() = 0;
+};
+
+template <typename Fn, typename... Args>
+class DeferredCallbackImpl final : public DeferredCallback {
+  public:
+    DeferredCallbackImpl(Fn&& fn, Args... args)
+        : mFn(std::move(fn)), mArgs(DeferredCallbackArg<Args>::Save(args)...) {}
+
+    void Run() override { RunImpl(std::index_sequence_for<Args...>()); }
+
+  private:
+    template <size_t... Is>
+    void RunImpl(std::index_sequence<Is...>) {
+        mFn(DeferredCallbackArg<Args>::Get(std::get<Is>(mArgs))...);
+    }
+
+    Fn mFn;
+    std::tuple<typename DeferredCallbackArg<Args>::Storage...> mArgs;
+};
+
 template <auto F>
 struct ForwardToServerHelper {
     template <typename _>
@@ -89,8 +154,14 @@ struct ForwardToServerHelper {
                 // Do nothing if the server has already been destroyed.
                 return;
             }
-            // Forward the arguments and the typed userdata to the Server:: member function.
-            (server.get()->*F)(data.get(), std::forward<decltype(args)>(args)...);
+            // Forward the arguments and the typed userdata to the Server:: member function, once
+            // the server isn't used by another thread.
+            Server* s = server.get();
+            s->RunCallback(
+                [s, data = std::move(data)](Args... forwardedArgs) {
+                    (s->*F)(data.get(), forwardedArgs...);
+                },
+                args...);
         }
     };
 
@@ -166,9 +237,15 @@ class Server : public ServerBase {
   public:
     static std::shared_ptr<Server> Create(const DawnProcTable& procs,
                                           CommandSerializer* serializer,
-                                          MemoryTransferService* memoryTransferService);
+                                          MemoryTransferService* memoryTransferService,
+                                          bool useCompactEncoding = false,
+                                          bool enableMultithreadedEncoding = false);
     ~Server() override;
 
+    // Handles the commands while the server is locked. The commands of multiple servers can be
+    // handled concurrently on different threads, even if they share the same native instance.
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override;
+
     // ChunkedCommandHandler implementation
     const volatile char* HandleCommandsImpl(const volatile char* commands, size_t size) override;
 
@@ -187,10 +264,51 @@ class Server : public ServerBase {
         return std::unique_ptr<T>(new T(mSelf));
     }
 
+    // Native callbacks can be called on any thread, for example when the native instance is shared
+    // with servers used by other threads. Runs |fn| with |args| immediately if the server isn't
+    // used by another thread, otherwise defers it until the other thread is done with the server
+    // or between two of the commands it handles. The arguments are copied when deferred.
+    // Callbacks are forwarded in the order they are called: the callbacks deferred before this one
+    // always run first, including when it is called synchronously while handling a command.
+    template <typename Fn, typename... Args>
+    void RunCallback(Fn&& fn, Args... args) {
+        if (TryLock()) {
+            RunDeferredCallbacks();
+            fn(args...);
+            Unlock();
+            return;
+        }
+        DeferCallback(std::make_unique<DeferredCallbackImpl<std::decay_t<Fn>, Args...>>(
+            std::forward<Fn>(fn), args...));
+    }
+
   private:
+    // The server is locked while it handles commands or forwards callbacks. The lock is recursive
+    // so that callbacks called synchronously by the native API while handling a command run
+    // immediately.
+    class ScopedLock : NonMovable {
+      public:
+        explicit ScopedLock(const Server* server);
+        ~ScopedLock();
+
+      private:
+        raw_ptr<const Server> mServer;
+    };
+    void Lock() const;
+    bool TryLock() const;
+    void Unlock() const;
+
+    void DeferCallback(std::unique_ptr<DeferredCallback> callback);
+    // Runs the deferred callbacks in the order they were deferred. Must be called while the server
+    // is locked, at a point where the objects may be modified, like any point where a native
+    // callback may run.
+    void RunDeferredCallbacks() const;
+
     Server(const DawnProcTable& procs,
            CommandSerializer* serializer,
-           MemoryTransferService* memoryTransferService);
+           MemoryTransferService* memoryTransferService,
+           bool useCompactEncoding,
+           bool enableMultithreadedEncoding);
 
     template <typename Cmd>
     void SerializeCommand(const Cmd& cmd) {
@@ -236,14 +354,30 @@ class Server : public ServerBase {
 
 #include "dawn/wire/server/ServerPrototypes_autogen.inc"
 
+    // Decodes a command serialized with the compact encoding and forwards it to its doer.
+    WireResult HandleCompactCommand(DeserializeBuffer* deserializeBuffer);
+
     WireDeserializeAllocator mAllocator;
     MutexProtected<ChunkedCommandSerializer> mSerializer;
     DawnProcTable mProcs;
     std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
     raw_ptr<MemoryTransferService> mMemoryTransferService = nullptr;
 
+    // The encoders of the last compact commands, used by the commands that don't repeat them.
+    bool mUseCompactEncoding = false;
+    ObjectId mLastCompactRenderPassEncoder = 0;
+    ObjectId mLastCompactComputePassEncoder = 0;
+
     // Weak pointer to self to facilitate creation of userdata.
     std::weak_ptr<Server> mSelf;
+
+    mutable std::mutex mMutex;
+    mutable std::atomic<std::thread::id> mLockOwner;
+    // Only used by the thread owning the lock.
+    mutable uint32_t mLockDepth = 0;
+    // Whether |mDeferredCallbacks| is non-empty. Only modified with |mDeferredCallbacks| locked.
+    mutable std::atomic<bool> mHasDeferredCallbacks = false;
+    mutable MutexProtected<std::deque<std::unique_ptr<DeferredCallback>>> mDeferredCallbacks;
 };
 
 std::unique_ptr<MemoryTransferService> CreateInlineMemoryTransferService();
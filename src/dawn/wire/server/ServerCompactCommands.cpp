@@ -0,0 +1,222 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "dawn/common/Log.h"
+#include "dawn/wire/CompactCommands.h"
+#include "dawn/wire/server/Server.h"
+
+namespace dawn::wire::server {
+
+namespace {
+
+// Returns the encoder of a compact command, which is either in the command or the one of the
+// previous compact command for the same type of encoder.
+WireResult ReadCompactEncoderId(CompactCommandReader* reader, ObjectId* lastEncoder, ObjectId* id) {
+    if (reader->IsSameEncoder()) {
+        if (*lastEncoder == 0) {
+            return WireResult::FatalError;
+        }
+        *id = *lastEncoder;
+        return WireResult::Success;
+    }
+
+    WIRE_TRY(reader->ReadId(id));
+    *lastEncoder = *id;
+    return WireResult::Success;
+}
+
+// Reverses the offset applied by the client so that WGPU_WHOLE_SIZE is encoded as 0.
+WireResult ReadCompactBindingSize(CompactCommandReader* reader, uint64_t* size) {
+    uint64_t encodedSize;
+    WIRE_TRY(reader->ReadU64(&encodedSize));
+    *size = encodedSize - 1;
+    return WireResult::Success;
+}
+
+}  // anonymous namespace
+
+WireResult Server::HandleCompactCommand(DeserializeBuffer* deserializeBuffer) {
+    if (!mUseCompactEncoding) {
+        dawn::ErrorLog() << "Received a compact command but the wire server doesn't use the "
+                            "compact encoding. WireClientDescriptor::useCompactEncoding must "
+                            "match WireServerDescriptor::useCompactEncoding.";
+        return WireResult::FatalError;
+    }
+
+    CompactCommandReader reader;
+    WIRE_TRY(reader.Begin(deserializeBuffer));
+
+    // The handles are resolved the same way as when deserializing regular commands.
+    const ObjectIdResolver& resolver = *this;
+
+    switch (reader.GetCmd()) {
+        case CompactCmd::RenderPassEncoderSetPipeline: {
+            ObjectId selfId;
+            ObjectId pipelineId;
+            WGPURenderPassEncoder self;
+            WGPURenderPipeline pipeline;
+            WIRE_TRY(ReadCompactEncoderId(&reader, &mLastCompactRenderPassEncoder, &selfId));
+            WIRE_TRY(reader.ReadId(&pipelineId));
+            WIRE_TRY(resolver.GetFromId(selfId, &self));
+            WIRE_TRY(resolver.GetFromId(pipelineId, &pipeline));
+            return DoRenderPassEncoderSetPipeline(self, pipeline);
+        }
+
+        case CompactCmd::RenderPassEncoderSetBindGroup: {
+            ObjectId selfId;
+            uint32_t groupIndex;
+            ObjectId groupId;
+            WGPURenderPassEncoder self;
+            WGPUBindGroup group;
+            WIRE_TRY(ReadCompactEncoderId(&reader, &mLastCompactRenderPassEncoder, &selfId));
+            WIRE_TRY(reader.ReadU32(&groupIndex));
+            WIRE_TRY(reader.ReadId(&groupId));
+            WIRE_TRY(resolver.GetFromId(selfId, &self));
+            WIRE_TRY(resolver.GetOptionalFromId(groupId, &group));
+            return DoRenderPassEncoderSetBindGroup(self, groupIndex, group, 0, nullptr);
+        }
+
+        case CompactCmd::RenderPassEncoderSetVertexBuffer: {
+            ObjectId selfId;
+            uint32_t slot;
+            ObjectId bufferId;
+            uint64_t offset;
+            uint64_t size;
+            WGPURenderPassEncoder self;
+            WGPUBuffer buffer;
+            WIRE_TRY(ReadCompactEncoderId(&reader, &mLastCompactRenderPassEncoder, &selfId));
+            WIRE_TRY(reader.ReadU32(&slot));
+            WIRE_TRY(reader.ReadId(&bufferId));
+            WIRE_TRY(reader.ReadU64(&offset));
+            WIRE_TRY(ReadCompactBindingSize(&reader, &size));
+            WIRE_TRY(resolver.GetFromId(selfId, &self));
+            WIRE_TRY(resolver.GetOptionalFromId(bufferId, &buffer));
+            return DoRenderPassEncoderSetVertexBuffer(self, slot, buffer, offset, size);
+        }
+
+        case CompactCmd::RenderPassEncoderSetIndexBuffer: {
+            ObjectId selfId;
+            ObjectId bufferId;
+            uint32_t format;
+            uint64_t offset;
+            uint64_t size;
+            WGPURenderPassEncoder self;
+            WGPUBuffer buffer;
+            WIRE_TRY(ReadCompactEncoderId(&reader, &mLastCompactRenderPassEncoder, &selfId));
+            WIRE_TRY(reader.ReadId(&bufferId));
+            WIRE_TRY(reader.ReadU32(&format));
+            WIRE_TRY(reader.ReadU64(&offset));
+            WIRE_TRY(ReadCompactBindingSize(&reader, &size));
+            WIRE_TRY(resolver.GetFromId(selfId, &self));
+            WIRE_TRY(resolver.GetFromId(bufferId, &buffer));
+            return DoRenderPassEncoderSetIndexBuffer(self, buffer,
+                                                     static_cast<WGPUIndexFormat>(format), offset,
+                                                     size);
+        }
+
+        case CompactCmd::RenderPassEncoderDraw: {
+            ObjectId selfId;
+            uint32_t vertexCount;
+            uint32_t instanceCount;
+            uint32_t firstVertex;
+            uint32_t firstInstance;
+            WGPURenderPassEncoder self;
+            WIRE_TRY(ReadCompactEncoderId(&reader, &mLastCompactRenderPassEncoder, &selfId));
+            WIRE_TRY(reader.ReadU32(&vertexCount));
+            WIRE_TRY(reader.ReadU32(&instanceCount));
+            WIRE_TRY(reader.ReadU32(&firstVertex));
+            WIRE_TRY(reader.ReadU32(&firstInstance));
+            WIRE_TRY(resolver.GetFromId(selfId, &self));
+            return DoRenderPassEncoderDraw(self, vertexCount, instanceCount, firstVertex,
+                                           firstInstance);
+        }
+
+        case CompactCmd::RenderPassEncoderDrawIndexed: {
+            ObjectId selfId;
+            uint32_t indexCount;
+            uint32_t instanceCount;
+            uint32_t firstIndex;
+            int32_t baseVertex;
+            uint32_t firstInstance;
+            WGPURenderPassEncoder self;
+            WIRE_TRY(ReadCompactEncoderId(&reader, &mLastCompactRenderPassEncoder, &selfId));
+            WIRE_TRY(reader.ReadU32(&indexCount));
+            WIRE_TRY(reader.ReadU32(&instanceCount));
+            WIRE_TRY(reader.ReadU32(&firstIndex));
+            WIRE_TRY(reader.ReadI32(&baseVertex));
+            WIRE_TRY(reader.ReadU32(&firstInstance));
+            WIRE_TRY(resolver.GetFromId(selfId, &self));
+            return DoRenderPassEncoderDrawIndexed(self, indexCount, instanceCount, firstIndex,
+                                                  baseVertex, firstInstance);
+        }
+
+        case CompactCmd::ComputePassEncoderSetPipeline: {
+            ObjectId selfId;
+            ObjectId pipelineId;
+            WGPUComputePassEncoder self;
+            WGPUComputePipeline pipeline;
+            WIRE_TRY(ReadCompactEncoderId(&reader, &mLastCompactComputePassEncoder, &selfId));
+            WIRE_TRY(reader.ReadId(&pipelineId));
+            WIRE_TRY(resolver.GetFromId(selfId, &self));
+            WIRE_TRY(resolver.GetFromId(pipelineId, &pipeline));
+            return DoComputePassEncoderSetPipeline(self, pipeline);
+        }
+
+        case CompactCmd::ComputePassEncoderSetBindGroup: {
+            ObjectId selfId;
+            uint32_t groupIndex;
+            ObjectId groupId;
+            WGPUComputePassEncoder self;
+            WGPUBindGroup group;
+            WIRE_TRY(ReadCompactEncoderId(&reader, &mLastCompactComputePassEncoder, &selfId));
+            WIRE_TRY(reader.ReadU32(&groupIndex));
+            WIRE_TRY(reader.ReadId(&groupId));
+            WIRE_TRY(resolver.GetFromId(selfId, &self));
+            WIRE_TRY(resolver.GetOptionalFromId(groupId, &group));
+            return DoComputePassEncoderSetBindGroup(self, groupIndex, group, 0, nullptr);
+        }
+
+        case CompactCmd::ComputePassEncoderDispatchWorkgroups: {
+            ObjectId selfId;
+            uint32_t workgroupCountX;
+            uint32_t workgroupCountY;
+            uint32_t workgroupCountZ;
+            WGPUComputePassEncoder self;
+            WIRE_TRY(ReadCompactEncoderId(&reader, &mLastCompactComputePassEncoder, &selfId));
+            WIRE_TRY(reader.ReadU32(&workgroupCountX));
+            WIRE_TRY(reader.ReadU32(&workgroupCountY));
+            WIRE_TRY(reader.ReadU32(&workgroupCountZ));
+            WIRE_TRY(resolver.GetFromId(selfId, &self));
+            return DoComputePassEncoderDispatchWorkgroups(self, workgroupCountX, workgroupCountY,
+                                                          workgroupCountZ);
+        }
+    }
+    return WireResult::FatalError;
+}
+
+}  // namespace dawn::wire::server
@@ -0,0 +1,56 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_API_OPTIONS_OPTIMIZATION_LEVEL_H_
+#define SRC_TINT_API_OPTIONS_OPTIMIZATION_LEVEL_H_
+
+#include <cstdint>
+
+#include "src/tint/utils/reflection/reflection.h"
+
+namespace tint {
+
+/// The level of optimization that the writers apply to the IR before generating the shader.
+/// Higher levels produce better shaders, but take longer to compile.
+enum class OptimizationLevel : uint8_t {
+    /// No optimization. Only the transforms needed to generate the shader are run.
+    kO0,
+    /// Cheap cleanups: constant propagation, common subexpression elimination and dead code
+    /// elimination.
+    kO1,
+    /// The kO1 passes, plus function inlining, the promotion of function-scope variables to
+    /// values and loop-invariant code motion.
+    kO2,
+};
+
+/// Reflect valid value ranges for the OptimizationLevel enum.
+TINT_REFLECT_ENUM_RANGE(OptimizationLevel, kO0, kO2);
+
+}  // namespace tint
+
+#endif  // SRC_TINT_API_OPTIONS_OPTIMIZATION_LEVEL_H_
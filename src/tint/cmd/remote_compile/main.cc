@@ -27,15 +27,34 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 #if TINT_BUILD_MSL_WRITER
 #include "src/tint/lang/msl/validate/validate.h"
 #endif
@@ -59,7 +78,17 @@ struct CompileResult {
     printf(R"(%s is a tool for compiling a shader on a remote machine
 
 usage as server:
-  %s -s [-p port-number]
+  %s -s [-p port-number] [-j thread-count] [--cache cache-directory]
+
+  The server runs until it is killed. Each client connection is served by its
+  own thread, and may send any number of compile requests. At most thread-count
+  shaders are compiled at once. thread-count defaults to the number of hardware
+  threads.
+  If --cache is given, the result of each compile is stored in the existing
+  directory cache-directory, keyed by a hash of the server executable, the
+  shader source and options, and identical requests are answered from the cache
+  without compiling. Clear the cache when the system's Metal compiler is
+  updated.
 
 usage as client:
   %s [-p port-number] [server-address] shader-file-path
@@ -297,9 +326,338 @@ RESPONSE Send(Stream& s, const REQUEST& req) {
     return {};
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Server
+////////////////////////////////////////////////////////////////////////////////
+
+/// Appends `v` to `out`, with the same encoding as Stream
+void Encode(std::string& out, uint32_t v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+/// Appends `v` to `out`, with the same encoding as Stream
+void Encode(std::string& out, const std::string& v) {
+    Encode(out, static_cast<uint32_t>(v.size()));
+    out += v;
+}
+
+/// Appends the enum value `e` to `out`, with the same encoding as Stream
+template <typename T>
+std::enable_if_t<std::is_enum<T>::value> Encode(std::string& out, T e) {
+    Encode(out, static_cast<uint32_t>(e));
+}
+
+/// Reads a uint32_t encoded with Encode() from the front of `in`
+/// @returns true on success
+bool Decode(std::string_view& in, uint32_t& v) {
+    if (in.size() < sizeof(v)) {
+        return false;
+    }
+    memcpy(&v, in.data(), sizeof(v));
+    in.remove_prefix(sizeof(v));
+    return true;
+}
+
+/// Reads a std::string encoded with Encode() from the front of `in`
+/// @returns true on success
+bool Decode(std::string_view& in, std::string& v) {
+    uint32_t count = 0;
+    if (!Decode(in, count) || in.size() < count) {
+        return false;
+    }
+    v = std::string(in.substr(0, count));
+    in.remove_prefix(count);
+    return true;
+}
+
+/// @returns the 64-bit FNV-1a hash of `data`. std::hash is not used as it is not stable between
+/// builds.
+uint64_t Fnv1a(std::string_view data) {
+    uint64_t hash = 0xcbf29ce484222325;
+    for (char c : data) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+    }
+    return hash;
+}
+
+/// @returns a hash of the server executable, which identifies the build of the server and of the
+/// compiler that it uses, or std::nullopt if the executable cannot be read
+/// @param argv0 the path of the executable, used when /proc/self/exe does not exist
+std::optional<std::string> BuildId(const char* argv0) {
+    std::ifstream file("/proc/self/exe", std::ios::binary);
+    if (!file) {
+        file.open(argv0, std::ios::binary);
+    }
+    if (!file) {
+        return std::nullopt;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::stringstream id;
+    id << std::hex << std::setw(16) << std::setfill('0') << Fnv1a(content);
+    return id.str();
+}
+
+/// ResultCache is an on-disk cache of compile results, keyed by the build of the server and the
+/// content of the compile request.
+/// Each result is stored in its own file, named with a hash of the request. The file also holds the
+/// whole request, so that hash collisions are detected. ResultCache is safe to use from multiple
+/// threads, and from multiple servers sharing the same directory.
+class ResultCache {
+  public:
+    /// Constructor
+    /// @param dir the directory holding the cache files. Must already exist.
+    /// @param build_id the identity of the server build, from BuildId()
+    ResultCache(std::string dir, std::string build_id)
+        : dir_(std::move(dir)), build_id_(std::move(build_id)) {}
+
+    /// @returns the cached result of compiling `req`, or std::nullopt if it is not in the cache
+    std::optional<CompileResult> Get(const CompileRequest& req) const {
+        auto key = Key(req);
+        std::ifstream file(Path(key), std::ios::binary);
+        if (!file) {
+            return std::nullopt;
+        }
+        std::string content((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+
+        std::string_view in = content;
+        std::string cached_key;
+        uint32_t success = 0;
+        CompileResult result;
+        if (!Decode(in, cached_key) || cached_key != key || !Decode(in, success) ||
+            !Decode(in, result.output)) {
+            return std::nullopt;
+        }
+        result.success = success != 0;
+        return result;
+    }
+
+    /// Adds the result of compiling `req` to the cache.
+    /// The file is written under a temporary name that is unique to the process and thread, then
+    /// renamed, so that readers never see a partially written file.
+    void Put(const CompileRequest& req, const CompileResult& result) const {
+        auto key = Key(req);
+        std::string content;
+        Encode(content, key);
+        Encode(content, result.success ? 1u : 0u);
+        Encode(content, result.output);
+
+        auto path = Path(key);
+        std::stringstream tmp_path;
+        tmp_path << path << ".tmp." << ProcessId() << "." << std::this_thread::get_id();
+        {
+            std::ofstream file(tmp_path.str(), std::ios::binary);
+            file.write(content.data(), static_cast<std::streamsize>(content.size()));
+            if (!file) {
+                return;
+            }
+        }
+        if (rename(tmp_path.str().c_str(), path.c_str()) != 0) {
+            remove(tmp_path.str().c_str());
+        }
+    }
+
+  private:
+    /// @returns the content of `req` and the server build that determine the compile result
+    std::string Key(const CompileRequest& req) const {
+        std::string key;
+        Encode(key, kProtocolVersion);
+        Encode(key, build_id_);
+        const_cast<CompileRequest&>(req).Serialize(
+            [&key](const auto& value) { Encode(key, value); });
+        return key;
+    }
+
+    /// @returns the path of the cache file for the request key `key`
+    std::string Path(const std::string& key) const {
+        std::stringstream path;
+        path << dir_ << "/" << std::hex << std::setw(16) << std::setfill('0') << Fnv1a(key);
+        return path.str();
+    }
+
+    /// @returns the identifier of the current process
+    static int ProcessId() {
+#if defined(_WIN32)
+        return _getpid();
+#else
+        return static_cast<int>(getpid());
+#endif
+    }
+
+    const std::string dir_;
+    const std::string build_id_;
+};
+
+/// Compiles the shader of the compile request `req`
+/// @returns the compile result, or std::nullopt if this server cannot compile the shader
+std::optional<CompileResult> CompileShader([[maybe_unused]] const CompileRequest& req) {
+#if TINT_BUILD_MSL_WRITER && TINT_BUILD_IS_MAC
+    if (req.language == SourceLanguage::MSL) {
+        auto version = tint::msl::validate::MslVersion::kMsl_1_2;
+        if (req.version_major == 2 && req.version_minor == 1) {
+            version = tint::msl::validate::MslVersion::kMsl_2_1;
+        }
+        if (req.version_major == 2 && req.version_minor == 3) {
+            version = tint::msl::validate::MslVersion::kMsl_2_3;
+        }
+        auto result = tint::msl::validate::ValidateUsingMetal(req.source, version);
+        return CompileResult{!result.failed, result.output};
+    }
+#endif
+    return std::nullopt;
+}
+
+/// CompilePool compiles shaders on a fixed number of threads, so that the number of concurrent
+/// compiles is bounded however many clients are connected.
+class CompilePool {
+  public:
+    /// A compile of a single shader
+    using Task = std::packaged_task<std::optional<CompileResult>()>;
+
+    /// Constructor
+    /// @param num_threads the number of threads that compile shaders
+    explicit CompilePool(uint32_t num_threads) {
+        for (uint32_t i = 0; i < num_threads; i++) {
+            threads_.emplace_back([this] { Run(); });
+        }
+    }
+
+    /// Destructor. Finishes the queued compiles, then joins the threads.
+    ~CompilePool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    /// Compiles `req` on one of the pool's threads, blocking until the compile has finished.
+    /// @returns the compile result, or std::nullopt if this server cannot compile the shader
+    std::optional<CompileResult> Compile(const CompileRequest& req) {
+        Task task([&req] { return CompileShader(req); });
+        auto result = task.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+        return result.get();
+    }
+
+  private:
+    /// The entry point of the pool's threads
+    void Run() {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Task> tasks_;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+/// Serves the client connected to `conn`, until the client closes the connection
+/// @param conn the client connection
+/// @param pool the pool that compiles the shaders
+/// @param cache the compile result cache, or nullptr if results are not cached
+/// @param verbose if true, the progress of the connection is printed to stdout
+void Serve(tint::socket::Socket* conn, CompilePool& pool, const ResultCache* cache, bool verbose) {
+    auto tid = std::this_thread::get_id();
+    if (verbose) {
+        std::cout << tid << " Client connected...\n";
+    }
+    Stream stream{conn, ""};
+
+    {
+        ConnectionRequest req;
+        stream >> req;
+        if (!stream.error.empty()) {
+            if (verbose) {
+                std::cout << tid << " Error: " << stream.error << "\n";
+            }
+            return;
+        }
+        ConnectionResponse resp;
+        if (req.protocol_version != kProtocolVersion) {
+            if (verbose) {
+                std::cout << tid << " Protocol version mismatch. requested: "
+                          << req.protocol_version << "\n";
+            }
+            resp.error = "Protocol version mismatch";
+            stream << resp;
+            return;
+        }
+        stream << resp;
+    }
+    if (verbose) {
+        std::cout << tid << " Connection established\n";
+    }
+
+    for (size_t num_requests = 0;; num_requests++) {
+        CompileRequest req;
+        stream >> req;
+        if (!stream.error.empty()) {
+            if (verbose) {
+                if (num_requests > 0) {
+                    std::cout << tid << " Client disconnected\n";
+                } else {
+                    std::cout << tid << " Error: " << stream.error << "\n";
+                }
+            }
+            return;
+        }
+
+        std::optional<CompileResult> result;
+        bool cached = false;
+        if (cache) {
+            result = cache->Get(req);
+            cached = result.has_value();
+        }
+        if (!result) {
+            result = pool.Compile(req);
+            if (result && cache) {
+                cache->Put(req, *result);
+            }
+        }
+
+        CompileResponse resp;
+        if (!result) {
+            resp.error = "server cannot compile this type of shader";
+        } else if (!result->success) {
+            resp.error = result->output;
+        }
+        stream << resp;
+
+        if (verbose && result) {
+            std::cout << tid << " Shader compilation " << (result->success ? "passed" : "failed")
+                      << (cached ? " (cached)" : "") << "\n";
+        }
+    }
+}
+
 }  // namespace
 
-bool RunServer(std::string port, bool verbose);
+bool RunServer(std::string port,
+               uint32_t num_threads,
+               std::string cache_dir,
+               const char* argv0,
+               bool verbose);
 bool RunClient(std::string address,
                std::string port,
                std::string file,
@@ -313,6 +671,8 @@ int main(int argc, char* argv[]) {
     int version_major = 0;
     int version_minor = 0;
     std::string port = "19000";
+    uint32_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::string cache_dir;
 
     std::regex metal_version_re{"^-?-std=macos-metal([0-9]+)\\.([0-9]+)"};
 
@@ -337,6 +697,26 @@ int main(int argc, char* argv[]) {
             verbose = true;
             continue;
         }
+        if (arg == "-j" || arg == "--jobs") {
+            if (i < argc - 1 && std::atoi(argv[i + 1]) > 0) {
+                i++;
+                num_threads = static_cast<uint32_t>(std::atoi(argv[i]));
+            } else {
+                printf("expected thread count");
+                exit(1);
+            }
+            continue;
+        }
+        if (arg == "--cache") {
+            if (i < argc - 1) {
+                i++;
+                cache_dir = argv[i];
+            } else {
+                printf("expected cache directory");
+                exit(1);
+            }
+            continue;
+        }
 
         // xcrun flags are ignored so this executable can be used as a replacement for xcrun.
         if ((arg == "-x" || arg == "-sdk") && (i < argc - 1)) {
@@ -366,7 +746,7 @@ int main(int argc, char* argv[]) {
     bool success = false;
 
     if (run_server) {
-        success = RunServer(port, verbose);
+        success = RunServer(port, num_threads, cache_dir, argv[0], verbose);
     } else {
         std::string address;
         std::string file;
@@ -400,82 +780,39 @@ int main(int argc, char* argv[]) {
     return 0;
 }
 
-bool RunServer(std::string port, bool verbose) {
+bool RunServer(std::string port,
+               uint32_t num_threads,
+               std::string cache_dir,
+               const char* argv0,
+               bool verbose) {
     auto server_socket = tint::socket::Socket::Listen("", port.c_str());
     if (!server_socket) {
         std::cout << "Failed to listen on port " << port << "\n";
         return false;
     }
-    std::cout << "Listening on port " << port.c_str() << "...\n";
-    while (auto conn = server_socket->Accept()) {
-        std::thread([=] {
-            auto tid = std::this_thread::get_id();
-            if (verbose) {
-                std::cout << tid << " Client connected...\n";
-            }
-            Stream stream{conn.get(), ""};
 
-            {
-                ConnectionRequest req;
-                stream >> req;
-                if (!stream.error.empty()) {
-                    if (verbose) {
-                        std::cout << tid << " Error: " << stream.error << "\n";
-                    }
-                    return;
-                }
-                ConnectionResponse resp;
-                if (req.protocol_version != kProtocolVersion) {
-                    if (verbose) {
-                        std::cout << tid << " Protocol version mismatch. requested: "
-                                  << req.protocol_version << "\n";
-                    }
-                    resp.error = "Protocol version mismatch";
-                    stream << resp;
-                    return;
-                }
-                stream << resp;
-            }
-            if (verbose) {
-                std::cout << tid << " Connection established\n";
-            }
-            {
-                CompileRequest req;
-                stream >> req;
-                if (!stream.error.empty()) {
-                    if (verbose) {
-                        std::cout << tid << " Error: " << stream.error << "\n";
-                    }
-                    return;
-                }
+    // The connection threads are detached, so they share the ownership of the cache and the pool.
+    std::shared_ptr<const ResultCache> cache;
+    if (!cache_dir.empty()) {
+        if (auto build_id = BuildId(argv0)) {
+            cache = std::make_shared<ResultCache>(cache_dir, *build_id);
+        } else {
+            std::cout << "Failed to read the server executable. Compile results are not cached\n";
+        }
+    }
+    auto pool = std::make_shared<CompilePool>(num_threads);
+
 #if TINT_BUILD_MSL_WRITER && TINT_BUILD_IS_MAC
-                if (req.language == SourceLanguage::MSL) {
-                    auto version = tint::msl::validate::MslVersion::kMsl_1_2;
-                    if (req.version_major == 2 && req.version_minor == 1) {
-                        version = tint::msl::validate::MslVersion::kMsl_2_1;
-                    }
-                    if (req.version_major == 2 && req.version_minor == 3) {
-                        version = tint::msl::validate::MslVersion::kMsl_2_3;
-                    }
-                    auto result = tint::msl::validate::ValidateUsingMetal(req.source, version);
-                    CompileResponse resp;
-                    if (result.failed) {
-                        resp.error = result.output;
-                    }
-                    stream << resp;
-
-                    if (verbose) {
-                        std::cout << tid << " Shader compilation "
-                                  << (result.failed ? "failed" : "passed") << "\n";
-                    }
-                    return;
-                }
+    // Compile a trivial shader, so that the Metal compiler is loaded before the first request.
+    pool->Compile(CompileRequest{SourceLanguage::MSL, 1, 2, "kernel void warm_up() {}"});
 #endif
-                CompileResponse resp;
-                resp.error = "server cannot compile this type of shader";
-                stream << resp;
-            }
-        }).detach();
+
+    // Each connection is served by its own thread, which mostly waits for the client's next
+    // request, so that idle clients do not hold up the other connections. Only the compiles are
+    // run on the pool's threads.
+    std::cout << "Listening on port " << port.c_str() << "...\n";
+    while (auto conn = server_socket->Accept()) {
+        std::thread([=] { Serve(conn.get(), *pool, cache.get(), verbose); }).detach();
     }
     return true;
 }
@@ -49,6 +49,7 @@ tint_target_add_dependencies(tint_cmd_test_test_cmd test_cmd
   tint_cmd_common_test
   tint_lang_core_constant_test
   tint_lang_core_intrinsic_test
+  tint_lang_core_ir_analysis_test
   tint_lang_core_ir_transform_test
   tint_lang_core_ir_test
   tint_lang_core_type_test
@@ -86,6 +87,7 @@ tint_target_add_dependencies(tint_cmd_test_test_cmd test_cmd
   tint_utils_rtti_test
   tint_utils_strconv_test
   tint_utils_symbol_test
+  tint_utils_system_test
   tint_utils_text_test
   tint_utils_traits_test
 )
@@ -50,6 +50,7 @@ tint_target_add_dependencies(tint_cmd_tint_cmd cmd
   tint_lang_core
   tint_lang_core_constant
   tint_lang_core_ir
+  tint_lang_core_ir_transform
   tint_lang_core_type
   tint_lang_hlsl_writer_common
   tint_lang_hlsl_writer_helpers
@@ -134,7 +135,9 @@ endif(TINT_BUILD_SPV_WRITER)
 if(TINT_BUILD_WGSL_READER)
   tint_target_add_dependencies(tint_cmd_tint_cmd cmd
     tint_lang_wgsl_reader
+    tint_lang_wgsl_reader_parser
     tint_lang_wgsl_reader_program_to_ir
+    tint_lang_wgsl_resolver
   )
 endif(TINT_BUILD_WGSL_READER)
 
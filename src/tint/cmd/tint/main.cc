@@ -25,13 +25,20 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <charconv>
+#include <chrono>
 #include <cstdio>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include "src/tint/lang/wgsl/sem/variable.h"
 
@@ -39,12 +46,15 @@
 #include "spirv-tools/libspirv.hpp"
 #endif  // TINT_BUILD_SPV_READER || TINT_BUILD_SPV_WRITER
 
+#include "src/tint/api/options/optimization_level.h"
 #include "src/tint/api/options/pixel_local.h"
 #include "src/tint/api/tint.h"
 #include "src/tint/cmd/common/generate_external_texture_bindings.h"
 #include "src/tint/cmd/common/helper.h"
 #include "src/tint/lang/core/ir/disassembler.h"
 #include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/transform/optimize.h"
+#include "src/tint/lang/core/ir/validator.h"
 #include "src/tint/lang/wgsl/ast/module.h"
 #include "src/tint/lang/wgsl/ast/transform/first_index_offset.h"
 #include "src/tint/lang/wgsl/ast/transform/manager.h"
@@ -52,6 +62,7 @@
 #include "src/tint/lang/wgsl/ast/transform/single_entry_point.h"
 #include "src/tint/lang/wgsl/ast/transform/substitute_override.h"
 #include "src/tint/lang/wgsl/helpers/flatten_bindings.h"
+#include "src/tint/lang/wgsl/helpers/for_each_entry_point.h"
 #include "src/tint/utils/cli/cli.h"
 #include "src/tint/utils/command/command.h"
 #include "src/tint/utils/containers/transform.h"
@@ -59,6 +70,7 @@
 #include "src/tint/utils/macros/defer.h"
 #include "src/tint/utils/system/env.h"
 #include "src/tint/utils/system/terminal.h"
+#include "src/tint/utils/system/thread_pool.h"
 #include "src/tint/utils/text/string.h"
 #include "src/tint/utils/text/string_stream.h"
 #include "src/tint/utils/text/styled_text.h"
@@ -66,8 +78,10 @@
 #include "src/tint/utils/text/styled_text_theme.h"
 
 #if TINT_BUILD_WGSL_READER
+#include "src/tint/lang/wgsl/reader/parser/parser.h"
 #include "src/tint/lang/wgsl/reader/program_to_ir/program_to_ir.h"
 #include "src/tint/lang/wgsl/reader/reader.h"
+#include "src/tint/lang/wgsl/resolver/resolve.h"
 #endif  // TINT_BUILD_WGSL_READER
 
 #if TINT_BUILD_SPV_WRITER
@@ -132,8 +146,27 @@
 namespace {
 
 /// Prints the given hash value in a format string that the end-to-end test runner can parse.
-[[maybe_unused]] void PrintHash(uint32_t hash) {
-    std::cout << "<<HASH: 0x" << std::hex << hash << ">>\n";
+[[maybe_unused]] void PrintHash(std::ostream& out, uint32_t hash) {
+    out << "<<HASH: 0x" << std::hex << hash << ">>\n";
+}
+
+/// Prints the time taken by each IR optimization pass.
+/// @param err the stream to print to
+/// @param timings the pass timings reported by the writer
+[[maybe_unused]] void PrintPassTimings(
+    std::ostream& err,
+    const std::vector<tint::core::ir::transform::PassTiming>& timings) {
+    auto print = [&err](std::string_view name, std::chrono::nanoseconds duration) {
+        err << std::left << std::setw(32) << name << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(10)
+                  << std::chrono::duration<double, std::milli>(duration).count() << " ms\n";
+    };
+    std::chrono::nanoseconds total{};
+    for (auto& timing : timings) {
+        print(timing.name, timing.duration);
+        total += timing.duration;
+    }
+    print("Total", total);
 }
 
 enum class Format : uint8_t {
@@ -176,8 +209,11 @@ struct Options {
 
     Format format = Format::kUnknown;
 
-    bool emit_single_entry_point = false;
-    std::string ep_name;
+    tint::Vector<std::string, 1> entry_points;
+    uint32_t jobs = 1;
+
+    std::string batch_manifest;
+    std::string timings_json;
 
     bool rename_all = false;
 
@@ -211,12 +247,83 @@ struct Options {
     bool dump_ir = false;
     bool use_ir = false;
     bool use_ir_reader = false;
+    tint::OptimizationLevel optimization_level = tint::OptimizationLevel::kO0;
+    bool time_passes = false;
+    tint::core::ir::ValidationMode ir_validation = tint::core::ir::kDefaultValidationMode;
 
 #if TINT_BUILD_SYNTAX_TREE_WRITER
     bool dump_ast = false;
 #endif  // TINT_BUILD_SYNTAX_TREE_WRITER
 };
 
+/// The time taken by a single phase of compiling a shader, as reported by `--timings-json`.
+struct PhaseTiming {
+    /// The phase, such as "parse", "transform" or "generate"
+    std::string phase;
+    /// The name of the transform or pass, for phases that run several of them
+    std::string name;
+    /// The time that the phase took
+    std::chrono::nanoseconds duration{};
+};
+
+/// The destination of a generated shader, and of the messages printed while generating it.
+struct Output {
+    /// The file that the shader is written to. If empty or "-", the shader is written to #out.
+    std::string file;
+    /// The stream for the shader when written to standard output, and for other results
+    std::ostream& out;
+    /// The stream for errors and diagnostics
+    std::ostream& err;
+    /// If not null, the time taken by each phase of generating the shader is appended to this list
+    std::vector<PhaseTiming>* timings = nullptr;
+};
+
+/// Appends the time between its construction and destruction to `Output::timings` as a phase, if
+/// the output has a timings list.
+class PhaseTimer {
+  public:
+    /// Constructor
+    /// @param output the output that the timing is appended to
+    /// @param phase the name of the phase
+    PhaseTimer(const Output& output, std::string phase)
+        : timings_(output.timings),
+          phase_(std::move(phase)),
+          start_(std::chrono::steady_clock::now()) {}
+
+    /// Destructor
+    ~PhaseTimer() {
+        if (timings_) {
+            timings_->push_back(
+                PhaseTiming{std::move(phase_), "", std::chrono::steady_clock::now() - start_});
+        }
+    }
+
+  private:
+    std::vector<PhaseTiming>* const timings_;
+    std::string phase_;
+    const std::chrono::steady_clock::time_point start_;
+};
+
+/// Calls @p f, timing the call as the phase @p phase of @p output.
+/// @returns the value returned by @p f
+template <typename F>
+auto TimePhase(const Output& output, std::string phase, F&& f) {
+    PhaseTimer timer(output, std::move(phase));
+    return f();
+}
+
+/// Appends the timings of the IR optimization passes to `output.timings`, if not null.
+[[maybe_unused]] void AddPassTimings(
+    const Output& output,
+    const std::vector<tint::core::ir::transform::PassTiming>& timings) {
+    if (output.timings) {
+        for (auto& timing : timings) {
+            output.timings->push_back(
+                PhaseTiming{"optimize", std::string(timing.name), timing.duration});
+        }
+    }
+}
+
 /// @returns the default ColorMode when no `--color` flag is specified.
 ColorMode ColorModeDefault() {
     if (!tint::TerminalSupportsColors(stdout)) {
@@ -318,15 +425,44 @@ If not provided, will be inferred from output filename extension:
                                                    ShortName{"col"}, Default{ColorModeDefault()});
     TINT_DEFER(opts->printer = CreatePrinter(*col.value));
 
-    auto& ep = options.Add<StringOption>("entry-point", "Output single entry point",
-                                         ShortName{"ep"}, Parameter{"name"});
+    auto& ep =
+        options.Add<StringOption>("entry-point", R"(Output the given entry points, comma separated.
+If more than one entry point is given, each is generated
+separately, and written to the output file name with the
+entry point name inserted before the extension)",
+                                  ShortName{"ep"}, Parameter{"names"});
     TINT_DEFER({
         if (ep.value.has_value()) {
-            opts->ep_name = *ep.value;
-            opts->emit_single_entry_point = true;
+            for (auto name : tint::Split(*ep.value, ",")) {
+                opts->entry_points.Push(std::string(name));
+            }
         }
     });
 
+    auto& jobs = options.Add<ValueOption<uint32_t>>(
+        "jobs", "Number of entry points, or --batch shaders, to generate concurrently",
+        ShortName{"j"}, Default{1u});
+    TINT_DEFER(opts->jobs = *jobs.value);
+
+    auto& batch =
+        options.Add<StringOption>("batch", R"(Generates each shader listed in the manifest file.
+Each line of the manifest holds the input file and options
+of one shader, separated by whitespace, as they would be
+passed to tint. Wrap an argument that holds whitespace in
+double quotes, and escape the quotes and backslashes in it
+with a backslash. Empty lines and lines starting with '#' are
+ignored. Only WGSL input files are supported, and the options
+that dump the AST, IR or bindings are ignored)",
+                                  Parameter{"manifest"});
+    TINT_DEFER(opts->batch_manifest = batch.value.value_or(""));
+
+    auto& timings_json =
+        options.Add<StringOption>("timings-json", R"(Writes the time taken by each phase of
+generating each shader of the --batch manifest to the
+file, as JSON. Use '-' for standard output)",
+                                  Parameter{"file"});
+    TINT_DEFER(opts->timings_json = timings_json.value.value_or(""));
+
     auto& output = options.Add<StringOption>("output-name", "Output file name", ShortName{"o"},
                                              Parameter{"name"});
     TINT_DEFER(opts->output_file = output.value.value_or(""));
@@ -370,6 +506,32 @@ When specified, automatically enables MSL validation)",
         "use-ir-reader", "Use the IR for the SPIR-V reader", Default{false});
     TINT_DEFER(opts->use_ir_reader = *use_ir_reader.value);
 
+    auto& optimization_level = options.Add<EnumOption<tint::OptimizationLevel>>(
+        "optimization-level", R"(Level of optimization applied to the IR by the writers.
+Only used with --use-ir)",
+        tint::Vector{
+            EnumName{tint::OptimizationLevel::kO0, "0"},
+            EnumName{tint::OptimizationLevel::kO1, "1"},
+            EnumName{tint::OptimizationLevel::kO2, "2"},
+        },
+        ShortName{"O"}, Default{tint::OptimizationLevel::kO0});
+    TINT_DEFER(opts->optimization_level = *optimization_level.value);
+
+    auto& time_passes = options.Add<BoolOption>(
+        "time-passes", "Prints the time taken by each IR optimization pass", Default{false});
+    TINT_DEFER(opts->time_passes = *time_passes.value);
+
+    auto& ir_validation = options.Add<EnumOption<tint::core::ir::ValidationMode>>(
+        "ir-validation", R"(Validation of the IR performed before each IR transform.
+Defaults to 'full' in debug builds, and 'none' in release builds)",
+        tint::Vector{
+            EnumName{tint::core::ir::ValidationMode::kNone, "none"},
+            EnumName{tint::core::ir::ValidationMode::kStructural, "structural"},
+            EnumName{tint::core::ir::ValidationMode::kFull, "full"},
+        },
+        Default{tint::core::ir::kDefaultValidationMode});
+    TINT_DEFER(opts->ir_validation = *ir_validation.value);
+
     auto& verbose =
         options.Add<BoolOption>("verbose", "Verbose output", ShortName{"v"}, Default{false});
     TINT_DEFER(opts->verbose = *verbose.value);
@@ -648,55 +810,63 @@ Options:
     if (files.Length() == 1) {
         opts->input_filename = files[0];
     }
+    if (batch.value.has_value() && files.Length() == 1) {
+        std::cerr << "An input file cannot be specified with --batch\n";
+        return false;
+    }
+    if (timings_json.value.has_value() && !batch.value.has_value()) {
+        std::cerr << "--timings-json can only be used with --batch\n";
+        return false;
+    }
 
     return true;
 }
 
-/// Writes the given `buffer` into the file named as `output_file` using the
-/// given `mode`.  If `output_file` is empty or "-", writes to standard
-/// output. If any error occurs, returns false and outputs error message to
-/// standard error. The ContainerT type must have data() and size() methods,
+/// Writes the given `buffer` into the file named as `output.file` using the
+/// given `mode`.  If `output.file` is empty or "-", writes to `output.out`.
+/// If any error occurs, returns false and writes an error message to
+/// `output.err`. The ContainerT type must have data() and size() methods,
 /// like `std::string` and `std::vector` do.
 /// @returns true on success
 template <typename ContainerT>
-[[maybe_unused]] bool WriteFile(const std::string& output_file,
+[[maybe_unused]] bool WriteFile(const Output& output,
                                 const std::string mode,
                                 const ContainerT& buffer) {
-    const bool use_stdout = output_file.empty() || output_file == "-";
-    FILE* file = stdout;
+    const size_t size = buffer.size() * sizeof(typename ContainerT::value_type);
+    if (output.file.empty() || output.file == "-") {
+        output.out.write(reinterpret_cast<const char*>(buffer.data()),
+                         static_cast<std::streamsize>(size));
+        if (!output.out) {
+            output.err << "Could not write all output to standard output\n";
+            return false;
+        }
+        return true;
+    }
 
-    if (!use_stdout) {
+    FILE* file = nullptr;
 #if defined(_MSC_VER)
-        fopen_s(&file, output_file.c_str(), mode.c_str());
+    fopen_s(&file, output.file.c_str(), mode.c_str());
 #else
-        file = fopen(output_file.c_str(), mode.c_str());
+    file = fopen(output.file.c_str(), mode.c_str());
 #endif
-        if (!file) {
-            std::cerr << "Could not open file " << output_file << " for writing\n";
-            return false;
-        }
+    if (!file) {
+        output.err << "Could not open file " << output.file << " for writing\n";
+        return false;
     }
 
     size_t written =
         fwrite(buffer.data(), sizeof(typename ContainerT::value_type), buffer.size(), file);
+    fclose(file);
     if (buffer.size() != written) {
-        if (use_stdout) {
-            std::cerr << "Could not write all output to standard output\n";
-        } else {
-            std::cerr << "Could not write to file " << output_file << "\n";
-            fclose(file);
-        }
+        output.err << "Could not write to file " << output.file << "\n";
         return false;
     }
-    if (!use_stdout) {
-        fclose(file);
-    }
 
     return true;
 }
 
 #if TINT_BUILD_SPV_WRITER
-std::string Disassemble(const std::vector<uint32_t>& data) {
+std::string Disassemble(const std::vector<uint32_t>& data, std::ostream& err) {
     std::string spv_errors;
     spv_target_env target_env = SPV_ENV_VULKAN_1_1;
 
@@ -729,7 +899,7 @@ std::string Disassemble(const std::vector<uint32_t>& data) {
     if (!tools.Disassemble(
             data, &result,
             SPV_BINARY_TO_TEXT_OPTION_INDENT | SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES)) {
-        std::cerr << spv_errors << "\n";
+        err << spv_errors << "\n";
     }
     return result;
 }
@@ -738,8 +908,9 @@ std::string Disassemble(const std::vector<uint32_t>& data) {
 /// Generate SPIR-V code for a program.
 /// @param program the program to generate
 /// @param options the options that Tint was invoked with
+/// @param output the destination of the generated code
 /// @returns true on success
-bool GenerateSpirv(const tint::Program& program, const Options& options) {
+bool GenerateSpirv(const tint::Program& program, const Options& options, const Output& output) {
 #if TINT_BUILD_SPV_WRITER
     // TODO(jrprice): Provide a way for the user to set non-default options.
     tint::spirv::writer::Options gen_options;
@@ -747,47 +918,59 @@ bool GenerateSpirv(const tint::Program& program, const Options& options) {
     gen_options.disable_workgroup_init = options.disable_workgroup_init;
     gen_options.use_storage_input_output_16 = options.use_storage_input_output_16;
     gen_options.bindings = tint::spirv::writer::GenerateBindings(program);
+    gen_options.optimization_level = options.optimization_level;
 
     tint::Result<tint::spirv::writer::Output> result;
     if (options.use_ir) {
         // Convert the AST program to an IR module.
-        auto ir = tint::wgsl::reader::ProgramToLoweredIR(program);
+        auto ir = TimePhase(output, "ProgramToIR",
+                            [&] { return tint::wgsl::reader::ProgramToLoweredIR(program); });
         if (ir != tint::Success) {
-            std::cerr << "Failed to generate IR: " << ir << "\n";
+            output.err << "Failed to generate IR: " << ir << "\n";
             return false;
         }
-        result = tint::spirv::writer::Generate(ir.Get(), gen_options);
+        ir->validation_mode = options.ir_validation;
+        result = TimePhase(output, "generate",
+                           [&] { return tint::spirv::writer::Generate(ir.Get(), gen_options); });
     } else {
-        result = tint::spirv::writer::Generate(program, gen_options);
+        result = TimePhase(output, "generate",
+                           [&] { return tint::spirv::writer::Generate(program, gen_options); });
     }
 
     if (result != tint::Success) {
-        tint::cmd::PrintWGSL(std::cerr, program);
-        std::cerr << "Failed to generate: " << result.Failure() << "\n";
+        tint::cmd::PrintWGSL(output.err, program);
+        output.err << "Failed to generate: " << result.Failure() << "\n";
         return false;
     }
 
-    if (options.format == Format::kSpvAsm) {
-        if (!WriteFile(options.output_file, "w", Disassemble(result.Get().spirv))) {
-            return false;
-        }
-    } else {
-        if (!WriteFile(options.output_file, "wb", result.Get().spirv)) {
-            return false;
+    if (options.time_passes) {
+        PrintPassTimings(output.err, result->pass_timings);
+    }
+    AddPassTimings(output, result->pass_timings);
+
+    bool written = TimePhase(output, "write", [&] {
+        if (options.format == Format::kSpvAsm) {
+            return WriteFile(output, "w", Disassemble(result.Get().spirv, output.err));
         }
+        return WriteFile(output, "wb", result.Get().spirv);
+    });
+    if (!written) {
+        return false;
     }
 
     const auto hash = tint::CRC32(result.Get().spirv.data(), result.Get().spirv.size());
     if (options.print_hash) {
-        PrintHash(hash);
+        PrintHash(output.out, hash);
     }
 
     if (options.validate && options.skip_hash.count(hash) == 0) {
+        PhaseTimer timer(output, "validate");
         // Use Vulkan 1.1, since this is what Tint, internally, uses.
         spvtools::SpirvTools tools(SPV_ENV_VULKAN_1_1);
         tools.SetMessageConsumer(
-            [](spv_message_level_t, const char*, const spv_position_t& pos, const char* msg) {
-                std::cerr << (pos.line + 1) << ":" << (pos.column + 1) << ": " << msg << "\n";
+            [&output](spv_message_level_t, const char*, const spv_position_t& pos,
+                      const char* msg) {
+                output.err << (pos.line + 1) << ":" << (pos.column + 1) << ": " << msg << "\n";
             });
         if (!tools.Validate(result.Get().spirv.data(), result.Get().spirv.size(),
                             spvtools::ValidatorOptions())) {
@@ -799,7 +982,8 @@ bool GenerateSpirv(const tint::Program& program, const Options& options) {
 #else
     (void)program;
     (void)options;
-    std::cerr << "SPIR-V writer not enabled in tint build" << std::endl;
+    (void)output;
+    output.err << "SPIR-V writer not enabled in tint build" << std::endl;
     return false;
 #endif  // TINT_BUILD_SPV_WRITER
 }
@@ -807,29 +991,33 @@ bool GenerateSpirv(const tint::Program& program, const Options& options) {
 /// Generate WGSL code for a program.
 /// @param program the program to generate
 /// @param options the options that Tint was invoked with
+/// @param output the destination of the generated code
 /// @returns true on success
 bool GenerateWgsl([[maybe_unused]] const tint::Program& program,
-                  [[maybe_unused]] const Options& options) {
+                  [[maybe_unused]] const Options& options,
+                  [[maybe_unused]] const Output& output) {
 #if TINT_BUILD_WGSL_WRITER
     // TODO(jrprice): Provide a way for the user to set non-default options.
     tint::wgsl::writer::Options gen_options;
-    auto result = tint::wgsl::writer::Generate(program, gen_options);
+    auto result = TimePhase(output, "generate",
+                            [&] { return tint::wgsl::writer::Generate(program, gen_options); });
     if (result != tint::Success) {
-        std::cerr << "Failed to generate: " << result.Failure() << "\n";
+        output.err << "Failed to generate: " << result.Failure() << "\n";
         return false;
     }
 
-    if (!WriteFile(options.output_file, "w", result->wgsl)) {
+    if (!TimePhase(output, "write", [&] { return WriteFile(output, "w", result->wgsl); })) {
         return false;
     }
 
     const auto hash = tint::CRC32(result->wgsl.data(), result->wgsl.size());
     if (options.print_hash) {
-        PrintHash(hash);
+        PrintHash(output.out, hash);
     }
 
 #if TINT_BUILD_WGSL_READER
     if (options.validate && options.skip_hash.count(hash) == 0) {
+        PhaseTimer timer(output, "validate");
         // Attempt to re-parse the output program with Tint's WGSL reader.
         tint::wgsl::reader::Options parser_options;
         parser_options.allowed_features = tint::wgsl::AllowedFeatures::Everything();
@@ -845,7 +1033,7 @@ bool GenerateWgsl([[maybe_unused]] const tint::Program& program,
 
     return true;
 #else
-    std::cerr << "WGSL writer not enabled in tint build" << std::endl;
+    output.err << "WGSL writer not enabled in tint build" << std::endl;
     return false;
 #endif  // TINT_BUILD_WGSL_WRITER
 }
@@ -853,11 +1041,13 @@ bool GenerateWgsl([[maybe_unused]] const tint::Program& program,
 /// Generate MSL code for a program.
 /// @param program the program to generate
 /// @param options the options that Tint was invoked with
+/// @param output the destination of the generated code
 /// @returns true on success
 bool GenerateMsl([[maybe_unused]] const tint::Program& program,
-                 [[maybe_unused]] const Options& options) {
+                 [[maybe_unused]] const Options& options,
+                 [[maybe_unused]] const Output& output) {
 #if !TINT_BUILD_MSL_WRITER
-    std::cerr << "MSL writer not enabled in tint build" << std::endl;
+    output.err << "MSL writer not enabled in tint build" << std::endl;
     return false;
 #else
     // Remap resource numbers to a flat namespace.
@@ -875,6 +1065,7 @@ bool GenerateMsl([[maybe_unused]] const tint::Program& program,
     gen_options.pixel_local_options = options.pixel_local_options;
     gen_options.bindings = tint::msl::writer::GenerateBindings(*input_program);
     gen_options.array_length_from_uniform.ubo_binding = 30;
+    gen_options.optimization_level = options.optimization_level;
 
     // Add array_length_from_uniform entries for all storage buffers with runtime sized arrays.
     std::unordered_set<tint::BindingPoint> storage_bindings;
@@ -892,29 +1083,39 @@ bool GenerateMsl([[maybe_unused]] const tint::Program& program,
     tint::Result<tint::msl::writer::Output> result;
     if (options.use_ir) {
         // Convert the AST program to an IR module.
-        auto ir = tint::wgsl::reader::ProgramToLoweredIR(program);
+        auto ir = TimePhase(output, "ProgramToIR",
+                            [&] { return tint::wgsl::reader::ProgramToLoweredIR(program); });
         if (ir != tint::Success) {
-            std::cerr << "Failed to generate IR: " << ir << "\n";
+            output.err << "Failed to generate IR: " << ir << "\n";
             return false;
         }
-        result = tint::msl::writer::Generate(ir.Get(), gen_options);
+        ir->validation_mode = options.ir_validation;
+        result = TimePhase(output, "generate",
+                           [&] { return tint::msl::writer::Generate(ir.Get(), gen_options); });
     } else {
-        result = tint::msl::writer::Generate(*input_program, gen_options);
+        result = TimePhase(output, "generate", [&] {
+            return tint::msl::writer::Generate(*input_program, gen_options);
+        });
     }
 
     if (result != tint::Success) {
-        tint::cmd::PrintWGSL(std::cerr, program);
-        std::cerr << "Failed to generate: " << result.Failure() << "\n";
+        tint::cmd::PrintWGSL(output.err, program);
+        output.err << "Failed to generate: " << result.Failure() << "\n";
         return false;
     }
 
-    if (!WriteFile(options.output_file, "w", result->msl)) {
+    if (options.time_passes) {
+        PrintPassTimings(output.err, result->pass_timings);
+    }
+    AddPassTimings(output, result->pass_timings);
+
+    if (!TimePhase(output, "write", [&] { return WriteFile(output, "w", result->msl); })) {
         return false;
     }
 
     const auto hash = tint::CRC32(result->msl.c_str());
     if (options.print_hash) {
-        PrintHash(hash);
+        PrintHash(output.out, hash);
     }
 
     // Default to validating against MSL 1.2.
@@ -931,6 +1132,7 @@ bool GenerateMsl([[maybe_unused]] const tint::Program& program,
     }
 
     if (options.validate && options.skip_hash.count(hash) == 0) {
+        PhaseTimer timer(output, "validate");
         tint::msl::validate::Result res;
 #if TINT_BUILD_IS_MAC
         res = tint::msl::validate::ValidateUsingMetal(result->msl, msl_version);
@@ -950,7 +1152,7 @@ bool GenerateMsl([[maybe_unused]] const tint::Program& program,
         }
 #endif  // TINT_BUILD_IS_MAC
         if (res.failed) {
-            std::cerr << res.output << "\n";
+            output.err << res.output << "\n";
             return false;
         }
     }
@@ -962,8 +1164,9 @@ bool GenerateMsl([[maybe_unused]] const tint::Program& program,
 /// Generate HLSL code for a program.
 /// @param program the program to generate
 /// @param options the options that Tint was invoked with
+/// @param output the destination of the generated code
 /// @returns true on success
-bool GenerateHlsl(const tint::Program& program, const Options& options) {
+bool GenerateHlsl(const tint::Program& program, const Options& options, const Output& output) {
 #if TINT_BUILD_HLSL_WRITER
     // If --fxc or --dxc was passed, then we must explicitly find and validate with that respective
     // compiler.
@@ -980,24 +1183,26 @@ bool GenerateHlsl(const tint::Program& program, const Options& options) {
     gen_options.polyfill_dot_4x8_packed = options.hlsl_shader_model < kMinShaderModelForDP4aInHLSL;
     gen_options.polyfill_pack_unpack_4x8 =
         options.hlsl_shader_model < kMinShaderModelForPackUnpack4x8InHLSL;
-    auto result = tint::hlsl::writer::Generate(program, gen_options);
+    auto result = TimePhase(output, "generate",
+                            [&] { return tint::hlsl::writer::Generate(program, gen_options); });
     if (result != tint::Success) {
-        tint::cmd::PrintWGSL(std::cerr, program);
-        std::cerr << "Failed to generate: " << result.Failure() << std::endl;
+        tint::cmd::PrintWGSL(output.err, program);
+        output.err << "Failed to generate: " << result.Failure() << std::endl;
         return false;
     }
 
-    if (!WriteFile(options.output_file, "w", result->hlsl)) {
+    if (!TimePhase(output, "write", [&] { return WriteFile(output, "w", result->hlsl); })) {
         return false;
     }
 
     const auto hash = tint::CRC32(result->hlsl.c_str());
     if (options.print_hash) {
-        PrintHash(hash);
+        PrintHash(output.out, hash);
     }
 
     if ((options.validate || must_validate_dxc || must_validate_fxc) &&
         (options.skip_hash.count(hash) == 0)) {
+        PhaseTimer timer(output, "validate");
         tint::hlsl::validate::Result dxc_res;
         bool dxc_found = false;
         if (options.validate || must_validate_dxc) {
@@ -1053,28 +1258,28 @@ bool GenerateHlsl(const tint::Program& program, const Options& options) {
         }
 
         if (fxc_res.failed) {
-            std::cerr << "FXC validation failure:" << std::endl << fxc_res.output << std::endl;
+            output.err << "FXC validation failure:" << std::endl << fxc_res.output << std::endl;
         }
         if (dxc_res.failed) {
-            std::cerr << "DXC validation failure:" << std::endl << dxc_res.output << std::endl;
+            output.err << "DXC validation failure:" << std::endl << dxc_res.output << std::endl;
         }
         if (fxc_res.failed || dxc_res.failed) {
             return false;
         }
         if (!fxc_found && !dxc_found) {
-            std::cerr << "Couldn't find FXC or DXC. Cannot validate" << std::endl;
+            output.err << "Couldn't find FXC or DXC. Cannot validate" << std::endl;
             return false;
         }
         if (options.verbose) {
             if (fxc_found && !fxc_res.failed) {
-                std::cout << "Passed FXC validation" << std::endl;
-                std::cout << fxc_res.output;
-                std::cout << std::endl;
+                output.out << "Passed FXC validation" << std::endl;
+                output.out << fxc_res.output;
+                output.out << std::endl;
             }
             if (dxc_found && !dxc_res.failed) {
-                std::cout << "Passed DXC validation" << std::endl;
-                std::cout << dxc_res.output;
-                std::cout << std::endl;
+                output.out << "Passed DXC validation" << std::endl;
+                output.out << dxc_res.output;
+                output.out << std::endl;
             }
         }
     }
@@ -1083,7 +1288,8 @@ bool GenerateHlsl(const tint::Program& program, const Options& options) {
 #else
     (void)program;
     (void)options;
-    std::cerr << "HLSL writer not enabled in tint build\n";
+    (void)output;
+    output.err << "HLSL writer not enabled in tint build\n";
     return false;
 #endif  // TINT_BUILD_HLSL_WRITER
 }
@@ -1091,11 +1297,13 @@ bool GenerateHlsl(const tint::Program& program, const Options& options) {
 /// Generate GLSL code for a program.
 /// @param program the program to generate
 /// @param options the options that Tint was invoked with
+/// @param output the destination of the generated code
 /// @returns true on success
 bool GenerateGlsl([[maybe_unused]] const tint::Program& program,
-                  [[maybe_unused]] const Options& options) {
+                  [[maybe_unused]] const Options& options,
+                  [[maybe_unused]] const Output& output) {
 #if !TINT_BUILD_GLSL_WRITER
-    std::cerr << "GLSL writer not enabled in tint build" << std::endl;
+    output.err << "GLSL writer not enabled in tint build" << std::endl;
     return false;
 #else
     tint::inspector::Inspector inspector(program);
@@ -1139,32 +1347,37 @@ bool GenerateGlsl([[maybe_unused]] const tint::Program& program,
             offset += 8;
         }
 
-        auto result = tint::glsl::writer::Generate(prg, gen_options, entry_point_name);
+        auto result = TimePhase(output, "generate", [&] {
+            return tint::glsl::writer::Generate(prg, gen_options, entry_point_name);
+        });
         if (result != tint::Success) {
-            tint::cmd::PrintWGSL(std::cerr, prg);
-            std::cerr << "Failed to generate: " << result.Failure() << "\n";
+            tint::cmd::PrintWGSL(output.err, prg);
+            output.err << "Failed to generate: " << result.Failure() << "\n";
             return false;
         }
 
-        if (!WriteFile(options.output_file, "w", result->glsl)) {
+        AddPassTimings(output, result->pass_timings);
+
+        if (!TimePhase(output, "write", [&] { return WriteFile(output, "w", result->glsl); })) {
             return false;
         }
 
         const auto hash = tint::CRC32(result->glsl.c_str());
         if (options.print_hash) {
-            PrintHash(hash);
+            PrintHash(output.out, hash);
         }
 
         if (options.validate && options.skip_hash.count(hash) == 0) {
 #if !TINT_BUILD_GLSL_VALIDATOR
-            std::cerr << "GLSL validator not enabled in tint build" << std::endl;
+            output.err << "GLSL validator not enabled in tint build" << std::endl;
             return false;
 #else
             // If there is no entry point name there is nothing to validate
             if (entry_point_name != "") {
+                PhaseTimer timer(output, "validate");
                 auto val = tint::glsl::validate::Validate(result->glsl, stage);
                 if (val != tint::Success) {
-                    std::cerr << val.Failure();
+                    output.err << val.Failure();
                     return false;
                 }
             }
@@ -1199,36 +1412,117 @@ bool GenerateGlsl([[maybe_unused]] const tint::Program& program,
 #endif  // TINT_BUILD_GLSL_WRITER
 }
 
-}  // namespace
+/// Generate code for a program in the output format.
+/// @param program the program to generate
+/// @param options the options that Tint was invoked with
+/// @param output the destination of the generated code
+/// @returns true on success
+bool Generate(const tint::Program& program, const Options& options, const Output& output) {
+    switch (options.format) {
+        case Format::kSpirv:
+        case Format::kSpvAsm:
+            return GenerateSpirv(program, options, output);
+        case Format::kWgsl:
+            return GenerateWgsl(program, options, output);
+        case Format::kMsl:
+            return GenerateMsl(program, options, output);
+        case Format::kHlsl:
+            return GenerateHlsl(program, options, output);
+        case Format::kGlsl:
+            return GenerateGlsl(program, options, output);
+        case Format::kNone:
+            break;
+        default:
+            output.err << "Unknown output format specified\n";
+            break;
+    }
+    return false;
+}
 
-int main(int argc, const char** argv) {
-    tint::Vector<std::string_view, 8> arguments;
-    for (int i = 1; i < argc; i++) {
-        std::string_view arg(argv[i]);
-        if (!arg.empty()) {
-            arguments.Push(argv[i]);
-        }
+/// @param output_file the output file name
+/// @param entry_point the entry point name
+/// @returns the file name that @p entry_point is written to when generating several entry points.
+/// The entry point name is inserted before the extension of @p output_file, so that "out.spv"
+/// becomes "out.main.spv". Standard output is left unchanged.
+std::string EntryPointOutputFile(const std::string& output_file, std::string_view entry_point) {
+    if (output_file.empty() || output_file == "-") {
+        return output_file;
     }
+    auto dot = output_file.find_last_of('.');
+    auto separator = output_file.find_last_of("/\\");
+    if (dot == std::string::npos || (separator != std::string::npos && dot < separator)) {
+        return output_file + "." + std::string(entry_point);
+    }
+    return output_file.substr(0, dot) + "." + std::string(entry_point) + output_file.substr(dot);
+}
 
-    Options options;
+/// Generate code for each of the entry points in `options.entry_points`, separately.
+/// Up to `options.jobs` entry points are generated concurrently. The output and messages of each
+/// entry point are buffered, and printed in the order that the entry points were listed.
+/// @param program the program holding the entry points
+/// @param options the options that Tint was invoked with
+/// @param output the destination of the generated code. Each entry point is written to the output
+/// file name with the entry point name inserted.
+/// @returns true if all the entry points were generated successfully
+bool GenerateEntryPoints(const tint::Program& program,
+                         const Options& options,
+                         const Output& output) {
+    struct EntryPointResult {
+        std::stringstream out;
+        std::stringstream err;
+        std::vector<PhaseTiming> timings;
+        bool success = false;
+    };
+    std::vector<EntryPointResult> results(options.entry_points.Length());
+
+    tint::wgsl::ForEachEntryPoint(
+        program, options.entry_points, options.jobs, [&](size_t index, tint::Program&& ep) {
+            auto& result = results[index];
+            if (!ep.IsValid()) {
+                tint::cmd::PrintWGSL(result.err, ep);
+                result.err << ep.Diagnostics() << "\n";
+                return;
+            }
+            Output ep_output{EntryPointOutputFile(output.file, options.entry_points[index]),
+                             result.out, result.err,
+                             output.timings ? &result.timings : nullptr};
+            result.success = Generate(ep, options, ep_output);
+        });
 
-    tint::Initialize();
-    tint::SetInternalCompilerErrorReporter(&tint::cmd::TintInternalCompilerErrorReporter);
+    bool success = true;
+    for (auto& result : results) {
+        output.out << result.out.str();
+        output.err << result.err.str();
+        if (output.timings) {
+            output.timings->insert(output.timings->end(), result.timings.begin(),
+                                   result.timings.end());
+        }
+        success &= result.success;
+    }
+    return success;
+}
 
-    struct TransformFactory {
-        const char* name;
-        /// Build and adds the transform to the transform manager.
-        /// Parameters:
-        ///   inspector - an inspector created from the parsed program
-        ///   manager   - the transform manager. Add transforms to this.
-        ///   inputs    - the input data to the transform manager. Add inputs to this.
-        /// Returns true on success, false on error (program will immediately exit)
-        std::function<bool(tint::inspector::Inspector& inspector,
-                           tint::ast::transform::Manager& manager,
-                           tint::ast::transform::DataMap& inputs)>
-            make;
-    };
-    std::vector<TransformFactory> transforms = {
+/// A transform that can be enabled with `--transform`
+struct TransformFactory {
+    /// The name of the transform
+    const char* name;
+    /// Build and adds the transform to the transform manager.
+    /// Parameters:
+    ///   inspector - an inspector created from the parsed program
+    ///   manager   - the transform manager. Add transforms to this.
+    ///   inputs    - the input data to the transform manager. Add inputs to this.
+    /// Returns true on success, false on error (the shader is not generated)
+    std::function<bool(tint::inspector::Inspector& inspector,
+                       tint::ast::transform::Manager& manager,
+                       tint::ast::transform::DataMap& inputs)>
+        make;
+};
+
+/// @param options the options that Tint was invoked with
+/// @param err the stream for errors
+/// @returns the transforms that can be enabled with `--transform`
+std::vector<TransformFactory> TransformFactories(Options& options, std::ostream& err) {
+    return {
         {"first_index_offset",
          [](tint::inspector::Inspector&, tint::ast::transform::Manager& m,
             tint::ast::transform::DataMap& i) {
@@ -1243,14 +1537,14 @@ int main(int argc, const char** argv) {
              return true;
          }},
         {"robustness",
-         [&](tint::inspector::Inspector&, tint::ast::transform::Manager&,
-             tint::ast::transform::DataMap&) {  // enabled via writer option
+         [&options](tint::inspector::Inspector&, tint::ast::transform::Manager&,
+                    tint::ast::transform::DataMap&) {  // enabled via writer option
              options.enable_robustness = true;
              return true;
          }},
         {"substitute_override",
-         [&](tint::inspector::Inspector& inspector, tint::ast::transform::Manager& m,
-             tint::ast::transform::DataMap& i) {
+         [&options, &err](tint::inspector::Inspector& inspector,
+                          tint::ast::transform::Manager& m, tint::ast::transform::DataMap& i) {
              tint::ast::transform::SubstituteOverride::Config cfg;
 
              std::unordered_map<tint::OverrideId, double> values;
@@ -1260,7 +1554,7 @@ int main(int argc, const char** argv) {
                  const auto& name = override.key.Value();
                  const auto& value = override.value;
                  if (name.empty()) {
-                     std::cerr << "empty override name\n";
+                     err << "empty override name\n";
                      return false;
                  }
                  if (auto num = tint::strconv::ParseNumber<decltype(tint::OverrideId::value)>(name);
@@ -1271,7 +1565,7 @@ int main(int argc, const char** argv) {
                      auto override_names = inspector.GetNamedOverrideIds();
                      auto it = override_names.find(name);
                      if (it == override_names.end()) {
-                         std::cerr << "unknown override '" << name << "'\n";
+                         err << "unknown override '" << name << "'\n";
                          return false;
                      }
                      values.emplace(it->second, value);
@@ -1285,19 +1579,21 @@ int main(int argc, const char** argv) {
              return true;
          }},
     };
-    auto transform_names = [&] {
-        tint::StringStream names;
-        for (auto& t : transforms) {
-            names << "   " << t.name << "\n";
-        }
-        return names.str();
-    };
+}
 
-    if (!ParseArgs(arguments, transform_names(), &options)) {
-        return 1;
+/// @param transforms the transforms that can be enabled with `--transform`
+/// @returns the names of @p transforms, one per line
+std::string TransformNames(const std::vector<TransformFactory>& transforms) {
+    tint::StringStream names;
+    for (auto& t : transforms) {
+        names << "   " << t.name << "\n";
     }
+    return names.str();
+}
 
-    // Implement output format defaults.
+/// Implements the output format defaults, if no format was specified.
+/// @param options the options that Tint was invoked with
+void ApplyFormatDefaults(Options& options) {
     if (options.format == Format::kUnknown) {
         // Try inferring from filename.
         options.format = InferFormat(options.output_file);
@@ -1306,52 +1602,16 @@ int main(int argc, const char** argv) {
         // Ultimately, default to SPIR-V assembly. That's nice for interactive use.
         options.format = Format::kSpvAsm;
     }
+}
 
-    tint::cmd::LoadProgramOptions opts;
-    opts.filename = options.input_filename;
-    opts.printer = options.printer.get();
-#if TINT_BUILD_SPV_READER
-    opts.use_ir = options.use_ir_reader;
-    opts.spirv_reader_options = options.spirv_reader_options;
-#endif
-
-    auto info = tint::cmd::LoadProgramInfo(opts);
-
-    if (options.parse_only) {
-        return 1;
-    }
-
-#if TINT_BUILD_SYNTAX_TREE_WRITER
-    if (options.dump_ast) {
-        tint::wgsl::writer::Options gen_options;
-        gen_options.use_syntax_tree_writer = true;
-        auto result = tint::wgsl::writer::Generate(info.program, gen_options);
-        if (result != tint::Success) {
-            std::cerr << "Failed to dump AST: " << result.Failure() << "\n";
-        } else {
-            std::cout << result->wgsl << "\n";
-        }
-    }
-#endif  // TINT_BUILD_SYNTAX_TREE_WRITER
-
-#if TINT_BUILD_WGSL_READER
-    if (options.dump_ir) {
-        auto result = tint::wgsl::reader::ProgramToLoweredIR(info.program);
-        if (result != tint::Success) {
-            std::cerr << "Failed to build IR from program: " << result.Failure() << "\n";
-        } else {
-            auto mod = result.Move();
-            if (options.dump_ir) {
-                std::cout << tint::core::ir::Disassemble(mod) << "\n";
-            }
-        }
-    }
-#endif  // TINT_BUILD_WGSL_READER
-
-    tint::inspector::Inspector inspector(info.program);
-    if (options.dump_inspector_bindings) {
-        tint::cmd::PrintInspectorBindings(inspector);
-    }
+/// Runs the transforms selected by `options` on the program, then generates code for it.
+/// @param input the program to compile
+/// @param options the options that Tint was invoked with
+/// @param output the destination of the generated code
+/// @returns true on success
+bool Compile(const tint::Program& input, Options& options, const Output& output) {
+    auto transforms = TransformFactories(options, output.err);
+    tint::inspector::Inspector inspector(input);
 
     tint::ast::transform::Manager transform_manager;
     tint::ast::transform::DataMap transform_inputs;
@@ -1403,15 +1663,15 @@ int main(int argc, const char** argv) {
             }
         }
 
-        std::cerr << "Unknown transform: " << name << "\n";
-        std::cerr << "Available transforms: \n" << transform_names() << "\n";
+        output.err << "Unknown transform: " << name << "\n";
+        output.err << "Available transforms: \n" << TransformNames(transforms) << "\n";
         return false;
     };
 
     // If overrides are provided, add the SubstituteOverride transform.
     if (!options.overrides.IsEmpty()) {
         if (!enable_transform("substitute_override")) {
-            return 1;
+            return false;
         }
     }
 
@@ -1420,48 +1680,413 @@ int main(int argc, const char** argv) {
         // be run that needs user input. Should we find a way to support that here
         // maybe through a provided file?
         if (!enable_transform(name)) {
-            return 1;
+            return false;
         }
     }
 
-    if (options.emit_single_entry_point) {
+    if (options.entry_points.Length() == 1) {
         transform_manager.append(std::make_unique<tint::ast::transform::SingleEntryPoint>());
-        transform_inputs.Add<tint::ast::transform::SingleEntryPoint::Config>(options.ep_name);
+        transform_inputs.Add<tint::ast::transform::SingleEntryPoint::Config>(
+            options.entry_points[0]);
     }
 
     tint::ast::transform::DataMap outputs;
-    auto program = transform_manager.Run(info.program, std::move(transform_inputs), outputs);
+    std::vector<tint::ast::transform::TransformTiming> transform_timings;
+    auto program = transform_manager.Run(input, std::move(transform_inputs), outputs,
+                                         output.timings ? &transform_timings : nullptr);
+    for (auto& timing : transform_timings) {
+        output.timings->push_back(
+            PhaseTiming{"transform", std::move(timing.name), timing.duration});
+    }
     if (!program.IsValid()) {
-        tint::cmd::PrintWGSL(std::cerr, program);
-        std::cerr << program.Diagnostics() << "\n";
-        return 1;
+        tint::cmd::PrintWGSL(output.err, program);
+        output.err << program.Diagnostics() << "\n";
+        return false;
+    }
+
+    if (options.entry_points.Length() > 1) {
+        return GenerateEntryPoints(program, options, output);
     }
+    return Generate(program, options, output);
+}
 
+/// A shader listed in a `--batch` manifest
+struct BatchShader {
+    /// The manifest line that lists the shader
+    size_t line = 0;
+    /// The options of the shader
+    Options options;
+    /// The buffered output of generating the shader
+    std::stringstream out;
+    /// The buffered errors and diagnostics of generating the shader
+    std::stringstream err;
+    /// The time taken by each phase of generating the shader
+    std::vector<PhaseTiming> timings;
+    /// The total time taken to generate the shader
+    std::chrono::nanoseconds duration{};
+    /// True if the shader was generated successfully
     bool success = false;
-    switch (options.format) {
+};
+
+/// Reads, parses and resolves the WGSL input file of @p shader, then compiles it.
+/// Unlike tint::cmd::LoadProgramInfo(), a shader that cannot be loaded writes its errors to the
+/// buffered error stream of the shader instead of exiting, so that the rest of the batch still
+/// runs.
+/// @param shader the shader to compile
+/// @returns true on success
+bool CompileBatchShader(BatchShader& shader) {
+    auto& options = shader.options;
+    Output output{options.output_file, shader.out, shader.err, &shader.timings};
+
+#if TINT_BUILD_WGSL_READER
+    if (!tint::HasSuffix(options.input_filename, ".wgsl")) {
+        output.err << "Only WGSL input files can be used with --batch: " << options.input_filename
+                   << "\n";
+        return false;
+    }
+
+    std::string source;
+    bool read = TimePhase(output, "read", [&] {
+        std::ifstream file(options.input_filename, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        source.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return !file.bad();
+    });
+    if (!read) {
+        output.err << "Failed to read " << options.input_filename << "\n";
+        return false;
+    }
+
+    auto file = std::make_unique<tint::Source::File>(options.input_filename, std::move(source));
+    tint::wgsl::reader::Parser parser(file.get());
+    TimePhase(output, "parse", [&] { return parser.Parse(); });
+    auto program = TimePhase(output, "resolve", [&] {
+        return tint::resolver::Resolve(parser.builder(), tint::wgsl::AllowedFeatures::Everything());
+    });
+
+    if (program.Diagnostics().Count() > 0) {
+        output.err << program.Diagnostics() << "\n";
+    }
+    if (!program.IsValid()) {
+        return false;
+    }
+    if (options.parse_only) {
+        return true;
+    }
+
+    return Compile(program, options, output);
+#else
+    output.err << "Tint not built with the WGSL reader enabled\n";
+    return false;
+#endif  // TINT_BUILD_WGSL_READER
+}
+
+/// @returns the name of the output format @p format
+std::string_view FormatName(Format format) {
+    switch (format) {
+        case Format::kUnknown:
+            break;
+        case Format::kNone:
+            return "none";
         case Format::kSpirv:
+            return "spirv";
         case Format::kSpvAsm:
-            success = GenerateSpirv(program, options);
-            break;
+            return "spvasm";
         case Format::kWgsl:
-            success = GenerateWgsl(program, options);
-            break;
+            return "wgsl";
         case Format::kMsl:
-            success = GenerateMsl(program, options);
-            break;
+            return "msl";
         case Format::kHlsl:
-            success = GenerateHlsl(program, options);
-            break;
+            return "hlsl";
         case Format::kGlsl:
-            success = GenerateGlsl(program, options);
-            break;
-        case Format::kNone:
-            break;
-        default:
-            std::cerr << "Unknown output format specified\n";
-            return 1;
+            return "glsl";
+    }
+    return "unknown";
+}
+
+/// Writes @p str to @p out as a quoted JSON string.
+void PrintJsonString(std::ostream& out, std::string_view str) {
+    out << '"';
+    for (char c : str) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\r':
+                out << "\\r";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                        << static_cast<int>(c) << std::dec << std::setfill(' ');
+                } else {
+                    out << c;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+/// @returns @p duration in milliseconds
+double Milliseconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/// Writes the time taken by each phase of generating the shaders of a batch, as JSON.
+/// @param out the stream to write to
+/// @param options the options that Tint was invoked with
+/// @param shaders the shaders of the batch
+/// @param duration the total time taken to generate the batch
+void PrintBatchTimings(std::ostream& out,
+                       const Options& options,
+                       const std::vector<std::unique_ptr<BatchShader>>& shaders,
+                       std::chrono::nanoseconds duration) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\n";
+    out << "  \"manifest\": ";
+    PrintJsonString(out, options.batch_manifest);
+    out << ",\n";
+    out << "  \"jobs\": " << options.jobs << ",\n";
+    out << "  \"duration_ms\": " << Milliseconds(duration) << ",\n";
+    out << "  \"shaders\": [";
+    for (size_t i = 0; i < shaders.size(); i++) {
+        auto& shader = *shaders[i];
+        out << (i > 0 ? "," : "") << "\n    {\n";
+        out << "      \"line\": " << shader.line << ",\n";
+        out << "      \"input\": ";
+        PrintJsonString(out, shader.options.input_filename);
+        out << ",\n";
+        out << "      \"output\": ";
+        PrintJsonString(out, shader.options.output_file);
+        out << ",\n";
+        out << "      \"format\": ";
+        PrintJsonString(out, FormatName(shader.options.format));
+        out << ",\n";
+        out << "      \"success\": " << (shader.success ? "true" : "false") << ",\n";
+        out << "      \"duration_ms\": " << Milliseconds(shader.duration) << ",\n";
+        out << "      \"phases\": [";
+        for (size_t p = 0; p < shader.timings.size(); p++) {
+            auto& timing = shader.timings[p];
+            out << (p > 0 ? "," : "") << "\n        {\"phase\": ";
+            PrintJsonString(out, timing.phase);
+            if (!timing.name.empty()) {
+                out << ", \"name\": ";
+                PrintJsonString(out, timing.name);
+            }
+            out << ", \"duration_ms\": " << Milliseconds(timing.duration) << "}";
+        }
+        out << (shader.timings.empty() ? "]\n" : "\n      ]\n");
+        out << "    }";
+    }
+    out << (shaders.empty() ? "]\n" : "\n  ]\n");
+    out << "}\n";
+}
+
+/// @returns true if @p c separates the arguments of a `--batch` manifest line
+bool IsManifestSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/// Splits a line of a `--batch` manifest into its arguments. The arguments are separated by
+/// whitespace, except for the whitespace between double quotes, so that `"my shader.wgsl"` is a
+/// single argument. A backslash escapes a quote or a backslash that follows it.
+/// @param line the manifest line
+/// @returns the arguments of the line, or std::nullopt if a quote is not closed
+std::optional<std::vector<std::string>> SplitManifestLine(std::string_view line) {
+    std::vector<std::string> fields;
+    std::string field;
+    bool in_field = false;
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        char c = line[i];
+        if (!quoted && IsManifestSpace(c)) {
+            if (in_field) {
+                fields.push_back(std::move(field));
+                field.clear();
+                in_field = false;
+            }
+            continue;
+        }
+        in_field = true;
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (c == '\\' && i + 1 < line.size() &&
+                   (line[i + 1] == '"' || line[i + 1] == '\\')) {
+            field += line[++i];
+        } else {
+            field += c;
+        }
+    }
+    if (quoted) {
+        return std::nullopt;
+    }
+    if (in_field) {
+        fields.push_back(std::move(field));
+    }
+    return fields;
+}
+
+/// Generates each of the shaders listed in the `options.batch_manifest` file, in a single process.
+/// Up to `options.jobs` shaders are generated concurrently. The output and messages of each shader
+/// are buffered, and printed in the order that the shaders were listed.
+/// @param options the options that Tint was invoked with
+/// @param transform_names the names of the transforms that can be enabled with `--transform`
+/// @returns true if all the shaders were generated successfully
+bool GenerateBatch(const Options& options, const std::string& transform_names) {
+    std::ifstream manifest(options.batch_manifest);
+    if (!manifest) {
+        std::cerr << "Failed to open " << options.batch_manifest << "\n";
+        return false;
+    }
+
+    std::vector<std::unique_ptr<BatchShader>> shaders;
+    std::string line;
+    for (size_t line_number = 1; std::getline(manifest, line); line_number++) {
+        auto trimmed = tint::TrimLeft(line, IsManifestSpace);
+        if (trimmed.empty() || trimmed[0] == '#') {
+            continue;
+        }
+        auto fields = SplitManifestLine(trimmed);
+        if (!fields) {
+            std::cerr << options.batch_manifest << ":" << line_number << ": unterminated quote\n";
+            return false;
+        }
+        tint::Vector<std::string_view, 8> arguments;
+        for (auto& field : *fields) {
+            arguments.Push(field);
+        }
+
+        auto shader = std::make_unique<BatchShader>();
+        shader->line = line_number;
+        if (!ParseArgs(arguments, transform_names, &shader->options)) {
+            std::cerr << options.batch_manifest << ":" << line_number << ": invalid options\n";
+            return false;
+        }
+        if (shader->options.input_filename.empty()) {
+            std::cerr << options.batch_manifest << ":" << line_number << ": no input file\n";
+            return false;
+        }
+        ApplyFormatDefaults(shader->options);
+        shaders.push_back(std::move(shader));
     }
-    if (!success) {
+
+    auto start = std::chrono::steady_clock::now();
+    tint::ThreadPool pool(std::min<size_t>(options.jobs, shaders.size()));
+    pool.ParallelFor(shaders.size(), [&](size_t index, size_t) {
+        auto& shader = *shaders[index];
+        auto shader_start = std::chrono::steady_clock::now();
+        shader.success = CompileBatchShader(shader);
+        shader.duration = std::chrono::steady_clock::now() - shader_start;
+    });
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    bool success = true;
+    for (auto& shader : shaders) {
+        std::cout << shader->out.str();
+        std::cerr << shader->err.str();
+        success &= shader->success;
+    }
+
+    if (options.timings_json == "-") {
+        PrintBatchTimings(std::cout, options, shaders, duration);
+    } else if (!options.timings_json.empty()) {
+        std::ofstream json(options.timings_json);
+        PrintBatchTimings(json, options, shaders, duration);
+        if (!json) {
+            std::cerr << "Could not write to file " << options.timings_json << "\n";
+            return false;
+        }
+    }
+
+    return success;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+    tint::Vector<std::string_view, 8> arguments;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg(argv[i]);
+        if (!arg.empty()) {
+            arguments.Push(argv[i]);
+        }
+    }
+
+    Options options;
+
+    tint::Initialize();
+    tint::SetInternalCompilerErrorReporter(&tint::cmd::TintInternalCompilerErrorReporter);
+
+    auto transform_names = TransformNames(TransformFactories(options, std::cerr));
+    if (!ParseArgs(arguments, transform_names, &options)) {
+        return 1;
+    }
+
+    if (!options.batch_manifest.empty()) {
+        return GenerateBatch(options, transform_names) ? 0 : 1;
+    }
+
+    ApplyFormatDefaults(options);
+
+    tint::cmd::LoadProgramOptions opts;
+    opts.filename = options.input_filename;
+    opts.printer = options.printer.get();
+#if TINT_BUILD_SPV_READER
+    opts.use_ir = options.use_ir_reader;
+    opts.spirv_reader_options = options.spirv_reader_options;
+#endif
+
+    auto info = tint::cmd::LoadProgramInfo(opts);
+
+    if (options.parse_only) {
+        return 1;
+    }
+
+#if TINT_BUILD_SYNTAX_TREE_WRITER
+    if (options.dump_ast) {
+        tint::wgsl::writer::Options gen_options;
+        gen_options.use_syntax_tree_writer = true;
+        auto result = tint::wgsl::writer::Generate(info.program, gen_options);
+        if (result != tint::Success) {
+            std::cerr << "Failed to dump AST: " << result.Failure() << "\n";
+        } else {
+            std::cout << result->wgsl << "\n";
+        }
+    }
+#endif  // TINT_BUILD_SYNTAX_TREE_WRITER
+
+#if TINT_BUILD_WGSL_READER
+    if (options.dump_ir) {
+        auto result = tint::wgsl::reader::ProgramToLoweredIR(info.program);
+        if (result != tint::Success) {
+            std::cerr << "Failed to build IR from program: " << result.Failure() << "\n";
+        } else {
+            auto mod = result.Move();
+            if (options.dump_ir) {
+                std::cout << tint::core::ir::Disassemble(mod) << "\n";
+            }
+        }
+    }
+#endif  // TINT_BUILD_WGSL_READER
+
+    if (options.dump_inspector_bindings) {
+        tint::inspector::Inspector inspector(info.program);
+        tint::cmd::PrintInspectorBindings(inspector);
+    }
+
+    if (!Compile(info.program, options, Output{options.output_file, std::cout, std::cerr})) {
         return 1;
     }
 
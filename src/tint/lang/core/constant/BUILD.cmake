@@ -70,6 +70,7 @@ tint_target_add_dependencies(tint_lang_core_constant lib
   tint_utils_result
   tint_utils_rtti
   tint_utils_symbol
+  tint_utils_system
   tint_utils_text
   tint_utils_traits
 )
@@ -125,6 +126,7 @@ tint_target_add_dependencies(tint_lang_core_constant_test test
   tint_utils_result
   tint_utils_rtti
   tint_utils_symbol
+  tint_utils_system
   tint_utils_text
   tint_utils_traits
 )
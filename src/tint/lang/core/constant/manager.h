@@ -35,6 +35,7 @@
 #include "src/tint/lang/core/type/manager.h"
 #include "src/tint/utils/containers/unique_allocator.h"
 #include "src/tint/utils/math/hash.h"
+#include "src/tint/utils/system/optional_mutex.h"
 
 namespace tint::core::constant {
 class Splat;
@@ -80,12 +81,19 @@ class Manager final {
         return out;
     }
 
+    /// Enables or disables locking of the manager, so that constants can be created concurrently
+    /// from multiple threads while enabled.
+    /// @note this does not change the thread safety of #types.
+    /// @param thread_safe true to enable locking
+    void SetThreadSafe(bool thread_safe) { mutex_.SetEnabled(thread_safe); }
+
     /// @param args the arguments used to construct the type, unique node or node.
     /// @return a pointer to an instance of `T` with the provided arguments.
     ///         If NODE derives from UniqueNode and an existing instance of `T` has been
     ///         constructed, then the same pointer is returned.
     template <typename NODE, typename... ARGS>
     NODE* Get(ARGS&&... args) {
+        auto lock = mutex_.Lock();
         return values_.Get<NODE>(std::forward<ARGS>(args)...);
     }
 
@@ -170,6 +178,8 @@ class Manager final {
 
     /// Unique types owned by the manager
     UniqueAllocator<Value, Hasher, Equal> values_;
+    /// Guards #values_ while the manager is thread safe
+    OptionalMutex mutex_;
 };
 
 }  // namespace tint::core::constant
@@ -39,6 +39,7 @@
 #include "src/tint/lang/core/intrinsic/table_data.h"
 #include "src/tint/lang/core/parameter_usage.h"
 #include "src/tint/lang/core/unary_op.h"
+#include "src/tint/utils/containers/hashmap.h"
 #include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/text/string.h"
 #include "src/tint/utils/text/string_stream.h"
@@ -225,7 +226,47 @@ Result<Overload, StyledText> LookupCtorConv(Context& context,
                                             VectorRef<const core::type::Type*> args,
                                             EvaluationStage earliest_eval_stage);
 
+/// OverloadCacheKey is the key of the cache of resolved overloads held by a Table.
+/// Types are uniquified by the type manager, so argument types are compared by pointer.
+struct OverloadCacheKey {
+    /// The kind of intrinsic being looked up
+    enum class Kind : uint8_t {
+        kBuiltinFn,
+        kUnaryOp,
+        kBinaryOp,
+        kCtorConv,
+    };
+
+    /// The kind of intrinsic being looked up
+    Kind kind;
+    /// The builtin function, operator, constructor or conversion identifier
+    uint32_t id;
+    /// The earliest evaluation stage of the call
+    EvaluationStage earliest_eval_stage;
+    /// The template arguments
+    Vector<const core::type::Type*, 1> template_args;
+    /// The argument types
+    Vector<const core::type::Type*, 4> args;
+
+    /// @returns the hash code of the key
+    tint::HashCode HashCode() const {
+        return Hash(kind, id, earliest_eval_stage, template_args, args);
+    }
+
+    /// Equality operator
+    /// @param other the key to compare against
+    /// @returns true if this key and @p other are the same
+    bool operator==(const OverloadCacheKey& other) const {
+        return kind == other.kind && id == other.id &&
+               earliest_eval_stage == other.earliest_eval_stage &&
+               template_args == other.template_args && args == other.args;
+    }
+};
+
 /// Table is a wrapper around a dialect to provide type-safe interface to the intrinsic table.
+/// Successful lookups are cached by the Table, so that looking up the same intrinsic with the same
+/// argument types again skips overload resolution. As the cache is not synchronized, a Table must
+/// only be used by a single thread at a time.
 template <typename DIALECT>
 struct Table {
     /// Alias to DIALECT::BuiltinFn
@@ -258,10 +299,15 @@ struct Table {
                                         VectorRef<const core::type::Type*> template_args,
                                         VectorRef<const core::type::Type*> args,
                                         EvaluationStage earliest_eval_stage) {
-        std::string_view name = DIALECT::ToString(builtin_fn);
-        size_t id = static_cast<size_t>(builtin_fn);
-        return LookupFn(context, name, id, std::move(template_args), std::move(args),
-                        earliest_eval_stage);
+        OverloadCacheKey key{OverloadCacheKey::Kind::kBuiltinFn,
+                             static_cast<uint32_t>(builtin_fn), earliest_eval_stage,
+                             template_args, args};
+        return Cached(std::move(key), [&] {
+            std::string_view name = DIALECT::ToString(builtin_fn);
+            size_t id = static_cast<size_t>(builtin_fn);
+            return LookupFn(context, name, id, std::move(template_args), std::move(args),
+                            earliest_eval_stage);
+        });
     }
 
     /// Lookup looks for the unary op overload with the given signature, raising an error
@@ -279,7 +325,10 @@ struct Table {
     Result<Overload, StyledText> Lookup(core::UnaryOp op,
                                         const core::type::Type* arg,
                                         EvaluationStage earliest_eval_stage) {
-        return LookupUnary(context, op, arg, earliest_eval_stage);
+        OverloadCacheKey key{OverloadCacheKey::Kind::kUnaryOp, static_cast<uint32_t>(op),
+                             earliest_eval_stage, Empty, Vector{arg}};
+        return Cached(std::move(key),
+                      [&] { return LookupUnary(context, op, arg, earliest_eval_stage); });
     }
 
     /// Lookup looks for the binary op overload with the given signature, raising an error
@@ -301,7 +350,12 @@ struct Table {
                                         const core::type::Type* rhs,
                                         EvaluationStage earliest_eval_stage,
                                         bool is_compound) {
-        return LookupBinary(context, op, lhs, rhs, earliest_eval_stage, is_compound);
+        // is_compound only changes the diagnostics of a failed lookup, which are not cached.
+        OverloadCacheKey key{OverloadCacheKey::Kind::kBinaryOp, static_cast<uint32_t>(op),
+                             earliest_eval_stage, Empty, Vector{lhs, rhs}};
+        return Cached(std::move(key), [&] {
+            return LookupBinary(context, op, lhs, rhs, earliest_eval_stage, is_compound);
+        });
     }
 
     /// Lookup looks for the value constructor or conversion overload for the given CtorConv.
@@ -319,14 +373,38 @@ struct Table {
                                         VectorRef<const core::type::Type*> template_args,
                                         VectorRef<const core::type::Type*> args,
                                         EvaluationStage earliest_eval_stage) {
-        std::string_view name = DIALECT::ToString(type);
-        size_t id = static_cast<size_t>(type);
-        return LookupCtorConv(context, name, id, std::move(template_args), std::move(args),
-                              earliest_eval_stage);
+        OverloadCacheKey key{OverloadCacheKey::Kind::kCtorConv, static_cast<uint32_t>(type),
+                             earliest_eval_stage, template_args, args};
+        return Cached(std::move(key), [&] {
+            std::string_view name = DIALECT::ToString(type);
+            size_t id = static_cast<size_t>(type);
+            return LookupCtorConv(context, name, id, std::move(template_args), std::move(args),
+                                  earliest_eval_stage);
+        });
     }
 
     /// The intrinsic context
     Context context;
+
+  private:
+    /// @returns the cached overload for @p key, or the result of calling @p lookup if there is no
+    /// cached overload. Successful results of @p lookup are added to the cache.
+    /// @param key the cache key
+    /// @param lookup the function that performs the lookup on a cache miss
+    template <typename LOOKUP>
+    Result<Overload, StyledText> Cached(OverloadCacheKey&& key, LOOKUP&& lookup) {
+        if (auto cached = cache_.Get(key)) {
+            return *cached;
+        }
+        auto result = lookup();
+        if (result == Success) {
+            cache_.Add(std::move(key), result.Get());
+        }
+        return result;
+    }
+
+    /// The cache of successfully resolved overloads
+    Hashmap<OverloadCacheKey, Overload, 32> cache_;
 };
 
 }  // namespace tint::core::intrinsic
@@ -953,5 +953,27 @@ TEST_F(CoreIntrinsicTableTest, Err257Arguments) {  // crbug.com/1323605
     ASSERT_THAT(result.Failure().Plain(), HasSubstr("no matching call"));
 }
 
+TEST_F(CoreIntrinsicTableTest, CachedLookup) {
+    auto* f32 = create<type::F32>();
+    auto first = table.Lookup(BuiltinFn::kCos, Empty, Vector{f32}, EvaluationStage::kConstant);
+    auto second = table.Lookup(BuiltinFn::kCos, Empty, Vector{f32}, EvaluationStage::kConstant);
+    ASSERT_EQ(first, Success);
+    ASSERT_EQ(second, Success);
+    EXPECT_EQ(first.Get(), second.Get());
+}
+
+TEST_F(CoreIntrinsicTableTest, CachedLookup_MismatchCompoundOp) {
+    auto* f32 = create<type::F32>();
+    auto* bool_ = create<type::Bool>();
+    auto binary = table.Lookup(BinaryOp::kMultiply, f32, bool_, EvaluationStage::kConstant,
+                               /* is_compound */ false);
+    auto compound = table.Lookup(BinaryOp::kMultiply, f32, bool_, EvaluationStage::kConstant,
+                                 /* is_compound */ true);
+    ASSERT_NE(binary, Success);
+    ASSERT_NE(compound, Success);
+    EXPECT_THAT(binary.Failure().Plain(), HasSubstr("'operator * (f32, bool)'"));
+    EXPECT_THAT(compound.Failure().Plain(), HasSubstr("'operator *= (f32, bool)'"));
+}
+
 }  // namespace
 }  // namespace tint::core::intrinsic
@@ -0,0 +1,406 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/analysis/integer_range_analysis.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "src/tint/lang/core/ir/access.h"
+#include "src/tint/lang/core/ir/constant.h"
+#include "src/tint/lang/core/ir/convert.h"
+#include "src/tint/lang/core/ir/core_binary.h"
+#include "src/tint/lang/core/ir/core_builtin_call.h"
+#include "src/tint/lang/core/ir/exit_if.h"
+#include "src/tint/lang/core/ir/exit_loop.h"
+#include "src/tint/lang/core/ir/function.h"
+#include "src/tint/lang/core/ir/function_param.h"
+#include "src/tint/lang/core/ir/if.h"
+#include "src/tint/lang/core/ir/let.h"
+#include "src/tint/lang/core/ir/load.h"
+#include "src/tint/lang/core/ir/loop.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/multi_in_block.h"
+#include "src/tint/lang/core/ir/store.h"
+#include "src/tint/lang/core/ir/var.h"
+#include "src/tint/lang/core/number.h"
+#include "src/tint/lang/core/type/i32.h"
+#include "src/tint/lang/core/type/pointer.h"
+#include "src/tint/lang/core/type/u32.h"
+#include "src/tint/utils/rtti/switch.h"
+
+namespace tint::core::ir::analysis {
+
+namespace {
+
+/// @returns the range of the values in [@p min, @p max], or @p type_range if either bound
+/// overflowed or is outside of @p type_range
+/// @param min the smallest value, if it did not overflow
+/// @param max the largest value, if it did not overflow
+/// @param type_range the range of the type of the value
+IntegerRange Fit(std::optional<AInt> min, std::optional<AInt> max, IntegerRange type_range) {
+    if (!min || !max || min->value < type_range.min || max->value > type_range.max) {
+        return type_range;
+    }
+    return IntegerRange{min->value, max->value};
+}
+
+/// @returns the range of the values of `min(a, b)` for `a` in @p a and `b` in @p b
+/// @param a the range of the first operand
+/// @param b the range of the second operand
+IntegerRange Min(IntegerRange a, IntegerRange b) {
+    return IntegerRange{std::min(a.min, b.min), std::min(a.max, b.max)};
+}
+
+/// @returns the range of the values of `max(a, b)` for `a` in @p a and `b` in @p b
+/// @param a the range of the first operand
+/// @param b the range of the second operand
+IntegerRange Max(IntegerRange a, IntegerRange b) {
+    return IntegerRange{std::max(a.min, b.min), std::max(a.max, b.max)};
+}
+
+}  // namespace
+
+IntegerRangeAnalysis::IntegerRangeAnalysis(Module& ir) : ir_(ir) {
+    for (auto& func : ir_.functions) {
+        if (func->Stage() == Function::PipelineStage::kCompute) {
+            for (auto* param : func->Params()) {
+                param_functions_.Add(param, func);
+            }
+        }
+    }
+}
+
+IntegerRangeAnalysis::~IntegerRangeAnalysis() = default;
+
+IntegerRange IntegerRangeAnalysis::Get(Value* value) {
+    if (auto range = ranges_.Get(value)) {
+        return *range;
+    }
+    // A value that depends on itself has the range of its type.
+    ranges_.Add(value, TypeRange(value->Type()));
+    auto range = Compute(value);
+    ranges_.Replace(value, range);
+    return range;
+}
+
+IntegerRange IntegerRangeAnalysis::Compute(Value* value) {
+    auto type_range = TypeRange(value->Type());
+    if (!value->Type()->IsAnyOf<core::type::I32, core::type::U32>()) {
+        return type_range;
+    }
+
+    if (auto* constant = value->As<Constant>()) {
+        auto v = constant->Value()->ValueAs<int64_t>();
+        return IntegerRange{v, v};
+    }
+    if (auto* param = value->As<FunctionParam>()) {
+        return ComputeParam(param, 0);
+    }
+    auto* result = value->As<InstructionResult>();
+    if (!result) {
+        return type_range;
+    }
+
+    return tint::Switch(
+        result->Instruction(),  //
+        [&](Let* let) { return Get(let->Value()); },
+        [&](Load* load) { return ComputeLoad(load); },
+        [&](Access* access) {
+            // A component of the `local_invocation_id` builtin.
+            auto* param = access->Object()->As<FunctionParam>();
+            auto* index = access->Indices()[0]->As<Constant>();
+            if (param && index && access->Indices().Length() == 1) {
+                return ComputeParam(param, index->Value()->ValueAs<uint32_t>());
+            }
+            return type_range;
+        },
+        [&](Convert* convert) {
+            auto* arg = convert->Args()[0];
+            if (!arg->Type()->IsAnyOf<core::type::I32, core::type::U32>()) {
+                return type_range;
+            }
+            auto range = Get(arg);
+            return Fit(AInt(range.min), AInt(range.max), type_range);
+        },
+        [&](CoreBinary* binary) {
+            auto lhs = Get(binary->LHS());
+            auto rhs = Get(binary->RHS());
+            switch (binary->Op()) {
+                case BinaryOp::kAdd:
+                    return Fit(CheckedAdd(AInt(lhs.min), AInt(rhs.min)),
+                               CheckedAdd(AInt(lhs.max), AInt(rhs.max)), type_range);
+                case BinaryOp::kSubtract:
+                    return Fit(CheckedSub(AInt(lhs.min), AInt(rhs.max)),
+                               CheckedSub(AInt(lhs.max), AInt(rhs.min)), type_range);
+                case BinaryOp::kMultiply: {
+                    auto a = CheckedMul(AInt(lhs.min), AInt(rhs.min));
+                    auto b = CheckedMul(AInt(lhs.min), AInt(rhs.max));
+                    auto c = CheckedMul(AInt(lhs.max), AInt(rhs.min));
+                    auto d = CheckedMul(AInt(lhs.max), AInt(rhs.max));
+                    if (!a || !b || !c || !d) {
+                        return type_range;
+                    }
+                    return Fit(std::min({*a, *b, *c, *d}), std::max({*a, *b, *c, *d}),
+                               type_range);
+                }
+                case BinaryOp::kDivide:
+                    if (lhs.min >= 0 && rhs.min > 0) {
+                        return IntegerRange{lhs.min / rhs.max, lhs.max / rhs.min};
+                    }
+                    return type_range;
+                case BinaryOp::kModulo:
+                    if (lhs.min >= 0 && rhs.min > 0) {
+                        return IntegerRange{0, std::min(lhs.max, rhs.max - 1)};
+                    }
+                    return type_range;
+                case BinaryOp::kAnd:
+                    if (lhs.min >= 0 || rhs.min >= 0) {
+                        // The result is no larger than the non-negative operands.
+                        int64_t max = std::numeric_limits<int64_t>::max();
+                        if (lhs.min >= 0) {
+                            max = std::min(max, lhs.max);
+                        }
+                        if (rhs.min >= 0) {
+                            max = std::min(max, rhs.max);
+                        }
+                        return IntegerRange{0, max};
+                    }
+                    return type_range;
+                case BinaryOp::kShiftRight:
+                    if (lhs.min >= 0 && rhs.min >= 0 && rhs.max < 32) {
+                        return IntegerRange{lhs.min >> rhs.max, lhs.max >> rhs.min};
+                    }
+                    return type_range;
+                default:
+                    return type_range;
+            }
+        },
+        [&](CoreBuiltinCall* call) {
+            auto args = call->Args();
+            switch (call->Func()) {
+                case core::BuiltinFn::kMin:
+                    return Min(Get(args[0]), Get(args[1]));
+                case core::BuiltinFn::kMax:
+                    return Max(Get(args[0]), Get(args[1]));
+                case core::BuiltinFn::kClamp:
+                    return Min(Max(Get(args[0]), Get(args[1])), Get(args[2]));
+                default:
+                    return type_range;
+            }
+        },
+        [&](Default) { return type_range; });
+}
+
+IntegerRange IntegerRangeAnalysis::ComputeLoad(Load* load) {
+    auto type_range = TypeRange(load->Result(0)->Type());
+    auto* from = load->From()->As<InstructionResult>();
+    auto* var = from ? from->Instruction()->As<Var>() : nullptr;
+    if (!var) {
+        return type_range;
+    }
+    std::optional<LoopVar> loop_var;
+    if (auto cached = loop_vars_.Get(var)) {
+        loop_var = *cached;
+    } else {
+        loop_vars_.Add(var, std::nullopt);
+        loop_var = ComputeLoopVar(var);
+        loop_vars_.Replace(var, loop_var);
+    }
+    if (loop_var && IsAfter(load, loop_var->condition)) {
+        return loop_var->range;
+    }
+    return type_range;
+}
+
+IntegerRange IntegerRangeAnalysis::ComputeParam(FunctionParam* param, uint32_t component) {
+    auto type_range = TypeRange(param->Type()->DeepestElement());
+    auto func = param_functions_.Get(param);
+    if (!func || !param->Builtin() || !(*func)->WorkgroupSize()) {
+        return type_range;
+    }
+    auto size = *(*func)->WorkgroupSize();
+    switch (*param->Builtin()) {
+        case BuiltinValue::kLocalInvocationIndex:
+            return IntegerRange{0, int64_t(size[0]) * size[1] * size[2] - 1};
+        case BuiltinValue::kLocalInvocationId:
+            if (component < 3) {
+                return IntegerRange{0, int64_t(size[component]) - 1};
+            }
+            return type_range;
+        default:
+            return type_range;
+    }
+}
+
+std::optional<IntegerRangeAnalysis::LoopVar> IntegerRangeAnalysis::ComputeLoopVar(Var* var) {
+    // The variable must be an integer declared in the initializer of a loop.
+    auto* ptr = var->Result(0)->Type()->As<core::type::Pointer>();
+    if (!ptr || ptr->AddressSpace() != AddressSpace::kFunction ||
+        !ptr->StoreType()->IsAnyOf<core::type::I32, core::type::U32>()) {
+        return std::nullopt;
+    }
+    auto* loop = var->Block()->Parent() ? var->Block()->Parent()->As<Loop>() : nullptr;
+    if (!loop || var->Block() != loop->Initializer()) {
+        return std::nullopt;
+    }
+    int64_t initial = 0;
+    if (var->Initializer()) {
+        auto* constant = var->Initializer()->As<Constant>();
+        if (!constant) {
+            return std::nullopt;
+        }
+        initial = constant->Value()->ValueAs<int64_t>();
+    }
+
+    // The variable must only be stored to once, in the continuing block, with its value
+    // incremented by a positive constant.
+    auto is_load_of_var = [&](Value* value) {
+        auto* result = value->As<InstructionResult>();
+        auto* load = result ? result->Instruction()->As<Load>() : nullptr;
+        return load && load->From() == var->Result(0);
+    };
+    Store* store = nullptr;
+    for (auto& usage : var->Result(0)->Usages()) {
+        if (auto* s = usage.instruction->As<Store>()) {
+            if (store || s->Block() != loop->Continuing()) {
+                return std::nullopt;
+            }
+            store = s;
+        } else if (!usage.instruction->Is<Load>()) {
+            return std::nullopt;
+        }
+    }
+    auto* stored = store ? store->From()->As<InstructionResult>() : nullptr;
+    auto* add = stored ? stored->Instruction()->As<CoreBinary>() : nullptr;
+    if (!add || add->Op() != BinaryOp::kAdd) {
+        return std::nullopt;
+    }
+    Constant* step = nullptr;
+    if (is_load_of_var(add->LHS())) {
+        step = add->RHS()->As<Constant>();
+    } else if (is_load_of_var(add->RHS())) {
+        step = add->LHS()->As<Constant>();
+    }
+    if (!step || step->Value()->ValueAs<int64_t>() <= 0) {
+        return std::nullopt;
+    }
+
+    // The first control instruction of the body must exit the loop when the variable is not less
+    // than a bound.
+    If* condition = nullptr;
+    for (auto* inst = loop->Body()->Front(); inst && !condition; inst = inst->next.Get()) {
+        if (inst->Is<ControlInstruction>()) {
+            condition = inst->As<If>();
+            if (!condition) {
+                return std::nullopt;
+            }
+        }
+    }
+    if (!condition || !tint::Is<ExitIf>(condition->True()->Terminator())) {
+        return std::nullopt;
+    }
+    auto* exit = tint::As<ExitLoop>(condition->False()->Terminator());
+    if (!exit || exit->Loop() != loop) {
+        return std::nullopt;
+    }
+    // The comparison, and the load of the variable that it tests, must be in the body ahead of the
+    // `if`, so that they see the value of the current iteration. The only store is in the
+    // continuing block, so the variable cannot change between the load and the `if`.
+    auto* cond = condition->Condition()->As<InstructionResult>();
+    auto* cmp = cond ? cond->Instruction()->As<CoreBinary>() : nullptr;
+    if (!cmp || cmp->Block() != loop->Body()) {
+        return std::nullopt;
+    }
+    auto is_tested_load_of_var = [&](Value* value) {
+        return is_load_of_var(value) &&
+               value->As<InstructionResult>()->Instruction()->Block() == loop->Body();
+    };
+    std::optional<int64_t> max;
+    switch (cmp->Op()) {
+        case BinaryOp::kLessThan:
+            if (is_tested_load_of_var(cmp->LHS())) {
+                max = Get(cmp->RHS()).max - 1;
+            }
+            break;
+        case BinaryOp::kLessThanEqual:
+            if (is_tested_load_of_var(cmp->LHS())) {
+                max = Get(cmp->RHS()).max;
+            }
+            break;
+        case BinaryOp::kGreaterThan:
+            if (is_tested_load_of_var(cmp->RHS())) {
+                max = Get(cmp->LHS()).max - 1;
+            }
+            break;
+        case BinaryOp::kGreaterThanEqual:
+            if (is_tested_load_of_var(cmp->RHS())) {
+                max = Get(cmp->LHS()).max;
+            }
+            break;
+        default:
+            break;
+    }
+
+    // The increment must not overflow, or the variable could wrap around to a smaller value.
+    auto type_range = TypeRange(ptr->StoreType());
+    if (!max || *max + step->Value()->ValueAs<int64_t>() > type_range.max) {
+        return std::nullopt;
+    }
+    return LoopVar{condition, IntegerRange{initial, *max}};
+}
+
+IntegerRange IntegerRangeAnalysis::TypeRange(const core::type::Type* type) {
+    if (type->Is<core::type::I32>()) {
+        return IntegerRange{std::numeric_limits<int32_t>::min(),
+                            std::numeric_limits<int32_t>::max()};
+    }
+    if (type->Is<core::type::U32>()) {
+        return IntegerRange{0, std::numeric_limits<uint32_t>::max()};
+    }
+    return IntegerRange{std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()};
+}
+
+bool IntegerRangeAnalysis::IsAfter(Instruction* inst, Instruction* before) {
+    // Find the instruction in the block of `before` that holds `inst`.
+    while (inst->Block() != before->Block()) {
+        auto* ctrl = inst->Block() ? inst->Block()->Parent() : nullptr;
+        if (!ctrl) {
+            return false;
+        }
+        inst = ctrl;
+    }
+    for (auto* next = before->next.Get(); next; next = next->next.Get()) {
+        if (next == inst) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace tint::core::ir::analysis
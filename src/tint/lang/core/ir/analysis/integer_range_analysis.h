@@ -0,0 +1,138 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_LANG_CORE_IR_ANALYSIS_INTEGER_RANGE_ANALYSIS_H_
+#define SRC_TINT_LANG_CORE_IR_ANALYSIS_INTEGER_RANGE_ANALYSIS_H_
+
+#include <cstdint>
+#include <optional>
+
+#include "src/tint/utils/containers/hashmap.h"
+
+// Forward declarations.
+namespace tint::core::ir {
+class Function;
+class FunctionParam;
+class If;
+class Instruction;
+class Load;
+class Module;
+class Value;
+class Var;
+}  // namespace tint::core::ir
+namespace tint::core::type {
+class Type;
+}  // namespace tint::core::type
+
+namespace tint::core::ir::analysis {
+
+/// An inclusive range of integer values.
+struct IntegerRange {
+    /// The smallest value in the range.
+    int64_t min = 0;
+    /// The largest value in the range.
+    int64_t max = 0;
+
+    /// @returns true if the range only holds values in [0, @p limit]
+    /// @param limit the largest allowed value
+    bool IsWithin(int64_t limit) const { return min >= 0 && max <= limit; }
+};
+
+/// IntegerRangeAnalysis determines the range of values that `i32` and `u32` scalar values can hold.
+/// The range of a value is derived from the ranges of the operands of the instruction that produces
+/// it, from the workgroup size for the `local_invocation_id` and `local_invocation_index` builtin
+/// parameters, and from the loop condition for the loads of a `for` loop variable that is only
+/// incremented in the continuing block. Values that the analysis cannot bound have the range of
+/// their type. The ranges are computed on demand and cached, so the module must not be modified
+/// in a way that changes the values that were already queried.
+class IntegerRangeAnalysis {
+  public:
+    /// Constructor
+    /// @param ir the module to analyze
+    explicit IntegerRangeAnalysis(Module& ir);
+
+    /// Destructor
+    ~IntegerRangeAnalysis();
+
+    /// @param value an `i32` or `u32` scalar value
+    /// @returns the range of values that @p value can hold
+    IntegerRange Get(Value* value);
+
+  private:
+    /// A loop variable that is tested by the loop condition.
+    struct LoopVar {
+        /// The `if` instruction that exits the loop when the condition is false.
+        If* condition = nullptr;
+        /// The range of the variable after the condition.
+        IntegerRange range;
+    };
+
+    /// @returns the range of @p value, without using the cached ranges
+    /// @param value the value
+    IntegerRange Compute(Value* value);
+
+    /// @returns the range of the result of @p load
+    /// @param load the load instruction
+    IntegerRange ComputeLoad(Load* load);
+
+    /// @returns the range of component @p component of the builtin parameter @p param
+    /// @param param the function parameter
+    /// @param component the index of the vector component, or 0 for a scalar parameter
+    IntegerRange ComputeParam(FunctionParam* param, uint32_t component);
+
+    /// @returns the loop variable information for @p var, or std::nullopt if @p var is not a loop
+    /// variable that is only incremented and tested by the loop condition
+    /// @param var the variable
+    std::optional<LoopVar> ComputeLoopVar(Var* var);
+
+    /// @returns the range of the values of @p type
+    /// @param type the type
+    IntegerRange TypeRange(const core::type::Type* type);
+
+    /// @returns true if @p inst, or the control instruction that holds it, comes after @p before
+    /// in the block of @p before
+    /// @param inst the instruction
+    /// @param before the instruction that comes first
+    bool IsAfter(Instruction* inst, Instruction* before);
+
+    /// The module.
+    Module& ir_;
+
+    /// The entry point that declares each function parameter.
+    Hashmap<FunctionParam*, Function*, 8> param_functions_;
+
+    /// The cached ranges of the values.
+    Hashmap<Value*, IntegerRange, 32> ranges_;
+
+    /// The cached loop variables.
+    Hashmap<Var*, std::optional<LoopVar>, 8> loop_vars_;
+};
+
+}  // namespace tint::core::ir::analysis
+
+#endif  // SRC_TINT_LANG_CORE_IR_ANALYSIS_INTEGER_RANGE_ANALYSIS_H_
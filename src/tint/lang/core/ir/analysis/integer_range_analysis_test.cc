@@ -0,0 +1,412 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/core/ir/analysis/integer_range_analysis.h"
+
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "src/tint/lang/core/ir/ir_helper_test.h"
+
+namespace tint::core::ir::analysis {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+using IR_IntegerRangeAnalysisTest = IRTestHelper;
+
+constexpr int64_t kI32Min = std::numeric_limits<int32_t>::min();
+constexpr int64_t kI32Max = std::numeric_limits<int32_t>::max();
+constexpr int64_t kU32Max = std::numeric_limits<uint32_t>::max();
+
+/// Helper to compare ranges.
+void ExpectRange(IntegerRange range, int64_t min, int64_t max) {
+    EXPECT_EQ(range.min, min);
+    EXPECT_EQ(range.max, max);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, Constant) {
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(b.Constant(42_i)), 42, 42);
+    ExpectRange(analysis.Get(b.Constant(-3_i)), -3, -3);
+    ExpectRange(analysis.Get(b.Constant(7_u)), 7, 7);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, UnknownValue) {
+    auto* func = b.Function("foo", ty.void_());
+    auto* i = b.FunctionParam("i", ty.i32());
+    auto* u = b.FunctionParam("u", ty.u32());
+    func->SetParams({i, u});
+    b.Append(func->Block(), [&] { b.Return(func); });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(i), kI32Min, kI32Max);
+    ExpectRange(analysis.Get(u), 0, kU32Max);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, LocalInvocationIndex) {
+    auto* func = b.Function("foo", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{8u, 4u, 2u});
+    auto* idx = b.FunctionParam("idx", ty.u32());
+    idx->SetBuiltin(BuiltinValue::kLocalInvocationIndex);
+    func->SetParams({idx});
+    b.Append(func->Block(), [&] { b.Return(func); });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(idx), 0, 63);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, LocalInvocationId) {
+    auto* func = b.Function("foo", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{8u, 4u, 1u});
+    auto* id = b.FunctionParam("id", ty.vec3<u32>());
+    id->SetBuiltin(BuiltinValue::kLocalInvocationId);
+    func->SetParams({id});
+    core::ir::Access* x = nullptr;
+    core::ir::Access* y = nullptr;
+    core::ir::Access* z = nullptr;
+    b.Append(func->Block(), [&] {
+        x = b.Access<u32>(id, 0_u);
+        y = b.Access<u32>(id, 1_u);
+        z = b.Access<u32>(id, 2_u);
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(x->Result(0)), 0, 7);
+    ExpectRange(analysis.Get(y->Result(0)), 0, 3);
+    ExpectRange(analysis.Get(z->Result(0)), 0, 0);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, LocalInvocationId_NotEntryPoint) {
+    auto* func = b.Function("foo", ty.void_());
+    auto* id = b.FunctionParam("id", ty.vec3<u32>());
+    id->SetBuiltin(BuiltinValue::kLocalInvocationId);
+    func->SetParams({id});
+    core::ir::Access* x = nullptr;
+    b.Append(func->Block(), [&] {
+        x = b.Access<u32>(id, 0_u);
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(x->Result(0)), 0, kU32Max);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, Arithmetic) {
+    auto* func = b.Function("foo", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{16u, 1u, 1u});
+    auto* idx = b.FunctionParam("idx", ty.u32());
+    idx->SetBuiltin(BuiltinValue::kLocalInvocationIndex);
+    func->SetParams({idx});
+    core::ir::Instruction* add = nullptr;
+    core::ir::Instruction* sub = nullptr;
+    core::ir::Instruction* mul = nullptr;
+    core::ir::Instruction* div = nullptr;
+    core::ir::Instruction* mod_ = nullptr;
+    core::ir::Instruction* shr = nullptr;
+    core::ir::Instruction* conv = nullptr;
+    b.Append(func->Block(), [&] {
+        mul = b.Multiply<u32>(idx, 4_u);
+        add = b.Add<u32>(mul, 3_u);
+        sub = b.Subtract<u32>(add, 1_u);
+        div = b.Divide<u32>(add, 2_u);
+        mod_ = b.Modulo<u32>(b.Constant(100_u), 8_u);
+        shr = b.ShiftRight<u32>(add, 2_u);
+        conv = b.Convert<i32>(add);
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(mul->Result(0)), 0, 60);
+    ExpectRange(analysis.Get(add->Result(0)), 3, 63);
+    ExpectRange(analysis.Get(sub->Result(0)), 2, 62);
+    ExpectRange(analysis.Get(div->Result(0)), 1, 31);
+    ExpectRange(analysis.Get(mod_->Result(0)), 0, 7);
+    ExpectRange(analysis.Get(shr->Result(0)), 0, 15);
+    ExpectRange(analysis.Get(conv->Result(0)), 3, 63);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, SubtractBelowZero) {
+    auto* func = b.Function("foo", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{16u, 1u, 1u});
+    auto* idx = b.FunctionParam("idx", ty.u32());
+    idx->SetBuiltin(BuiltinValue::kLocalInvocationIndex);
+    func->SetParams({idx});
+    core::ir::Instruction* sub = nullptr;
+    b.Append(func->Block(), [&] {
+        sub = b.Subtract<u32>(idx, 1_u);
+        b.Return(func);
+    });
+
+    // The subtraction can wrap around, so the result could be any u32 value.
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(sub->Result(0)), 0, kU32Max);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, MinMaxClamp) {
+    auto* func = b.Function("foo", ty.void_());
+    auto* i = b.FunctionParam("i", ty.i32());
+    func->SetParams({i});
+    core::ir::Instruction* min = nullptr;
+    core::ir::Instruction* max = nullptr;
+    core::ir::Instruction* clamp = nullptr;
+    b.Append(func->Block(), [&] {
+        min = b.Call<i32>(core::BuiltinFn::kMin, i, 10_i);
+        max = b.Call<i32>(core::BuiltinFn::kMax, min, 0_i);
+        clamp = b.Call<i32>(core::BuiltinFn::kClamp, i, -5_i, 5_i);
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(min->Result(0)), kI32Min, 10);
+    ExpectRange(analysis.Get(max->Result(0)), 0, 10);
+    ExpectRange(analysis.Get(clamp->Result(0)), -5, 5);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, ForLoop) {
+    auto* func = b.Function("foo", ty.void_());
+    core::ir::Instruction* before = nullptr;
+    core::ir::Instruction* after = nullptr;
+    core::ir::Instruction* continuing = nullptr;
+    b.Append(func->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_i);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                before = b.Load(i);
+                auto* ifelse = b.If(b.LessThan<bool>(before, 10_i));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                after = b.Load(i);
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                continuing = b.Load(i);
+                b.Store(i, b.Add<i32>(continuing, 1_i));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(after->Result(0)), 0, 9);
+    // The load that is tested by the condition, and the load in the continuing block, are not
+    // bounded by the condition.
+    ExpectRange(analysis.Get(before->Result(0)), kI32Min, kI32Max);
+    ExpectRange(analysis.Get(continuing->Result(0)), kI32Min, kI32Max);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, ForLoop_LessThanEqual_NestedLoad) {
+    auto* func = b.Function("foo", ty.void_());
+    core::ir::Instruction* nested = nullptr;
+    b.Append(func->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 2_u);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(b.LessThanEqual<bool>(b.Load(i), 8_u));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                auto* inner = b.If(true);
+                b.Append(inner->True(), [&] {
+                    nested = b.Load(i);
+                    b.ExitIf(inner);
+                });
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<u32>(b.Load(i), 2_u));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(nested->Result(0)), 2, 8);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, ForLoop_LoadOutsideLoop) {
+    auto* func = b.Function("foo", ty.void_());
+    core::ir::Instruction* after = nullptr;
+    b.Append(func->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_i);
+            // The condition tests the initial value of the variable, not the current one.
+            auto* initial = b.Load(i);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(b.LessThan<bool>(initial, 10_i));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                after = b.Load(i);
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<i32>(b.Load(i), 1_i));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(after->Result(0)), kI32Min, kI32Max);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, ForLoop_CompareOutsideLoop) {
+    auto* func = b.Function("foo", ty.void_());
+    core::ir::Instruction* after = nullptr;
+    b.Append(func->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_i);
+            auto* in_bounds = b.LessThan<bool>(b.Load(i), 10_i);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(in_bounds);
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                after = b.Load(i);
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<i32>(b.Load(i), 1_i));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(after->Result(0)), kI32Min, kI32Max);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, ForLoop_StoreInBody) {
+    auto* func = b.Function("foo", ty.void_());
+    core::ir::Instruction* after = nullptr;
+    b.Append(func->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_i);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(b.LessThan<bool>(b.Load(i), 10_i));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                b.Store(i, 20_i);
+                after = b.Load(i);
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<i32>(b.Load(i), 1_i));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(after->Result(0)), kI32Min, kI32Max);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, ForLoop_Decrement) {
+    auto* func = b.Function("foo", ty.void_());
+    core::ir::Instruction* after = nullptr;
+    b.Append(func->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_i);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(b.LessThan<bool>(b.Load(i), 10_i));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                after = b.Load(i);
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<i32>(b.Load(i), -1_i));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(after->Result(0)), kI32Min, kI32Max);
+}
+
+TEST_F(IR_IntegerRangeAnalysisTest, ForLoop_IncrementCouldOverflow) {
+    auto* func = b.Function("foo", ty.void_());
+    core::ir::Instruction* after = nullptr;
+    b.Append(func->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_u);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(b.LessThanEqual<bool>(b.Load(i), u32(0xffffffff)));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                after = b.Load(i);
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<u32>(b.Load(i), 1_u));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func);
+    });
+
+    IntegerRangeAnalysis analysis(mod);
+    ExpectRange(analysis.Get(after->Result(0)), 0, kU32Max);
+}
+
+}  // namespace
+}  // namespace tint::core::ir::analysis
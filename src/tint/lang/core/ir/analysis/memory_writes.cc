@@ -0,0 +1,119 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/core/ir/analysis/memory_writes.h"
+
+#include "src/tint/lang/core/ir/access.h"
+#include "src/tint/lang/core/ir/bitcast.h"
+#include "src/tint/lang/core/ir/construct.h"
+#include "src/tint/lang/core/ir/convert.h"
+#include "src/tint/lang/core/ir/core_builtin_call.h"
+#include "src/tint/lang/core/ir/let.h"
+#include "src/tint/lang/core/ir/store.h"
+#include "src/tint/lang/core/ir/store_vector_element.h"
+#include "src/tint/lang/core/ir/var.h"
+#include "src/tint/lang/core/type/pointer.h"
+#include "src/tint/utils/rtti/switch.h"
+
+namespace tint::core::ir::analysis {
+
+bool IsPure(const CoreBuiltinCall* call) {
+    auto fn = call->Func();
+    if (core::HasSideEffects(fn) || core::IsDerivative(fn) || core::IsTexture(fn) ||
+        core::IsSubgroup(fn) || core::IsBarrier(fn) || core::IsAtomic(fn)) {
+        return false;
+    }
+    for (auto* arg : call->Args()) {
+        if (arg->Type()->Is<core::type::Pointer>()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MayWriteMemory(const Instruction* inst) {
+    return tint::Switch(
+        inst,  //
+        [&](const Store*) { return true; },
+        [&](const StoreVectorElement*) { return true; },
+        [&](const CoreBuiltinCall* call) {
+            // Barriers and atomics make the writes of other invocations visible.
+            auto fn = call->Func();
+            return core::HasSideEffects(fn) || core::IsBarrier(fn) || core::IsAtomic(fn);
+        },
+        [&](const Call* call) {
+            // User calls and the builtins of other dialects may write to any memory.
+            return !call->IsAnyOf<Bitcast, Construct, Convert>();
+        },
+        [&](Default) { return false; });
+}
+
+Var* RootVarOf(Value* ptr, TrackedVars tracked) {
+    while (auto* result = As<InstructionResult>(ptr)) {
+        auto* inst = result->Instruction();
+        if (auto* access = inst->As<Access>()) {
+            ptr = access->Object();
+        } else if (auto* let = inst->As<Let>()) {
+            ptr = let->Value();
+        } else if (auto* var = inst->As<Var>()) {
+            if (tracked == TrackedVars::kFunction) {
+                auto* ptr_ty = var->Result(0)->Type()->As<core::type::Pointer>();
+                return ptr_ty->AddressSpace() == core::AddressSpace::kFunction ? var : nullptr;
+            }
+            return var;
+        } else {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+void MemoryWrites::Add(Instruction* inst, TrackedVars tracked) {
+    if (!MayWriteMemory(inst)) {
+        return;
+    }
+    Var* var = nullptr;
+    if (auto* store = inst->As<Store>()) {
+        var = RootVarOf(store->To(), tracked);
+    } else if (auto* store_el = inst->As<StoreVectorElement>()) {
+        var = RootVarOf(store_el->To(), tracked);
+    }
+    if (var) {
+        vars.Add(var);
+    } else {
+        any = true;
+    }
+}
+
+void MemoryWrites::Add(const MemoryWrites& other) {
+    any = any || other.any;
+    for (auto& var : other.vars) {
+        vars.Add(var);
+    }
+}
+
+}  // namespace tint::core::ir::analysis
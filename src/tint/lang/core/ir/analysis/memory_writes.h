@@ -0,0 +1,86 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_LANG_CORE_IR_ANALYSIS_MEMORY_WRITES_H_
+#define SRC_TINT_LANG_CORE_IR_ANALYSIS_MEMORY_WRITES_H_
+
+#include "src/tint/utils/containers/hashset.h"
+
+// Forward declarations.
+namespace tint::core::ir {
+class CoreBuiltinCall;
+class Instruction;
+class Value;
+class Var;
+}  // namespace tint::core::ir
+
+namespace tint::core::ir::analysis {
+
+/// @returns true if @p call is a call to a builtin that has no side effects, does not access
+/// memory through a pointer, and does not depend on the other invocations
+/// @param call the builtin call
+bool IsPure(const CoreBuiltinCall* call);
+
+/// @returns true if @p inst may write to memory
+/// @param inst the instruction
+bool MayWriteMemory(const Instruction* inst);
+
+/// The variables that are tracked individually. The writes to other memory are treated as writes to
+/// any memory.
+enum class TrackedVars {
+    /// Only the function-scope variables are tracked.
+    kFunction,
+    /// The variables of all address spaces are tracked.
+    kAll,
+};
+
+/// @returns the variable that @p ptr points into, looking through accesses and lets, or nullptr if
+/// the variable is not known or is not tracked
+/// @param ptr the pointer
+/// @param tracked the variables that are tracked
+Var* RootVarOf(Value* ptr, TrackedVars tracked);
+
+/// MemoryWrites is the memory that a set of instructions may write to.
+struct MemoryWrites {
+    /// True if any memory may be written to.
+    bool any = false;
+    /// The variables that are written to, when `any` is false.
+    Hashset<Var*, 4> vars;
+
+    /// Adds the memory that @p inst may write to.
+    /// @param inst the instruction
+    /// @param tracked the variables that are tracked
+    void Add(Instruction* inst, TrackedVars tracked);
+
+    /// Adds the memory written to by @p other.
+    /// @param other the writes to add
+    void Add(const MemoryWrites& other);
+};
+
+}  // namespace tint::core::ir::analysis
+
+#endif  // SRC_TINT_LANG_CORE_IR_ANALYSIS_MEMORY_WRITES_H_
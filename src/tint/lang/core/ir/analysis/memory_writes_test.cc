@@ -0,0 +1,126 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/core/ir/analysis/memory_writes.h"
+
+#include "gtest/gtest.h"
+#include "src/tint/lang/core/ir/ir_helper_test.h"
+
+namespace tint::core::ir::analysis {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+using IR_MemoryWritesTest = IRTestHelper;
+
+TEST_F(IR_MemoryWritesTest, IsPure) {
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        auto* var = b.Var<workgroup, atomic<i32>>("a");
+        auto* max = b.Call<i32>(core::BuiltinFn::kMax, 1_i, 2_i);
+        auto* atomic = b.Call<i32>(core::BuiltinFn::kAtomicLoad, var);
+        auto* barrier = b.Call<void>(core::BuiltinFn::kWorkgroupBarrier);
+        EXPECT_TRUE(IsPure(max));
+        EXPECT_FALSE(IsPure(atomic));
+        EXPECT_FALSE(IsPure(barrier));
+        b.Return(func);
+    });
+}
+
+TEST_F(IR_MemoryWritesTest, MayWriteMemory) {
+    auto* callee = b.Function("bar", ty.void_());
+    b.Append(callee->Block(), [&] { b.Return(callee); });
+
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        auto* var = b.Var<function, i32>("v");
+        auto* load = b.Load(var);
+        auto* store = b.Store(var, 1_i);
+        auto* convert = b.Convert<f32>(load);
+        auto* call = b.Call(callee);
+        auto* barrier = b.Call<void>(core::BuiltinFn::kStorageBarrier);
+        EXPECT_FALSE(MayWriteMemory(var));
+        EXPECT_FALSE(MayWriteMemory(load));
+        EXPECT_TRUE(MayWriteMemory(store));
+        EXPECT_FALSE(MayWriteMemory(convert));
+        EXPECT_TRUE(MayWriteMemory(call));
+        EXPECT_TRUE(MayWriteMemory(barrier));
+        b.Return(func);
+    });
+}
+
+TEST_F(IR_MemoryWritesTest, RootVarOf) {
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        auto* fn_var = b.Var<function, array<i32, 4>>("f");
+        auto* priv_var = b.Var<private_, array<i32, 4>>("p");
+        auto* fn_let = b.Let("l", fn_var);
+        auto* fn_el = b.Access<ptr<function, i32>>(fn_let, 1_i);
+        auto* priv_el = b.Access<ptr<private_, i32>>(priv_var, 1_i);
+        EXPECT_EQ(RootVarOf(fn_el->Result(0), TrackedVars::kFunction), fn_var);
+        EXPECT_EQ(RootVarOf(fn_el->Result(0), TrackedVars::kAll), fn_var);
+        EXPECT_EQ(RootVarOf(priv_el->Result(0), TrackedVars::kFunction), nullptr);
+        EXPECT_EQ(RootVarOf(priv_el->Result(0), TrackedVars::kAll), priv_var);
+        b.Return(func);
+    });
+}
+
+TEST_F(IR_MemoryWritesTest, Add) {
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        auto* fn_var = b.Var<function, i32>("f");
+        auto* priv_var = b.Var<private_, i32>("p");
+        auto* fn_store = b.Store(fn_var, 1_i);
+        auto* priv_store = b.Store(priv_var, 2_i);
+
+        MemoryWrites function_writes;
+        function_writes.Add(fn_store, TrackedVars::kFunction);
+        EXPECT_FALSE(function_writes.any);
+        EXPECT_TRUE(function_writes.vars.Contains(fn_var));
+        function_writes.Add(priv_store, TrackedVars::kFunction);
+        EXPECT_TRUE(function_writes.any);
+
+        MemoryWrites all_writes;
+        all_writes.Add(fn_store, TrackedVars::kAll);
+        all_writes.Add(priv_store, TrackedVars::kAll);
+        EXPECT_FALSE(all_writes.any);
+        EXPECT_TRUE(all_writes.vars.Contains(fn_var));
+        EXPECT_TRUE(all_writes.vars.Contains(priv_var));
+
+        MemoryWrites merged;
+        merged.Add(all_writes);
+        EXPECT_FALSE(merged.any);
+        EXPECT_EQ(merged.vars.Count(), 2u);
+        merged.Add(function_writes);
+        EXPECT_TRUE(merged.any);
+        b.Return(func);
+    });
+}
+
+}  // namespace
+}  // namespace tint::core::ir::analysis
@@ -54,6 +54,11 @@ Continue::Continue(ir::Loop* loop, VectorRef<Value*> args) : loop_(loop) {
 
 Continue::~Continue() = default;
 
+void Continue::Destroy() {
+    SetLoop(nullptr);
+    Base::Destroy();
+}
+
 Continue* Continue::Clone(CloneContext& ctx) {
     auto* loop = ctx.Remap(Loop());
     auto args = ctx.Remap<Continue::kDefaultNumOperands>(Args());
@@ -62,12 +67,12 @@ Continue* Continue::Clone(CloneContext& ctx) {
 }
 
 void Continue::SetLoop(ir::Loop* loop) {
-    if (loop_ && loop_->Body()) {
-        loop_->Body()->RemoveInboundSiblingBranch(this);
+    if (loop_ && loop_->Continuing()) {
+        loop_->Continuing()->RemoveInboundSiblingBranch(this);
     }
     loop_ = loop;
     if (loop) {
-        loop->Body()->AddInboundSiblingBranch(this);
+        loop->Continuing()->AddInboundSiblingBranch(this);
     }
 }
 
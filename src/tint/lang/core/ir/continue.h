@@ -56,6 +56,9 @@ class Continue final : public Castable<Continue, Terminator> {
     explicit Continue(ir::Loop* loop, VectorRef<Value*> args = tint::Empty);
     ~Continue() override;
 
+    /// @copydoc Value::Destroy
+    void Destroy() override;
+
     /// @copydoc Instruction::Clone()
     Continue* Clone(CloneContext& ctx) override;
 
@@ -58,6 +58,17 @@ TEST_F(IR_ContinueTest, Results) {
     EXPECT_TRUE(brk->Results().IsEmpty());
 }
 
+TEST_F(IR_ContinueTest, Destroy) {
+    auto* loop = b.Loop();
+    auto* cont = b.Continue(loop);
+    EXPECT_EQ(loop->Continuing()->InboundSiblingBranches().Length(), 1u);
+
+    cont->Destroy();
+
+    EXPECT_FALSE(cont->Alive());
+    EXPECT_TRUE(loop->Continuing()->InboundSiblingBranches().IsEmpty());
+}
+
 TEST_F(IR_ContinueTest, Fail_NullLoop) {
     EXPECT_FATAL_FAILURE(
         {
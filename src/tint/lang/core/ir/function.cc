@@ -57,6 +57,7 @@ Function* Function::Clone(CloneContext& ctx) {
     new_func->return_.builtin = return_.builtin;
     new_func->return_.location = return_.location;
     new_func->return_.invariant = return_.invariant;
+    new_func->always_inline_ = always_inline_;
 
     ctx.Replace(this, new_func);
     block_->CloneInto(ctx, new_func->block_);
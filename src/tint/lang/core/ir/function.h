@@ -96,6 +96,14 @@ class Function : public Castable<Function, Value> {
     /// @returns the workgroup size information
     std::optional<std::array<uint32_t, 3>> WorkgroupSize() const { return workgroup_size_; }
 
+    /// Marks the function as a helper created by a transform, such as a polyfill, which the Inline
+    /// transform can inline into its callers regardless of its size.
+    /// @param always_inline `true` to always inline the function
+    void SetAlwaysInline(bool always_inline) { always_inline_ = always_inline; }
+
+    /// @returns true if the function should always be inlined into its callers
+    bool AlwaysInline() const { return always_inline_; }
+
     /// @param type the return type for the function
     void SetReturnType(const core::type::Type* type) { return_.type = type; }
 
@@ -171,6 +179,7 @@ class Function : public Castable<Function, Value> {
   private:
     PipelineStage pipeline_stage_ = PipelineStage::kUndefined;
     std::optional<std::array<uint32_t, 3>> workgroup_size_;
+    bool always_inline_ = false;
 
     struct {
         const core::type::Type* type = nullptr;
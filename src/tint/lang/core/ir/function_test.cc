@@ -88,6 +88,7 @@ TEST_F(IR_FunctionTest, Clone) {
     f->SetReturnLocation(
         1, Interpolation{core::InterpolationType::kFlat, core::InterpolationSampling::kCentroid});
     f->SetReturnInvariant(true);
+    f->SetAlwaysInline(true);
 
     auto* param1 = b.FunctionParam("a", mod.Types().i32());
     auto* param2 = b.FunctionParam("b", mod.Types().f32());
@@ -119,6 +120,7 @@ TEST_F(IR_FunctionTest, Clone) {
     EXPECT_EQ(core::InterpolationSampling::kCentroid, loc.interpolation->sampling);
 
     EXPECT_TRUE(new_f->ReturnInvariant());
+    EXPECT_TRUE(new_f->AlwaysInline());
 
     EXPECT_EQ(2u, new_f->Params().Length());
     EXPECT_EQ(new_param1, new_f->Params()[0]);
@@ -61,6 +61,14 @@ class Instruction : public Castable<Instruction> {
     /// @returns the operands of the instruction
     virtual VectorRef<const ir::Value*> Operands() const = 0;
 
+    /// @param idx the index of the operand
+    /// @returns the use of the operand with index @p idx, or nullptr if the index is out of bounds
+    virtual Use* OperandUse(size_t idx) = 0;
+
+    /// @param idx the index of the operand
+    /// @returns the use of the operand with index @p idx, or nullptr if the index is out of bounds
+    virtual const Use* OperandUse(size_t idx) const = 0;
+
     /// Replaces the operands of the instruction
     /// @param operands the new operands of the instruction
     virtual void SetOperands(VectorRef<ir::Value*> operands) = 0;
@@ -29,6 +29,7 @@
 #define SRC_TINT_LANG_CORE_IR_MODULE_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "src/tint/lang/core/constant/manager.h"
@@ -36,6 +37,7 @@
 #include "src/tint/lang/core/ir/constant.h"
 #include "src/tint/lang/core/ir/function.h"
 #include "src/tint/lang/core/ir/instruction.h"
+#include "src/tint/lang/core/ir/validator.h"
 #include "src/tint/lang/core/ir/value.h"
 #include "src/tint/lang/core/type/manager.h"
 #include "src/tint/utils/containers/const_propagating_ptr.h"
@@ -155,6 +157,14 @@ class Module {
 
     /// The map of core::constant::Value to their ir::Constant.
     Hashmap<const core::constant::Value*, ir::Constant*, 16> constants;
+
+    /// The level of validation performed by ValidateAndDumpIfNeeded() before each transform.
+    ValidationMode validation_mode = kDefaultValidationMode;
+
+    /// The functions modified since the module was last validated by ValidateAndDumpIfNeeded(), or
+    /// std::nullopt if any part of the module may have been modified.
+    /// @see SetModifiedFunctions()
+    std::optional<Vector<const Function*, 8>> modified_functions;
 };
 
 }  // namespace tint::core::ir
@@ -56,13 +56,8 @@ class OperandInstruction : public Castable<OperandInstruction<N, R>, Instruction
     /// @param value the value to use
     void SetOperand(size_t index, ir::Value* value) override {
         TINT_ASSERT(index < operands_.Length());
-        if (operands_[index]) {
-            operands_[index]->RemoveUsage({this, index});
-        }
         operands_[index] = value;
-        if (value) {
-            value->AddUsage({this, index});
-        }
+        uses_[index].Set(value);
     }
 
     /// Replaces the operands of the instruction
@@ -70,21 +65,19 @@ class OperandInstruction : public Castable<OperandInstruction<N, R>, Instruction
     void SetOperands(VectorRef<ir::Value*> operands) override {
         ClearOperands();
         operands_ = std::move(operands);
+        uses_.Reserve(operands_.Length());
         for (size_t i = 0; i < operands_.Length(); i++) {
-            if (operands_[i]) {
-                operands_[i]->AddUsage({this, static_cast<uint32_t>(i)});
-            }
+            uses_.Emplace(this, i);
+            uses_.Back().Set(operands_[i]);
         }
     }
 
     /// Removes all operands from the instruction
     void ClearOperands() {
-        for (uint32_t i = 0; i < operands_.Length(); i++) {
-            if (!operands_[i]) {
-                continue;
-            }
-            operands_[i]->RemoveUsage({this, i});
+        for (auto& use : uses_) {
+            use.Set(nullptr);
         }
+        uses_.Clear();
         operands_.Clear();
     }
 
@@ -125,6 +118,14 @@ class OperandInstruction : public Castable<OperandInstruction<N, R>, Instruction
     /// @returns the operands of the instruction
     VectorRef<const ir::Value*> Operands() const override { return operands_; }
 
+    /// @copydoc Instruction::OperandUse
+    Use* OperandUse(size_t idx) override { return idx < uses_.Length() ? &uses_[idx] : nullptr; }
+
+    /// @copydoc Instruction::OperandUse
+    const Use* OperandUse(size_t idx) const override {
+        return idx < uses_.Length() ? &uses_[idx] : nullptr;
+    }
+
     /// @returns the result values for this instruction
     VectorRef<InstructionResult*> Results() override { return results_; }
 
@@ -152,10 +153,9 @@ class OperandInstruction : public Castable<OperandInstruction<N, R>, Instruction
     void AddOperand(size_t idx, ir::Value* value) {
         TINT_ASSERT(idx == operands_.Length());
 
-        if (value) {
-            value->AddUsage({this, static_cast<uint32_t>(operands_.Length())});
-        }
         operands_.Push(value);
+        uses_.Emplace(this, idx);
+        uses_.Back().Set(value);
     }
 
     /// Append a list of operands to the operand list for this instruction.
@@ -180,6 +180,9 @@ class OperandInstruction : public Castable<OperandInstruction<N, R>, Instruction
 
     /// The operands to this instruction.
     Vector<ir::Value*, N> operands_;
+    /// The uses of the operands of this instruction. Each element links the instruction into the
+    /// use list of the operand with the same index.
+    Vector<Use, N> uses_;
     /// The results of this instruction.
     Vector<ir::InstructionResult*, R> results_;
 
@@ -53,16 +53,30 @@ tint_add_target(tint_lang_core_ir_transform lib
   lang/core/ir/transform/builtin_polyfill.h
   lang/core/ir/transform/combine_access_instructions.cc
   lang/core/ir/transform/combine_access_instructions.h
+  lang/core/ir/transform/common_subexpression_elimination.cc
+  lang/core/ir/transform/common_subexpression_elimination.h
+  lang/core/ir/transform/constant_propagation.cc
+  lang/core/ir/transform/constant_propagation.h
   lang/core/ir/transform/conversion_polyfill.cc
   lang/core/ir/transform/conversion_polyfill.h
+  lang/core/ir/transform/dead_code_elimination.cc
+  lang/core/ir/transform/dead_code_elimination.h
   lang/core/ir/transform/demote_to_helper.cc
   lang/core/ir/transform/demote_to_helper.h
   lang/core/ir/transform/direct_variable_access.cc
   lang/core/ir/transform/direct_variable_access.h
+  lang/core/ir/transform/inline.cc
+  lang/core/ir/transform/inline.h
+  lang/core/ir/transform/loop_invariant_code_motion.cc
+  lang/core/ir/transform/loop_invariant_code_motion.h
   lang/core/ir/transform/multiplanar_external_texture.cc
   lang/core/ir/transform/multiplanar_external_texture.h
+  lang/core/ir/transform/optimize.cc
+  lang/core/ir/transform/optimize.h
   lang/core/ir/transform/preserve_padding.cc
   lang/core/ir/transform/preserve_padding.h
+  lang/core/ir/transform/promote_vars_to_values.cc
+  lang/core/ir/transform/promote_vars_to_values.h
   lang/core/ir/transform/robustness.cc
   lang/core/ir/transform/robustness.h
   lang/core/ir/transform/shader_io.cc
@@ -84,6 +98,7 @@ tint_target_add_dependencies(tint_lang_core_ir_transform lib
   tint_lang_core_constant
   tint_lang_core_intrinsic
   tint_lang_core_ir
+  tint_lang_core_ir_analysis
   tint_lang_core_type
   tint_utils_containers
   tint_utils_diagnostic
@@ -112,12 +127,19 @@ tint_add_target(tint_lang_core_ir_transform_test test
   lang/core/ir/transform/block_decorated_structs_test.cc
   lang/core/ir/transform/builtin_polyfill_test.cc
   lang/core/ir/transform/combine_access_instructions_test.cc
+  lang/core/ir/transform/common_subexpression_elimination_test.cc
+  lang/core/ir/transform/constant_propagation_test.cc
   lang/core/ir/transform/conversion_polyfill_test.cc
+  lang/core/ir/transform/dead_code_elimination_test.cc
   lang/core/ir/transform/demote_to_helper_test.cc
   lang/core/ir/transform/direct_variable_access_test.cc
   lang/core/ir/transform/helper_test.h
+  lang/core/ir/transform/inline_test.cc
+  lang/core/ir/transform/loop_invariant_code_motion_test.cc
   lang/core/ir/transform/multiplanar_external_texture_test.cc
+  lang/core/ir/transform/optimize_test.cc
   lang/core/ir/transform/preserve_padding_test.cc
+  lang/core/ir/transform/promote_vars_to_values_test.cc
   lang/core/ir/transform/robustness_test.cc
   lang/core/ir/transform/std140_test.cc
   lang/core/ir/transform/value_to_let_test.cc
@@ -164,6 +164,7 @@ struct State {
 
             // Create the helper function.
             auto* func = b.Function(name.str(), result_ty);
+            func->SetAlwaysInline(true);
             auto* lhs = b.FunctionParam("lhs", result_ty);
             auto* rhs = b.FunctionParam("rhs", result_ty);
             func->SetParams({lhs, rhs});
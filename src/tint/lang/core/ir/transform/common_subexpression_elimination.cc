@@ -0,0 +1,362 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/common_subexpression_elimination.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/access.h"
+#include "src/tint/lang/core/ir/analysis/memory_writes.h"
+#include "src/tint/lang/core/ir/binary.h"
+#include "src/tint/lang/core/ir/bitcast.h"
+#include "src/tint/lang/core/ir/constant.h"
+#include "src/tint/lang/core/ir/construct.h"
+#include "src/tint/lang/core/ir/continue.h"
+#include "src/tint/lang/core/ir/convert.h"
+#include "src/tint/lang/core/ir/core_builtin_call.h"
+#include "src/tint/lang/core/ir/function.h"
+#include "src/tint/lang/core/ir/load.h"
+#include "src/tint/lang/core/ir/load_vector_element.h"
+#include "src/tint/lang/core/ir/loop.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/multi_in_block.h"
+#include "src/tint/lang/core/ir/store.h"
+#include "src/tint/lang/core/ir/store_vector_element.h"
+#include "src/tint/lang/core/ir/swizzle.h"
+#include "src/tint/lang/core/ir/unary.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/lang/core/ir/var.h"
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/rtti/switch.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// The identity of the value computed by an instruction.
+struct Key {
+    /// The kind of the instruction.
+    const tint::TypeInfo* kind = nullptr;
+    /// The result type.
+    const core::type::Type* type = nullptr;
+    /// The operator or builtin function, if any.
+    uint32_t op = 0;
+    /// The operands. Constant operands are represented by their constant value, so that equal
+    /// constants compare equal.
+    Vector<const void*, 4> operands;
+    /// The swizzle indices, if any.
+    Vector<uint32_t, 4> indices;
+    /// The memory epoch of all memory, for loads.
+    uint32_t global_epoch = 0;
+    /// The memory epoch of the function-scope variable that is loaded from, if any.
+    uint32_t var_epoch = 0;
+
+    /// @returns the hash code of the key
+    tint::HashCode HashCode() const {
+        return Hash(kind, type, op, operands, indices, global_epoch, var_epoch);
+    }
+
+    /// Equality operator
+    /// @param other the key to compare against
+    /// @returns true if this key and @p other are equal
+    bool operator==(const Key& other) const {
+        return kind == other.kind && type == other.type && op == other.op &&
+               operands == other.operands && indices == other.indices &&
+               global_epoch == other.global_epoch && var_epoch == other.var_epoch;
+    }
+};
+
+/// The memory epochs, which change each time memory may be written to.
+struct Memory {
+    /// The epoch of all memory.
+    uint32_t global_epoch = 0;
+    /// The epochs of the function-scope variables that have been written to.
+    Hashmap<Var*, uint32_t, 8> var_epochs;
+};
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module& ir;
+
+    /// The instruction results that are available, by their key.
+    Hashmap<Key, InstructionResult*, 32> values{};
+
+    /// The keys added to `values`, in order, so that they can be removed at the end of a scope.
+    Vector<Key, 32> scope{};
+
+    /// The current memory epochs.
+    Memory memory{};
+
+    /// The next memory epoch.
+    uint32_t next_epoch = 1;
+
+    /// The memory written to by each control instruction.
+    Hashmap<ControlInstruction*, analysis::MemoryWrites, 8> writes{};
+
+    /// True if an instruction of the function being processed has been replaced.
+    bool changed = false;
+
+    /// Process the module.
+    void Process() {
+        Vector<const Function*, 8> modified;
+        for (auto& func : ir.functions) {
+            changed = false;
+            ProcessBlock(func->Block());
+            if (changed) {
+                modified.Push(func);
+            }
+        }
+        SetModifiedFunctions(ir, std::move(modified));
+    }
+
+  private:
+    /// Processes the instructions of @p block in a new scope.
+    /// @param block the block
+    void ProcessBlock(Block* block) {
+        size_t mark = scope.Length();
+        ProcessInstructions(block);
+        PopScope(mark);
+    }
+
+    /// Processes the instructions of @p block in the current scope.
+    /// @param block the block
+    void ProcessInstructions(Block* block) {
+        for (auto* inst = block->Front(); inst;) {
+            auto* next = inst->next.Get();
+            Visit(inst);
+            inst = next;
+        }
+    }
+
+    /// Removes the values that were added to the scope after @p mark.
+    /// @param mark the length of the scope to return to
+    void PopScope(size_t mark) {
+        while (scope.Length() > mark) {
+            values.Remove(scope.Pop());
+        }
+    }
+
+    /// Visits @p inst, replacing its result if an identical instruction dominates it.
+    /// @param inst the instruction
+    void Visit(Instruction* inst) {
+        tint::Switch(
+            inst,  //
+            [&](Loop* loop) { VisitLoop(loop); },
+            [&](ControlInstruction* ctrl) {
+                // Each block starts with the memory state from before the control instruction.
+                Memory before = memory;
+                ctrl->ForeachBlock([&](Block* block) {
+                    memory = before;
+                    ProcessBlock(block);
+                });
+                memory = std::move(before);
+                Apply(WritesOf(ctrl));
+            },
+            [&](Store* store) { Write(store->To()); },
+            [&](StoreVectorElement* store) { Write(store->To()); },
+            [&](Default) {
+                if (analysis::MayWriteMemory(inst)) {
+                    memory.global_epoch = next_epoch++;
+                    return;
+                }
+                auto key = KeyOf(inst);
+                if (!key) {
+                    return;
+                }
+                auto* result = inst->Result(0);
+                if (auto existing = values.Get(*key)) {
+                    result->ReplaceAllUsesWith(*existing);
+                    inst->Destroy();
+                    changed = true;
+                    return;
+                }
+                values.Add(*key, result);
+                scope.Push(std::move(*key));
+            });
+    }
+
+    /// Visits the blocks of @p loop.
+    /// @param loop the loop
+    void VisitLoop(Loop* loop) {
+        size_t mark = scope.Length();
+        ProcessInstructions(loop->Initializer());
+
+        // Memory written by one iteration is read by the next, so values loaded before the body
+        // cannot be reused in a loop that writes to them.
+        auto loop_writes = WritesOf(loop);
+        Apply(loop_writes);
+
+        size_t body_mark = scope.Length();
+        ProcessInstructions(loop->Body());
+
+        // The values of the body dominate the continuing block, unless the body can branch to the
+        // continuing block before reaching them.
+        for (auto* branch : loop->Continuing()->InboundSiblingBranches()) {
+            if (branch->Block() != loop->Body()) {
+                PopScope(body_mark);
+                break;
+            }
+        }
+        ProcessInstructions(loop->Continuing());
+
+        PopScope(mark);
+        Apply(loop_writes);
+    }
+
+    /// @returns the key of @p inst if it is a pure instruction with a single result, otherwise
+    /// nullptr
+    /// @param inst the instruction
+    std::optional<Key> KeyOf(Instruction* inst) {
+        if (inst->Results().Length() != 1) {
+            return std::nullopt;
+        }
+
+        Key key;
+        key.kind = &inst->TypeInfo();
+        key.type = inst->Result(0)->Type();
+        bool pure = tint::Switch(
+            inst,  //
+            [&](Access*) { return true; },
+            [&](Binary* binary) {
+                key.op = static_cast<uint32_t>(binary->Op());
+                return true;
+            },
+            [&](Unary* unary) {
+                key.op = static_cast<uint32_t>(unary->Op());
+                return true;
+            },
+            [&](Bitcast*) { return true; },
+            [&](Construct*) { return true; },
+            [&](Convert*) { return true; },
+            [&](Swizzle* swizzle) {
+                key.indices = swizzle->Indices();
+                return true;
+            },
+            [&](Load* load) {
+                SetEpochs(key, load->From());
+                return true;
+            },
+            [&](LoadVectorElement* load) {
+                SetEpochs(key, load->From());
+                return true;
+            },
+            [&](CoreBuiltinCall* call) {
+                key.op = static_cast<uint32_t>(call->Func());
+                return analysis::IsPure(call);
+            },
+            [&](Default) { return false; });
+        if (!pure) {
+            return std::nullopt;
+        }
+
+        for (auto* operand : inst->Operands()) {
+            if (auto* constant = As<Constant>(operand)) {
+                key.operands.Push(constant->Value());
+            } else {
+                key.operands.Push(operand);
+            }
+        }
+        return key;
+    }
+
+    /// Sets the memory epochs of the load key @p key.
+    /// @param key the key
+    /// @param ptr the pointer that is loaded from
+    void SetEpochs(Key& key, Value* ptr) {
+        key.global_epoch = memory.global_epoch;
+        if (auto* var = FunctionVarOf(ptr)) {
+            key.var_epoch = memory.var_epochs.GetOr(var, 0u);
+        }
+    }
+
+    /// Updates the memory epochs for a store to @p ptr.
+    /// @param ptr the pointer that is stored to
+    void Write(Value* ptr) {
+        if (auto* var = FunctionVarOf(ptr)) {
+            memory.var_epochs.Replace(var, next_epoch++);
+        } else {
+            memory.global_epoch = next_epoch++;
+        }
+    }
+
+    /// Starts a new memory epoch for the memory written to by @p w.
+    /// @param w the memory written to
+    void Apply(const analysis::MemoryWrites& w) {
+        if (w.any) {
+            memory.global_epoch = next_epoch++;
+            return;
+        }
+        for (auto& var : w.vars) {
+            memory.var_epochs.Replace(var, next_epoch++);
+        }
+    }
+
+    /// @returns the memory that the blocks of @p ctrl may write to. This is returned by value, as
+    /// adding the writes of a nested control instruction to `writes` can rehash the map.
+    /// @param ctrl the control instruction
+    analysis::MemoryWrites WritesOf(ControlInstruction* ctrl) {
+        if (auto existing = writes.Get(ctrl)) {
+            return *existing;
+        }
+        analysis::MemoryWrites w;
+        ctrl->ForeachBlock([&](Block* block) {
+            for (auto* inst : *block) {
+                if (auto* nested = inst->As<ControlInstruction>()) {
+                    w.Add(WritesOf(nested));
+                } else {
+                    w.Add(inst, analysis::TrackedVars::kFunction);
+                }
+            }
+        });
+        writes.Add(ctrl, w);
+        return w;
+    }
+
+    /// @returns the function-scope variable that @p ptr points into, or nullptr if @p ptr may
+    /// point to any other memory
+    /// @param ptr the pointer
+    Var* FunctionVarOf(Value* ptr) {
+        return analysis::RootVarOf(ptr, analysis::TrackedVars::kFunction);
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> CommonSubexpressionElimination(Module& ir) {
+    auto result = ValidateAndDumpIfNeeded(ir, "CommonSubexpressionElimination transform");
+    if (result != Success) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
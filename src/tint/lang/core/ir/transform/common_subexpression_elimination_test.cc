@@ -0,0 +1,781 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/common_subexpression_elimination.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+using IR_CommonSubexpressionEliminationTest = TransformTest;
+
+TEST_F(IR_CommonSubexpressionEliminationTest, Empty) {
+    auto* expect = R"(
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, BinaryUnaryAndBuiltinCall) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* x = b.Add<i32>(param, 1_i);
+        auto* y = b.Add<i32>(param, 1_i);
+        auto* z = b.Add<i32>(param, 2_i);
+        auto* abs_x = b.Call<i32>(core::BuiltinFn::kAbs, x);
+        auto* abs_y = b.Call<i32>(core::BuiltinFn::kAbs, y);
+        auto* neg_x = b.Negation<i32>(abs_x);
+        auto* neg_y = b.Negation<i32>(abs_y);
+        b.Return(ep, b.Multiply<i32>(b.Add<i32>(neg_x, neg_y), z));
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    %4:i32 = add %p, 1i
+    %5:i32 = add %p, 2i
+    %6:i32 = abs %3
+    %7:i32 = abs %4
+    %8:i32 = negation %6
+    %9:i32 = negation %7
+    %10:i32 = add %8, %9
+    %11:i32 = mul %10, %5
+    ret %11
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    %4:i32 = add %p, 2i
+    %5:i32 = abs %3
+    %6:i32 = negation %5
+    %7:i32 = add %6, %6
+    %8:i32 = mul %7, %4
+    ret %8
+  }
+}
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, AccessLoadAndSwizzle) {
+    auto* arr = b.Var("arr", ty.ptr<private_, array<vec4<f32>, 4>>());
+    b.ir.root_block->Append(arr);
+
+    auto* ep = b.Function("ep", ty.vec2<f32>());
+    auto* idx = b.FunctionParam("idx", ty.u32());
+    ep->SetParams({idx});
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Load(b.Access<ptr<private_, vec4<f32>>>(arr, idx));
+        auto* c = b.Load(b.Access<ptr<private_, vec4<f32>>>(arr, idx));
+        auto* sa = b.Swizzle(ty.vec2<f32>(), a, Vector{2u, 1u});
+        auto* sc = b.Swizzle(ty.vec2<f32>(), c, Vector{2u, 1u});
+        auto* sd = b.Swizzle(ty.vec2<f32>(), c, Vector{1u, 2u});
+        b.Return(ep, b.Add<vec2<f32>>(b.Add<vec2<f32>>(sa, sc), sd));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %arr:ptr<private, array<vec4<f32>, 4>, read_write> = var
+}
+
+%ep = func(%idx:u32):vec2<f32> -> %b2 {
+  %b2 = block {
+    %4:ptr<private, vec4<f32>, read_write> = access %arr, %idx
+    %5:vec4<f32> = load %4
+    %6:ptr<private, vec4<f32>, read_write> = access %arr, %idx
+    %7:vec4<f32> = load %6
+    %8:vec2<f32> = swizzle %5, zy
+    %9:vec2<f32> = swizzle %7, zy
+    %10:vec2<f32> = swizzle %7, yz
+    %11:vec2<f32> = add %8, %9
+    %12:vec2<f32> = add %11, %10
+    ret %12
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %arr:ptr<private, array<vec4<f32>, 4>, read_write> = var
+}
+
+%ep = func(%idx:u32):vec2<f32> -> %b2 {
+  %b2 = block {
+    %4:ptr<private, vec4<f32>, read_write> = access %arr, %idx
+    %5:vec4<f32> = load %4
+    %6:vec2<f32> = swizzle %5, zy
+    %7:vec2<f32> = swizzle %5, yz
+    %8:vec2<f32> = add %6, %6
+    %9:vec2<f32> = add %8, %7
+    ret %9
+  }
+}
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, NoModify_DifferentResultTypes) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.u32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        b.Let("a", b.Convert<f32>(param));
+        b.Let("b", b.Convert<i32>(param));
+        b.Let("c", b.Bitcast<f32>(param));
+        b.Let("d", b.Bitcast<i32>(param));
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:u32):void -> %b1 {
+  %b1 = block {
+    %3:f32 = convert %p
+    %a:f32 = let %3
+    %5:i32 = convert %p
+    %b:i32 = let %5
+    %7:f32 = bitcast %p
+    %c:f32 = let %7
+    %9:i32 = bitcast %p
+    %d:i32 = let %9
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, ReuseInNestedBlocks) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* x = b.Multiply<i32>(param, 3_i);
+        auto* ifelse = b.If(b.Equal<bool>(param, 0_i));
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {
+            auto* loop = b.Loop();
+            b.Append(loop->Body(), [&] {
+                b.Let("y", b.Multiply<i32>(param, 3_i));
+                b.ExitLoop(loop);
+            });
+            b.ExitIf(ifelse, b.Multiply<i32>(param, 3_i));
+        });
+        b.Append(ifelse->False(), [&] { b.ExitIf(ifelse, x); });
+        b.Return(ep, b.Add<i32>(ifelse->Result(0), b.Multiply<i32>(param, 3_i)));
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = mul %p, 3i
+    %4:bool = eq %p, 0i
+    %5:i32 = if %4 [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        loop [b: %b4] {  # loop_1
+          %b4 = block {  # body
+            %6:i32 = mul %p, 3i
+            %y:i32 = let %6
+            exit_loop  # loop_1
+          }
+        }
+        %8:i32 = mul %p, 3i
+        exit_if %8  # if_1
+      }
+      %b3 = block {  # false
+        exit_if %3  # if_1
+      }
+    }
+    %9:i32 = mul %p, 3i
+    %10:i32 = add %5, %9
+    ret %10
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = mul %p, 3i
+    %4:bool = eq %p, 0i
+    %5:i32 = if %4 [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        loop [b: %b4] {  # loop_1
+          %b4 = block {  # body
+            %y:i32 = let %3
+            exit_loop  # loop_1
+          }
+        }
+        exit_if %3  # if_1
+      }
+      %b3 = block {  # false
+        exit_if %3  # if_1
+      }
+    }
+    %7:i32 = add %5, %3
+    ret %7
+  }
+}
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, NoModify_SiblingBlocks) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* ifelse = b.If(b.Equal<bool>(param, 0_i));
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] { b.ExitIf(ifelse, b.Multiply<i32>(param, 3_i)); });
+        b.Append(ifelse->False(), [&] { b.ExitIf(ifelse, b.Multiply<i32>(param, 3_i)); });
+        auto* swtch = b.Switch(param);
+        b.Append(b.Case(swtch, {b.Constant(1_i)}), [&] {
+            b.Let("a", b.Multiply<i32>(param, 3_i));
+            b.ExitSwitch(swtch);
+        });
+        b.Append(b.DefaultCase(swtch), [&] {
+            b.Let("b", b.Multiply<i32>(param, 3_i));
+            b.ExitSwitch(swtch);
+        });
+        b.Return(ep, b.Add<i32>(ifelse->Result(0), b.Multiply<i32>(param, 3_i)));
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:bool = eq %p, 0i
+    %4:i32 = if %3 [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        %5:i32 = mul %p, 3i
+        exit_if %5  # if_1
+      }
+      %b3 = block {  # false
+        %6:i32 = mul %p, 3i
+        exit_if %6  # if_1
+      }
+    }
+    switch %p [c: (1i, %b4), c: (default, %b5)] {  # switch_1
+      %b4 = block {  # case
+        %7:i32 = mul %p, 3i
+        %a:i32 = let %7
+        exit_switch  # switch_1
+      }
+      %b5 = block {  # case
+        %9:i32 = mul %p, 3i
+        %b:i32 = let %9
+        exit_switch  # switch_1
+      }
+    }
+    %11:i32 = mul %p, 3i
+    %12:i32 = add %4, %11
+    ret %12
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, NoModify_LoadAfterStoreOrCall) {
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    b.ir.root_block->Append(v);
+
+    auto* f = b.Function("f", ty.void_());
+    b.Append(f->Block(), [&] { b.Return(f); });
+
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        auto* x = b.Load(v);
+        b.Store(v, 1_i);
+        auto* y = b.Load(v);
+        b.Call(f);
+        auto* z = b.Load(v);
+        b.Return(ep, b.Add<i32>(b.Add<i32>(x, y), z));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%f = func():void -> %b2 {
+  %b2 = block {
+    ret
+  }
+}
+%ep = func():i32 -> %b3 {
+  %b3 = block {
+    %4:i32 = load %v
+    store %v, 1i
+    %5:i32 = load %v
+    %6:void = call %f
+    %7:i32 = load %v
+    %8:i32 = add %4, %5
+    %9:i32 = add %8, %7
+    ret %9
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, LoadAfterStoreToOtherFunctionVar) {
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Var<function, i32>("a");
+        auto* c = b.Var<function, array<i32, 4>>("c");
+        auto* x = b.Load(a);
+        b.Store(b.Access<ptr<function, i32>>(c, 1_u), 1_i);
+        auto* y = b.Load(a);
+        b.Store(a, 2_i);
+        auto* z = b.Load(a);
+        b.Return(ep, b.Add<i32>(b.Add<i32>(x, y), z));
+    });
+
+    auto* src = R"(
+%ep = func():i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var
+    %c:ptr<function, array<i32, 4>, read_write> = var
+    %4:i32 = load %a
+    %5:ptr<function, i32, read_write> = access %c, 1u
+    store %5, 1i
+    %6:i32 = load %a
+    store %a, 2i
+    %7:i32 = load %a
+    %8:i32 = add %4, %6
+    %9:i32 = add %8, %7
+    ret %9
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func():i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var
+    %c:ptr<function, array<i32, 4>, read_write> = var
+    %4:i32 = load %a
+    %5:ptr<function, i32, read_write> = access %c, 1u
+    store %5, 1i
+    store %a, 2i
+    %6:i32 = load %a
+    %7:i32 = add %4, %4
+    %8:i32 = add %7, %6
+    ret %8
+  }
+}
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, LoadAfterIfThatStores) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.bool_());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Var<function, i32>("a");
+        auto* c = b.Var<function, i32>("c");
+        auto* x = b.Load(a);
+        auto* y = b.Load(c);
+        auto* ifelse = b.If(param);
+        b.Append(ifelse->True(), [&] {
+            b.Let("t", b.Load(a));
+            b.Store(a, 1_i);
+            b.ExitIf(ifelse);
+        });
+        b.Append(ifelse->False(), [&] {
+            b.Let("f", b.Load(a));
+            b.ExitIf(ifelse);
+        });
+        auto* la = b.Load(a);
+        auto* z = b.Add<i32>(la, b.Load(c));
+        b.Return(ep, b.Add<i32>(b.Add<i32>(x, y), z));
+    });
+
+    auto* src = R"(
+%ep = func(%p:bool):i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var
+    %c:ptr<function, i32, read_write> = var
+    %5:i32 = load %a
+    %6:i32 = load %c
+    if %p [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        %7:i32 = load %a
+        %t:i32 = let %7
+        store %a, 1i
+        exit_if  # if_1
+      }
+      %b3 = block {  # false
+        %9:i32 = load %a
+        %f:i32 = let %9
+        exit_if  # if_1
+      }
+    }
+    %11:i32 = load %a
+    %12:i32 = load %c
+    %13:i32 = add %11, %12
+    %14:i32 = add %5, %6
+    %15:i32 = add %14, %13
+    ret %15
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:bool):i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var
+    %c:ptr<function, i32, read_write> = var
+    %5:i32 = load %a
+    %6:i32 = load %c
+    if %p [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        %t:i32 = let %5
+        store %a, 1i
+        exit_if  # if_1
+      }
+      %b3 = block {  # false
+        %f:i32 = let %5
+        exit_if  # if_1
+      }
+    }
+    %9:i32 = load %a
+    %10:i32 = add %9, %6
+    %11:i32 = add %5, %6
+    %12:i32 = add %11, %10
+    ret %12
+  }
+}
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, LoopThatStores) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Var<function, i32>("a");
+        auto* x = b.Multiply<i32>(param, 3_i);
+        b.Let("x", b.Load(a));
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            auto* y = b.Load(a);
+            b.Store(a, b.Add<i32>(y, b.Multiply<i32>(param, 3_i)));
+            b.Let("y", b.Load(a));
+            b.Continue(loop);
+
+            b.Append(loop->Continuing(), [&] {
+                b.BreakIf(loop, b.Equal<bool>(b.Load(a), x));
+            });
+        });
+        b.Let("z", b.Load(a));
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var
+    %4:i32 = mul %p, 3i
+    %5:i32 = load %a
+    %x:i32 = let %5
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        %7:i32 = load %a
+        %8:i32 = mul %p, 3i
+        %9:i32 = add %7, %8
+        store %a, %9
+        %10:i32 = load %a
+        %y:i32 = let %10
+        continue %b3
+      }
+      %b3 = block {  # continuing
+        %12:i32 = load %a
+        %13:bool = eq %12, %4
+        break_if %13 %b2
+      }
+    }
+    %14:i32 = load %a
+    %z:i32 = let %14
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var
+    %4:i32 = mul %p, 3i
+    %5:i32 = load %a
+    %x:i32 = let %5
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        %7:i32 = load %a
+        %8:i32 = add %7, %4
+        store %a, %8
+        %9:i32 = load %a
+        %y:i32 = let %9
+        continue %b3
+      }
+      %b3 = block {  # continuing
+        %11:bool = eq %9, %4
+        break_if %11 %b2
+      }
+    }
+    %12:i32 = load %a
+    %z:i32 = let %12
+    ret
+  }
+}
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, NoModify_ContinuingAfterEarlyContinue) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            auto* ifelse = b.If(b.Equal<bool>(param, 0_i));
+            b.Append(ifelse->True(), [&] { b.Continue(loop); });
+            b.Let("x", b.Multiply<i32>(param, 3_i));
+            b.Continue(loop);
+
+            b.Append(loop->Continuing(), [&] {
+                b.BreakIf(loop, b.Equal<bool>(b.Multiply<i32>(param, 3_i), 1_i));
+            });
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        %3:bool = eq %p, 0i
+        if %3 [t: %b4] {  # if_1
+          %b4 = block {  # true
+            continue %b3
+          }
+        }
+        %4:i32 = mul %p, 3i
+        %x:i32 = let %4
+        continue %b3
+      }
+      %b3 = block {  # continuing
+        %6:i32 = mul %p, 3i
+        %7:bool = eq %6, 1i
+        break_if %7 %b2
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, LoopBodyValueInContinuing) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            b.Let("x", b.Multiply<i32>(param, 3_i));
+            b.Continue(loop);
+
+            b.Append(loop->Continuing(), [&] {
+                b.BreakIf(loop, b.Equal<bool>(b.Multiply<i32>(param, 3_i), 1_i));
+            });
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        %3:i32 = mul %p, 3i
+        %x:i32 = let %3
+        continue %b3
+      }
+      %b3 = block {  # continuing
+        %5:i32 = mul %p, 3i
+        %6:bool = eq %5, 1i
+        break_if %6 %b2
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        %3:i32 = mul %p, 3i
+        %x:i32 = let %3
+        continue %b3
+      }
+      %b3 = block {  # continuing
+        %5:bool = eq %3, 1i
+        break_if %5 %b2
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, NoModify_BuiltinsWithSideEffectsOrBarriers) {
+    auto* wg = b.Var("wg", ty.ptr<workgroup, i32>());
+    auto* counter = b.Var("counter", ty.ptr<workgroup, atomic<i32>>());
+    b.ir.root_block->Append(wg);
+    b.ir.root_block->Append(counter);
+
+    auto* ep = b.Function("ep", ty.void_());
+    b.Append(ep->Block(), [&] {
+        b.Let("a", b.Call<i32>(core::BuiltinFn::kAtomicAdd, counter, 1_i));
+        b.Let("b", b.Call<i32>(core::BuiltinFn::kAtomicAdd, counter, 1_i));
+        b.Let("c", b.Load(wg));
+        b.Call<void>(core::BuiltinFn::kWorkgroupBarrier);
+        b.Let("d", b.Load(wg));
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %wg:ptr<workgroup, i32, read_write> = var
+  %counter:ptr<workgroup, atomic<i32>, read_write> = var
+}
+
+%ep = func():void -> %b2 {
+  %b2 = block {
+    %4:i32 = atomicAdd %counter, 1i
+    %a:i32 = let %4
+    %6:i32 = atomicAdd %counter, 1i
+    %b:i32 = let %6
+    %8:i32 = load %wg
+    %c:i32 = let %8
+    %10:void = workgroupBarrier
+    %11:i32 = load %wg
+    %d:i32 = let %11
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
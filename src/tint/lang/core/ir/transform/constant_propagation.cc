@@ -0,0 +1,481 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/constant_propagation.h"
+
+#include "src/tint/lang/core/constant/eval.h"
+#include "src/tint/lang/core/intrinsic/dialect.h"
+#include "src/tint/lang/core/intrinsic/table.h"
+#include "src/tint/lang/core/ir/access.h"
+#include "src/tint/lang/core/ir/bitcast.h"
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/construct.h"
+#include "src/tint/lang/core/ir/convert.h"
+#include "src/tint/lang/core/ir/core_binary.h"
+#include "src/tint/lang/core/ir/core_builtin_call.h"
+#include "src/tint/lang/core/ir/core_unary.h"
+#include "src/tint/lang/core/ir/exit.h"
+#include "src/tint/lang/core/ir/if.h"
+#include "src/tint/lang/core/ir/let.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/swizzle.h"
+#include "src/tint/lang/core/ir/switch.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/lang/core/type/array.h"
+#include "src/tint/lang/core/type/matrix.h"
+#include "src/tint/lang/core/type/struct.h"
+#include "src/tint/lang/core/type/vector.h"
+#include "src/tint/utils/rtti/switch.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module& ir;
+
+    /// The IR builder.
+    Builder b{ir};
+
+    /// The diagnostics produced by the constant evaluator.
+    diag::List diags{};
+
+    /// The constant evaluator, using the runtime semantics of the operations.
+    core::constant::Eval eval{ir.constant_values, diags, /* use_runtime_semantics */ true};
+
+    /// The intrinsic table, used to find the constant evaluation function of the core builtins
+    /// and operators.
+    core::intrinsic::Table<core::intrinsic::Dialect> table{ir.Types(), ir.symbols};
+
+    /// The instructions that may be simplified since they were last visited.
+    Vector<Instruction*, 64> worklist{};
+
+    /// Process the module.
+    void Process() {
+        // Push the instructions in reverse so that they are popped in the order they were created,
+        // which visits operands before the instructions that use them.
+        Vector<Instruction*, 64> instructions;
+        for (auto* inst : ir.Instructions()) {
+            if (inst->Block()) {
+                instructions.Push(inst);
+            }
+        }
+        for (size_t i = instructions.Length(); i > 0; i--) {
+            worklist.Push(instructions[i - 1]);
+        }
+
+        while (!worklist.IsEmpty()) {
+            auto* inst = worklist.Pop();
+            if (inst->Alive() && inst->Block()) {
+                Visit(inst);
+            }
+        }
+    }
+
+  private:
+    /// Simplifies @p inst if possible.
+    /// @param inst the instruction
+    void Visit(Instruction* inst) {
+        tint::Switch(
+            inst,  //
+            [&](If* if_) { VisitIf(if_); },
+            [&](Switch* swtch) { VisitSwitch(swtch); },
+            [&](Exit* exit) {
+                // An argument of the exit may have become a constant.
+                if (auto* ctrl = exit->ControlInstruction(); ctrl && ctrl->IsAnyOf<If, Switch>()) {
+                    worklist.Push(ctrl);
+                }
+            },
+            [&](Default) {
+                if (auto* value = Fold(inst)) {
+                    Replace(inst->Result(0), b.Constant(value));
+                    inst->Destroy();
+                }
+            });
+    }
+
+    /// Replaces @p if_ with its taken block if its condition is a constant.
+    /// @param if_ the if instruction
+    void VisitIf(If* if_) {
+        if (auto* cond = if_->Condition()->As<Constant>()) {
+            if (Inline(if_, cond->Value()->ValueAs<bool>() ? if_->True() : if_->False())) {
+                return;
+            }
+        }
+        FoldResults(if_);
+    }
+
+    /// Replaces @p swtch with its taken case if its condition is a constant.
+    /// @param swtch the switch instruction
+    void VisitSwitch(Switch* swtch) {
+        if (auto* cond = swtch->Condition()->As<Constant>()) {
+            ir::Block* taken = nullptr;
+            ir::Block* default_block = nullptr;
+            for (auto& c : swtch->Cases()) {
+                for (auto& selector : c.selectors) {
+                    if (selector.IsDefault()) {
+                        default_block = c.block;
+                    } else if (selector.val->Value()->Equal(cond->Value())) {
+                        taken = c.block;
+                    }
+                }
+            }
+            if (!taken) {
+                taken = default_block;
+            }
+            if (taken && Inline(swtch, taken)) {
+                return;
+            }
+        }
+        FoldResults(swtch);
+    }
+
+    /// Replaces the results of @p ctrl with a constant when every exit of @p ctrl passes that
+    /// same constant.
+    /// @param ctrl the if or switch instruction
+    void FoldResults(ControlInstruction* ctrl) {
+        if (ctrl->Exits().IsEmpty()) {
+            return;
+        }
+        for (size_t i = 0; i < ctrl->Results().Length(); i++) {
+            auto* result = ctrl->Result(i);
+            if (!result->IsUsed()) {
+                continue;
+            }
+            Constant* value = nullptr;
+            for (auto& exit : ctrl->Exits()) {
+                auto* arg = exit->Args()[i]->As<Constant>();
+                if (!arg || (value && !value->Value()->Equal(arg->Value()))) {
+                    value = nullptr;
+                    break;
+                }
+                value = arg;
+            }
+            if (value) {
+                Replace(result, value);
+            }
+        }
+    }
+
+    /// Replaces @p ctrl with the instructions of @p block, which is the only block of @p ctrl that
+    /// can be executed. If @p block does not branch back to @p ctrl, the instructions that follow
+    /// @p ctrl are unreachable and are removed.
+    /// @param ctrl the control instruction
+    /// @param block the taken block
+    /// @returns true if @p ctrl was replaced, false if the control flow could not be simplified
+    bool Inline(ControlInstruction* ctrl, ir::Block* block) {
+        // Exits nested in other control instructions, like a `break` from a switch case inside an
+        // `if`, cannot be removed without restructuring the control flow.
+        for (auto& exit : ctrl->Exits()) {
+            if (exit->Block()->Parent() != ctrl) {
+                return false;
+            }
+        }
+
+        auto* terminator = block->Terminator();
+        if (!terminator && !block->IsEmpty()) {
+            return false;
+        }
+        auto* exit = As<Exit>(terminator);
+        bool falls_through = !terminator || (exit && exit->ControlInstruction() == ctrl);
+
+        if (!falls_through) {
+            Vector<Instruction*, 16> unreachable;
+            for (auto* inst = ctrl->next.Get(); inst; inst = inst->next.Get()) {
+                if (IsUsedOutsideOf(inst, ctrl->Block())) {
+                    return false;
+                }
+                unreachable.Push(inst);
+            }
+            for (size_t i = unreachable.Length(); i > 0; i--) {
+                unreachable[i - 1]->Destroy();
+            }
+        }
+
+        while (auto* inst = block->Front()) {
+            if (falls_through && inst == terminator) {
+                break;
+            }
+            inst->Remove();
+            inst->InsertBefore(ctrl);
+        }
+
+        if (exit && falls_through) {
+            for (size_t i = 0; i < ctrl->Results().Length(); i++) {
+                Replace(ctrl->Result(i), exit->Args()[i]);
+            }
+        }
+        ctrl->Destroy();
+        return true;
+    }
+
+    /// @returns true if the results of @p inst are used outside of @p block and the blocks nested
+    /// in it, like in the continuing block of a loop when @p block is the loop body.
+    /// @param inst the instruction
+    /// @param block the block that holds @p inst
+    bool IsUsedOutsideOf(Instruction* inst, ir::Block* block) {
+        for (auto* result : inst->Results()) {
+            for (auto& usage : result->Usages()) {
+                Instruction* user = usage.instruction;
+                while (user->Block() != block) {
+                    user = user->Block()->Parent();
+                    if (!user) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    /// Replaces all the uses of @p result with @p value, and queues the users for another visit if
+    /// @p value is a constant.
+    /// @param result the result to replace
+    /// @param value the replacement value
+    void Replace(InstructionResult* result, Value* value) {
+        if (value->Is<Constant>()) {
+            for (auto& usage : result->Usages()) {
+                worklist.Push(usage.instruction);
+            }
+        }
+        result->ReplaceAllUsesWith(value);
+    }
+
+    /// @returns the constant value of @p inst if it can be evaluated, otherwise nullptr
+    /// @param inst the instruction
+    const core::constant::Value* Fold(Instruction* inst) {
+        if (inst->Results().Length() != 1) {
+            return nullptr;
+        }
+        auto* ty = inst->Result(0)->Type();
+        return tint::Switch(
+            inst,  //
+            [&](CoreBinary* binary) -> const core::constant::Value* {
+                auto* lhs = binary->LHS()->As<Constant>();
+                auto* rhs = binary->RHS()->As<Constant>();
+                if (!lhs || !rhs) {
+                    return nullptr;
+                }
+                auto overload = table.Lookup(binary->Op(), lhs->Type(), rhs->Type(),
+                                             core::EvaluationStage::kRuntime,
+                                             /* is_compound */ false);
+                if (overload != Success) {
+                    return nullptr;
+                }
+                return Eval(overload->const_eval_fn, ty, Vector{lhs->Value(), rhs->Value()});
+            },
+            [&](CoreUnary* unary) -> const core::constant::Value* {
+                auto* val = unary->Val()->As<Constant>();
+                if (!val) {
+                    return nullptr;
+                }
+                auto overload =
+                    table.Lookup(unary->Op(), val->Type(), core::EvaluationStage::kRuntime);
+                if (overload != Success) {
+                    return nullptr;
+                }
+                return Eval(overload->const_eval_fn, ty, Vector{val->Value()});
+            },
+            [&](CoreBuiltinCall* call) -> const core::constant::Value* {
+                if (core::HasSideEffects(call->Func())) {
+                    return nullptr;
+                }
+                Vector<const core::constant::Value*, 4> args;
+                Vector<const core::type::Type*, 4> arg_types;
+                if (!ConstantArgs(call->Args(), args)) {
+                    return nullptr;
+                }
+                for (auto* arg : args) {
+                    arg_types.Push(arg->Type());
+                }
+                auto overload = table.Lookup(call->Func(), Empty, std::move(arg_types),
+                                             core::EvaluationStage::kRuntime);
+                if (overload != Success) {
+                    return nullptr;
+                }
+                return Eval(overload->const_eval_fn, ty, std::move(args));
+            },
+            [&](Convert* convert) -> const core::constant::Value* {
+                auto* val = convert->Args()[0]->As<Constant>();
+                if (!val) {
+                    return nullptr;
+                }
+                return Eval([&] { return eval.Convert(ty, val->Value(), Source{}); });
+            },
+            [&](Bitcast* bitcast) -> const core::constant::Value* {
+                auto* val = bitcast->Val()->As<Constant>();
+                if (!val) {
+                    return nullptr;
+                }
+                return Eval(&core::constant::Eval::bitcast, ty, Vector{val->Value()});
+            },
+            [&](Construct* construct) -> const core::constant::Value* {
+                Vector<const core::constant::Value*, 4> args;
+                if (!ConstantArgs(construct->Args(), args)) {
+                    return nullptr;
+                }
+                return ConstructValue(ty, std::move(args));
+            },
+            [&](Swizzle* swizzle) -> const core::constant::Value* {
+                auto* obj = swizzle->Object()->As<Constant>();
+                if (!obj) {
+                    return nullptr;
+                }
+                return Eval([&] { return eval.Swizzle(ty, obj->Value(), swizzle->Indices()); });
+            },
+            [&](Access* access) -> const core::constant::Value* {
+                auto* obj = access->Object()->As<Constant>();
+                if (!obj) {
+                    return nullptr;
+                }
+                const core::constant::Value* value = obj->Value();
+                for (auto* index : access->Indices()) {
+                    auto* idx = index->As<Constant>();
+                    if (!idx) {
+                        return nullptr;
+                    }
+                    value = Eval([&] {  //
+                        return eval.Index(value, value->Type(), idx->Value(), Source{});
+                    });
+                    if (!value) {
+                        return nullptr;
+                    }
+                }
+                return value;
+            },
+            [&](Let* let) -> const core::constant::Value* {
+                auto* val = let->Value()->As<Constant>();
+                return val ? val->Value() : nullptr;
+            },
+            [&](Default) -> const core::constant::Value* { return nullptr; });
+    }
+
+    /// @returns the constant value of a construct instruction of type @p ty with the arguments
+    /// @p args, or nullptr if it cannot be evaluated
+    /// @param ty the constructed type
+    /// @param args the constant arguments
+    const core::constant::Value* ConstructValue(const core::type::Type* ty,
+                                                Vector<const core::constant::Value*, 4> args) {
+        if (args.IsEmpty()) {
+            return ir.constant_values.Zero(ty);
+        }
+        if (args.Length() == 1 && args[0]->Type() == ty) {
+            return args[0];
+        }
+        bool all_scalars = true;
+        for (auto* arg : args) {
+            all_scalars = all_scalars && arg->Type()->Is<core::type::Scalar>();
+        }
+        using Fn = core::constant::Eval::Function;
+        Fn fn = tint::Switch(
+            ty,  //
+            [&](const core::type::Vector* vec) -> Fn {
+                if (args.Length() == 1 && all_scalars) {
+                    return &core::constant::Eval::VecSplat;
+                }
+                if (args.Length() == vec->Width() && all_scalars) {
+                    return &core::constant::Eval::VecInitS;
+                }
+                return &core::constant::Eval::VecInitM;
+            },
+            [&](const core::type::Matrix*) -> Fn {
+                return all_scalars ? &core::constant::Eval::MatInitS
+                                   : &core::constant::Eval::MatInitV;
+            },
+            [&](Default) -> Fn { return nullptr; });
+        if (fn) {
+            return Eval(fn, ty, std::move(args));
+        }
+        if (ty->IsAnyOf<core::type::Array, core::type::Struct>()) {
+            return Eval([&] { return eval.ArrayOrStructCtor(ty, std::move(args)); });
+        }
+        return nullptr;
+    }
+
+    /// Appends the constant values of @p values to @p out.
+    /// @returns true if all of @p values are constants
+    /// @param values the values
+    /// @param out the list of constant values
+    bool ConstantArgs(tint::Slice<Value* const> values,
+                      Vector<const core::constant::Value*, 4>& out) {
+        for (auto* value : values) {
+            auto* c = value->As<Constant>();
+            if (!c) {
+                return false;
+            }
+            out.Push(c->Value());
+        }
+        return true;
+    }
+
+    /// @returns the result of the constant evaluation function @p fn called with @p args, or
+    /// nullptr if the function is null or the evaluation fails or raises a diagnostic
+    /// @param fn the constant evaluation function
+    /// @param ty the result type
+    /// @param args the constant arguments
+    const core::constant::Value* Eval(core::constant::Eval::Function fn,
+                                      const core::type::Type* ty,
+                                      VectorRef<const core::constant::Value*> args) {
+        if (!fn) {
+            return nullptr;
+        }
+        return Eval([&] { return (eval.*fn)(ty, std::move(args), Source{}); });
+    }
+
+    /// @returns the result of @p evaluate, or nullptr if the evaluation fails, raises a diagnostic
+    /// or produces no value
+    /// @param evaluate the function that calls the constant evaluator
+    template <typename F>
+    const core::constant::Value* Eval(F&& evaluate) {
+        // Runtime semantics report errors like overflows as warnings and return a value, but the
+        // value may not match what the device would compute, so leave those to the device.
+        size_t num_diags = diags.Count();
+        auto result = evaluate();
+        if (result != Success || diags.Count() != num_diags) {
+            return nullptr;
+        }
+        return result.Get();
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> ConstantPropagation(Module& ir) {
+    auto result = ValidateAndDumpIfNeeded(ir, "ConstantPropagation transform");
+    if (result != Success) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
@@ -0,0 +1,62 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_CONSTANT_PROPAGATION_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_CONSTANT_PROPAGATION_H_
+
+#include "src/tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::core::ir {
+class Module;
+}
+
+namespace tint::core::ir::transform {
+
+/// ConstantPropagation is a transform that evaluates instructions whose operands are all constants,
+/// using the same constant evaluator as the resolver, and propagates the results to their uses.
+/// The transform also:
+/// * replaces `if` and `switch` instructions that have a constant condition with the contents of
+///   the block that is always taken, removing the blocks that are never taken.
+/// * replaces the results of `if` and `switch` instructions with a constant when every exit passes
+///   that same constant.
+/// Instructions that would produce a diagnostic when evaluated, such as an integer division by
+/// zero, are left untouched so that they keep their runtime behavior.
+/// This is constant folding with branch pruning, run to a fixed point. It is not sparse conditional
+/// constant propagation: it does not track which control flow edges are executable, and it does
+/// not propagate constants through the block parameters of loops. A loop variable is therefore
+/// never treated as a constant, and an exit in a block that cannot be executed still stops the
+/// results of its control instruction from being folded, until that block is removed.
+///
+/// @param module the module to transform
+/// @returns error diagnostics on failure
+Result<SuccessType> ConstantPropagation(Module& module);
+
+}  // namespace tint::core::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_CONSTANT_PROPAGATION_H_
@@ -0,0 +1,857 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/constant_propagation.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+using IR_ConstantPropagationTest = TransformTest;
+
+TEST_F(IR_ConstantPropagationTest, Empty) {
+    auto* expect = R"(
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, NoModify_NonConstantOperands) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* x = b.Add<i32>(param, 1_i);
+        auto* y = b.Negation<i32>(x);
+        b.Return(ep, b.Call<i32>(core::BuiltinFn::kAbs, y));
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    %4:i32 = negation %3
+    %5:i32 = abs %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, FoldBinaryAndUnary) {
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        auto* x = b.Let("x", b.Add<i32>(1_i, 2_i));
+        auto* y = b.Multiply<i32>(x, 3_i);
+        b.Return(ep, b.Negation<i32>(y));
+    });
+
+    auto* src = R"(
+%ep = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = add 1i, 2i
+    %x:i32 = let %2
+    %4:i32 = mul %x, 3i
+    %5:i32 = negation %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func():i32 -> %b1 {
+  %b1 = block {
+    ret -9i
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, FoldBuiltinCall) {
+    auto* ep = b.Function("ep", ty.f32());
+    b.Append(ep->Block(), [&] {
+        auto* clamped = b.Call<u32>(core::BuiltinFn::kMin, 5_u, 3_u);
+        auto* x = b.Convert<f32>(clamped);
+        b.Return(ep, b.Call<f32>(core::BuiltinFn::kSqrt, b.Multiply<f32>(x, 3_f)));
+    });
+
+    auto* src = R"(
+%ep = func():f32 -> %b1 {
+  %b1 = block {
+    %2:u32 = min 5u, 3u
+    %3:f32 = convert %2
+    %4:f32 = mul %3, 3.0f
+    %5:f32 = sqrt %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func():f32 -> %b1 {
+  %b1 = block {
+    ret 3.0f
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, NoModify_BuiltinWithSideEffects) {
+    auto* ep = b.Function("ep", ty.void_());
+    b.Append(ep->Block(), [&] {
+        b.Call<void>(core::BuiltinFn::kWorkgroupBarrier);
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func():void -> %b1 {
+  %b1 = block {
+    %2:void = workgroupBarrier
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, NoModify_DivideByZero) {
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] { b.Return(ep, b.Divide<i32>(1_i, 0_i)); });
+
+    auto* src = R"(
+%ep = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = div 1i, 0i
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, FoldConstructSwizzleAndAccess) {
+    auto* ep = b.Function("ep", ty.f32());
+    b.Append(ep->Block(), [&] {
+        auto* v = b.Construct<vec3<f32>>(1_f, 2_f, 3_f);
+        auto* s = b.Swizzle(ty.vec2<f32>(), v, Vector{2u, 1u});
+        b.Return(ep, b.Access<f32>(s, 1_u));
+    });
+
+    auto* src = R"(
+%ep = func():f32 -> %b1 {
+  %b1 = block {
+    %2:vec3<f32> = construct 1.0f, 2.0f, 3.0f
+    %3:vec2<f32> = swizzle %2, zy
+    %4:f32 = access %3, 1u
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func():f32 -> %b1 {
+  %b1 = block {
+    ret 2.0f
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, RobustnessClampOfConstantIndex) {
+    auto* arr = b.Var("arr", ty.ptr<private_, array<f32, 4>>());
+    b.ir.root_block->Append(arr);
+
+    auto* ep = b.Function("ep", ty.f32());
+    b.Append(ep->Block(), [&] {
+        auto* idx = b.Call<u32>(core::BuiltinFn::kMin, 7_u, 3_u);
+        b.Return(ep, b.Load(b.Access<ptr<private_, f32>>(arr, idx)));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %arr:ptr<private, array<f32, 4>, read_write> = var
+}
+
+%ep = func():f32 -> %b2 {
+  %b2 = block {
+    %3:u32 = min 7u, 3u
+    %4:ptr<private, f32, read_write> = access %arr, %3
+    %5:f32 = load %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %arr:ptr<private, array<f32, 4>, read_write> = var
+}
+
+%ep = func():f32 -> %b2 {
+  %b2 = block {
+    %3:ptr<private, f32, read_write> = access %arr, 3u
+    %4:f32 = load %3
+    ret %4
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, IfTrue) {
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    b.ir.root_block->Append(v);
+
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        auto* ifelse = b.If(b.Equal<bool>(1_i, 1_i));
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {
+            b.Store(v, 1_i);
+            b.ExitIf(ifelse, b.Load(v));
+        });
+        b.Append(ifelse->False(), [&] {
+            b.Store(v, 2_i);
+            b.ExitIf(ifelse, 2_i);
+        });
+        b.Return(ep, b.Add<i32>(ifelse->Result(0), 1_i));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():i32 -> %b2 {
+  %b2 = block {
+    %3:bool = eq 1i, 1i
+    %4:i32 = if %3 [t: %b3, f: %b4] {  # if_1
+      %b3 = block {  # true
+        store %v, 1i
+        %5:i32 = load %v
+        exit_if %5  # if_1
+      }
+      %b4 = block {  # false
+        store %v, 2i
+        exit_if 2i  # if_1
+      }
+    }
+    %6:i32 = add %4, 1i
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():i32 -> %b2 {
+  %b2 = block {
+    store %v, 1i
+    %3:i32 = load %v
+    %4:i32 = add %3, 1i
+    ret %4
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, IfFalse) {
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    b.ir.root_block->Append(v);
+
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        auto* ifelse = b.If(false);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {
+            b.Store(v, 1_i);
+            b.ExitIf(ifelse, b.Load(v));
+        });
+        b.Append(ifelse->False(), [&] {
+            b.Store(v, 2_i);
+            b.ExitIf(ifelse, 2_i);
+        });
+        b.Return(ep, b.Add<i32>(ifelse->Result(0), 1_i));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():i32 -> %b2 {
+  %b2 = block {
+    %3:i32 = if false [t: %b3, f: %b4] {  # if_1
+      %b3 = block {  # true
+        store %v, 1i
+        %4:i32 = load %v
+        exit_if %4  # if_1
+      }
+      %b4 = block {  # false
+        store %v, 2i
+        exit_if 2i  # if_1
+      }
+    }
+    %5:i32 = add %3, 1i
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():i32 -> %b2 {
+  %b2 = block {
+    store %v, 2i
+    ret 3i
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, IfFalse_NoElse) {
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    b.ir.root_block->Append(v);
+
+    auto* ep = b.Function("ep", ty.void_());
+    b.Append(ep->Block(), [&] {
+        auto* ifelse = b.If(false);
+        b.Append(ifelse->True(), [&] {
+            b.Store(v, 1_i);
+            b.ExitIf(ifelse);
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():void -> %b2 {
+  %b2 = block {
+    if false [t: %b3] {  # if_1
+      %b3 = block {  # true
+        store %v, 1i
+        exit_if  # if_1
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():void -> %b2 {
+  %b2 = block {
+    ret
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, IfTrue_Return) {
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    b.ir.root_block->Append(v);
+
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        auto* ifelse = b.If(true);
+        b.Append(ifelse->True(), [&] { b.Return(ep, 1_i); });
+        b.Store(v, 2_i);
+        b.Return(ep, b.Load(v));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():i32 -> %b2 {
+  %b2 = block {
+    if true [t: %b3] {  # if_1
+      %b3 = block {  # true
+        ret 1i
+      }
+    }
+    store %v, 2i
+    %3:i32 = load %v
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():i32 -> %b2 {
+  %b2 = block {
+    ret 1i
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, NoModify_IfTrue_ReturnFromLoopBodyUsedInContinuing) {
+    auto* ep = b.Function("ep", ty.void_());
+    b.Append(ep->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            auto* ifelse = b.If(true);
+            b.Append(ifelse->True(), [&] { b.Return(ep); });
+            auto* x = b.Load(b.Var<function, u32>("v"));
+            b.Continue(loop);
+
+            b.Append(loop->Continuing(), [&] { b.BreakIf(loop, b.Equal<bool>(x, 1_u)); });
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func():void -> %b1 {
+  %b1 = block {
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        if true [t: %b4] {  # if_1
+          %b4 = block {  # true
+            ret
+          }
+        }
+        %v:ptr<function, u32, read_write> = var
+        %3:u32 = load %v
+        continue %b3
+      }
+      %b3 = block {  # continuing
+        %4:bool = eq %3, 1u
+        break_if %4 %b2
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, IfTrue_ExitLoop) {
+    auto* ep = b.Function("ep", ty.void_());
+    b.Append(ep->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            auto* ifelse = b.If(true);
+            b.Append(ifelse->True(), [&] { b.ExitLoop(loop); });
+            auto* v = b.Var<function, u32>("v");
+            b.Store(v, 1_u);
+            b.Continue(loop);
+
+            b.Append(loop->Continuing(), [&] { b.BreakIf(loop, true); });
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func():void -> %b1 {
+  %b1 = block {
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        if true [t: %b4] {  # if_1
+          %b4 = block {  # true
+            exit_loop  # loop_1
+          }
+        }
+        %v:ptr<function, u32, read_write> = var
+        store %v, 1u
+        continue %b3
+      }
+      %b3 = block {  # continuing
+        break_if true %b2
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func():void -> %b1 {
+  %b1 = block {
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        exit_loop  # loop_1
+      }
+      %b3 = block {  # continuing
+        break_if true %b2
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, SwitchCase) {
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    b.ir.root_block->Append(v);
+
+    auto* ep = b.Function("ep", ty.void_());
+    b.Append(ep->Block(), [&] {
+        auto* swtch = b.Switch(b.Add<i32>(1_i, 1_i));
+        b.Append(b.Case(swtch, {b.Constant(1_i)}), [&] {
+            b.Store(v, 1_i);
+            b.ExitSwitch(swtch);
+        });
+        b.Append(b.Case(swtch, {b.Constant(2_i), b.Constant(3_i)}), [&] {
+            b.Store(v, 2_i);
+            b.ExitSwitch(swtch);
+        });
+        b.Append(b.DefaultCase(swtch), [&] {
+            b.Store(v, 3_i);
+            b.ExitSwitch(swtch);
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():void -> %b2 {
+  %b2 = block {
+    %3:i32 = add 1i, 1i
+    switch %3 [c: (1i, %b3), c: (2i 3i, %b4), c: (default, %b5)] {  # switch_1
+      %b3 = block {  # case
+        store %v, 1i
+        exit_switch  # switch_1
+      }
+      %b4 = block {  # case
+        store %v, 2i
+        exit_switch  # switch_1
+      }
+      %b5 = block {  # case
+        store %v, 3i
+        exit_switch  # switch_1
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():void -> %b2 {
+  %b2 = block {
+    store %v, 2i
+    ret
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, SwitchDefault) {
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    b.ir.root_block->Append(v);
+
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        auto* swtch = b.Switch(5_i);
+        swtch->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(b.Case(swtch, {b.Constant(1_i)}), [&] {
+            b.Store(v, 1_i);
+            b.ExitSwitch(swtch, 1_i);
+        });
+        b.Append(b.Case(swtch, {b.Constant(2_i), nullptr}), [&] {
+            b.Store(v, 2_i);
+            b.ExitSwitch(swtch, 2_i);
+        });
+        b.Return(ep, swtch->Result(0));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():i32 -> %b2 {
+  %b2 = block {
+    %3:i32 = switch 5i [c: (1i, %b3), c: (2i default, %b4)] {  # switch_1
+      %b3 = block {  # case
+        store %v, 1i
+        exit_switch 1i  # switch_1
+      }
+      %b4 = block {  # case
+        store %v, 2i
+        exit_switch 2i  # switch_1
+      }
+    }
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():i32 -> %b2 {
+  %b2 = block {
+    store %v, 2i
+    ret 2i
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, NoModify_SwitchWithNestedExit) {
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    b.ir.root_block->Append(v);
+
+    auto* ep = b.Function("ep", ty.void_());
+    ep->SetParams({cond});
+    b.Append(ep->Block(), [&] {
+        auto* swtch = b.Switch(1_i);
+        b.Append(b.Case(swtch, {b.Constant(1_i), nullptr}), [&] {
+            auto* ifelse = b.If(cond);
+            b.Append(ifelse->True(), [&] { b.ExitSwitch(swtch); });
+            b.Store(v, 1_i);
+            b.ExitSwitch(swtch);
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func(%cond:bool):void -> %b2 {
+  %b2 = block {
+    switch 1i [c: (1i default, %b3)] {  # switch_1
+      %b3 = block {  # case
+        if %cond [t: %b4] {  # if_1
+          %b4 = block {  # true
+            exit_switch  # switch_1
+          }
+        }
+        store %v, 1i
+        exit_switch  # switch_1
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantPropagationTest, IfResultSameConstantOnAllExits) {
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    b.ir.root_block->Append(v);
+
+    auto* ep = b.Function("ep", ty.i32());
+    ep->SetParams({cond});
+    b.Append(ep->Block(), [&] {
+        auto* ifelse = b.If(cond);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {
+            b.Store(v, 1_i);
+            b.ExitIf(ifelse, b.Add<i32>(2_i, 2_i));
+        });
+        b.Append(ifelse->False(), [&] {
+            b.Store(v, 2_i);
+            b.ExitIf(ifelse, 4_i);
+        });
+        b.Return(ep, b.Multiply<i32>(ifelse->Result(0), 2_i));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func(%cond:bool):i32 -> %b2 {
+  %b2 = block {
+    %4:i32 = if %cond [t: %b3, f: %b4] {  # if_1
+      %b3 = block {  # true
+        store %v, 1i
+        %5:i32 = add 2i, 2i
+        exit_if %5  # if_1
+      }
+      %b4 = block {  # false
+        store %v, 2i
+        exit_if 4i  # if_1
+      }
+    }
+    %6:i32 = mul %4, 2i
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func(%cond:bool):i32 -> %b2 {
+  %b2 = block {
+    %4:i32 = if %cond [t: %b3, f: %b4] {  # if_1
+      %b3 = block {  # true
+        store %v, 1i
+        exit_if 4i  # if_1
+      }
+      %b4 = block {  # false
+        store %v, 2i
+        exit_if 4i  # if_1
+      }
+    }
+    ret 8i
+  }
+}
+)";
+
+    Run(ConstantPropagation);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
@@ -167,6 +167,7 @@ struct State {
 
             // Create the helper function.
             auto* func = b.Function(name.str(), res_ty);
+            func->SetAlwaysInline(true);
             auto* value = b.FunctionParam("value", src_ty);
             func->SetParams({value});
             b.Append(func->Block(), [&] {
@@ -0,0 +1,234 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/dead_code_elimination.h"
+
+#include "src/tint/lang/core/ir/access.h"
+#include "src/tint/lang/core/ir/binary.h"
+#include "src/tint/lang/core/ir/bitcast.h"
+#include "src/tint/lang/core/ir/construct.h"
+#include "src/tint/lang/core/ir/convert.h"
+#include "src/tint/lang/core/ir/core_builtin_call.h"
+#include "src/tint/lang/core/ir/function.h"
+#include "src/tint/lang/core/ir/let.h"
+#include "src/tint/lang/core/ir/load.h"
+#include "src/tint/lang/core/ir/load_vector_element.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/store.h"
+#include "src/tint/lang/core/ir/store_vector_element.h"
+#include "src/tint/lang/core/ir/swizzle.h"
+#include "src/tint/lang/core/ir/unary.h"
+#include "src/tint/lang/core/ir/user_call.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/lang/core/ir/var.h"
+#include "src/tint/lang/core/type/pointer.h"
+#include "src/tint/lang/core/type/void.h"
+#include "src/tint/utils/rtti/switch.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module& ir;
+
+    /// The instructions that may have become dead since they were last checked.
+    Vector<Instruction*, 64> worklist{};
+
+    /// Process the module.
+    void Process() {
+        RemoveUncalledFunctions();
+
+        for (auto* inst : ir.Instructions()) {
+            if (inst->Block()) {
+                worklist.Push(inst);
+            }
+        }
+        while (!worklist.IsEmpty()) {
+            auto* inst = worklist.Pop();
+            if (inst->Alive() && inst->Block()) {
+                TryRemove(inst);
+            }
+        }
+    }
+
+  private:
+    /// Removes the functions that are not entry points and are never called.
+    void RemoveUncalledFunctions() {
+        bool removed = true;
+        while (removed) {
+            removed = false;
+            // Callers are declared after their callees, so visit the functions in reverse order
+            // to remove whole call trees in a single pass.
+            for (size_t i = ir.functions.Length(); i > 0; i--) {
+                Function* fn = ir.functions[i - 1];
+                if (fn->Alive() && fn->Stage() == Function::PipelineStage::kUndefined &&
+                    !IsCalled(fn)) {
+                    fn->Destroy();
+                    removed = true;
+                }
+            }
+        }
+        ir.functions.EraseIf([](auto& fn) { return !fn->Alive(); });
+    }
+
+    /// @returns true if @p fn is called by any function
+    /// @param fn the function
+    bool IsCalled(Function* fn) {
+        for (auto& usage : fn->Usages()) {
+            // Functions are also used by their own return instructions.
+            if (usage.instruction->Is<UserCall>()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Removes @p inst if it is dead.
+    /// @param inst the instruction
+    void TryRemove(Instruction* inst) {
+        if (auto* var = inst->As<Var>()) {
+            TryRemoveVar(var);
+            return;
+        }
+        if (!HasNoSideEffects(inst)) {
+            return;
+        }
+        for (auto* result : inst->Results()) {
+            if (result->IsUsed()) {
+                return;
+            }
+        }
+        Remove(inst);
+    }
+
+    /// Removes @p var if it is a function-scope, private or workgroup variable that is never used,
+    /// or a function-scope or private variable that is only ever stored to, in which case its
+    /// stores are removed too.
+    /// @param var the variable
+    void TryRemoveVar(Var* var) {
+        // Shader IO and resource variables are part of the interface of the shader, even when they
+        // are not used.
+        auto* ptr = var->Result(0);
+        auto space = ptr->Type()->As<core::type::Pointer>()->AddressSpace();
+        if (space != core::AddressSpace::kFunction && space != core::AddressSpace::kPrivate &&
+            space != core::AddressSpace::kWorkgroup) {
+            return;
+        }
+
+        if (!ptr->IsUsed()) {
+            Remove(var);
+            return;
+        }
+        if (space == core::AddressSpace::kWorkgroup) {
+            return;
+        }
+
+        Vector<Instruction*, 8> stores;
+        if (!IsOnlyStoredTo(ptr, stores)) {
+            return;
+        }
+        for (auto* store : stores) {
+            Remove(store);
+        }
+        Remove(var);
+    }
+
+    /// @returns true if the only uses of the pointer @p ptr are stores through it, either directly
+    /// or through access instructions.
+    /// @param ptr the pointer value
+    /// @param stores the list that the stores and accesses are appended to, with each access
+    /// after all the instructions that use it.
+    bool IsOnlyStoredTo(Value* ptr, Vector<Instruction*, 8>& stores) {
+        for (auto& usage : ptr->Usages()) {
+            auto* inst = usage.instruction;
+            bool is_store = tint::Switch(
+                inst,
+                [&](Store*) { return usage.operand_index == Store::kToOperandOffset; },
+                [&](StoreVectorElement*) {
+                    return usage.operand_index == StoreVectorElement::kToOperandOffset;
+                },
+                [&](Access* access) {
+                    return usage.operand_index == Access::kObjectOperandOffset &&
+                           IsOnlyStoredTo(access->Result(0), stores);
+                },
+                [&](Default) { return false; });
+            if (!is_store) {
+                return false;
+            }
+            stores.Push(inst);
+        }
+        return true;
+    }
+
+    /// @returns true if @p inst can be removed without changing the behavior of the program when
+    /// its results are unused.
+    /// @param inst the instruction
+    bool HasNoSideEffects(Instruction* inst) {
+        if (inst->IsAnyOf<Access, Binary, Bitcast, Construct, Convert, Let, Load,
+                          LoadVectorElement, Swizzle, Unary>()) {
+            return true;
+        }
+        if (auto* call = inst->As<CoreBuiltinCall>()) {
+            return !core::HasSideEffects(call->Func()) &&
+                   !call->Result(0)->Type()->Is<core::type::Void>();
+        }
+        return false;
+    }
+
+    /// Destroys @p inst and queues the instructions of its operands, which may now be dead.
+    /// @param inst the instruction
+    void Remove(Instruction* inst) {
+        Vector<Value*, 8> operands(inst->Operands());
+        inst->Destroy();
+        for (auto* operand : operands) {
+            if (auto* result = As<InstructionResult>(operand)) {
+                if (auto* producer = result->Instruction()) {
+                    worklist.Push(producer);
+                }
+            }
+        }
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> DeadCodeElimination(Module& ir) {
+    auto result = ValidateAndDumpIfNeeded(ir, "DeadCodeElimination transform");
+    if (result != Success) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
@@ -0,0 +1,489 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/dead_code_elimination.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+using IR_DeadCodeEliminationTest = TransformTest;
+
+TEST_F(IR_DeadCodeEliminationTest, Empty) {
+    auto* expect = R"(
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_UsedValues) {
+    auto* ep = b.Function("ep", ty.f32(), Function::PipelineStage::kFragment);
+    ep->SetReturnLocation(0_u, {});
+    b.Append(ep->Block(), [&] {
+        auto* x = b.Let("x", 1_f);
+        auto* y = b.Multiply<f32>(x, 2_f);
+        b.Return(ep, b.Call<f32>(core::BuiltinFn::kAbs, y));
+    });
+
+    auto* src = R"(
+%ep = @fragment func():f32 [@location(0)] -> %b1 {
+  %b1 = block {
+    %x:f32 = let 1.0f
+    %3:f32 = mul %x, 2.0f
+    %4:f32 = abs %3
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UnusedValueChain) {
+    auto* ep = b.Function("ep", ty.f32(), Function::PipelineStage::kFragment);
+    ep->SetReturnLocation(0_u, {});
+    b.Append(ep->Block(), [&] {
+        auto* x = b.Let("x", 1_f);
+        auto* y = b.Multiply<f32>(x, 2_f);
+        auto* v = b.Construct<vec2<f32>>(y, x);
+        b.Let("unused", b.Swizzle(ty.vec2<f32>(), v, Vector{1u, 0u}));
+        b.Call<f32>(core::BuiltinFn::kAbs, y);
+        b.Return(ep, 0.5_f);
+    });
+
+    auto* src = R"(
+%ep = @fragment func():f32 [@location(0)] -> %b1 {
+  %b1 = block {
+    %x:f32 = let 1.0f
+    %3:f32 = mul %x, 2.0f
+    %4:vec2<f32> = construct %3, %x
+    %5:vec2<f32> = swizzle %4, yx
+    %unused:vec2<f32> = let %5
+    %7:f32 = abs %3
+    ret 0.5f
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = @fragment func():f32 [@location(0)] -> %b1 {
+  %b1 = block {
+    ret 0.5f
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_SideEffects) {
+    auto* buffer = b.Var("buffer", ty.ptr<storage, atomic<i32>>());
+    buffer->SetBindingPoint(0, 0);
+    mod.root_block->Append(buffer);
+
+    auto* foo = b.Function("foo", ty.i32());
+    b.Append(foo->Block(), [&] { b.Return(foo, 1_i); });
+
+    auto* ep = b.Function("ep", ty.void_(), Function::PipelineStage::kCompute,
+                          std::array<uint32_t, 3>{1u, 1u, 1u});
+    b.Append(ep->Block(), [&] {
+        b.Call(ty.i32(), foo);
+        b.Call<i32>(core::BuiltinFn::kAtomicAdd, buffer, 1_i);
+        b.Call<void>(core::BuiltinFn::kStorageBarrier);
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %buffer:ptr<storage, atomic<i32>, read_write> = var @binding_point(0, 0)
+}
+
+%foo = func():i32 -> %b2 {
+  %b2 = block {
+    ret 1i
+  }
+}
+%ep = @compute @workgroup_size(1, 1, 1) func():void -> %b3 {
+  %b3 = block {
+    %4:i32 = call %foo
+    %5:i32 = atomicAdd %buffer, 1i
+    %6:void = storageBarrier
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UncalledFunctions) {
+    auto* leaf = b.Function("leaf", ty.i32());
+    b.Append(leaf->Block(), [&] { b.Return(leaf, 1_i); });
+
+    auto* helper = b.Function("helper", ty.i32());
+    b.Append(helper->Block(), [&] { b.Return(helper, b.Call(ty.i32(), leaf)); });
+
+    auto* used = b.Function("used", ty.f32());
+    b.Append(used->Block(), [&] { b.Return(used, 0.5_f); });
+
+    auto* unused = b.Function("unused", ty.i32());
+    b.Append(unused->Block(), [&] { b.Return(unused, b.Call(ty.i32(), helper)); });
+
+    auto* ep = b.Function("ep", ty.f32(), Function::PipelineStage::kFragment);
+    ep->SetReturnLocation(0_u, {});
+    b.Append(ep->Block(), [&] { b.Return(ep, b.Call(ty.f32(), used)); });
+
+    auto* src = R"(
+%leaf = func():i32 -> %b1 {
+  %b1 = block {
+    ret 1i
+  }
+}
+%helper = func():i32 -> %b2 {
+  %b2 = block {
+    %3:i32 = call %leaf
+    ret %3
+  }
+}
+%used = func():f32 -> %b3 {
+  %b3 = block {
+    ret 0.5f
+  }
+}
+%unused = func():i32 -> %b4 {
+  %b4 = block {
+    %6:i32 = call %helper
+    ret %6
+  }
+}
+%ep = @fragment func():f32 [@location(0)] -> %b5 {
+  %b5 = block {
+    %8:f32 = call %used
+    ret %8
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%used = func():f32 -> %b1 {
+  %b1 = block {
+    ret 0.5f
+  }
+}
+%ep = @fragment func():f32 [@location(0)] -> %b2 {
+  %b2 = block {
+    %3:f32 = call %used
+    ret %3
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UnreferencedModuleScopeVars) {
+    auto* used = b.Var("used", ty.ptr<uniform, f32>());
+    used->SetBindingPoint(0, 0);
+    mod.root_block->Append(used);
+    auto* unused = b.Var("unused", ty.ptr<storage, f32>());
+    unused->SetBindingPoint(0, 1);
+    mod.root_block->Append(unused);
+    auto* only_in_unused_fn = b.Var<workgroup, f32>("only_in_unused_fn");
+    mod.root_block->Append(only_in_unused_fn);
+
+    auto* unused_fn = b.Function("unused_fn", ty.f32());
+    b.Append(unused_fn->Block(), [&] { b.Return(unused_fn, b.Load(only_in_unused_fn)); });
+
+    auto* ep = b.Function("ep", ty.f32(), Function::PipelineStage::kFragment);
+    ep->SetReturnLocation(0_u, {});
+    b.Append(ep->Block(), [&] { b.Return(ep, b.Load(used)); });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %used:ptr<uniform, f32, read> = var @binding_point(0, 0)
+  %unused:ptr<storage, f32, read_write> = var @binding_point(0, 1)
+  %only_in_unused_fn:ptr<workgroup, f32, read_write> = var
+}
+
+%unused_fn = func():f32 -> %b2 {
+  %b2 = block {
+    %5:f32 = load %only_in_unused_fn
+    ret %5
+  }
+}
+%ep = @fragment func():f32 [@location(0)] -> %b3 {
+  %b3 = block {
+    %7:f32 = load %used
+    ret %7
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %used:ptr<uniform, f32, read> = var @binding_point(0, 0)
+  %unused:ptr<storage, f32, read_write> = var @binding_point(0, 1)
+}
+
+%ep = @fragment func():f32 [@location(0)] -> %b2 {
+  %b2 = block {
+    %4:f32 = load %used
+    ret %4
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_ShaderIOAndResourceVars) {
+    auto* sample_index =
+        b.Var("sample_index", ty.ptr(core::AddressSpace::kIn, ty.u32(), core::Access::kRead));
+    IOAttributes sample_index_attrs;
+    sample_index_attrs.builtin = core::BuiltinValue::kSampleIndex;
+    sample_index->SetAttributes(sample_index_attrs);
+    mod.root_block->Append(sample_index);
+    auto* color =
+        b.Var("color", ty.ptr(core::AddressSpace::kIn, ty.vec4<f32>(), core::Access::kRead));
+    IOAttributes color_attrs;
+    color_attrs.location = 0u;
+    color_attrs.interpolation = Interpolation{core::InterpolationType::kPerspective,
+                                              core::InterpolationSampling::kSample};
+    color->SetAttributes(color_attrs);
+    mod.root_block->Append(color);
+    auto* out = b.Var("out", ty.ptr(core::AddressSpace::kOut, ty.vec4<f32>()));
+    IOAttributes out_attrs;
+    out_attrs.location = 0u;
+    out->SetAttributes(out_attrs);
+    mod.root_block->Append(out);
+    auto* buffer = b.Var("buffer", ty.ptr<uniform, vec4<f32>>());
+    buffer->SetBindingPoint(0, 0);
+    mod.root_block->Append(buffer);
+
+    auto* ep = b.Function("ep", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(ep->Block(), [&] {
+        b.Store(out, b.Splat<vec4<f32>>(1_f, 4));
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %sample_index:ptr<__in, u32, read> = var @builtin(sample_index)
+  %color:ptr<__in, vec4<f32>, read> = var @location(0) @interpolate(perspective, sample)
+  %out:ptr<__out, vec4<f32>, read_write> = var @location(0)
+  %buffer:ptr<uniform, vec4<f32>, read> = var @binding_point(0, 0)
+}
+
+%ep = @fragment func():void -> %b2 {
+  %b2 = block {
+    store %out, vec4<f32>(1.0f)
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, DeadStores) {
+    auto* priv = b.Var<private_, f32>("priv");
+    mod.root_block->Append(priv);
+    auto* buffer = b.Var("buffer", ty.ptr<storage, f32>());
+    buffer->SetBindingPoint(0, 0);
+    mod.root_block->Append(buffer);
+
+    auto* ep = b.Function("ep", ty.void_(), Function::PipelineStage::kCompute,
+                          std::array<uint32_t, 3>{1u, 1u, 1u});
+    b.Append(ep->Block(), [&] {
+        auto* value = b.Load(buffer);
+        auto* v = b.Var<function, vec4<f32>>("v");
+        b.Store(v, b.Construct<vec4<f32>>(value, value, value, value));
+        b.StoreVectorElement(v, 1_u, 2_f);
+        auto* a = b.Var<function, array<f32, 4>>("a");
+        auto* element = b.Access<ptr<function, f32>>(a, 2_u);
+        b.Store(element, b.Multiply<f32>(value, 3_f));
+        b.Store(priv, value);
+        b.Store(buffer, 4_f);
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %priv:ptr<private, f32, read_write> = var
+  %buffer:ptr<storage, f32, read_write> = var @binding_point(0, 0)
+}
+
+%ep = @compute @workgroup_size(1, 1, 1) func():void -> %b2 {
+  %b2 = block {
+    %4:f32 = load %buffer
+    %v:ptr<function, vec4<f32>, read_write> = var
+    %6:vec4<f32> = construct %4, %4, %4, %4
+    store %v, %6
+    store_vector_element %v, 1u, 2.0f
+    %a:ptr<function, array<f32, 4>, read_write> = var
+    %8:ptr<function, f32, read_write> = access %a, 2u
+    %9:f32 = mul %4, 3.0f
+    store %8, %9
+    store %priv, %4
+    store %buffer, 4.0f
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %buffer:ptr<storage, f32, read_write> = var @binding_point(0, 0)
+}
+
+%ep = @compute @workgroup_size(1, 1, 1) func():void -> %b2 {
+  %b2 = block {
+    store %buffer, 4.0f
+    ret
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_StoredVarIsRead) {
+    auto* ep = b.Function("ep", ty.f32(), Function::PipelineStage::kFragment);
+    ep->SetReturnLocation(0_u, {});
+    b.Append(ep->Block(), [&] {
+        auto* v = b.Var<function, f32>("v");
+        b.Store(v, 1_f);
+        auto* ifelse = b.If(true);
+        b.Append(ifelse->True(), [&] {
+            b.Store(v, 2_f);
+            b.ExitIf(ifelse);
+        });
+        b.Return(ep, b.Load(v));
+    });
+
+    auto* src = R"(
+%ep = @fragment func():f32 [@location(0)] -> %b1 {
+  %b1 = block {
+    %v:ptr<function, f32, read_write> = var
+    store %v, 1.0f
+    if true [t: %b2] {  # if_1
+      %b2 = block {  # true
+        store %v, 2.0f
+        exit_if  # if_1
+      }
+    }
+    %3:f32 = load %v
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_VarPassedToFunction) {
+    auto* param = b.FunctionParam("p", ty.ptr<function, f32>());
+    auto* foo = b.Function("foo", ty.void_());
+    foo->SetParams({param});
+    b.Append(foo->Block(), [&] { b.Return(foo); });
+
+    auto* ep = b.Function("ep", ty.void_(), Function::PipelineStage::kCompute,
+                          std::array<uint32_t, 3>{1u, 1u, 1u});
+    b.Append(ep->Block(), [&] {
+        auto* v = b.Var<function, f32>("v");
+        b.Store(v, 1_f);
+        b.Call(ty.void_(), foo, v);
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%foo = func(%p:ptr<function, f32, read_write>):void -> %b1 {
+  %b1 = block {
+    ret
+  }
+}
+%ep = @compute @workgroup_size(1, 1, 1) func():void -> %b2 {
+  %b2 = block {
+    %v:ptr<function, f32, read_write> = var
+    store %v, 1.0f
+    %5:void = call %foo, %v
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
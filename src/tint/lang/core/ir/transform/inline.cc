@@ -0,0 +1,278 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/inline.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/clone_context.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/lang/core/type/void.h"
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/containers/hashset.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// PIMPL state for the transform.
+struct State {
+    /// The transform config.
+    const InlineConfig& config;
+
+    /// The IR module.
+    Module& ir;
+
+    /// The IR builder.
+    Builder b{ir};
+
+    /// The functions that have already been visited.
+    Hashset<Function*, 16> visited{};
+
+    /// The function that holds each function body block.
+    Hashmap<Block*, Function*, 16> function_blocks{};
+
+    /// The functions that have had calls inlined into them.
+    Hashset<Function*, 16> modified{};
+
+    /// Process the module.
+    void Process() {
+        for (auto& func : ir.functions) {
+            function_blocks.Add(func->Block(), func);
+        }
+        for (auto& func : ir.functions) {
+            Visit(func);
+        }
+        ir.functions.EraseIf([](auto& fn) { return !fn->Alive(); });
+
+        Vector<const Function*, 8> modified_functions;
+        for (auto& func : ir.functions) {
+            if (modified.Contains(func.Get())) {
+                modified_functions.Push(func);
+            }
+        }
+        SetModifiedFunctions(ir, std::move(modified_functions));
+    }
+
+  private:
+    /// Visits @p fn after the functions that it calls, and inlines it into its callers if it is
+    /// small enough.
+    /// @param fn the function
+    void Visit(Function* fn) {
+        if (!visited.Add(fn)) {
+            return;
+        }
+
+        // Inline the functions called by this function first. The calls are gathered before
+        // visiting the callees, as inlining them modifies the blocks of this function.
+        Vector<Function*, 8> callees;
+        ForeachInstruction(fn->Block(), [&](Instruction* inst) {
+            if (auto* call = inst->As<UserCall>()) {
+                callees.Push(call->Target());
+            }
+        });
+        for (auto* callee : callees) {
+            Visit(callee);
+        }
+
+        if (fn->Stage() != Function::PipelineStage::kUndefined || !ShouldInline(fn) ||
+            !CanInline(fn->Block(), /* in_loop_or_switch */ false)) {
+            return;
+        }
+
+        Vector<UserCall*, 8> calls;
+        for (auto& usage : fn->Usages()) {
+            // Functions are also used by their own return instructions.
+            if (auto* call = usage.instruction->As<UserCall>()) {
+                calls.Push(call);
+            }
+        }
+        if (calls.IsEmpty()) {
+            return;
+        }
+        for (auto* call : calls) {
+            modified.Add(FunctionOf(call));
+            InlineCall(call, fn);
+        }
+        fn->Destroy();
+    }
+
+    /// @returns the function that holds @p inst
+    /// @param inst the instruction
+    Function* FunctionOf(Instruction* inst) {
+        auto* block = inst->Block();
+        while (auto* parent = block->Parent()) {
+            block = parent->Block();
+        }
+        return *function_blocks.Get(block);
+    }
+
+    /// @returns true if @p fn should be inlined into its callers
+    /// @param fn the function
+    bool ShouldInline(Function* fn) {
+        if (config.always_inline_helpers && fn->AlwaysInline()) {
+            return true;
+        }
+        uint32_t count = 0;
+        ForeachInstruction(fn->Block(), [&](Instruction*) { count++; });
+        return count <= config.max_instructions;
+    }
+
+    /// @returns true if the instructions of @p block can be inlined, which is when they only
+    /// return from inside `if` instructions
+    /// @param block the block
+    /// @param in_loop_or_switch true if @p block is nested in a `loop` or `switch` instruction
+    bool CanInline(Block* block, bool in_loop_or_switch) {
+        for (auto* inst : *block) {
+            if (inst->Is<Return>() && in_loop_or_switch) {
+                return false;
+            }
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                bool ok = true;
+                ctrl->ForeachBlock([&](Block* inner) {
+                    ok = ok && CanInline(inner, in_loop_or_switch || !ctrl->Is<If>());
+                });
+                if (!ok) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /// Replaces @p call with the instructions of @p fn.
+    /// @param call the call
+    /// @param fn the function called by @p call
+    void InlineCall(UserCall* call, Function* fn) {
+        // Clone the body of the function, replacing the parameters with the call arguments.
+        CloneContext ctx{ir};
+        auto params = fn->Params();
+        auto args = call->Args();
+        for (size_t i = 0; i < params.Length(); i++) {
+            ctx.Replace<Value, Value>(params[i], args[i]);
+        }
+        auto* body = b.Block();
+        fn->Block()->CloneInto(ctx, body);
+
+        Vector<Return*, 4> returns;
+        bool in_loop = InLoop(call->Block());
+        ForeachInstruction(body, [&](Instruction* inst) {
+            if (auto* ret = inst->As<Return>()) {
+                returns.Push(ret);
+            } else if (auto* var = inst->As<Var>(); var && in_loop && !var->Initializer()) {
+                // The variable was zero-initialized on each call, but a variable without an
+                // initializer in a loop is only zero-initialized on the first iteration.
+                var->SetInitializer(b.Zero(var->Result(0)->Type()->UnwrapPtr()));
+            }
+        });
+
+        auto* result = call->Result(0);
+        if (returns.Length() == 1 && returns[0] == body->Terminator()) {
+            // The function only returns at the end of its body, so its instructions can be moved
+            // to before the call.
+            auto* value = returns[0]->Value();
+            returns[0]->Destroy();
+            for (auto* inst = body->Front(); inst;) {
+                auto* next = inst->next.Get();
+                inst->Remove();
+                inst->InsertBefore(call);
+                inst = next;
+            }
+            if (value) {
+                result->ReplaceAllUsesWith(value);
+            }
+        } else {
+            // The function returns from inside an `if`, so wrap its instructions in a loop that
+            // exits on each return.
+            auto* loop = b.Loop();
+            if (!fn->ReturnType()->Is<core::type::Void>()) {
+                loop->SetResults(b.InstructionResult(fn->ReturnType()));
+            }
+            for (auto* inst = body->Front(); inst;) {
+                auto* next = inst->next.Get();
+                inst->Remove();
+                loop->Body()->Append(inst);
+                inst = next;
+            }
+            for (auto* ret : returns) {
+                auto* value = ret->Value();
+                ret->ReplaceWith(value ? b.ExitLoop(loop, value) : b.ExitLoop(loop));
+                ret->Destroy();
+            }
+            loop->InsertBefore(call);
+            if (!loop->Results().IsEmpty()) {
+                result->ReplaceAllUsesWith(loop->Result(0));
+            }
+        }
+        call->Destroy();
+    }
+
+    /// @returns true if @p block is nested in a `loop` instruction
+    /// @param block the block
+    bool InLoop(Block* block) {
+        for (auto* ctrl = block->Parent(); ctrl; ctrl = ctrl->Block()->Parent()) {
+            if (ctrl->Is<Loop>()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Calls @p callback with each of the instructions of @p block, including the instructions
+    /// nested in its control instructions.
+    /// @param block the block
+    /// @param callback the function to call with each instruction
+    template <typename F>
+    void ForeachInstruction(Block* block, F&& callback) {
+        for (auto* inst = block->Front(); inst;) {
+            auto* next = inst->next.Get();
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                ctrl->ForeachBlock([&](Block* inner) { ForeachInstruction(inner, callback); });
+            }
+            callback(inst);
+            inst = next;
+        }
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> Inline(Module& ir, const InlineConfig& config) {
+    auto result = ValidateAndDumpIfNeeded(ir, "Inline transform");
+    if (result != Success) {
+        return result;
+    }
+
+    State{config, ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
@@ -0,0 +1,68 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_INLINE_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_INLINE_H_
+
+#include <cstdint>
+
+#include "src/tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::core::ir {
+class Module;
+}
+
+namespace tint::core::ir::transform {
+
+/// The set of functions that should be inlined by the Inline transform.
+struct InlineConfig {
+    /// Functions with at most this number of instructions, including the instructions nested in
+    /// their control instructions, are inlined into their callers.
+    uint32_t max_instructions = 8;
+
+    /// Should the functions marked with Function::SetAlwaysInline() be inlined regardless of their
+    /// size?
+    bool always_inline_helpers = true;
+};
+
+/// Inline is a transform that replaces calls to user functions with the body of the function.
+/// Callees are processed before their callers, so the size of a function includes the functions
+/// that were inlined into it. A function that returns from inside an `if` is inlined as a loop
+/// that exits on each return, as the `ret` instructions become `exit_loop` instructions. Functions
+/// that return from inside a `loop` or `switch` are not inlined. Functions that are no longer
+/// called after inlining are removed.
+///
+/// @param module the module to transform
+/// @param config the transform config
+/// @returns error diagnostics on failure
+Result<SuccessType> Inline(Module& module, const InlineConfig& config);
+
+}  // namespace tint::core::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_INLINE_H_
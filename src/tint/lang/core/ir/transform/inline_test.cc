@@ -0,0 +1,642 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/inline.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+class IR_InlineTest : public TransformTest {
+  protected:
+    /// Creates a function `add_one(p:i32):i32` that returns `p + 1`.
+    /// @returns the function
+    Function* AddOne() {
+        auto* fn = b.Function("add_one", ty.i32());
+        auto* p = b.FunctionParam("p", ty.i32());
+        fn->SetParams({p});
+        b.Append(fn->Block(), [&] { b.Return(fn, b.Add<i32>(p, 1_i)); });
+        return fn;
+    }
+};
+
+TEST_F(IR_InlineTest, NoModify_NoCalls) {
+    auto* ep = b.Function("ep", ty.i32(), Function::PipelineStage::kCompute, {{1, 1, 1}});
+    b.Append(ep->Block(), [&] { b.Return(ep, 1_i); });
+
+    auto* src = R"(
+%ep = @compute @workgroup_size(1, 1, 1) func():i32 -> %b1 {
+  %b1 = block {
+    ret 1i
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    InlineConfig config;
+    config.max_instructions = 100;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineTest, SmallFunction) {
+    auto* add_one = AddOne();
+
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("param", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* x = b.Call(add_one, param);
+        b.Return(ep, b.Multiply<i32>(x, 2_i));
+    });
+
+    auto* src = R"(
+%add_one = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    ret %3
+  }
+}
+%ep = func(%param:i32):i32 -> %b2 {
+  %b2 = block {
+    %6:i32 = call %add_one, %param
+    %7:i32 = mul %6, 2i
+    ret %7
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%param:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %param, 1i
+    %4:i32 = mul %3, 2i
+    ret %4
+  }
+}
+)";
+
+    InlineConfig config;
+    config.max_instructions = 2;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineTest, NoModify_LargerThanThreshold) {
+    auto* add_one = AddOne();
+
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("param", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] { b.Return(ep, b.Call(add_one, param)); });
+
+    auto* src = R"(
+%add_one = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    ret %3
+  }
+}
+%ep = func(%param:i32):i32 -> %b2 {
+  %b2 = block {
+    %6:i32 = call %add_one, %param
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    InlineConfig config;
+    config.max_instructions = 1;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineTest, AlwaysInlineHelper) {
+    auto* add_one = AddOne();
+    add_one->SetAlwaysInline(true);
+
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("param", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] { b.Return(ep, b.Call(add_one, param)); });
+
+    auto* src = R"(
+%add_one = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    ret %3
+  }
+}
+%ep = func(%param:i32):i32 -> %b2 {
+  %b2 = block {
+    %6:i32 = call %add_one, %param
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%param:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %param, 1i
+    ret %3
+  }
+}
+)";
+
+    InlineConfig config;
+    config.max_instructions = 0;
+    config.always_inline_helpers = true;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineTest, NoModify_AlwaysInlineHelperWhenDisabled) {
+    auto* add_one = AddOne();
+    add_one->SetAlwaysInline(true);
+
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("param", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] { b.Return(ep, b.Call(add_one, param)); });
+
+    auto* src = R"(
+%add_one = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    ret %3
+  }
+}
+%ep = func(%param:i32):i32 -> %b2 {
+  %b2 = block {
+    %6:i32 = call %add_one, %param
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    InlineConfig config;
+    config.max_instructions = 0;
+    config.always_inline_helpers = false;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineTest, MultipleCallSitesAndNestedCalls) {
+    auto* add_one = AddOne();
+
+    auto* add_two = b.Function("add_two", ty.i32());
+    auto* p = b.FunctionParam("p", ty.i32());
+    add_two->SetParams({p});
+    b.Append(add_two->Block(), [&] {
+        auto* x = b.Call(add_one, p);
+        b.Return(add_two, b.Call(add_one, x));
+    });
+
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("param", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* x = b.Call(add_two, param);
+        b.Return(ep, b.Call(add_two, x));
+    });
+
+    auto* src = R"(
+%add_one = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    ret %3
+  }
+}
+%add_two = func(%p_1:i32):i32 -> %b2 {  # %p_1: 'p'
+  %b2 = block {
+    %6:i32 = call %add_one, %p_1
+    %7:i32 = call %add_one, %6
+    ret %7
+  }
+}
+%ep = func(%param:i32):i32 -> %b3 {
+  %b3 = block {
+    %10:i32 = call %add_two, %param
+    %11:i32 = call %add_two, %10
+    ret %11
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%param:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %param, 1i
+    %4:i32 = add %3, 1i
+    %5:i32 = add %4, 1i
+    %6:i32 = add %5, 1i
+    ret %6
+  }
+}
+)";
+
+    InlineConfig config;
+    config.max_instructions = 4;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineTest, ReturnInsideIf) {
+    auto* fn = b.Function("f", ty.i32());
+    auto* p = b.FunctionParam("p", ty.i32());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* ifelse = b.If(b.LessThan<bool>(p, 0_i));
+        b.Append(ifelse->True(), [&] { b.Return(fn, 0_i); });
+        b.Return(fn, p);
+    });
+
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("param", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* x = b.Call(fn, param);
+        b.Return(ep, b.Multiply<i32>(x, 2_i));
+    });
+
+    auto* src = R"(
+%f = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:bool = lt %p, 0i
+    if %3 [t: %b2] {  # if_1
+      %b2 = block {  # true
+        ret 0i
+      }
+    }
+    ret %p
+  }
+}
+%ep = func(%param:i32):i32 -> %b3 {
+  %b3 = block {
+    %6:i32 = call %f, %param
+    %7:i32 = mul %6, 2i
+    ret %7
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%param:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = loop [b: %b2] {  # loop_1
+      %b2 = block {  # body
+        %4:bool = lt %param, 0i
+        if %4 [t: %b3] {  # if_1
+          %b3 = block {  # true
+            exit_loop 0i  # loop_1
+          }
+        }
+        exit_loop %param  # loop_1
+      }
+    }
+    %5:i32 = mul %3, 2i
+    ret %5
+  }
+}
+)";
+
+    InlineConfig config;
+    config.max_instructions = 10;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineTest, VoidReturnInsideIf) {
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    b.ir.root_block->Append(v);
+
+    auto* fn = b.Function("f", ty.void_());
+    auto* p = b.FunctionParam("p", ty.bool_());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* ifelse = b.If(p);
+        b.Append(ifelse->True(), [&] { b.Return(fn); });
+        b.Append(ifelse->False(), [&] {
+            b.Store(v, 1_i);
+            b.Return(fn);
+        });
+        b.Unreachable();
+    });
+
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("param", ty.bool_());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        b.Call(fn, param);
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%f = func(%p:bool):void -> %b2 {
+  %b2 = block {
+    if %p [t: %b3, f: %b4] {  # if_1
+      %b3 = block {  # true
+        ret
+      }
+      %b4 = block {  # false
+        store %v, 1i
+        ret
+      }
+    }
+    unreachable
+  }
+}
+%ep = func(%param:bool):void -> %b5 {
+  %b5 = block {
+    %6:void = call %f, %param
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func(%param:bool):void -> %b2 {
+  %b2 = block {
+    loop [b: %b3] {  # loop_1
+      %b3 = block {  # body
+        if %param [t: %b4, f: %b5] {  # if_1
+          %b4 = block {  # true
+            exit_loop  # loop_1
+          }
+          %b5 = block {  # false
+            store %v, 1i
+            exit_loop  # loop_1
+          }
+        }
+        unreachable
+      }
+    }
+    ret
+  }
+}
+)";
+
+    InlineConfig config;
+    config.max_instructions = 10;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineTest, NoModify_ReturnInsideLoopOrSwitch) {
+    auto* f = b.Function("f", ty.i32());
+    b.Append(f->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] { b.Return(f, 1_i); });
+        b.Unreachable();
+    });
+
+    auto* g = b.Function("g", ty.i32());
+    auto* p = b.FunctionParam("p", ty.i32());
+    g->SetParams({p});
+    b.Append(g->Block(), [&] {
+        auto* swtch = b.Switch(p);
+        b.Append(b.Case(swtch, {b.Constant(1_i)}), [&] { b.Return(g, 1_i); });
+        b.Append(b.DefaultCase(swtch), [&] { b.ExitSwitch(swtch); });
+        b.Return(g, 2_i);
+    });
+
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] { b.Return(ep, b.Call(g, b.Call(f))); });
+
+    auto* src = R"(
+%f = func():i32 -> %b1 {
+  %b1 = block {
+    loop [b: %b2] {  # loop_1
+      %b2 = block {  # body
+        ret 1i
+      }
+    }
+    unreachable
+  }
+}
+%g = func(%p:i32):i32 -> %b3 {
+  %b3 = block {
+    switch %p [c: (1i, %b4), c: (default, %b5)] {  # switch_1
+      %b4 = block {  # case
+        ret 1i
+      }
+      %b5 = block {  # case
+        exit_switch  # switch_1
+      }
+    }
+    ret 2i
+  }
+}
+%ep = func():i32 -> %b6 {
+  %b6 = block {
+    %5:i32 = call %f
+    %6:i32 = call %g, %5
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    InlineConfig config;
+    config.max_instructions = 100;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineTest, VarInCallInsideLoop) {
+    auto* fn = b.Function("f", ty.i32());
+    b.Append(fn->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        b.Store(v, b.Add<i32>(b.Load(v), 1_i));
+        b.Return(fn, b.Load(v));
+    });
+
+    auto* ep = b.Function("ep", ty.void_());
+    b.Append(ep->Block(), [&] {
+        b.Let("x", b.Call(fn));
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            b.Let("y", b.Call(fn));
+            b.ExitLoop(loop);
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%f = func():i32 -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var
+    %3:i32 = load %v
+    %4:i32 = add %3, 1i
+    store %v, %4
+    %5:i32 = load %v
+    ret %5
+  }
+}
+%ep = func():void -> %b2 {
+  %b2 = block {
+    %7:i32 = call %f
+    %x:i32 = let %7
+    loop [b: %b3] {  # loop_1
+      %b3 = block {  # body
+        %9:i32 = call %f
+        %y:i32 = let %9
+        exit_loop  # loop_1
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func():void -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var
+    %3:i32 = load %v
+    %4:i32 = add %3, 1i
+    store %v, %4
+    %5:i32 = load %v
+    %x:i32 = let %5
+    loop [b: %b2] {  # loop_1
+      %b2 = block {  # body
+        %v_1:ptr<function, i32, read_write> = var, 0i  # %v_1: 'v'
+        %8:i32 = load %v_1
+        %9:i32 = add %8, 1i
+        store %v_1, %9
+        %10:i32 = load %v_1
+        %y:i32 = let %10
+        exit_loop  # loop_1
+      }
+    }
+    ret
+  }
+}
+)";
+
+    InlineConfig config;
+    config.max_instructions = 10;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineTest, PointerParameter) {
+    auto* fn = b.Function("f", ty.void_());
+    auto* p = b.FunctionParam("p", ty.ptr<function, i32>());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        b.Store(p, 1_i);
+        b.Return(fn);
+    });
+
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        b.Call(fn, v);
+        b.Return(ep, b.Load(v));
+    });
+
+    auto* src = R"(
+%f = func(%p:ptr<function, i32, read_write>):void -> %b1 {
+  %b1 = block {
+    store %p, 1i
+    ret
+  }
+}
+%ep = func():i32 -> %b2 {
+  %b2 = block {
+    %v:ptr<function, i32, read_write> = var
+    %5:void = call %f, %v
+    %6:i32 = load %v
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func():i32 -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var
+    store %v, 1i
+    %3:i32 = load %v
+    ret %3
+  }
+}
+)";
+
+    InlineConfig config;
+    config.max_instructions = 10;
+    Run(Inline, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
@@ -0,0 +1,359 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/core/ir/transform/loop_invariant_code_motion.h"
+
+#include <functional>
+#include <utility>
+
+#include "src/tint/lang/core/ir/access.h"
+#include "src/tint/lang/core/ir/analysis/memory_writes.h"
+#include "src/tint/lang/core/ir/binary.h"
+#include "src/tint/lang/core/ir/bitcast.h"
+#include "src/tint/lang/core/ir/block_param.h"
+#include "src/tint/lang/core/ir/break_if.h"
+#include "src/tint/lang/core/ir/constant.h"
+#include "src/tint/lang/core/ir/construct.h"
+#include "src/tint/lang/core/ir/continue.h"
+#include "src/tint/lang/core/ir/convert.h"
+#include "src/tint/lang/core/ir/core_builtin_call.h"
+#include "src/tint/lang/core/ir/exit.h"
+#include "src/tint/lang/core/ir/function.h"
+#include "src/tint/lang/core/ir/let.h"
+#include "src/tint/lang/core/ir/load.h"
+#include "src/tint/lang/core/ir/load_vector_element.h"
+#include "src/tint/lang/core/ir/loop.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/multi_in_block.h"
+#include "src/tint/lang/core/ir/next_iteration.h"
+#include "src/tint/lang/core/ir/swizzle.h"
+#include "src/tint/lang/core/ir/unary.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/lang/core/ir/var.h"
+#include "src/tint/lang/core/type/pointer.h"
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/rtti/switch.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module& ir;
+
+    /// The block that declares each block parameter.
+    Hashmap<BlockParam*, Block*, 8> param_blocks{};
+
+    /// Process the module.
+    void Process() {
+        Vector<const Function*, 8> modified;
+        for (auto& func : ir.functions) {
+            Vector<Loop*, 8> loops;
+            CollectLoops(func->Block(), loops);
+            bool hoisted = false;
+            for (auto* loop : loops) {
+                hoisted |= Hoist(loop);
+            }
+            if (hoisted) {
+                modified.Push(func);
+            }
+        }
+        SetModifiedFunctions(ir, std::move(modified));
+    }
+
+    /// Appends the loops nested in @p block to @p loops, with inner loops before the loops that
+    /// hold them. Also records the block of each block parameter.
+    /// @param block the block
+    /// @param loops the list of loops
+    void CollectLoops(Block* block, Vector<Loop*, 8>& loops) {
+        if (auto* multi_in = block->As<MultiInBlock>()) {
+            for (auto* param : multi_in->Params()) {
+                param_blocks.Add(param, block);
+            }
+        }
+        for (auto* inst = block->Front(); inst; inst = inst->next.Get()) {
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                ctrl->ForeachBlock([&](Block* b) { CollectLoops(b, loops); });
+                if (auto* loop = ctrl->As<Loop>()) {
+                    loops.Push(loop);
+                }
+            }
+        }
+    }
+
+    /// Moves the invariant instructions of the body of @p loop to before @p loop.
+    /// @param loop the loop
+    /// @returns true if any instruction was moved
+    bool Hoist(Loop* loop) {
+        auto writes = WritesOf(loop);
+        return HoistFrom(loop->Body(), loop, writes, true);
+    }
+
+    /// Moves the invariant instructions of @p block, and of the `if` and `switch` instructions
+    /// nested in it, to before @p loop.
+    /// @param block the block in the body of @p loop
+    /// @param loop the loop
+    /// @param writes the memory that the loop may write to
+    /// @param executed true if the first instruction of @p block is executed each time the loop
+    /// body is entered
+    /// @returns true if any instruction was moved
+    bool HoistFrom(Block* block, Loop* loop, const analysis::MemoryWrites& writes, bool executed) {
+        // Once an instruction may leave the block, the instructions that follow it are only moved
+        // if they cannot trap.
+        bool hoisted = false;
+        for (auto* inst = block->Front(); inst;) {
+            auto* next = inst->next.Get();
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                if (!ctrl->Is<Loop>()) {
+                    ctrl->ForeachBlock(
+                        [&](Block* b) { hoisted |= HoistFrom(b, loop, writes, false); });
+                }
+                if (MayLeave(ctrl)) {
+                    executed = false;
+                }
+            } else if (CanHoist(inst, loop, writes, executed)) {
+                inst->Remove();
+                inst->InsertBefore(loop);
+                hoisted = true;
+            }
+            inst = next;
+        }
+        return hoisted;
+    }
+
+    /// @returns true if @p inst can be moved to before @p loop
+    /// @param inst the instruction in the loop body
+    /// @param loop the loop
+    /// @param writes the memory that the loop may write to
+    /// @param executed true if @p inst is executed each time the loop body is entered
+    bool CanHoist(Instruction* inst,
+                  Loop* loop,
+                  const analysis::MemoryWrites& writes,
+                  bool executed) {
+        if (inst->Results().Length() != 1) {
+            return false;
+        }
+        for (auto* operand : inst->Operands()) {
+            if (operand && !IsInvariant(operand, loop)) {
+                return false;
+            }
+        }
+        return tint::Switch(
+            inst,  //
+            [&](Access* access) {
+                // Indexing into a value with a dynamic index could read out of bounds.
+                return executed || access->Object()->Type()->Is<core::type::Pointer>() ||
+                       AllConstant(access->Indices());
+            },
+            [&](Binary* binary) {
+                // Integer division by zero is undefined in some backends.
+                auto op = binary->Op();
+                if ((op == BinaryOp::kDivide || op == BinaryOp::kModulo) &&
+                    binary->Result(0)->Type()->is_integer_scalar_or_vector()) {
+                    return executed;
+                }
+                return true;
+            },
+            [&](Unary*) { return true; },
+            [&](Bitcast*) { return true; },
+            [&](Construct*) { return true; },
+            [&](Convert*) { return true; },
+            [&](Swizzle*) { return true; },
+            [&](Let*) { return true; },
+            [&](CoreBuiltinCall* call) {
+                // The length of a runtime-sized array does not change while the shader runs.
+                return call->Func() == core::BuiltinFn::kArrayLength || analysis::IsPure(call);
+            },
+            [&](Load* load) { return CanHoistLoad(load->From(), writes, executed); },
+            [&](LoadVectorElement* load) {
+                return (executed || load->Index()->Is<Constant>()) &&
+                       CanHoistLoad(load->From(), writes, executed);
+            },
+            [&](Default) { return false; });
+    }
+
+    /// @returns true if a load from @p ptr can be moved to before the loop
+    /// @param ptr the pointer that is loaded from
+    /// @param writes the memory that the loop may write to
+    /// @param executed true if the load is executed each time the loop body is entered
+    bool CanHoistLoad(Value* ptr, const analysis::MemoryWrites& writes, bool executed) {
+        Var* var = nullptr;
+        while (auto* result = As<InstructionResult>(ptr)) {
+            auto* inst = result->Instruction();
+            if (auto* access = inst->As<Access>()) {
+                // Loading through a dynamic index could read out of bounds.
+                if (!executed && !AllConstant(access->Indices())) {
+                    return false;
+                }
+                ptr = access->Object();
+            } else if (auto* let = inst->As<Let>()) {
+                ptr = let->Value();
+            } else {
+                var = inst->As<Var>();
+                break;
+            }
+        }
+        if (!var) {
+            return false;
+        }
+
+        auto* ptr_ty = var->Result(0)->Type()->As<core::type::Pointer>();
+        switch (ptr_ty->AddressSpace()) {
+            case core::AddressSpace::kUniform:
+            case core::AddressSpace::kPushConstant:
+                return true;
+            case core::AddressSpace::kStorage:
+                return ptr_ty->Access() == core::Access::kRead;
+            case core::AddressSpace::kFunction:
+            case core::AddressSpace::kPrivate:
+                return !writes.any && !writes.vars.Contains(var);
+            default:
+                // Workgroup memory can be written to by the other invocations.
+                return false;
+        }
+    }
+
+    /// @returns true if @p value is not computed inside @p loop
+    /// @param value the value
+    /// @param loop the loop
+    bool IsInvariant(Value* value, Loop* loop) {
+        if (auto* result = value->As<InstructionResult>()) {
+            return !IsInLoop(result->Instruction()->Block(), loop);
+        }
+        if (auto* param = value->As<BlockParam>()) {
+            auto block = param_blocks.Get(param);
+            return block && !IsInLoop(*block, loop);
+        }
+        // Constants and function parameters.
+        return true;
+    }
+
+    /// @returns true if @p block is one of the blocks of @p loop, or is nested in one of them
+    /// @param block the block
+    /// @param loop the loop
+    bool IsInLoop(Block* block, Loop* loop) {
+        while (block) {
+            auto* ctrl = block->Parent();
+            if (!ctrl) {
+                return false;
+            }
+            if (ctrl == loop) {
+                return true;
+            }
+            block = ctrl->Block();
+        }
+        return false;
+    }
+
+    /// @returns true if @p inst is @p ctrl, or is nested in one of the blocks of @p ctrl
+    /// @param inst the instruction
+    /// @param ctrl the control instruction
+    bool IsIn(Instruction* inst, ControlInstruction* ctrl) {
+        while (inst) {
+            if (inst == ctrl) {
+                return true;
+            }
+            inst = inst->Block() ? inst->Block()->Parent() : nullptr;
+        }
+        return false;
+    }
+
+    /// @returns true if @p ctrl may branch to somewhere other than the instruction that follows
+    /// it, or may not complete
+    /// @param ctrl the control instruction
+    bool MayLeave(ControlInstruction* ctrl) {
+        if (ctrl->Is<Loop>()) {
+            // A loop may never complete.
+            return true;
+        }
+        bool leaves = false;
+        ForeachNestedBlock(ctrl, [&](Block* block) {
+            tint::Switch(
+                block->Terminator(),  //
+                [&](Exit* exit) { leaves |= !IsIn(exit->ControlInstruction(), ctrl); },
+                [&](Continue* cont) { leaves |= !IsIn(cont->Loop(), ctrl); },
+                [&](NextIteration* next) { leaves |= !IsIn(next->Loop(), ctrl); },
+                [&](BreakIf* break_if) { leaves |= !IsIn(break_if->Loop(), ctrl); },
+                [&](Terminator*) { leaves = true; });
+        });
+        return leaves;
+    }
+
+    /// @returns the memory that @p loop may write to
+    /// @param loop the loop
+    analysis::MemoryWrites WritesOf(Loop* loop) {
+        analysis::MemoryWrites writes;
+        ForeachNestedBlock(loop, [&](Block* block) {
+            for (auto* inst = block->Front(); inst; inst = inst->next.Get()) {
+                writes.Add(inst, analysis::TrackedVars::kAll);
+            }
+        });
+        return writes;
+    }
+
+    /// Calls @p cb for each block of @p ctrl, and each block nested in them.
+    /// @param ctrl the control instruction
+    /// @param cb the callback
+    void ForeachNestedBlock(ControlInstruction* ctrl, const std::function<void(Block*)>& cb) {
+        ctrl->ForeachBlock([&](Block* block) {
+            cb(block);
+            for (auto* inst = block->Front(); inst; inst = inst->next.Get()) {
+                if (auto* nested = inst->As<ControlInstruction>()) {
+                    ForeachNestedBlock(nested, cb);
+                }
+            }
+        });
+    }
+
+    /// @returns true if all of @p values are constants
+    /// @param values the values
+    bool AllConstant(tint::Slice<Value* const> values) {
+        for (auto* value : values) {
+            if (!value->Is<Constant>()) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> LoopInvariantCodeMotion(Module& ir) {
+    auto result = ValidateAndDumpIfNeeded(ir, "LoopInvariantCodeMotion transform");
+    if (result != Success) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
@@ -0,0 +1,58 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_LOOP_INVARIANT_CODE_MOTION_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_LOOP_INVARIANT_CODE_MOTION_H_
+
+#include "src/tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::core::ir {
+class Module;
+}
+
+namespace tint::core::ir::transform {
+
+/// LoopInvariantCodeMotion is a transform that moves the instructions of a loop body whose operands
+/// are all defined outside of the loop to just before the loop, so that they are only evaluated
+/// once. Inner loops are processed before the loops that hold them, so invariant instructions can
+/// move out of several loops.
+/// Only instructions without side effects are moved. Loads are only moved when the memory cannot be
+/// written to while the loop runs. Instructions that the loop may not execute, because they are
+/// inside an `if` or `switch` or come after an instruction that can leave the loop, are only
+/// moved when evaluating them early cannot trap, so integer division and dynamically indexed loads
+/// stay in the loop. Derivative, texture,
+/// subgroup and barrier builtins are never moved, as they depend on the invocations that execute
+/// them together.
+///
+/// @param module the module to transform
+/// @returns error diagnostics on failure
+Result<SuccessType> LoopInvariantCodeMotion(Module& module);
+
+}  // namespace tint::core::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_LOOP_INVARIANT_CODE_MOTION_H_
@@ -0,0 +1,1335 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/core/ir/transform/loop_invariant_code_motion.h"
+
+#include <functional>
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+#include "src/tint/lang/core/type/sampled_texture.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+class IR_LoopInvariantCodeMotionTest : public TransformTest {
+  protected:
+    /// Appends `for (var i = 0i; i < n; i++) { body }` to the current block.
+    /// @param n the loop bound
+    /// @param body the callback that builds the rest of the loop body
+    /// @returns the loop
+    Loop* ForLoop(Value* n, std::function<void(Var* i)> body) {
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_i);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(b.LessThan<bool>(b.Load(i), n));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                body(i);
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<i32>(b.Load(i), 1_i));
+                b.NextIteration(loop);
+            });
+        });
+        return loop;
+    }
+};
+
+TEST_F(IR_LoopInvariantCodeMotionTest, Empty) {
+    auto* expect = R"(
+)";
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, HoistArithmetic) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        ForLoop(param, [&](Var* i) {
+            auto* x = b.Multiply<i32>(param, 2_i);
+            auto* y = b.Add<i32>(x, 1_i);
+            auto* z = b.Add<i32>(y, b.Load(i));
+            b.Store(sum, z);
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:i32 = load %i
+        %6:bool = lt %5, %p
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:i32 = mul %p, 2i
+        %8:i32 = add %7, 1i
+        %9:i32 = load %i
+        %10:i32 = add %8, %9
+        store %sum, %10
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %11:i32 = load %i
+        %12:i32 = add %11, 1i
+        store %i, %12
+        next_iteration %b3
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    %4:i32 = mul %p, 2i
+    %5:i32 = add %4, 1i
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %7:i32 = load %i
+        %8:bool = lt %7, %p
+        if %8 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %9:i32 = load %i
+        %10:i32 = add %5, %9
+        store %sum, %10
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %11:i32 = load %i
+        %12:i32 = add %11, 1i
+        store %i, %12
+        next_iteration %b3
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(expect, str());
+    ASSERT_TRUE(mod.modified_functions.has_value());
+    ASSERT_EQ(mod.modified_functions->Length(), 1u);
+    EXPECT_EQ(mod.modified_functions->Front(), ep);
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, HoistUniformLoad) {
+    auto* s = ty.Struct(mod.symbols.New("S"), {
+                                                  {mod.symbols.New("a"), ty.i32()},
+                                                  {mod.symbols.New("b"), ty.array<i32, 4>()},
+                                              });
+    auto* u = b.Var("u", ty.ptr(uniform, s));
+    u->SetBindingPoint(0, 0);
+    mod.root_block->Append(u);
+
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        ForLoop(param, [&](Var*) {
+            auto* a = b.Load(b.Access(ty.ptr<uniform, i32>(), u, 0_u));
+            auto* e = b.Load(b.Access(ty.ptr<uniform, i32>(), u, 1_u, 2_u));
+            // A dynamic index could be out of bounds, and the loop may not have executed it.
+            auto* d = b.Load(b.Access(ty.ptr<uniform, i32>(), u, 1_u, param));
+            auto* x = b.Add<i32>(a, e);
+            b.Store(sum, b.Add<i32>(x, d));
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+S = struct @align(4) {
+  a:i32 @offset(0)
+  b:array<i32, 4> @offset(4)
+}
+
+%b1 = block {  # root
+  %u:ptr<uniform, S, read> = var @binding_point(0, 0)
+}
+
+%ep = func(%p:i32):void -> %b2 {
+  %b2 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [i: %b3, b: %b4, c: %b5] {  # loop_1
+      %b3 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b4
+      }
+      %b4 = block {  # body
+        %6:i32 = load %i
+        %7:bool = lt %6, %p
+        if %7 [t: %b6, f: %b7] {  # if_1
+          %b6 = block {  # true
+            exit_if  # if_1
+          }
+          %b7 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %8:ptr<uniform, i32, read> = access %u, 0u
+        %9:i32 = load %8
+        %10:ptr<uniform, i32, read> = access %u, 1u, 2u
+        %11:i32 = load %10
+        %12:ptr<uniform, i32, read> = access %u, 1u, %p
+        %13:i32 = load %12
+        %14:i32 = add %9, %11
+        %15:i32 = add %14, %13
+        store %sum, %15
+        continue %b5
+      }
+      %b5 = block {  # continuing
+        %16:i32 = load %i
+        %17:i32 = add %16, 1i
+        store %i, %17
+        next_iteration %b4
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+S = struct @align(4) {
+  a:i32 @offset(0)
+  b:array<i32, 4> @offset(4)
+}
+
+%b1 = block {  # root
+  %u:ptr<uniform, S, read> = var @binding_point(0, 0)
+}
+
+%ep = func(%p:i32):void -> %b2 {
+  %b2 = block {
+    %sum:ptr<function, i32, read_write> = var
+    %5:ptr<uniform, i32, read> = access %u, 0u
+    %6:i32 = load %5
+    %7:ptr<uniform, i32, read> = access %u, 1u, 2u
+    %8:i32 = load %7
+    %9:ptr<uniform, i32, read> = access %u, 1u, %p
+    %10:i32 = add %6, %8
+    loop [i: %b3, b: %b4, c: %b5] {  # loop_1
+      %b3 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b4
+      }
+      %b4 = block {  # body
+        %12:i32 = load %i
+        %13:bool = lt %12, %p
+        if %13 [t: %b6, f: %b7] {  # if_1
+          %b6 = block {  # true
+            exit_if  # if_1
+          }
+          %b7 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %14:i32 = load %9
+        %15:i32 = add %10, %14
+        store %sum, %15
+        continue %b5
+      }
+      %b5 = block {  # continuing
+        %16:i32 = load %i
+        %17:i32 = add %16, 1i
+        store %i, %17
+        next_iteration %b4
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, HoistDynamicIndexBeforeExit) {
+    auto* arr = b.Var("arr", ty.ptr(storage, ty.array<i32, 4>(), read));
+    arr->SetBindingPoint(0, 0);
+    mod.root_block->Append(arr);
+
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            auto* x = b.Load(b.Access(ty.ptr<storage, i32, read>(), arr, param));
+            auto* y = b.Divide<i32>(x, param);
+            b.Store(sum, b.Add<i32>(b.Load(sum), y));
+            auto* ifelse = b.If(b.GreaterThan<bool>(b.Load(sum), 100_i));
+            b.Append(ifelse->True(), [&] { b.ExitLoop(loop); });
+            auto* z = b.Divide<i32>(x, 3_i);
+            auto* w = b.Load(b.Access(ty.ptr<storage, i32, read>(), arr, z));
+            b.Store(sum, b.Add<i32>(b.Load(sum), w));
+            b.Continue(loop);
+        });
+        b.Return(ep, b.Load(sum));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %arr:ptr<storage, array<i32, 4>, read> = var @binding_point(0, 0)
+}
+
+%ep = func(%p:i32):i32 -> %b2 {
+  %b2 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [b: %b3] {  # loop_1
+      %b3 = block {  # body
+        %5:ptr<storage, i32, read> = access %arr, %p
+        %6:i32 = load %5
+        %7:i32 = div %6, %p
+        %8:i32 = load %sum
+        %9:i32 = add %8, %7
+        store %sum, %9
+        %10:i32 = load %sum
+        %11:bool = gt %10, 100i
+        if %11 [t: %b4] {  # if_1
+          %b4 = block {  # true
+            exit_loop  # loop_1
+          }
+        }
+        %12:i32 = div %6, 3i
+        %13:ptr<storage, i32, read> = access %arr, %12
+        %14:i32 = load %13
+        %15:i32 = load %sum
+        %16:i32 = add %15, %14
+        store %sum, %16
+        continue %b5
+      }
+    }
+    %17:i32 = load %sum
+    ret %17
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %arr:ptr<storage, array<i32, 4>, read> = var @binding_point(0, 0)
+}
+
+%ep = func(%p:i32):i32 -> %b2 {
+  %b2 = block {
+    %sum:ptr<function, i32, read_write> = var
+    %5:ptr<storage, i32, read> = access %arr, %p
+    %6:i32 = load %5
+    %7:i32 = div %6, %p
+    loop [b: %b3] {  # loop_1
+      %b3 = block {  # body
+        %8:i32 = load %sum
+        %9:i32 = add %8, %7
+        store %sum, %9
+        %10:i32 = load %sum
+        %11:bool = gt %10, 100i
+        if %11 [t: %b4] {  # if_1
+          %b4 = block {  # true
+            exit_loop  # loop_1
+          }
+        }
+        %12:i32 = div %6, 3i
+        %13:ptr<storage, i32, read> = access %arr, %12
+        %14:i32 = load %13
+        %15:i32 = load %sum
+        %16:i32 = add %15, %14
+        store %sum, %16
+        continue %b5
+      }
+    }
+    %17:i32 = load %sum
+    ret %17
+  }
+}
+)";
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, HoistPastIfThatDoesNotLeave) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            auto* ifelse = b.If(b.GreaterThan<bool>(b.Load(sum), 10_i));
+            b.Append(ifelse->True(), [&] {
+                b.Store(sum, 0_i);
+                b.ExitIf(ifelse);
+            });
+            auto* x = b.Divide<i32>(100_i, param);
+            b.Store(sum, b.Add<i32>(b.Load(sum), x));
+            auto* exit = b.If(b.GreaterThan<bool>(b.Load(sum), 100_i));
+            b.Append(exit->True(), [&] { b.ExitLoop(loop); });
+            b.Continue(loop);
+        });
+        b.Return(ep, b.Load(sum));
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [b: %b2] {  # loop_1
+      %b2 = block {  # body
+        %4:i32 = load %sum
+        %5:bool = gt %4, 10i
+        if %5 [t: %b3] {  # if_1
+          %b3 = block {  # true
+            store %sum, 0i
+            exit_if  # if_1
+          }
+        }
+        %6:i32 = div 100i, %p
+        %7:i32 = load %sum
+        %8:i32 = add %7, %6
+        store %sum, %8
+        %9:i32 = load %sum
+        %10:bool = gt %9, 100i
+        if %10 [t: %b4] {  # if_2
+          %b4 = block {  # true
+            exit_loop  # loop_1
+          }
+        }
+        continue %b5
+      }
+    }
+    %11:i32 = load %sum
+    ret %11
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    %4:i32 = div 100i, %p
+    loop [b: %b2] {  # loop_1
+      %b2 = block {  # body
+        %5:i32 = load %sum
+        %6:bool = gt %5, 10i
+        if %6 [t: %b3] {  # if_1
+          %b3 = block {  # true
+            store %sum, 0i
+            exit_if  # if_1
+          }
+        }
+        %7:i32 = load %sum
+        %8:i32 = add %7, %4
+        store %sum, %8
+        %9:i32 = load %sum
+        %10:bool = gt %9, 100i
+        if %10 [t: %b4] {  # if_2
+          %b4 = block {  # true
+            exit_loop  # loop_1
+          }
+        }
+        continue %b5
+      }
+    }
+    %11:i32 = load %sum
+    ret %11
+  }
+}
+)";
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, HoistLoadOfVarNotWrittenInLoop) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* v = b.Var<function>("v", param);
+        auto* sum = b.Var<function, i32>("sum");
+        ForLoop(param, [&](Var*) {
+            auto* x = b.Load(v);
+            b.Store(sum, b.Add<i32>(b.Load(sum), x));
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var, %p
+    %sum:ptr<function, i32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %6:i32 = load %i
+        %7:bool = lt %6, %p
+        if %7 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %8:i32 = load %v
+        %9:i32 = load %sum
+        %10:i32 = add %9, %8
+        store %sum, %10
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %11:i32 = load %i
+        %12:i32 = add %11, 1i
+        store %i, %12
+        next_iteration %b3
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var, %p
+    %sum:ptr<function, i32, read_write> = var
+    %5:i32 = load %v
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %7:i32 = load %i
+        %8:bool = lt %7, %p
+        if %8 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %9:i32 = load %sum
+        %10:i32 = add %9, %5
+        store %sum, %10
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %11:i32 = load %i
+        %12:i32 = add %11, 1i
+        store %i, %12
+        next_iteration %b3
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, HoistArrayLength) {
+    auto* buffer = b.Var("buffer", ty.ptr<storage, array<i32>>());
+    buffer->SetBindingPoint(0, 0);
+    mod.root_block->Append(buffer);
+
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        ForLoop(param, [&](Var* i) {
+            auto* len = b.Call(ty.u32(), core::BuiltinFn::kArrayLength, buffer);
+            auto* idx = b.Subtract<u32>(len, 1_u);
+            auto* value = b.Load(i);
+            b.Store(b.Access(ty.ptr<storage, i32>(), buffer, idx), value);
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %buffer:ptr<storage, array<i32>, read_write> = var @binding_point(0, 0)
+}
+
+%ep = func(%p:i32):void -> %b2 {
+  %b2 = block {
+    loop [i: %b3, b: %b4, c: %b5] {  # loop_1
+      %b3 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b4
+      }
+      %b4 = block {  # body
+        %5:i32 = load %i
+        %6:bool = lt %5, %p
+        if %6 [t: %b6, f: %b7] {  # if_1
+          %b6 = block {  # true
+            exit_if  # if_1
+          }
+          %b7 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:u32 = arrayLength %buffer
+        %8:u32 = sub %7, 1u
+        %9:i32 = load %i
+        %10:ptr<storage, i32, read_write> = access %buffer, %8
+        store %10, %9
+        continue %b5
+      }
+      %b5 = block {  # continuing
+        %11:i32 = load %i
+        %12:i32 = add %11, 1i
+        store %i, %12
+        next_iteration %b4
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %buffer:ptr<storage, array<i32>, read_write> = var @binding_point(0, 0)
+}
+
+%ep = func(%p:i32):void -> %b2 {
+  %b2 = block {
+    %4:u32 = arrayLength %buffer
+    %5:u32 = sub %4, 1u
+    %6:ptr<storage, i32, read_write> = access %buffer, %5
+    loop [i: %b3, b: %b4, c: %b5] {  # loop_1
+      %b3 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b4
+      }
+      %b4 = block {  # body
+        %8:i32 = load %i
+        %9:bool = lt %8, %p
+        if %9 [t: %b6, f: %b7] {  # if_1
+          %b6 = block {  # true
+            exit_if  # if_1
+          }
+          %b7 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %10:i32 = load %i
+        store %6, %10
+        continue %b5
+      }
+      %b5 = block {  # continuing
+        %11:i32 = load %i
+        %12:i32 = add %11, 1i
+        store %i, %12
+        next_iteration %b4
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, NoModify_LoadOfVarWrittenInLoop) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        ForLoop(param, [&](Var*) {
+            auto* x = b.Load(sum);
+            b.Store(sum, b.Add<i32>(x, 1_i));
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:i32 = load %i
+        %6:bool = lt %5, %p
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:i32 = load %sum
+        %8:i32 = add %7, 1i
+        store %sum, %8
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %9:i32 = load %i
+        %10:i32 = add %9, 1i
+        store %i, %10
+        next_iteration %b3
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(src, str());
+    ASSERT_TRUE(mod.modified_functions.has_value());
+    EXPECT_TRUE(mod.modified_functions->IsEmpty());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, NoModify_LoadWithCallInLoop) {
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    mod.root_block->Append(v);
+
+    auto* foo = b.Function("foo", ty.void_());
+    b.Append(foo->Block(), [&] {
+        b.Store(v, 42_i);
+        b.Return(foo);
+    });
+
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        ForLoop(param, [&](Var*) {
+            auto* x = b.Load(v);
+            b.Store(sum, b.Add<i32>(b.Load(sum), x));
+            b.Call(ty.void_(), foo);
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%foo = func():void -> %b2 {
+  %b2 = block {
+    store %v, 42i
+    ret
+  }
+}
+%ep = func(%p:i32):void -> %b3 {
+  %b3 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [i: %b4, b: %b5, c: %b6] {  # loop_1
+      %b4 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b5
+      }
+      %b5 = block {  # body
+        %7:i32 = load %i
+        %8:bool = lt %7, %p
+        if %8 [t: %b7, f: %b8] {  # if_1
+          %b7 = block {  # true
+            exit_if  # if_1
+          }
+          %b8 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %9:i32 = load %v
+        %10:i32 = load %sum
+        %11:i32 = add %10, %9
+        store %sum, %11
+        %12:void = call %foo
+        continue %b6
+      }
+      %b6 = block {  # continuing
+        %13:i32 = load %i
+        %14:i32 = add %13, 1i
+        store %i, %14
+        next_iteration %b5
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(src, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, NoModify_WorkgroupLoad) {
+    auto* wg = b.Var("wg", ty.ptr<workgroup, i32>());
+    mod.root_block->Append(wg);
+
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        ForLoop(param, [&](Var*) {
+            auto* x = b.Load(wg);
+            b.Store(sum, b.Add<i32>(b.Load(sum), x));
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %wg:ptr<workgroup, i32, read_write> = var
+}
+
+%ep = func(%p:i32):void -> %b2 {
+  %b2 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [i: %b3, b: %b4, c: %b5] {  # loop_1
+      %b3 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b4
+      }
+      %b4 = block {  # body
+        %6:i32 = load %i
+        %7:bool = lt %6, %p
+        if %7 [t: %b6, f: %b7] {  # if_1
+          %b6 = block {  # true
+            exit_if  # if_1
+          }
+          %b7 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %8:i32 = load %wg
+        %9:i32 = load %sum
+        %10:i32 = add %9, %8
+        store %sum, %10
+        continue %b5
+      }
+      %b5 = block {  # continuing
+        %11:i32 = load %i
+        %12:i32 = add %11, 1i
+        store %i, %12
+        next_iteration %b4
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(src, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, NoModify_DerivativeAndTexture) {
+    auto* t = b.Var("t", ty.ptr(handle, ty.Get<core::type::SampledTexture>(
+                                            core::type::TextureDimension::k2d, ty.f32())));
+    t->SetBindingPoint(0, 0);
+    mod.root_block->Append(t);
+    auto* s = b.Var("s", ty.ptr(handle, ty.sampler()));
+    s->SetBindingPoint(0, 1);
+    mod.root_block->Append(s);
+
+    auto* ep = b.Function("ep", ty.void_(), Function::PipelineStage::kFragment);
+    auto* coord = b.FunctionParam("coord", ty.vec2<f32>());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({coord, param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, vec4<f32>>("sum");
+        auto* tex = b.Load(t);
+        auto* sampler = b.Load(s);
+        ForLoop(param, [&](Var*) {
+            auto* dx = b.Call<vec2<f32>>(core::BuiltinFn::kDpdx, coord);
+            auto* sample =
+                b.Call<vec4<f32>>(core::BuiltinFn::kTextureSample, tex, sampler, dx);
+            b.Store(sum, b.Add<vec4<f32>>(b.Load(sum), sample));
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %t:ptr<handle, texture_2d<f32>, read> = var @binding_point(0, 0)
+  %s:ptr<handle, sampler, read> = var @binding_point(0, 1)
+}
+
+%ep = @fragment func(%coord:vec2<f32>, %p:i32):void -> %b2 {
+  %b2 = block {
+    %sum:ptr<function, vec4<f32>, read_write> = var
+    %7:texture_2d<f32> = load %t
+    %8:sampler = load %s
+    loop [i: %b3, b: %b4, c: %b5] {  # loop_1
+      %b3 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b4
+      }
+      %b4 = block {  # body
+        %10:i32 = load %i
+        %11:bool = lt %10, %p
+        if %11 [t: %b6, f: %b7] {  # if_1
+          %b6 = block {  # true
+            exit_if  # if_1
+          }
+          %b7 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %12:vec2<f32> = dpdx %coord
+        %13:vec4<f32> = textureSample %7, %8, %12
+        %14:vec4<f32> = load %sum
+        %15:vec4<f32> = add %14, %13
+        store %sum, %15
+        continue %b5
+      }
+      %b5 = block {  # continuing
+        %16:i32 = load %i
+        %17:i32 = add %16, 1i
+        store %i, %17
+        next_iteration %b4
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(src, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, HoistInstructionInIf) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        ForLoop(param, [&](Var* i) {
+            auto* ifelse = b.If(b.Equal<bool>(b.Load(i), 2_i));
+            b.Append(ifelse->True(), [&] {
+                b.Store(sum, b.Multiply<i32>(param, 3_i));
+                b.ExitIf(ifelse);
+            });
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:i32 = load %i
+        %6:bool = lt %5, %p
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:i32 = load %i
+        %8:bool = eq %7, 2i
+        if %8 [t: %b7] {  # if_2
+          %b7 = block {  # true
+            %9:i32 = mul %p, 3i
+            store %sum, %9
+            exit_if  # if_2
+          }
+        }
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %10:i32 = load %i
+        %11:i32 = add %10, 1i
+        store %i, %11
+        next_iteration %b3
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    %4:i32 = mul %p, 3i
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %6:i32 = load %i
+        %7:bool = lt %6, %p
+        if %7 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %8:i32 = load %i
+        %9:bool = eq %8, 2i
+        if %9 [t: %b7] {  # if_2
+          %b7 = block {  # true
+            store %sum, %4
+            exit_if  # if_2
+          }
+        }
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %10:i32 = load %i
+        %11:i32 = add %10, 1i
+        store %i, %11
+        next_iteration %b3
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, NoModify_DivideInIf) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        ForLoop(param, [&](Var* i) {
+            auto* ifelse = b.If(b.Equal<bool>(b.Load(i), 2_i));
+            b.Append(ifelse->True(), [&] {
+                b.Store(sum, b.Divide<i32>(3_i, param));
+                b.ExitIf(ifelse);
+            });
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:i32 = load %i
+        %6:bool = lt %5, %p
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:i32 = load %i
+        %8:bool = eq %7, 2i
+        if %8 [t: %b7] {  # if_2
+          %b7 = block {  # true
+            %9:i32 = div 3i, %p
+            store %sum, %9
+            exit_if  # if_2
+          }
+        }
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %10:i32 = load %i
+        %11:i32 = add %10, 1i
+        store %i, %11
+        next_iteration %b3
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(src, str());
+}
+
+TEST_F(IR_LoopInvariantCodeMotionTest, NestedLoops) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        ForLoop(param, [&](Var* i) {
+            ForLoop(param, [&](Var* j) {
+                auto* x = b.Multiply<i32>(param, param);
+                auto* y = b.Multiply<i32>(b.Load(i), x);
+                auto* z = b.Add<i32>(y, b.Load(j));
+                b.Store(sum, b.Add<i32>(b.Load(sum), z));
+            });
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:i32 = load %i
+        %6:bool = lt %5, %p
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        loop [i: %b7, b: %b8, c: %b9] {  # loop_2
+          %b7 = block {  # initializer
+            %i_1:ptr<function, i32, read_write> = var, 0i  # %i_1: 'i'
+            next_iteration %b8
+          }
+          %b8 = block {  # body
+            %8:i32 = load %i_1
+            %9:bool = lt %8, %p
+            if %9 [t: %b10, f: %b11] {  # if_2
+              %b10 = block {  # true
+                exit_if  # if_2
+              }
+              %b11 = block {  # false
+                exit_loop  # loop_2
+              }
+            }
+            %10:i32 = mul %p, %p
+            %11:i32 = load %i
+            %12:i32 = mul %11, %10
+            %13:i32 = load %i_1
+            %14:i32 = add %12, %13
+            %15:i32 = load %sum
+            %16:i32 = add %15, %14
+            store %sum, %16
+            continue %b9
+          }
+          %b9 = block {  # continuing
+            %17:i32 = load %i_1
+            %18:i32 = add %17, 1i
+            store %i_1, %18
+            next_iteration %b8
+          }
+        }
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %19:i32 = load %i
+        %20:i32 = add %19, 1i
+        store %i, %20
+        next_iteration %b3
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    %4:i32 = mul %p, %p
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %6:i32 = load %i
+        %7:bool = lt %6, %p
+        if %7 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %8:i32 = load %i
+        %9:i32 = mul %8, %4
+        loop [i: %b7, b: %b8, c: %b9] {  # loop_2
+          %b7 = block {  # initializer
+            %i_1:ptr<function, i32, read_write> = var, 0i  # %i_1: 'i'
+            next_iteration %b8
+          }
+          %b8 = block {  # body
+            %11:i32 = load %i_1
+            %12:bool = lt %11, %p
+            if %12 [t: %b10, f: %b11] {  # if_2
+              %b10 = block {  # true
+                exit_if  # if_2
+              }
+              %b11 = block {  # false
+                exit_loop  # loop_2
+              }
+            }
+            %13:i32 = load %i_1
+            %14:i32 = add %9, %13
+            %15:i32 = load %sum
+            %16:i32 = add %15, %14
+            store %sum, %16
+            continue %b9
+          }
+          %b9 = block {  # continuing
+            %17:i32 = load %i_1
+            %18:i32 = add %17, 1i
+            store %i_1, %18
+            next_iteration %b8
+          }
+        }
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %19:i32 = load %i
+        %20:i32 = add %19, 1i
+        store %i, %20
+        next_iteration %b3
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(LoopInvariantCodeMotion);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
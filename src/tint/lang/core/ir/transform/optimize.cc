@@ -0,0 +1,85 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/optimize.h"
+
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/transform/common_subexpression_elimination.h"
+#include "src/tint/lang/core/ir/transform/constant_propagation.h"
+#include "src/tint/lang/core/ir/transform/dead_code_elimination.h"
+#include "src/tint/lang/core/ir/transform/loop_invariant_code_motion.h"
+#include "src/tint/lang/core/ir/transform/promote_vars_to_values.h"
+
+namespace tint::core::ir::transform {
+
+Result<SuccessType> Optimize(Module& ir, const OptimizeConfig& config) {
+#define RUN_PASS(name, ...)                                           \
+    do {                                                              \
+        auto start = std::chrono::steady_clock::now();                \
+        auto result = name(ir, ##__VA_ARGS__);                        \
+        if (result != Success) {                                      \
+            return result;                                            \
+        }                                                             \
+        if (config.timings) {                                         \
+            auto duration = std::chrono::steady_clock::now() - start; \
+            config.timings->push_back(PassTiming{#name, duration});   \
+        }                                                             \
+    } while (false)
+
+    if (config.level == OptimizationLevel::kO0) {
+        return Success;
+    }
+
+    if (config.level >= OptimizationLevel::kO2) {
+        // Inline must come before the passes that optimize the body of the callers.
+        RUN_PASS(Inline, config.inline_config);
+
+        // PromoteVarsToValues must come after Inline, as inlining replaces pointer parameters with
+        // the variables of the callers.
+        if (config.promote_vars_to_values) {
+            RUN_PASS(PromoteVarsToValues);
+        }
+    }
+
+    RUN_PASS(ConstantPropagation);
+
+    // LoopInvariantCodeMotion must come before CommonSubexpressionElimination, so that the hoisted
+    // instructions can be merged with the identical instructions that come before the loop.
+    if (config.level >= OptimizationLevel::kO2) {
+        RUN_PASS(LoopInvariantCodeMotion);
+    }
+
+    RUN_PASS(CommonSubexpressionElimination);
+
+    // DeadCodeElimination must come last, to clean up after all the other passes.
+    RUN_PASS(DeadCodeElimination);
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
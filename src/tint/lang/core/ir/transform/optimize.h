@@ -0,0 +1,87 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_OPTIMIZE_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_OPTIMIZE_H_
+
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+#include "src/tint/api/options/optimization_level.h"
+#include "src/tint/lang/core/ir/transform/inline.h"
+#include "src/tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::core::ir {
+class Module;
+}
+
+namespace tint::core::ir::transform {
+
+/// The time taken by a single pass of the Optimize transform.
+struct PassTiming {
+    /// The name of the pass
+    std::string_view name;
+    /// The time that the pass took to run
+    std::chrono::nanoseconds duration{};
+};
+
+/// Configuration options for the Optimize transform.
+struct OptimizeConfig {
+    /// The optimization level, which selects the passes to run
+    OptimizationLevel level = OptimizationLevel::kO0;
+
+    /// Should function-scope variables be promoted to values at kO2?
+    /// Only enable this for backends that can emit the values without a variable.
+    bool promote_vars_to_values = false;
+
+    /// The configuration of the Inline pass, run at kO2
+    InlineConfig inline_config = {};
+
+    /// If not null, the time taken by each pass that was run is appended to this list
+    std::vector<PassTiming>* timings = nullptr;
+};
+
+/// Optimize is a transform that runs the IR optimization passes selected by the optimization level
+/// of the config, in the order that lets each pass benefit from the previous ones:
+///  * kO0 runs no passes.
+///  * kO1 runs ConstantPropagation, CommonSubexpressionElimination and DeadCodeElimination.
+///  * kO2 runs Inline and PromoteVarsToValues first, and LoopInvariantCodeMotion before
+///    CommonSubexpressionElimination.
+/// This is the shared optimization pipeline of the writers, which run it after the transforms that
+/// create helper functions, and before the transforms that lower the IR to their dialect.
+///
+/// @param module the module to transform
+/// @param config the transform config
+/// @returns error diagnostics on failure
+Result<SuccessType> Optimize(Module& module, const OptimizeConfig& config);
+
+}  // namespace tint::core::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_OPTIMIZE_H_
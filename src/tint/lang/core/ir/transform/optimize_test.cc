@@ -0,0 +1,270 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/optimize.h"
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+class IR_OptimizeTest : public TransformTest {
+  protected:
+    /// Builds a module with a small function call, a foldable expression, a repeated expression and
+    /// an unused expression.
+    void Build() {
+        auto* add_one = b.Function("add_one", ty.i32());
+        auto* p = b.FunctionParam("p", ty.i32());
+        add_one->SetParams({p});
+        b.Append(add_one->Block(), [&] { b.Return(add_one, b.Add<i32>(p, 1_i)); });
+
+        auto* buffer = b.Var("buffer", ty.ptr<storage, i32>());
+        buffer->SetBindingPoint(0, 0);
+        mod.root_block->Append(buffer);
+
+        auto* ep = b.Function("ep", ty.void_(), Function::PipelineStage::kCompute, {{1, 1, 1}});
+        b.Append(ep->Block(), [&] {
+            auto* param = b.Load(buffer);
+            auto* x = b.Call(add_one, param);
+            auto* y = b.Multiply<i32>(param, 2_i);
+            auto* z = b.Multiply<i32>(param, 2_i);
+            b.Subtract<i32>(param, 3_i);
+            auto* c = b.Add<i32>(1_i, 2_i);
+            auto* sum = b.Add<i32>(x, y);
+            sum = b.Add<i32>(sum, z);
+            b.Store(buffer, b.Add<i32>(sum, c));
+            b.Return(ep);
+        });
+    }
+};
+
+TEST_F(IR_OptimizeTest, O0) {
+    Build();
+
+    auto* src = R"(
+%b1 = block {  # root
+  %buffer:ptr<storage, i32, read_write> = var @binding_point(0, 0)
+}
+
+%add_one = func(%p:i32):i32 -> %b2 {
+  %b2 = block {
+    %4:i32 = add %p, 1i
+    ret %4
+  }
+}
+%ep = @compute @workgroup_size(1, 1, 1) func():void -> %b3 {
+  %b3 = block {
+    %6:i32 = load %buffer
+    %7:i32 = call %add_one, %6
+    %8:i32 = mul %6, 2i
+    %9:i32 = mul %6, 2i
+    %10:i32 = sub %6, 3i
+    %11:i32 = add 1i, 2i
+    %12:i32 = add %7, %8
+    %13:i32 = add %12, %9
+    %14:i32 = add %13, %11
+    store %buffer, %14
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    OptimizeConfig config;
+    config.level = OptimizationLevel::kO0;
+    Run(Optimize, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_OptimizeTest, O1) {
+    Build();
+
+    auto* src = R"(
+%b1 = block {  # root
+  %buffer:ptr<storage, i32, read_write> = var @binding_point(0, 0)
+}
+
+%add_one = func(%p:i32):i32 -> %b2 {
+  %b2 = block {
+    %4:i32 = add %p, 1i
+    ret %4
+  }
+}
+%ep = @compute @workgroup_size(1, 1, 1) func():void -> %b3 {
+  %b3 = block {
+    %6:i32 = load %buffer
+    %7:i32 = call %add_one, %6
+    %8:i32 = mul %6, 2i
+    %9:i32 = mul %6, 2i
+    %10:i32 = sub %6, 3i
+    %11:i32 = add 1i, 2i
+    %12:i32 = add %7, %8
+    %13:i32 = add %12, %9
+    %14:i32 = add %13, %11
+    store %buffer, %14
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %buffer:ptr<storage, i32, read_write> = var @binding_point(0, 0)
+}
+
+%add_one = func(%p:i32):i32 -> %b2 {
+  %b2 = block {
+    %4:i32 = add %p, 1i
+    ret %4
+  }
+}
+%ep = @compute @workgroup_size(1, 1, 1) func():void -> %b3 {
+  %b3 = block {
+    %6:i32 = load %buffer
+    %7:i32 = call %add_one, %6
+    %8:i32 = mul %6, 2i
+    %9:i32 = add %7, %8
+    %10:i32 = add %9, %8
+    %11:i32 = add %10, 3i
+    store %buffer, %11
+    ret
+  }
+}
+)";
+
+    OptimizeConfig config;
+    config.level = OptimizationLevel::kO1;
+    Run(Optimize, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_OptimizeTest, O2) {
+    Build();
+
+    auto* src = R"(
+%b1 = block {  # root
+  %buffer:ptr<storage, i32, read_write> = var @binding_point(0, 0)
+}
+
+%add_one = func(%p:i32):i32 -> %b2 {
+  %b2 = block {
+    %4:i32 = add %p, 1i
+    ret %4
+  }
+}
+%ep = @compute @workgroup_size(1, 1, 1) func():void -> %b3 {
+  %b3 = block {
+    %6:i32 = load %buffer
+    %7:i32 = call %add_one, %6
+    %8:i32 = mul %6, 2i
+    %9:i32 = mul %6, 2i
+    %10:i32 = sub %6, 3i
+    %11:i32 = add 1i, 2i
+    %12:i32 = add %7, %8
+    %13:i32 = add %12, %9
+    %14:i32 = add %13, %11
+    store %buffer, %14
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %buffer:ptr<storage, i32, read_write> = var @binding_point(0, 0)
+}
+
+%ep = @compute @workgroup_size(1, 1, 1) func():void -> %b2 {
+  %b2 = block {
+    %3:i32 = load %buffer
+    %4:i32 = add %3, 1i
+    %5:i32 = mul %3, 2i
+    %6:i32 = add %4, %5
+    %7:i32 = add %6, %5
+    %8:i32 = add %7, 3i
+    store %buffer, %8
+    ret
+  }
+}
+)";
+
+    OptimizeConfig config;
+    config.level = OptimizationLevel::kO2;
+    Run(Optimize, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_OptimizeTest, Timings) {
+    Build();
+
+    std::vector<PassTiming> timings;
+    OptimizeConfig config;
+    config.level = OptimizationLevel::kO2;
+    config.promote_vars_to_values = true;
+    config.timings = &timings;
+    Run(Optimize, config);
+
+    std::vector<std::string_view> names;
+    for (auto& timing : timings) {
+        names.push_back(timing.name);
+    }
+    EXPECT_THAT(names, testing::ElementsAre("Inline", "PromoteVarsToValues", "ConstantPropagation",
+                                            "LoopInvariantCodeMotion",
+                                            "CommonSubexpressionElimination",
+                                            "DeadCodeElimination"));
+}
+
+TEST_F(IR_OptimizeTest, Timings_O0) {
+    Build();
+
+    std::vector<PassTiming> timings;
+    OptimizeConfig config;
+    config.level = OptimizationLevel::kO0;
+    config.timings = &timings;
+    Run(Optimize, config);
+
+    EXPECT_TRUE(timings.empty());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
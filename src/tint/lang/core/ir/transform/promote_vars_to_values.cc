@@ -0,0 +1,508 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/promote_vars_to_values.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/lang/core/type/pointer.h"
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/containers/hashset.h"
+#include "src/tint/utils/containers/unique_vector.h"
+#include "src/tint/utils/rtti/switch.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// The values of the promoted variables at an instruction.
+using Values = Hashmap<Var*, Value*, 8>;
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module& ir;
+
+    /// The IR builder.
+    Builder b{ir};
+
+    /// The variables of the function being processed that are promoted.
+    Hashset<Var*, 16> promoted{};
+
+    /// The promotable variables that are stored to by the instructions of each block, including the
+    /// instructions of its nested blocks, in the order of their first store.
+    Hashmap<Block*, UniqueVector<Var*, 4>, 32> stores{};
+
+    /// The variables whose values are passed by the exit instructions of each control instruction.
+    Hashmap<ControlInstruction*, Vector<Var*, 4>, 8> exit_vars{};
+
+    /// The variables whose values are passed by the `next_iteration` and `break_if` instructions
+    /// of each loop.
+    Hashmap<Loop*, Vector<Var*, 4>, 8> next_iteration_vars{};
+
+    /// The variables whose values are passed by the `continue` instructions of each loop.
+    Hashmap<Loop*, Vector<Var*, 4>, 8> continue_vars{};
+
+    /// Process the module.
+    void Process() {
+        Vector<const Function*, 8> modified;
+        for (auto& func : ir.functions) {
+            if (Process(func)) {
+                modified.Push(func);
+            }
+        }
+        SetModifiedFunctions(ir, std::move(modified));
+    }
+
+  private:
+    /// Promotes the variables of @p func.
+    /// @param func the function
+    /// @returns true if any variable was promoted
+    bool Process(Function* func) {
+        Vector<Var*, 16> vars;
+        ForeachInstruction(func->Block(), [&](Instruction* inst) {
+            if (auto* var = inst->As<Var>(); var && CanPromote(var)) {
+                promoted.Add(var);
+                vars.Push(var);
+            }
+        });
+        if (vars.IsEmpty()) {
+            return false;
+        }
+
+        CollectStores(func->Block());
+
+        // A `break_if` cannot pass values to the results of its loop, so the variables that are
+        // declared outside such a loop and stored inside it are left in memory.
+        ForeachInstruction(func->Block(), [&](Instruction* inst) {
+            auto* loop = inst->As<Loop>();
+            if (!loop || !tint::Is<BreakIf>(loop->Continuing()->Terminator())) {
+                return;
+            }
+            loop->ForeachBlock([&](Block* block) {
+                for (auto* var : *stores.Get(block)) {
+                    if (!IsNestedIn(var->Block(), loop)) {
+                        promoted.Remove(var);
+                    }
+                }
+            });
+        });
+
+        Values values;
+        Promote(func->Block(), values);
+
+        for (auto* var : vars) {
+            if (promoted.Contains(var)) {
+                var->Destroy();
+            }
+        }
+        promoted.Clear();
+        stores.Clear();
+        exit_vars.Clear();
+        next_iteration_vars.Clear();
+        continue_vars.Clear();
+        return true;
+    }
+
+    /// @returns true if @p var is a function-scope variable whose pointer is only used to load from
+    /// and store to the variable
+    /// @param var the variable
+    bool CanPromote(Var* var) {
+        auto* ptr = var->Result(0)->Type()->As<core::type::Pointer>();
+        if (!ptr || ptr->AddressSpace() != core::AddressSpace::kFunction) {
+            return false;
+        }
+        for (auto& usage : var->Result(0)->Usages()) {
+            auto* inst = usage.instruction;
+            if (!(inst->Is<Load>() && usage.operand_index == Load::kFromOperandOffset) &&
+                !(inst->Is<Store>() && usage.operand_index == Store::kToOperandOffset)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Records the promotable variables that are stored to in @p block and its nested blocks.
+    /// @param block the block
+    void CollectStores(Block* block) {
+        UniqueVector<Var*, 4> vars;
+        for (auto* inst : *block) {
+            if (auto* store = inst->As<Store>()) {
+                if (auto* var = PromotedVar(store->To())) {
+                    vars.Add(var);
+                }
+            } else if (auto* ctrl = inst->As<ControlInstruction>()) {
+                ctrl->ForeachBlock([&](Block* inner) {
+                    CollectStores(inner);
+                    for (auto* var : *stores.Get(inner)) {
+                        vars.Add(var);
+                    }
+                });
+            }
+        }
+        stores.Add(block, std::move(vars));
+    }
+
+    /// Replaces the loads and stores of the promoted variables in @p block with values.
+    /// @param block the block
+    /// @param values the values of the promoted variables at the start of @p block, updated to
+    /// their values at the end of @p block
+    void Promote(Block* block, Values& values) {
+        for (auto* inst = block->Front(); inst;) {
+            auto* next = inst->next.Get();
+            tint::Switch(
+                inst,  //
+                [&](Var* var) {
+                    if (promoted.Contains(var)) {
+                        values.Replace(var, var->Initializer() ? var->Initializer()
+                                                               : b.Zero(StoreType(var)));
+                    }
+                },
+                [&](Load* load) {
+                    if (auto* var = PromotedVar(load->From())) {
+                        load->Result(0)->ReplaceAllUsesWith(ValueOf(var, values));
+                        load->Destroy();
+                    }
+                },
+                [&](Store* store) {
+                    if (auto* var = PromotedVar(store->To())) {
+                        values.Replace(var, store->From());
+                        store->Destroy();
+                    }
+                },
+                [&](Loop* loop) { PromoteLoop(loop, values); },
+                [&](ControlInstruction* ctrl) { PromoteIfOrSwitch(ctrl, values); },
+                [&](Exit* exit) {
+                    if (auto vars = exit_vars.Get(exit->ControlInstruction())) {
+                        AddArgs(exit, *vars, values);
+                    }
+                },
+                [&](NextIteration* next_iteration) {
+                    if (auto vars = next_iteration_vars.Get(next_iteration->Loop())) {
+                        AddArgs(next_iteration, *vars, values);
+                    }
+                },
+                [&](BreakIf* break_if) {
+                    if (auto vars = next_iteration_vars.Get(break_if->Loop())) {
+                        AddArgs(break_if, *vars, values);
+                    }
+                },
+                [&](Continue* cont) {
+                    if (auto vars = continue_vars.Get(cont->Loop())) {
+                        AddArgs(cont, *vars, values);
+                    }
+                });
+            inst = next;
+        }
+    }
+
+    /// Promotes the variables that are stored inside the `if` or `switch` instruction @p ctrl.
+    /// @param ctrl the control instruction
+    /// @param values the values of the promoted variables before @p ctrl, updated to their values
+    /// after @p ctrl
+    void PromoteIfOrSwitch(ControlInstruction* ctrl, Values& values) {
+        // The variables that are declared before the instruction and stored inside it leave the
+        // instruction as its results.
+        UniqueVector<Var*, 4> vars;
+        bool exits = !ctrl->Exits().IsEmpty();
+        ctrl->ForeachBlock([&](Block* block) {
+            AddDeclared(vars, block, values);
+            exits = exits || !block->Terminator();
+        });
+        if (exits && !vars.IsEmpty()) {
+            ctrl->ForeachBlock([&](Block* block) {
+                if (!block->Terminator()) {
+                    block->Append(b.Exit(ctrl));
+                }
+            });
+            AddResults(ctrl, vars);
+        }
+
+        ctrl->ForeachBlock([&](Block* block) {
+            Values inner = values;
+            Promote(block, inner);
+        });
+
+        SetToResults(ctrl, vars, exits, values);
+    }
+
+    /// Promotes the variables that are stored inside the loop @p loop.
+    /// @param loop the loop
+    /// @param values the values of the promoted variables before @p loop, updated to their values
+    /// after @p loop
+    void PromoteLoop(Loop* loop, Values& values) {
+        // The variables that are declared before the loop and stored inside it leave the loop as
+        // its results.
+        UniqueVector<Var*, 4> vars;
+        loop->ForeachBlock([&](Block* block) { AddDeclared(vars, block, values); });
+        bool exits = !loop->Exits().IsEmpty();
+        if (exits && !vars.IsEmpty()) {
+            AddResults(loop, vars);
+        }
+
+        // The variables that are declared before the body and stored in the body or continuing
+        // are carried from one iteration to the next by the parameters of the body.
+        UniqueVector<Var*, 4> carried;
+        for (auto* block : {loop->Body(), loop->Continuing()}) {
+            for (auto* var : *stores.Get(block)) {
+                if (promoted.Contains(var) && !IsNestedIn(var->Block(), loop->Body()) &&
+                    !IsNestedIn(var->Block(), loop->Continuing())) {
+                    carried.Add(var);
+                }
+            }
+        }
+        Vector<BlockParam*, 4> body_params;
+        if (!carried.IsEmpty()) {
+            if (!loop->HasInitializer()) {
+                loop->Initializer()->Append(b.NextIteration(loop));
+            }
+            if (!loop->Continuing()->Terminator()) {
+                loop->Continuing()->Append(b.NextIteration(loop));
+            }
+            body_params = AddParams(loop->Body(), carried);
+            next_iteration_vars.Add(loop, Vector<Var*, 4>{carried});
+        }
+
+        // The continuing block also needs the values of the variables that are declared in the
+        // body and used in the continuing block.
+        UniqueVector<Var*, 4> continued = carried;
+        Vector<BlockParam*, 4> continuing_params;
+        if (!loop->Continuing()->InboundSiblingBranches().IsEmpty()) {
+            ForeachInstruction(loop->Continuing(), [&](Instruction* inst) {
+                Var* var = nullptr;
+                if (auto* load = inst->As<Load>()) {
+                    var = PromotedVar(load->From());
+                } else if (auto* store = inst->As<Store>()) {
+                    var = PromotedVar(store->To());
+                }
+                if (var && var->Block() == loop->Body()) {
+                    continued.Add(var);
+                }
+            });
+            if (!continued.IsEmpty()) {
+                continuing_params = AddParams(loop->Continuing(), continued);
+                continue_vars.Add(loop, Vector<Var*, 4>{continued});
+            }
+        }
+
+        Values initializer_values = values;
+        Promote(loop->Initializer(), initializer_values);
+
+        Values body_values = initializer_values;
+        for (size_t i = 0; i < carried.Length(); i++) {
+            body_values.Replace(carried[i], body_params[i]);
+        }
+        Promote(loop->Body(), body_values);
+
+        // If the continuing block is not reachable, it uses the values of the body parameters.
+        Values continuing_values = std::move(initializer_values);
+        if (!continuing_params.IsEmpty()) {
+            for (size_t i = 0; i < continued.Length(); i++) {
+                continuing_values.Replace(continued[i], continuing_params[i]);
+            }
+        } else {
+            for (size_t i = 0; i < carried.Length(); i++) {
+                continuing_values.Replace(carried[i], body_params[i]);
+            }
+        }
+        Promote(loop->Continuing(), continuing_values);
+
+        SetToResults(loop, vars, exits, values);
+    }
+
+    /// Adds the promoted variables in @p values that are stored to in @p block to @p vars.
+    /// @param vars the list of variables
+    /// @param block the block
+    /// @param values the values of the variables that are declared before @p block
+    void AddDeclared(UniqueVector<Var*, 4>& vars, Block* block, const Values& values) {
+        for (auto* var : *stores.Get(block)) {
+            if (promoted.Contains(var) && values.Contains(var)) {
+                vars.Add(var);
+            }
+        }
+    }
+
+    /// Adds a result to @p ctrl for each variable in @p vars, and records that the exits of @p ctrl
+    /// pass the values of @p vars.
+    /// @param ctrl the control instruction
+    /// @param vars the variables
+    void AddResults(ControlInstruction* ctrl, const UniqueVector<Var*, 4>& vars) {
+        Vector<InstructionResult*, 4> results{ctrl->Results()};
+        for (auto* var : vars) {
+            auto* result = b.InstructionResult(StoreType(var));
+            CopyName(var, result);
+            results.Push(result);
+        }
+        ctrl->SetResults(std::move(results));
+        exit_vars.Add(ctrl, Vector<Var*, 4>{vars});
+    }
+
+    /// Adds a parameter to @p block for each variable in @p vars.
+    /// @param block the block
+    /// @param vars the variables
+    /// @returns the new parameters
+    Vector<BlockParam*, 4> AddParams(MultiInBlock* block, const UniqueVector<Var*, 4>& vars) {
+        Vector<BlockParam*, 4> params;
+        for (auto* var : vars) {
+            auto* param = b.BlockParam(StoreType(var));
+            CopyName(var, param);
+            params.Push(param);
+        }
+        Vector<BlockParam*, 8> all_params{block->Params()};
+        for (auto* param : params) {
+            all_params.Push(param);
+        }
+        block->SetParams(std::move(all_params));
+        return params;
+    }
+
+    /// Updates the values of @p vars to the results of @p ctrl after it has been promoted.
+    /// @param ctrl the control instruction
+    /// @param vars the variables that are stored inside @p ctrl
+    /// @param exits true if @p ctrl has exits, false if the instructions after it are unreachable
+    /// @param values the values of the promoted variables
+    void SetToResults(ControlInstruction* ctrl,
+                      const UniqueVector<Var*, 4>& vars,
+                      bool exits,
+                      Values& values) {
+        auto results = ctrl->Results();
+        size_t offset = results.Length() - (exits ? vars.Length() : 0);
+        for (size_t i = 0; i < vars.Length(); i++) {
+            if (exits) {
+                values.Replace(vars[i], results[offset + i]);
+            } else {
+                values.Remove(vars[i]);
+            }
+        }
+    }
+
+    /// Appends the values of @p vars to the arguments of @p term.
+    /// @param term the terminator instruction
+    /// @param vars the variables
+    /// @param values the values of the promoted variables at @p term
+    void AddArgs(Terminator* term, VectorRef<Var*> vars, const Values& values) {
+        Vector<Value*, 8> operands{term->Operands()};
+        for (auto* var : vars) {
+            operands.Push(ValueOf(var, values));
+        }
+        term->SetOperands(std::move(operands));
+    }
+
+    /// @returns the value of @p var in @p values, or the zero value of its type if the variable
+    /// has not been declared on the path to the instruction
+    /// @param var the variable
+    /// @param values the values of the promoted variables
+    Value* ValueOf(Var* var, const Values& values) {
+        if (auto value = values.Get(var)) {
+            return *value;
+        }
+        return b.Zero(StoreType(var));
+    }
+
+    /// @returns the variable that declares @p ptr if it is promoted, otherwise nullptr
+    /// @param ptr the pointer value
+    Var* PromotedVar(Value* ptr) {
+        if (auto* result = ptr->As<InstructionResult>()) {
+            if (auto* var = result->Instruction()->As<Var>(); var && promoted.Contains(var)) {
+                return var;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @returns the store type of @p var
+    /// @param var the variable
+    const core::type::Type* StoreType(Var* var) { return var->Result(0)->Type()->UnwrapPtr(); }
+
+    /// Gives @p value the name of @p var, if it has one.
+    /// @param var the variable
+    /// @param value the value
+    void CopyName(Var* var, Value* value) {
+        if (auto name = ir.NameOf(var)) {
+            ir.SetName(value, name);
+        }
+    }
+
+    /// @returns true if @p block is @p ancestor or is nested in it
+    /// @param block the block
+    /// @param ancestor the ancestor block
+    bool IsNestedIn(Block* block, Block* ancestor) {
+        while (block) {
+            if (block == ancestor) {
+                return true;
+            }
+            auto* ctrl = block->Parent();
+            block = ctrl ? ctrl->Block() : nullptr;
+        }
+        return false;
+    }
+
+    /// @returns true if @p block is nested in @p ctrl
+    /// @param block the block
+    /// @param ctrl the control instruction
+    bool IsNestedIn(Block* block, ControlInstruction* ctrl) {
+        for (auto* parent = block->Parent(); parent; parent = parent->Block()->Parent()) {
+            if (parent == ctrl) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Calls @p callback with each of the instructions of @p block, including the instructions
+    /// nested in its control instructions.
+    /// @param block the block
+    /// @param callback the function to call with each instruction
+    template <typename F>
+    void ForeachInstruction(Block* block, F&& callback) {
+        for (auto* inst : *block) {
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                ctrl->ForeachBlock([&](Block* inner) { ForeachInstruction(inner, callback); });
+            }
+            callback(inst);
+        }
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> PromoteVarsToValues(Module& ir) {
+    auto result = ValidateAndDumpIfNeeded(ir, "PromoteVarsToValues transform");
+    if (result != Success) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
@@ -0,0 +1,792 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/transform/promote_vars_to_values.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+using IR_PromoteVarsToValuesTest = TransformTest;
+
+TEST_F(IR_PromoteVarsToValuesTest, NoModify_NoVars) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] { b.Return(ep, b.Add<i32>(param, 1_i)); });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, NoModify_PointerUsedByOtherInstructions) {
+    auto* ep = b.Function("ep", ty.f32());
+    b.Append(ep->Block(), [&] {
+        auto* v = b.Var<function, array<f32, 4>>("v");
+        auto* a = b.Var<function, i32>("a");
+        b.Let("p", a);
+        b.Store(a, 1_i);
+        b.Return(ep, b.Load(b.Access(ty.ptr<function, f32>(), v, 0_u)));
+    });
+
+    auto* src = R"(
+%ep = func():f32 -> %b1 {
+  %b1 = block {
+    %v:ptr<function, array<f32, 4>, read_write> = var
+    %a:ptr<function, i32, read_write> = var
+    %p:ptr<function, i32, read_write> = let %a
+    store %a, 1i
+    %5:ptr<function, f32, read_write> = access %v, 0u
+    %6:f32 = load %5
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, NoModify_PrivateVar) {
+    auto* v = b.Var("v", ty.ptr<private_, i32>());
+    mod.root_block->Append(v);
+
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        b.Store(v, 1_i);
+        b.Return(ep, b.Load(v));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%ep = func():i32 -> %b2 {
+  %b2 = block {
+    store %v, 1i
+    %3:i32 = load %v
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, LoadsAndStores) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Var<function, i32>("a");
+        auto* c = b.Var<function>("c", param);
+        auto* x = b.Load(a);
+        b.Store(a, b.Add<i32>(b.Load(c), 1_i));
+        auto* y = b.Load(a);
+        b.Store(c, b.Multiply<i32>(x, y));
+        b.Return(ep, b.Load(c));
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var
+    %c:ptr<function, i32, read_write> = var, %p
+    %5:i32 = load %a
+    %6:i32 = load %c
+    %7:i32 = add %6, 1i
+    store %a, %7
+    %8:i32 = load %a
+    %9:i32 = mul %5, %8
+    store %c, %9
+    %10:i32 = load %c
+    ret %10
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %p, 1i
+    %4:i32 = mul 0i, %3
+    ret %4
+  }
+}
+)";
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, StoreInIf) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Var<function>("a", param);
+        auto* ifelse = b.If(b.Equal<bool>(param, 0_i));
+        b.Append(ifelse->True(), [&] {
+            auto* inner = b.Var<function>("inner", 2_i);
+            b.Store(a, b.Load(inner));
+            b.ExitIf(ifelse);
+        });
+        b.Return(ep, b.Load(a));
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var, %p
+    %4:bool = eq %p, 0i
+    if %4 [t: %b2] {  # if_1
+      %b2 = block {  # true
+        %inner:ptr<function, i32, read_write> = var, 2i
+        %6:i32 = load %inner
+        store %a, %6
+        exit_if  # if_1
+      }
+    }
+    %7:i32 = load %a
+    ret %7
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:bool = eq %p, 0i
+    %a:i32 = if %3 [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        exit_if 2i  # if_1
+      }
+      %b3 = block {  # false
+        exit_if %p  # if_1
+      }
+    }
+    ret %a
+  }
+}
+)";
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, StoreInIfWithResults) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Var<function, i32>("a");
+        auto* ifelse = b.If(b.Equal<bool>(param, 0_i));
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {
+            b.Store(a, 1_i);
+            b.ExitIf(ifelse, 2_i);
+        });
+        b.Append(ifelse->False(), [&] { b.ExitIf(ifelse, 3_i); });
+        b.Return(ep, b.Add<i32>(ifelse->Result(0), b.Load(a)));
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var
+    %4:bool = eq %p, 0i
+    %5:i32 = if %4 [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        store %a, 1i
+        exit_if 2i  # if_1
+      }
+      %b3 = block {  # false
+        exit_if 3i  # if_1
+      }
+    }
+    %6:i32 = load %a
+    %7:i32 = add %5, %6
+    ret %7
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:bool = eq %p, 0i
+    %4:i32, %a:i32 = if %3 [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        exit_if 2i, 1i  # if_1
+      }
+      %b3 = block {  # false
+        exit_if 3i, 0i  # if_1
+      }
+    }
+    %6:i32 = add %4, %a
+    ret %6
+  }
+}
+)";
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, StoreInIfThatReturns) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Var<function, i32>("a");
+        auto* ifelse = b.If(b.Equal<bool>(param, 0_i));
+        b.Append(ifelse->True(), [&] {
+            b.Store(a, 1_i);
+            b.Return(ep, b.Load(a));
+        });
+        b.Append(ifelse->False(), [&] {
+            b.Store(a, 2_i);
+            b.Return(ep, b.Load(a));
+        });
+        b.Unreachable();
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var
+    %4:bool = eq %p, 0i
+    if %4 [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        store %a, 1i
+        %5:i32 = load %a
+        ret %5
+      }
+      %b3 = block {  # false
+        store %a, 2i
+        %6:i32 = load %a
+        ret %6
+      }
+    }
+    unreachable
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:bool = eq %p, 0i
+    if %3 [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        ret 1i
+      }
+      %b3 = block {  # false
+        ret 2i
+      }
+    }
+    unreachable
+  }
+}
+)";
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, StoreInSwitch) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Var<function, i32>("a");
+        auto* c = b.Var<function, i32>("c");
+        auto* swtch = b.Switch(param);
+        b.Append(b.Case(swtch, {b.Constant(1_i)}), [&] {
+            b.Store(a, 1_i);
+            b.ExitSwitch(swtch);
+        });
+        b.Append(b.Case(swtch, {b.Constant(2_i)}), [&] {
+            b.Store(c, 2_i);
+            auto* ifelse = b.If(b.Equal<bool>(param, 0_i));
+            b.Append(ifelse->True(), [&] {
+                b.Store(a, 3_i);
+                b.ExitSwitch(swtch);
+            });
+            b.Store(a, 4_i);
+            b.ExitSwitch(swtch);
+        });
+        b.Append(b.DefaultCase(swtch), [&] { b.Return(ep, 0_i); });
+        auto* x = b.Load(a);
+        b.Return(ep, b.Add<i32>(x, b.Load(c)));
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var
+    %c:ptr<function, i32, read_write> = var
+    switch %p [c: (1i, %b2), c: (2i, %b3), c: (default, %b4)] {  # switch_1
+      %b2 = block {  # case
+        store %a, 1i
+        exit_switch  # switch_1
+      }
+      %b3 = block {  # case
+        store %c, 2i
+        %5:bool = eq %p, 0i
+        if %5 [t: %b5] {  # if_1
+          %b5 = block {  # true
+            store %a, 3i
+            exit_switch  # switch_1
+          }
+        }
+        store %a, 4i
+        exit_switch  # switch_1
+      }
+      %b4 = block {  # case
+        ret 0i
+      }
+    }
+    %6:i32 = load %a
+    %7:i32 = load %c
+    %8:i32 = add %6, %7
+    ret %8
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %a:i32, %c:i32 = switch %p [c: (1i, %b2), c: (2i, %b3), c: (default, %b4)] {  # switch_1
+      %b2 = block {  # case
+        exit_switch 1i, 0i  # switch_1
+      }
+      %b3 = block {  # case
+        %5:bool = eq %p, 0i
+        %a_1:i32 = if %5 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_switch 3i, 2i  # switch_1
+          }
+          %b6 = block {  # false
+            exit_if 0i  # if_1
+          }
+        }  # %a_1: 'a'
+        exit_switch 4i, 2i  # switch_1
+      }
+      %b4 = block {  # case
+        ret 0i
+      }
+    }
+    %7:i32 = add %a, %c
+    ret %7
+  }
+}
+)";
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, ForLoop) {
+    auto* ep = b.Function("ep", ty.i32());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* sum = b.Var<function, i32>("sum");
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_i);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(b.LessThan<bool>(b.Load(i), param));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                auto* x = b.Load(sum);
+                b.Store(sum, b.Add<i32>(x, b.Load(i)));
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<i32>(b.Load(i), 1_i));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(ep, b.Load(sum));
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:i32 = load %i
+        %6:bool = lt %5, %p
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:i32 = load %sum
+        %8:i32 = load %i
+        %9:i32 = add %7, %8
+        store %sum, %9
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %10:i32 = load %i
+        %11:i32 = add %10, 1i
+        store %i, %11
+        next_iteration %b3
+      }
+    }
+    %12:i32 = load %sum
+    ret %12
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):i32 -> %b1 {
+  %b1 = block {
+    %sum:i32 = loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        next_iteration %b3 0i, 0i
+      }
+      %b3 = block (%sum_1:i32, %i:i32) {  # body
+        %6:bool = lt %i:i32, %p
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop %sum_1:i32  # loop_1
+          }
+        }
+        %7:i32 = add %sum_1:i32, %i:i32
+        continue %b4 %7, %i:i32
+      }
+      %b4 = block (%sum_2:i32, %i_1:i32) {  # continuing
+        %10:i32 = add %i_1:i32, 1i
+        next_iteration %b3 %sum_2:i32, %10
+      }
+    }
+    ret %sum
+  }
+}
+)";
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, LoopWithoutInitializerOrContinuing) {
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Var<function>("a", 1_i);
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            auto* x = b.Multiply<i32>(b.Load(a), 2_i);
+            b.Store(a, x);
+            auto* ifelse = b.If(b.GreaterThan<bool>(x, 100_i));
+            b.Append(ifelse->True(), [&] { b.ExitLoop(loop); });
+            b.Continue(loop);
+        });
+        b.Return(ep, b.Load(a));
+    });
+
+    auto* src = R"(
+%ep = func():i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var, 1i
+    loop [b: %b2] {  # loop_1
+      %b2 = block {  # body
+        %3:i32 = load %a
+        %4:i32 = mul %3, 2i
+        store %a, %4
+        %5:bool = gt %4, 100i
+        if %5 [t: %b3] {  # if_1
+          %b3 = block {  # true
+            exit_loop  # loop_1
+          }
+        }
+        continue %b4
+      }
+    }
+    %6:i32 = load %a
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func():i32 -> %b1 {
+  %b1 = block {
+    %a:i32 = loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        next_iteration %b3 1i
+      }
+      %b3 = block (%a_1:i32) {  # body
+        %4:i32 = mul %a_1:i32, 2i
+        %5:bool = gt %4, 100i
+        if %5 [t: %b5] {  # if_1
+          %b5 = block {  # true
+            exit_loop %4  # loop_1
+          }
+        }
+        continue %b4 %4
+      }
+      %b4 = block (%a_2:i32) {  # continuing
+        next_iteration %b3 %a_2:i32
+      }
+    }
+    ret %a
+  }
+}
+)";
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, BodyVarUsedInContinuing) {
+    auto* ep = b.Function("ep", ty.void_());
+    auto* param = b.FunctionParam("p", ty.i32());
+    ep->SetParams({param});
+    b.Append(ep->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            auto* ifelse = b.If(b.Equal<bool>(param, 0_i));
+            b.Append(ifelse->True(), [&] { b.Continue(loop); });
+            auto* a = b.Var<function>("a", param);
+            b.Store(a, b.Add<i32>(b.Load(a), 1_i));
+            b.Continue(loop);
+
+            b.Append(loop->Continuing(), [&] {
+                b.BreakIf(loop, b.GreaterThan<bool>(b.Load(a), 10_i));
+            });
+        });
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        %3:bool = eq %p, 0i
+        if %3 [t: %b4] {  # if_1
+          %b4 = block {  # true
+            continue %b3
+          }
+        }
+        %a:ptr<function, i32, read_write> = var, %p
+        %5:i32 = load %a
+        %6:i32 = add %5, 1i
+        store %a, %6
+        continue %b3
+      }
+      %b3 = block {  # continuing
+        %7:i32 = load %a
+        %8:bool = gt %7, 10i
+        break_if %8 %b2
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func(%p:i32):void -> %b1 {
+  %b1 = block {
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        %3:bool = eq %p, 0i
+        if %3 [t: %b4] {  # if_1
+          %b4 = block {  # true
+            continue %b3 0i
+          }
+        }
+        %4:i32 = add %p, 1i
+        continue %b3 %4
+      }
+      %b3 = block (%a:i32) {  # continuing
+        %6:bool = gt %a:i32, 10i
+        break_if %6 %b2
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_PromoteVarsToValuesTest, StoreInLoopWithBreakIf) {
+    auto* ep = b.Function("ep", ty.i32());
+    b.Append(ep->Block(), [&] {
+        auto* a = b.Var<function>("a", 1_i);
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_i);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                b.Store(a, b.Multiply<i32>(b.Load(a), 2_i));
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                auto* next = b.Add<i32>(b.Load(i), 1_i);
+                b.Store(i, next);
+                b.BreakIf(loop, b.Equal<bool>(next, 4_i));
+            });
+        });
+        b.Return(ep, b.Load(a));
+    });
+
+    auto* src = R"(
+%ep = func():i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var, 1i
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, i32, read_write> = var, 0i
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %4:i32 = load %a
+        %5:i32 = mul %4, 2i
+        store %a, %5
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %6:i32 = load %i
+        %7:i32 = add %6, 1i
+        store %i, %7
+        %8:bool = eq %7, 4i
+        break_if %8 %b3
+      }
+    }
+    %9:i32 = load %a
+    ret %9
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%ep = func():i32 -> %b1 {
+  %b1 = block {
+    %a:ptr<function, i32, read_write> = var, 1i
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        next_iteration %b3 0i
+      }
+      %b3 = block (%i:i32) {  # body
+        %4:i32 = load %a
+        %5:i32 = mul %4, 2i
+        store %a, %5
+        continue %b4 %i:i32
+      }
+      %b4 = block (%i_1:i32) {  # continuing
+        %7:i32 = add %i_1:i32, 1i
+        %8:bool = eq %7, 4i
+        break_if %8 %b3 %7
+      }
+    }
+    %9:i32 = load %a
+    ret %9
+  }
+}
+)";
+
+    Run(PromoteVarsToValues);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
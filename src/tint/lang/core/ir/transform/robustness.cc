@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "src/tint/lang/core/ir/analysis/integer_range_analysis.h"
 #include "src/tint/lang/core/ir/builder.h"
 #include "src/tint/lang/core/ir/module.h"
 #include "src/tint/lang/core/ir/validator.h"
@@ -58,6 +59,12 @@ struct State {
     /// The type manager.
     core::type::Manager& ty{ir.Types()};
 
+    /// The integer range analysis, used to skip the clamping of indices that are in bounds.
+    analysis::IntegerRangeAnalysis ranges{ir};
+
+    /// The `min` calls that clamp each index, used to reuse the clamps of the same index.
+    Hashmap<ir::Value*, Vector<ir::CoreBuiltinCall*, 2>, 32> clamps{};
+
     /// Process the module.
     void Process() {
         // Find the access instructions that may need to be clamped.
@@ -201,15 +208,59 @@ struct State {
             // Generate a new constant index that is clamped to the limit.
             clamped_idx = b.Constant(u32(std::min(const_idx->Value()->ValueAs<uint32_t>(),
                                                   const_limit->Value()->ValueAs<uint32_t>())));
+        } else if (const_limit && config.use_integer_range_analysis &&
+                   ranges.Get(idx).IsWithin(const_limit->Value()->ValueAs<int64_t>())) {
+            // The index is known to be within the limit.
+            return;
+        } else if (auto* clamp = FindClamp(idx, limit, inst)) {
+            // Reuse the clamp of the same index that comes before this instruction.
+            clamped_idx = clamp->Result(0);
         } else {
             // Clamp it to the dynamic limit.
-            clamped_idx = b.Call(ty.u32(), core::BuiltinFn::kMin, CastToU32(idx), limit)->Result(0);
+            auto* call = b.Call(ty.u32(), core::BuiltinFn::kMin, CastToU32(idx), limit);
+            if (config.use_integer_range_analysis) {
+                // Record the clamp, so that later accesses with the same index can reuse it.
+                clamps.GetOrAddZero(idx).Push(call);
+            }
+            clamped_idx = call->Result(0);
         }
 
         // Replace the index operand with the clamped version.
         inst->SetOperand(op_idx, clamped_idx);
     }
 
+    /// @returns a `min` call that clamps @p idx to @p limit and is always executed before @p inst,
+    /// or nullptr if there is no such call
+    /// @param idx the index
+    /// @param limit the limit of the index
+    /// @param inst the instruction that uses the index
+    ir::CoreBuiltinCall* FindClamp(ir::Value* idx, ir::Value* limit, ir::Instruction* inst) {
+        auto calls = clamps.Get(idx);
+        if (!calls) {
+            return nullptr;
+        }
+        for (auto* call : *calls) {
+            if (call->Args()[1] != limit) {
+                continue;
+            }
+            // Find the instruction in the block of the call that holds `inst`, and check that the
+            // call comes before it.
+            auto* holder = inst;
+            while (holder && holder->Block() != call->Block()) {
+                holder = holder->Block()->Parent();
+            }
+            if (!holder) {
+                continue;
+            }
+            for (auto* prev = holder->prev.Get(); prev; prev = prev->prev.Get()) {
+                if (prev == call) {
+                    return call;
+                }
+            }
+        }
+        return nullptr;
+    }
+
     /// Clamp the indices of an access instruction to ensure they are within the limits of the types
     /// that they are indexing into.
     /// @param access the access instruction
@@ -67,6 +67,12 @@ struct RobustnessConfig {
 
     /// Should the transform skip index clamping on runtime-sized arrays?
     bool disable_runtime_sized_array_index_clamping = false;
+
+    /// Should the transform skip the clamping of indices that the integer range analysis proves to
+    /// be in bounds, such as the variable of a `for` loop that is bounded by the loop condition,
+    /// and reuse the clamp of an index that has already been clamped to the same limit?
+    /// This changes the generated code, so it is only enabled by the optimizing writer pipelines.
+    bool use_integer_range_analysis = false;
 };
 
 /// Robustness is a transform that prevents out-of-bounds memory accesses.
@@ -3649,5 +3649,498 @@ TEST_P(IR_RobustnessTest, TextureStore_Storage3D) {
     EXPECT_EQ(GetParam() ? expect : src, str());
 }
 
+////////////////////////////////////////////////////////////////
+// Test the indices that are proven to be in bounds by the integer range analysis.
+////////////////////////////////////////////////////////////////
+
+using IR_RobustnessIntegerRangeTest = TransformTest;
+
+TEST_F(IR_RobustnessIntegerRangeTest, ForLoopVar) {
+    auto* func = b.Function("foo", ty.u32());
+    b.Append(func->Block(), [&] {
+        auto* arr = b.Var("arr", ty.ptr(function, ty.array<u32, 4>()));
+        auto* sum = b.Var<function, u32>("sum");
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_u);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(b.LessThan<bool>(b.Load(i), 4_u));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                auto* access = b.Access(ty.ptr<function, u32>(), arr, b.Load(i));
+                auto* x = b.Load(sum);
+                b.Store(sum, b.Add<u32>(x, b.Load(access)));
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<u32>(b.Load(i), 1_u));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func, b.Load(sum));
+    });
+
+    auto* src = R"(
+%foo = func():u32 -> %b1 {
+  %b1 = block {
+    %arr:ptr<function, array<u32, 4>, read_write> = var
+    %sum:ptr<function, u32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, u32, read_write> = var, 0u
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:u32 = load %i
+        %6:bool = lt %5, 4u
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:u32 = load %i
+        %8:ptr<function, u32, read_write> = access %arr, %7
+        %9:u32 = load %sum
+        %10:u32 = load %8
+        %11:u32 = add %9, %10
+        store %sum, %11
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %12:u32 = load %i
+        %13:u32 = add %12, 1u
+        store %i, %13
+        next_iteration %b3
+      }
+    }
+    %14:u32 = load %sum
+    ret %14
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():u32 -> %b1 {
+  %b1 = block {
+    %arr:ptr<function, array<u32, 4>, read_write> = var
+    %sum:ptr<function, u32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, u32, read_write> = var, 0u
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:u32 = load %i
+        %6:bool = lt %5, 4u
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:u32 = load %i
+        %8:ptr<function, u32, read_write> = access %arr, %7
+        %9:u32 = load %sum
+        %10:u32 = load %8
+        %11:u32 = add %9, %10
+        store %sum, %11
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %12:u32 = load %i
+        %13:u32 = add %12, 1u
+        store %i, %13
+        next_iteration %b3
+      }
+    }
+    %14:u32 = load %sum
+    ret %14
+  }
+}
+)";
+
+    RobustnessConfig cfg;
+    cfg.use_integer_range_analysis = true;
+    Run(Robustness, cfg);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_RobustnessIntegerRangeTest, ForLoopVar_OutOfBounds) {
+    auto* func = b.Function("foo", ty.u32());
+    b.Append(func->Block(), [&] {
+        auto* arr = b.Var("arr", ty.ptr(function, ty.array<u32, 4>()));
+        auto* sum = b.Var<function, u32>("sum");
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_u);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(b.LessThanEqual<bool>(b.Load(i), 4_u));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                auto* access = b.Access(ty.ptr<function, u32>(), arr, b.Load(i));
+                auto* x = b.Load(sum);
+                b.Store(sum, b.Add<u32>(x, b.Load(access)));
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<u32>(b.Load(i), 1_u));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func, b.Load(sum));
+    });
+
+    auto* src = R"(
+%foo = func():u32 -> %b1 {
+  %b1 = block {
+    %arr:ptr<function, array<u32, 4>, read_write> = var
+    %sum:ptr<function, u32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, u32, read_write> = var, 0u
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:u32 = load %i
+        %6:bool = lte %5, 4u
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:u32 = load %i
+        %8:ptr<function, u32, read_write> = access %arr, %7
+        %9:u32 = load %sum
+        %10:u32 = load %8
+        %11:u32 = add %9, %10
+        store %sum, %11
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %12:u32 = load %i
+        %13:u32 = add %12, 1u
+        store %i, %13
+        next_iteration %b3
+      }
+    }
+    %14:u32 = load %sum
+    ret %14
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():u32 -> %b1 {
+  %b1 = block {
+    %arr:ptr<function, array<u32, 4>, read_write> = var
+    %sum:ptr<function, u32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, u32, read_write> = var, 0u
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:u32 = load %i
+        %6:bool = lte %5, 4u
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:u32 = load %i
+        %8:u32 = min %7, 3u
+        %9:ptr<function, u32, read_write> = access %arr, %8
+        %10:u32 = load %sum
+        %11:u32 = load %9
+        %12:u32 = add %10, %11
+        store %sum, %12
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %13:u32 = load %i
+        %14:u32 = add %13, 1u
+        store %i, %14
+        next_iteration %b3
+      }
+    }
+    %15:u32 = load %sum
+    ret %15
+  }
+}
+)";
+
+    RobustnessConfig cfg;
+    cfg.use_integer_range_analysis = true;
+    Run(Robustness, cfg);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_RobustnessIntegerRangeTest, LocalInvocationId) {
+    auto* wgvar = b.Var("wgvar", ty.ptr(workgroup, ty.array<f32, 16>()));
+    mod.root_block->Append(wgvar);
+
+    auto* func = b.Function("foo", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{4u, 4u, 1u});
+    auto* id = b.FunctionParam("id", ty.vec3<u32>());
+    id->SetBuiltin(BuiltinValue::kLocalInvocationId);
+    func->SetParams({id});
+    b.Append(func->Block(), [&] {
+        auto* x = b.Access<u32>(id, 0_u);
+        auto* y = b.Access<u32>(id, 1_u);
+        auto* idx = b.Add<u32>(b.Multiply<u32>(y, 4_u), x);
+        b.Store(b.Access(ty.ptr<workgroup, f32>(), wgvar, idx), 1_f);
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %wgvar:ptr<workgroup, array<f32, 16>, read_write> = var
+}
+
+%foo = @compute @workgroup_size(4, 4, 1) func(%id:vec3<u32> [@local_invocation_id]):void -> %b2 {
+  %b2 = block {
+    %4:u32 = access %id, 0u
+    %5:u32 = access %id, 1u
+    %6:u32 = mul %5, 4u
+    %7:u32 = add %6, %4
+    %8:ptr<workgroup, f32, read_write> = access %wgvar, %7
+    store %8, 1.0f
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %wgvar:ptr<workgroup, array<f32, 16>, read_write> = var
+}
+
+%foo = @compute @workgroup_size(4, 4, 1) func(%id:vec3<u32> [@local_invocation_id]):void -> %b2 {
+  %b2 = block {
+    %4:u32 = access %id, 0u
+    %5:u32 = access %id, 1u
+    %6:u32 = mul %5, 4u
+    %7:u32 = add %6, %4
+    %8:ptr<workgroup, f32, read_write> = access %wgvar, %7
+    store %8, 1.0f
+    ret
+  }
+}
+)";
+
+    RobustnessConfig cfg;
+    cfg.use_integer_range_analysis = true;
+    Run(Robustness, cfg);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_RobustnessIntegerRangeTest, Disabled) {
+    auto* func = b.Function("foo", ty.u32());
+    b.Append(func->Block(), [&] {
+        auto* arr = b.Var("arr", ty.ptr(function, ty.array<u32, 4>()));
+        auto* sum = b.Var<function, u32>("sum");
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {
+            auto* i = b.Var<function>("i", 0_u);
+            b.NextIteration(loop);
+
+            b.Append(loop->Body(), [&] {
+                auto* ifelse = b.If(b.LessThan<bool>(b.Load(i), 4_u));
+                b.Append(ifelse->True(), [&] { b.ExitIf(ifelse); });
+                b.Append(ifelse->False(), [&] { b.ExitLoop(loop); });
+                auto* access = b.Access(ty.ptr<function, u32>(), arr, b.Load(i));
+                auto* x = b.Load(sum);
+                b.Store(sum, b.Add<u32>(x, b.Load(access)));
+                b.Continue(loop);
+            });
+
+            b.Append(loop->Continuing(), [&] {
+                b.Store(i, b.Add<u32>(b.Load(i), 1_u));
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func, b.Load(sum));
+    });
+
+    auto* src = R"(
+%foo = func():u32 -> %b1 {
+  %b1 = block {
+    %arr:ptr<function, array<u32, 4>, read_write> = var
+    %sum:ptr<function, u32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, u32, read_write> = var, 0u
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:u32 = load %i
+        %6:bool = lt %5, 4u
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:u32 = load %i
+        %8:ptr<function, u32, read_write> = access %arr, %7
+        %9:u32 = load %sum
+        %10:u32 = load %8
+        %11:u32 = add %9, %10
+        store %sum, %11
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %12:u32 = load %i
+        %13:u32 = add %12, 1u
+        store %i, %13
+        next_iteration %b3
+      }
+    }
+    %14:u32 = load %sum
+    ret %14
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():u32 -> %b1 {
+  %b1 = block {
+    %arr:ptr<function, array<u32, 4>, read_write> = var
+    %sum:ptr<function, u32, read_write> = var
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        %i:ptr<function, u32, read_write> = var, 0u
+        next_iteration %b3
+      }
+      %b3 = block {  # body
+        %5:u32 = load %i
+        %6:bool = lt %5, 4u
+        if %6 [t: %b5, f: %b6] {  # if_1
+          %b5 = block {  # true
+            exit_if  # if_1
+          }
+          %b6 = block {  # false
+            exit_loop  # loop_1
+          }
+        }
+        %7:u32 = load %i
+        %8:u32 = min %7, 3u
+        %9:ptr<function, u32, read_write> = access %arr, %8
+        %10:u32 = load %sum
+        %11:u32 = load %9
+        %12:u32 = add %10, %11
+        store %sum, %12
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %13:u32 = load %i
+        %14:u32 = add %13, 1u
+        store %i, %14
+        next_iteration %b3
+      }
+    }
+    %15:u32 = load %sum
+    ret %15
+  }
+}
+)";
+
+    // The integer range analysis is disabled by default.
+    RobustnessConfig cfg;
+    Run(Robustness, cfg);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_RobustnessIntegerRangeTest, ReuseClampOfSameIndex) {
+    auto* func = b.Function("foo", ty.u32());
+    auto* idx = b.FunctionParam("idx", ty.u32());
+    func->SetParams({idx});
+    b.Append(func->Block(), [&] {
+        auto* arr = b.Var("arr", ty.ptr(function, ty.array<u32, 4>()));
+        auto* first = b.Load(b.Access(ty.ptr<function, u32>(), arr, idx));
+        auto* ifelse = b.If(true);
+        b.Append(ifelse->True(), [&] {
+            b.Store(b.Access(ty.ptr<function, u32>(), arr, idx), first);
+            b.ExitIf(ifelse);
+        });
+        b.Return(func, b.Load(b.Access(ty.ptr<function, u32>(), arr, idx)));
+    });
+
+    auto* src = R"(
+%foo = func(%idx:u32):u32 -> %b1 {
+  %b1 = block {
+    %arr:ptr<function, array<u32, 4>, read_write> = var
+    %4:ptr<function, u32, read_write> = access %arr, %idx
+    %5:u32 = load %4
+    if true [t: %b2] {  # if_1
+      %b2 = block {  # true
+        %6:ptr<function, u32, read_write> = access %arr, %idx
+        store %6, %5
+        exit_if  # if_1
+      }
+    }
+    %7:ptr<function, u32, read_write> = access %arr, %idx
+    %8:u32 = load %7
+    ret %8
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%idx:u32):u32 -> %b1 {
+  %b1 = block {
+    %arr:ptr<function, array<u32, 4>, read_write> = var
+    %4:u32 = min %idx, 3u
+    %5:ptr<function, u32, read_write> = access %arr, %4
+    %6:u32 = load %5
+    if true [t: %b2] {  # if_1
+      %b2 = block {  # true
+        %7:ptr<function, u32, read_write> = access %arr, %4
+        store %7, %6
+        exit_if  # if_1
+      }
+    }
+    %8:ptr<function, u32, read_write> = access %arr, %4
+    %9:u32 = load %8
+    ret %9
+  }
+}
+)";
+
+    RobustnessConfig cfg;
+    cfg.use_integer_range_analysis = true;
+    Run(Robustness, cfg);
+
+    EXPECT_EQ(expect, str());
+}
+
 }  // namespace
 }  // namespace tint::core::ir::transform
@@ -222,6 +222,7 @@ struct State {
                 auto* helper = convert_helpers.GetOrAdd(str, [&] {
                     auto* input_str = source->Type()->As<core::type::Struct>();
                     auto* func = b.Function("convert_" + str->FriendlyName(), str);
+                    func->SetAlwaysInline(true);
                     auto* input = b.FunctionParam("input", input_str);
                     func->SetParams({input});
                     b.Append(func->Block(), [&] {
@@ -92,12 +92,12 @@ struct State {
 
         auto maybe_put_in_let = [&](auto* inst) {
             if (auto* result = inst->Result(0)) {
-                auto& usages = result->Usages();
+                auto usages = result->Usages();
                 switch (usages.Count()) {
                     case 0:  // No usage
                         break;
                     case 1: {  // Single usage
-                        auto usage = (*usages.begin())->instruction;
+                        auto usage = usages.begin()->instruction;
                         if (usage->Block() == inst->Block()) {
                             // Usage in same block. Assign to pending_resolution, as we don't
                             // know whether its safe to inline yet.
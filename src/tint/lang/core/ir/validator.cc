@@ -130,7 +130,12 @@ class Validator {
     /// Create a core validator
     /// @param mod the module to be validated
     /// @param capabilities the optional capabilities that are allowed
-    explicit Validator(const Module& mod, Capabilities capabilities);
+    /// @param mode the level of validation to perform
+    /// @param functions if not null, the only functions of the module to validate
+    Validator(const Module& mod,
+              Capabilities capabilities,
+              ValidationMode mode,
+              const VectorRef<const Function*>* functions = nullptr);
 
     /// Destructor
     ~Validator();
@@ -318,6 +323,8 @@ class Validator {
   private:
     const Module& mod_;
     Capabilities capabilities_;
+    ValidationMode mode_;
+    const VectorRef<const Function*>* functions_ = nullptr;
     std::shared_ptr<Source::File> disassembly_file;
     diag::List diagnostics_;
     Disassembler dis_{mod_};
@@ -329,8 +336,11 @@ class Validator {
     void DisassembleIfNeeded();
 };
 
-Validator::Validator(const Module& mod, Capabilities capabilities)
-    : mod_(mod), capabilities_(capabilities) {}
+Validator::Validator(const Module& mod,
+                     Capabilities capabilities,
+                     ValidationMode mode,
+                     const VectorRef<const Function*>* functions)
+    : mod_(mod), capabilities_(capabilities), mode_(mode), functions_(functions) {}
 
 Validator::~Validator() = default;
 
@@ -351,11 +361,21 @@ Result<SuccessType> Validator::Run() {
         }
     }
 
-    for (auto& func : mod_.functions) {
-        CheckFunction(func);
+    if (functions_) {
+        for (auto* func : *functions_) {
+            // Skip functions that have been removed from the module.
+            if (all_functions_.Contains(func)) {
+                CheckFunction(func);
+            }
+        }
+    } else {
+        for (auto& func : mod_.functions) {
+            CheckFunction(func);
+        }
     }
 
-    if (!diagnostics_.ContainsErrors()) {
+    // Orphaned instructions can only be detected when all the functions have been visited.
+    if (!functions_ && !diagnostics_.ContainsErrors()) {
         // Check for orphaned instructions.
         for (auto* inst : mod_.Instructions()) {
             if (!visited_instructions_.Contains(inst)) {
@@ -574,6 +594,17 @@ void Validator::CheckInstruction(const Instruction* inst) {
         }
     }
 
+    if (mode_ == ValidationMode::kStructural) {
+        // Only check the control flow structure, and skip type checking of the instructions.
+        tint::Switch(
+            inst,                                              //
+            [&](const If* if_) { CheckIf(if_); },              //
+            [&](const Loop* l) { CheckLoop(l); },              //
+            [&](const Switch* s) { CheckSwitch(s); },          //
+            [&](const Terminator* b) { CheckTerminator(b); });
+        return;
+    }
+
     tint::Switch(
         inst,                                                              //
         [&](const Access* a) { CheckAccess(a); },                          //
@@ -1089,14 +1120,28 @@ const core::type::Type* Validator::GetVectorPtrElementType(const Instruction* in
 
 }  // namespace
 
-Result<SuccessType> Validate(const Module& mod, Capabilities capabilities) {
-    Validator v(mod, capabilities);
+Result<SuccessType> Validate(const Module& mod, Capabilities capabilities, ValidationMode mode) {
+    if (mode == ValidationMode::kNone) {
+        return Success;
+    }
+    Validator v(mod, capabilities, mode);
     return v.Run();
 }
 
-Result<SuccessType> ValidateAndDumpIfNeeded([[maybe_unused]] const Module& ir,
+Result<SuccessType> ValidateFunctions(const Module& mod,
+                                      VectorRef<const Function*> functions,
+                                      Capabilities capabilities,
+                                      ValidationMode mode) {
+    if (mode == ValidationMode::kNone) {
+        return Success;
+    }
+    Validator v(mod, capabilities, mode, &functions);
+    return v.Run();
+}
+
+Result<SuccessType> ValidateAndDumpIfNeeded(Module& ir,
                                             [[maybe_unused]] const char* msg,
-                                            [[maybe_unused]] Capabilities capabilities) {
+                                            Capabilities capabilities) {
 #if TINT_DUMP_IR_WHEN_VALIDATING
     std::cout << "=========================================================" << std::endl;
     std::cout << "== IR dump before " << msg << ":" << std::endl;
@@ -1104,14 +1149,22 @@ Result<SuccessType> ValidateAndDumpIfNeeded([[maybe_unused]] const Module& ir,
     std::cout << Disassemble(ir);
 #endif
 
-#ifndef NDEBUG
-    auto result = Validate(ir, capabilities);
+    // The transform that is about to run may modify any part of the module, unless it declares
+    // otherwise with SetModifiedFunctions().
+    auto modified = std::move(ir.modified_functions);
+    ir.modified_functions.reset();
+
+    auto result = modified ? ValidateFunctions(ir, *modified, capabilities, ir.validation_mode)
+                           : Validate(ir, capabilities, ir.validation_mode);
     if (result != Success) {
         return result.Failure();
     }
-#endif
 
     return Success;
 }
 
+void SetModifiedFunctions(Module& ir, VectorRef<const Function*> functions) {
+    ir.modified_functions = Vector<const Function*, 8>(functions);
+}
+
 }  // namespace tint::core::ir
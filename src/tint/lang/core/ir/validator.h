@@ -28,13 +28,16 @@
 #ifndef SRC_TINT_LANG_CORE_IR_VALIDATOR_H_
 #define SRC_TINT_LANG_CORE_IR_VALIDATOR_H_
 
+#include <cstdint>
 #include <string>
 
 #include "src/tint/utils/containers/enum_set.h"
+#include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/result/result.h"
 
 // Forward declarations
 namespace tint::core::ir {
+class Function;
 class Module;
 }  // namespace tint::core::ir
 
@@ -51,21 +54,69 @@ enum class Capability {
 /// Capabilities is a set of Capability
 using Capabilities = EnumSet<Capability>;
 
+/// Enumerator of the levels of IR validation.
+enum class ValidationMode : uint8_t {
+    /// No validation is performed.
+    kNone,
+    /// Only the structure of the IR is validated: block terminators, instruction parents, result
+    /// and operand usages, and the targets of control flow instructions. Instructions are not type
+    /// checked, which avoids the cost of the intrinsic table lookups.
+    kStructural,
+    /// All the validation rules are checked.
+    kFull,
+};
+
+/// The validation mode used by ValidateAndDumpIfNeeded() for a newly constructed Module.
+#ifndef NDEBUG
+static constexpr ValidationMode kDefaultValidationMode = ValidationMode::kFull;
+#else
+static constexpr ValidationMode kDefaultValidationMode = ValidationMode::kNone;
+#endif
+
 /// Validates that a given IR module is correctly formed
 /// @param mod the module to validate
 /// @param capabilities the optional capabilities that are allowed
+/// @param mode the level of validation to perform
+/// @returns success or failure
+Result<SuccessType> Validate(const Module& mod,
+                            Capabilities capabilities = {},
+                            ValidationMode mode = ValidationMode::kFull);
+
+/// Validates the root block and the functions @p functions of the module @p mod.
+/// The other functions of the module are assumed to be valid, and are not checked.
+/// @param mod the module to validate
+/// @param functions the functions to validate. Functions that are not part of the module are
+/// ignored.
+/// @param capabilities the optional capabilities that are allowed
+/// @param mode the level of validation to perform
 /// @returns success or failure
-Result<SuccessType> Validate(const Module& mod, Capabilities capabilities = {});
+Result<SuccessType> ValidateFunctions(const Module& mod,
+                                      VectorRef<const Function*> functions,
+                                      Capabilities capabilities = {},
+                                      ValidationMode mode = ValidationMode::kFull);
 
-/// Validates the module @p ir and dumps its contents if required by the build configuration.
+/// Validates the module @p ir with the module's validation mode, and dumps its contents if required
+/// by the build configuration.
+/// If the last transform declared the functions it modified with SetModifiedFunctions(), then
+/// only the root block and those functions are validated.
 /// @param ir the module to transform
 /// @param msg the msg to accompany the output
 /// @param capabilities the optional capabilities that are allowed
 /// @returns success or failure
-Result<SuccessType> ValidateAndDumpIfNeeded(const Module& ir,
+Result<SuccessType> ValidateAndDumpIfNeeded(Module& ir,
                                             const char* msg,
                                             Capabilities capabilities = {});
 
+/// Declares that the transform that has just been run on @p ir has only modified the root block and
+/// the functions @p functions, so that the next call to ValidateAndDumpIfNeeded() only needs to
+/// re-validate those. @p functions must include any function created by the transform, and the
+/// callers of any function whose signature was changed.
+/// @note this must only be called by a transform that called ValidateAndDumpIfNeeded() on entry and
+/// that did not run any other transforms since.
+/// @param ir the module
+/// @param functions the functions modified by the transform
+void SetModifiedFunctions(Module& ir, VectorRef<const Function*> functions);
+
 }  // namespace tint::core::ir
 
 #endif  // SRC_TINT_LANG_CORE_IR_VALIDATOR_H_
@@ -3529,6 +3529,92 @@ note: # Disassembly
 )");
 }
 
+TEST_F(IR_ValidatorTest, ValidationMode_None) {
+    b.Function("my_func", ty.void_());
+
+    EXPECT_EQ(ir::Validate(mod, {}, ValidationMode::kNone), Success);
+}
+
+TEST_F(IR_ValidatorTest, ValidationMode_Structural_SkipsTypeChecks) {
+    auto* v =
+        mod.allocators.instructions.Create<ir::Let>(b.InstructionResult(ty.f32()), b.Constant(1_i));
+
+    auto* f = b.Function("my_func", ty.void_());
+
+    auto sb = b.Append(f->Block());
+    sb.Append(v);
+    sb.Return(f);
+
+    EXPECT_EQ(ir::Validate(mod, {}, ValidationMode::kStructural), Success);
+    EXPECT_NE(ir::Validate(mod, {}, ValidationMode::kFull), Success);
+}
+
+TEST_F(IR_ValidatorTest, ValidationMode_Structural_NoTerminator) {
+    b.Function("my_func", ty.void_());
+
+    auto res = ir::Validate(mod, {}, ValidationMode::kStructural);
+    ASSERT_NE(res, Success);
+    EXPECT_THAT(res.Failure().reason.Str(),
+                testing::HasSubstr("block: does not end in a terminator instruction"));
+}
+
+TEST_F(IR_ValidatorTest, ValidateFunctions) {
+    auto* valid = b.Function("valid", ty.void_());
+    b.Append(valid->Block(), [&] { b.Return(valid); });
+    auto* invalid = b.Function("invalid", ty.void_());
+
+    EXPECT_EQ(ir::ValidateFunctions(mod, Vector<const Function*, 1>{valid}), Success);
+
+    auto res = ir::ValidateFunctions(mod, Vector<const Function*, 1>{invalid});
+    ASSERT_NE(res, Success);
+    EXPECT_THAT(res.Failure().reason.Str(),
+                testing::HasSubstr("block: does not end in a terminator instruction"));
+}
+
+TEST_F(IR_ValidatorTest, ValidateFunctions_RemovedFunction) {
+    auto* removed = b.Function("removed", ty.void_());
+    mod.functions.Clear();
+
+    EXPECT_EQ(ir::ValidateFunctions(mod, Vector<const Function*, 1>{removed}), Success);
+}
+
+TEST_F(IR_ValidatorTest, ValidateFunctions_ChecksRootBlock) {
+    auto* l = b.Loop();
+    l->Body()->Append(b.Continue(l));
+    mod.root_block->Append(l);
+
+    auto res = ir::ValidateFunctions(mod, Empty);
+    ASSERT_NE(res, Success);
+    EXPECT_THAT(res.Failure().reason.Str(), testing::HasSubstr("root block: invalid instruction"));
+}
+
+TEST_F(IR_ValidatorTest, ValidateAndDumpIfNeeded_ValidationMode) {
+    b.Function("my_func", ty.void_());
+
+    mod.validation_mode = ValidationMode::kNone;
+    EXPECT_EQ(ir::ValidateAndDumpIfNeeded(mod, "test"), Success);
+
+    mod.validation_mode = ValidationMode::kFull;
+    EXPECT_NE(ir::ValidateAndDumpIfNeeded(mod, "test"), Success);
+}
+
+TEST_F(IR_ValidatorTest, ValidateAndDumpIfNeeded_ModifiedFunctions) {
+    auto* valid = b.Function("valid", ty.void_());
+    b.Append(valid->Block(), [&] { b.Return(valid); });
+    b.Function("invalid", ty.void_());
+
+    mod.validation_mode = ValidationMode::kFull;
+
+    // Only the declared functions are validated.
+    SetModifiedFunctions(mod, Vector<const Function*, 1>{valid});
+    EXPECT_EQ(ir::ValidateAndDumpIfNeeded(mod, "test"), Success);
+    EXPECT_FALSE(mod.modified_functions.has_value());
+
+    // The next transform did not declare the functions it modified, so the whole module is
+    // validated.
+    EXPECT_NE(ir::ValidateAndDumpIfNeeded(mod, "test"), Success);
+}
+
 template <typename T>
 static const type::Type* TypeBuilder(type::Manager& m) {
     return m.Get<T>();
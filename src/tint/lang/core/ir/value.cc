@@ -29,6 +29,7 @@
 
 #include "src/tint/lang/core/ir/constant.h"
 #include "src/tint/lang/core/ir/instruction.h"
+#include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/ice/ice.h"
 
 TINT_INSTANTIATE_TYPEINFO(tint::core::ir::Value);
@@ -44,26 +45,79 @@ void Value::Destroy() {
     flags_.Add(Flag::kDead);
 }
 
+void Value::RemoveUsage(Usage u) {
+    if (auto* use = u.instruction->OperandUse(u.operand_index); use && use->Get() == this) {
+        use->Unlink();
+    }
+}
+
+bool Value::HasUsage(const Instruction* instruction, size_t operand_index) const {
+    auto* use = instruction->OperandUse(operand_index);
+    return use && use->Get() == this;
+}
+
 void Value::ForEachUse(std::function<void(Usage use)> func) {
-    auto uses = uses_;
+    Vector<Usage, 8> uses;
+    for (auto* use = first_use_; use; use = use->next_) {
+        uses.Push(use->GetUsage());
+    }
     for (auto& use : uses) {
         func(use);
     }
 }
 
 void Value::ReplaceAllUsesWith(std::function<Value*(Usage use)> replacer) {
-    while (!uses_.IsEmpty()) {
-        auto& use = *uses_.begin();
+    while (first_use_) {
+        auto use = first_use_->GetUsage();
         auto* replacement = replacer(use);
-        use->instruction->SetOperand(use->operand_index, replacement);
+        use.instruction->SetOperand(use.operand_index, replacement);
     }
 }
 
 void Value::ReplaceAllUsesWith(Value* replacement) {
-    while (!uses_.IsEmpty()) {
-        auto& use = *uses_.begin();
-        use->instruction->SetOperand(use->operand_index, replacement);
+    while (first_use_) {
+        auto use = first_use_->GetUsage();
+        use.instruction->SetOperand(use.operand_index, replacement);
+    }
+}
+
+Use::Use(Use&& other)
+    : usage_(other.usage_), value_(other.value_), prev_(other.prev_), next_(other.next_) {
+    if (value_) {
+        (prev_ ? prev_->next_ : value_->first_use_) = this;
+        (next_ ? next_->prev_ : value_->last_use_) = this;
+    }
+    other.value_ = nullptr;
+    other.prev_ = nullptr;
+    other.next_ = nullptr;
+}
+
+void Use::Set(Value* value) {
+    if (value == value_) {
+        return;
+    }
+    Unlink();
+    if (value) {
+        // Append to the end of the list, so that the usages are iterated in the order they were
+        // added.
+        value_ = value;
+        prev_ = value->last_use_;
+        (prev_ ? prev_->next_ : value->first_use_) = this;
+        value->last_use_ = this;
+        value->num_uses_++;
+    }
+}
+
+void Use::Unlink() {
+    if (!value_) {
+        return;
     }
+    (prev_ ? prev_->next_ : value_->first_use_) = next_;
+    (next_ ? next_->prev_ : value_->last_use_) = prev_;
+    value_->num_uses_--;
+    value_ = nullptr;
+    prev_ = nullptr;
+    next_ = nullptr;
 }
 
 }  // namespace tint::core::ir
@@ -28,14 +28,21 @@
 #ifndef SRC_TINT_LANG_CORE_IR_VALUE_H_
 #define SRC_TINT_LANG_CORE_IR_VALUE_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+
 #include "src/tint/lang/core/type/type.h"
-#include "src/tint/utils/containers/hashset.h"
+#include "src/tint/utils/containers/enum_set.h"
+#include "src/tint/utils/math/hash.h"
 #include "src/tint/utils/rtti/castable.h"
 
 // Forward declarations
 namespace tint::core::ir {
 class CloneContext;
 class Instruction;
+class Value;
 }  // namespace tint::core::ir
 
 namespace tint::core::ir {
@@ -58,6 +65,160 @@ struct Usage {
     }
 };
 
+/// Use is an operand slot of an instruction, which uses a Value.
+/// Uses are held by the instruction, and are linked into an intrusive doubly-linked list of all
+/// the uses of the value. This makes adding and removing a usage of a value O(1), without any
+/// hashing or allocation.
+class Use {
+  public:
+    /// Constructor
+    /// @param instruction the instruction that holds the use
+    /// @param operand_index the index of the operand
+    Use(Instruction* instruction, size_t operand_index) : usage_{instruction, operand_index} {}
+
+    /// Move constructor. Replaces @p other in the use list of its value.
+    /// @param other the use to move
+    Use(Use&& other);
+
+    /// Destructor.
+    /// @note the destructor does not unlink the use, as the value may have already been destroyed
+    /// when the module is destroyed. Use Set(nullptr) to remove the use from the value.
+    ~Use() = default;
+
+    /// Copying a use is not permitted.
+    Use(const Use&) = delete;
+    /// Assigning a use is not permitted.
+    Use& operator=(const Use&) = delete;
+    /// Assigning a use is not permitted.
+    Use& operator=(Use&&) = delete;
+
+    /// Sets the value used, moving the use from the use list of the previous value to the use list
+    /// of @p value.
+    /// @param value the new value, or nullptr
+    void Set(Value* value);
+
+    /// @returns the value used, or nullptr if the use is not linked to a value
+    Value* Get() const { return value_; }
+
+    /// @returns the instruction and operand index of the use
+    const Usage& GetUsage() const { return usage_; }
+
+    /// @returns the next use of the value, or nullptr if this is the last use
+    const Use* Next() const { return next_; }
+
+  private:
+    friend class Value;
+
+    /// Removes the use from the use list of its value.
+    void Unlink();
+
+    Usage usage_;
+    Value* value_ = nullptr;
+    Use* prev_ = nullptr;
+    Use* next_ = nullptr;
+};
+
+/// UsageList is an iterable view of the usages of a Value.
+/// @note the view is invalidated if a usage is added or removed while iterating.
+class UsageList {
+  public:
+    /// Iterator over the usages of a value.
+    class Iterator {
+      public:
+        /// The iterator category
+        using iterator_category = std::forward_iterator_tag;
+        /// The element type
+        using value_type = Usage;
+        /// The difference type
+        using difference_type = std::ptrdiff_t;
+        /// The element pointer type
+        using pointer = const Usage*;
+        /// The element reference type
+        using reference = const Usage&;
+
+        /// Constructor
+        /// @param use the current use
+        explicit Iterator(const Use* use) : use_(use) {}
+
+        /// @returns the current usage
+        const Usage& operator*() const { return use_->GetUsage(); }
+
+        /// @returns a pointer to the current usage
+        const Usage* operator->() const { return &use_->GetUsage(); }
+
+        /// Increments the iterator to the next usage
+        /// @returns this iterator
+        Iterator& operator++() {
+            use_ = use_->Next();
+            return *this;
+        }
+
+        /// Increments the iterator to the next usage
+        /// @returns the iterator before it was incremented
+        Iterator operator++(int) {
+            Iterator prev = *this;
+            use_ = use_->Next();
+            return prev;
+        }
+
+        /// Equality operator
+        /// @param other the other iterator
+        /// @returns true if the iterators point to the same usage
+        bool operator==(const Iterator& other) const { return use_ == other.use_; }
+
+        /// Inequality operator
+        /// @param other the other iterator
+        /// @returns true if the iterators point to different usages
+        bool operator!=(const Iterator& other) const { return use_ != other.use_; }
+
+      private:
+        const Use* use_;
+    };
+
+    /// The element type
+    using value_type = Usage;
+    /// The iterator type
+    using iterator = Iterator;
+    /// The const iterator type
+    using const_iterator = Iterator;
+
+    /// Constructor
+    /// @param first the first use
+    /// @param count the number of uses
+    UsageList(const Use* first, size_t count) : first_(first), count_(count) {}
+
+    /// @returns an iterator to the first usage
+    Iterator begin() const { return Iterator{first_}; }
+
+    /// @returns an iterator past the last usage
+    Iterator end() const { return Iterator{nullptr}; }
+
+    /// @returns the number of usages
+    size_t Count() const { return count_; }
+
+    /// @returns the number of usages
+    size_t size() const { return count_; }
+
+    /// @returns true if there are no usages
+    bool IsEmpty() const { return count_ == 0; }
+
+    /// @param pred a predicate function with the signature `bool(const Usage&)`
+    /// @returns true if the predicate returns true for all the usages
+    template <typename PREDICATE>
+    bool All(PREDICATE&& pred) const {
+        for (auto& usage : *this) {
+            if (!pred(usage)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+  private:
+    const Use* first_;
+    size_t count_;
+};
+
 /// Value in the IR.
 class Value : public Castable<Value> {
   public:
@@ -78,30 +239,25 @@ class Value : public Castable<Value> {
     /// @returns true if the Value has not been destroyed with Destroy()
     bool Alive() const { return !flags_.Contains(Flag::kDead); }
 
-    /// Adds a usage of this value.
-    /// @param u the usage
-    void AddUsage(Usage u) { uses_.Add(u); }
-
-    /// Remove a usage of this value.
+    /// Removes a usage of this value, without changing the operand of the instruction.
+    /// @note this leaves the IR in an invalid state, and is only intended for testing the validator.
     /// @param u the usage
-    void RemoveUsage(Usage u) { uses_.Remove(u); }
+    void RemoveUsage(Usage u);
 
-    /// @returns the set of usages of this value. An instruction may appear multiple times if it
-    /// uses the value for multiple different operands.
-    const Hashset<Usage, 4>& Usages() { return uses_; }
+    /// @returns the usages of this value, in the order that they were added. An instruction may
+    /// appear multiple times if it uses the value for multiple different operands.
+    UsageList Usages() const { return UsageList{first_use_, num_uses_}; }
 
     /// @returns true if this Value has any usages
-    bool IsUsed() const { return !uses_.IsEmpty(); }
+    bool IsUsed() const { return num_uses_ != 0; }
 
     /// @returns the number of usages of this Value
-    size_t NumUsages() const { return uses_.Count(); }
+    size_t NumUsages() const { return num_uses_; }
 
     /// @returns true if the usages contains the instruction and operand index pair.
     /// @param instruction the instruction
-    /// @param operand_index the in
-    bool HasUsage(const Instruction* instruction, size_t operand_index) const {
-        return uses_.Contains(Usage{const_cast<Instruction*>(instruction), operand_index});
-    }
+    /// @param operand_index the index of the operand
+    bool HasUsage(const Instruction* instruction, size_t operand_index) const;
 
     /// Apply a function to all uses of the value that exist prior to calling this method.
     /// @param func the function will be applied to each use
@@ -120,13 +276,19 @@ class Value : public Castable<Value> {
     Value();
 
   private:
+    friend class Use;
+
     /// Flags applied to an Value
     enum class Flag {
         /// The value has been destroyed
         kDead,
     };
 
-    Hashset<Usage, 4> uses_;
+    /// The first and last uses of the value
+    Use* first_use_ = nullptr;
+    Use* last_use_ = nullptr;
+    /// The number of uses of the value
+    uint32_t num_uses_ = 0;
 
     /// Bitset of value flags
     tint::EnumSet<Flag> flags_;
@@ -25,6 +25,8 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <utility>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest-spi.h"
 #include "src/tint/lang/core/ir/ir_helper_test.h"
@@ -59,6 +61,64 @@ TEST_F(IR_ValueTest, ReplaceAllUsesWith_Fn) {
     EXPECT_EQ(inst->LHS(), val_new);
 }
 
+TEST_F(IR_ValueTest, Usages_InsertionOrder) {
+    auto* val = b.InstructionResult(ty.i32());
+    auto* a = b.Add(ty.i32(), val, 1_i);
+    auto* c = b.Multiply(ty.i32(), 2_i, val);
+    auto* d = b.Subtract(ty.i32(), val, val);
+    EXPECT_THAT(val->Usages(), testing::ElementsAre(Usage{a, 0u}, Usage{c, 1u}, Usage{d, 0u},
+                                                    Usage{d, 1u}));
+    EXPECT_EQ(val->NumUsages(), 4u);
+    EXPECT_TRUE(val->IsUsed());
+}
+
+TEST_F(IR_ValueTest, Usages_SetOperand) {
+    auto* val = b.InstructionResult(ty.i32());
+    auto* other = b.InstructionResult(ty.i32());
+    auto* a = b.Add(ty.i32(), val, 1_i);
+    auto* c = b.Add(ty.i32(), val, 2_i);
+    auto* d = b.Add(ty.i32(), val, 3_i);
+
+    c->SetOperand(0, other);
+    EXPECT_THAT(val->Usages(), testing::ElementsAre(Usage{a, 0u}, Usage{d, 0u}));
+    EXPECT_THAT(other->Usages(), testing::ElementsAre(Usage{c, 0u}));
+    EXPECT_TRUE(val->HasUsage(a, 0u));
+    EXPECT_FALSE(val->HasUsage(c, 0u));
+    EXPECT_TRUE(other->HasUsage(c, 0u));
+
+    a->Destroy();
+    d->Destroy();
+    EXPECT_TRUE(val->Usages().IsEmpty());
+    EXPECT_FALSE(val->IsUsed());
+    EXPECT_EQ(val->NumUsages(), 0u);
+}
+
+TEST_F(IR_ValueTest, Usages_ManyOperands) {
+    // Exceed the number of operands held inline by the instruction, so that the uses are moved
+    // when the operand list is reallocated.
+    auto* val = b.InstructionResult(ty.i32());
+    Vector<Value*, 4> args;
+    for (size_t i = 0; i < 16; i++) {
+        args.Push(val);
+    }
+    auto* construct = b.Construct(ty.array<i32, 16>(), std::move(args));
+    EXPECT_EQ(val->NumUsages(), 16u);
+    size_t i = 0;
+    for (auto& usage : val->Usages()) {
+        EXPECT_EQ(usage.instruction, construct);
+        EXPECT_EQ(usage.operand_index, i++);
+    }
+    EXPECT_EQ(i, 16u);
+
+    auto* val_new = b.InstructionResult(ty.i32());
+    val->ReplaceAllUsesWith(val_new);
+    EXPECT_TRUE(val->Usages().IsEmpty());
+    EXPECT_EQ(val_new->NumUsages(), 16u);
+    for (auto* arg : construct->Args()) {
+        EXPECT_EQ(arg, val_new);
+    }
+}
+
 TEST_F(IR_ValueTest, Destroy) {
     auto* val = b.InstructionResult(ty.i32());
     EXPECT_TRUE(val->Alive());
@@ -28,6 +28,7 @@
 #ifndef SRC_TINT_LANG_CORE_IR_VAR_H_
 #define SRC_TINT_LANG_CORE_IR_VAR_H_
 
+#include <optional>
 #include <string>
 
 #include "src/tint/api/common/binding_point.h"
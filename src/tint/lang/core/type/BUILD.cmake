@@ -127,6 +127,7 @@ tint_target_add_dependencies(tint_lang_core_type lib
   tint_utils_result
   tint_utils_rtti
   tint_utils_symbol
+  tint_utils_system
   tint_utils_text
   tint_utils_traits
 )
@@ -185,6 +186,7 @@ tint_target_add_dependencies(tint_lang_core_type_test test
   tint_utils_result
   tint_utils_rtti
   tint_utils_symbol
+  tint_utils_system
   tint_utils_text
   tint_utils_traits
 )
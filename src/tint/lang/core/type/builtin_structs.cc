@@ -69,6 +69,8 @@ constexpr std::array kModfVecAbstractNames{
 };
 
 Struct* CreateModfResult(Manager& types, SymbolTable& symbols, const Type* ty) {
+    // Hold the lock so that finding, creating and initializing the structures is atomic.
+    auto lock = types.Lock();
     auto build = [&](core::BuiltinType name, const Type* t) {
         auto symbol = symbols.Register(tint::ToString(name));
         if (auto* existing = types.Find<type::Struct>(symbol)) {
@@ -83,10 +85,12 @@ Struct* CreateModfResult(Manager& types, SymbolTable& symbols, const Type* ty) {
         [&](const F16*) { return build(core::BuiltinType::kModfResultF16, ty); },
         [&](const AbstractFloat*) {
             auto* abstract = build(core::BuiltinType::kModfResultAbstract, ty);
-            abstract->SetConcreteTypes(tint::Vector{
-                build(core::BuiltinType::kModfResultF32, types.f32()),
-                build(core::BuiltinType::kModfResultF16, types.f16()),
-            });
+            if (abstract->ConcreteTypes().IsEmpty()) {
+                abstract->SetConcreteTypes(tint::Vector{
+                    build(core::BuiltinType::kModfResultF32, types.f32()),
+                    build(core::BuiltinType::kModfResultF16, types.f16()),
+                });
+            }
             return abstract;
         },
         [&](const Vector* vec) {
@@ -97,10 +101,12 @@ Struct* CreateModfResult(Manager& types, SymbolTable& symbols, const Type* ty) {
                 [&](const F16*) { return build(kModfVecF16Names[width - 2], vec); },
                 [&](const AbstractFloat*) {
                     auto* abstract = build(kModfVecAbstractNames[width - 2], vec);
-                    abstract->SetConcreteTypes(tint::Vector{
-                        build(kModfVecF32Names[width - 2], types.vec(types.f32(), width)),
-                        build(kModfVecF16Names[width - 2], types.vec(types.f16(), width)),
-                    });
+                    if (abstract->ConcreteTypes().IsEmpty()) {
+                        abstract->SetConcreteTypes(tint::Vector{
+                            build(kModfVecF32Names[width - 2], types.vec(types.f32(), width)),
+                            build(kModfVecF16Names[width - 2], types.vec(types.f16(), width)),
+                        });
+                    }
                     return abstract;
                 },  //
                 TINT_ICE_ON_NO_MATCH);
@@ -130,6 +136,8 @@ constexpr std::array kFrexpVecAbstractNames{
 };
 
 Struct* CreateFrexpResult(Manager& types, SymbolTable& symbols, const Type* ty) {
+    // Hold the lock so that finding, creating and initializing the structures is atomic.
+    auto lock = types.Lock();
     auto build = [&](core::BuiltinType name, const Type* fract_ty, const Type* exp_ty) {
         auto symbol = symbols.Register(tint::ToString(name));
         if (auto* existing = types.Find<type::Struct>(symbol)) {
@@ -144,10 +152,12 @@ Struct* CreateFrexpResult(Manager& types, SymbolTable& symbols, const Type* ty)
         [&](const F16*) { return build(core::BuiltinType::kFrexpResultF16, ty, types.i32()); },
         [&](const AbstractFloat*) {
             auto* abstract = build(core::BuiltinType::kFrexpResultAbstract, ty, types.AInt());
-            abstract->SetConcreteTypes(tint::Vector{
-                build(core::BuiltinType::kFrexpResultF32, types.f32(), types.i32()),
-                build(core::BuiltinType::kFrexpResultF16, types.f16(), types.i32()),
-            });
+            if (abstract->ConcreteTypes().IsEmpty()) {
+                abstract->SetConcreteTypes(tint::Vector{
+                    build(core::BuiltinType::kFrexpResultF32, types.f32(), types.i32()),
+                    build(core::BuiltinType::kFrexpResultF16, types.f16(), types.i32()),
+                });
+            }
             return abstract;
         },
         [&](const Vector* vec) {
@@ -166,10 +176,12 @@ Struct* CreateFrexpResult(Manager& types, SymbolTable& symbols, const Type* ty)
                     auto* vec_i32 = types.vec(types.i32(), width);
                     auto* vec_ai = types.vec(types.AInt(), width);
                     auto* abstract = build(kFrexpVecAbstractNames[width - 2], ty, vec_ai);
-                    abstract->SetConcreteTypes(tint::Vector{
-                        build(kFrexpVecF32Names[width - 2], vec_f32, vec_i32),
-                        build(kFrexpVecF16Names[width - 2], vec_f16, vec_i32),
-                    });
+                    if (abstract->ConcreteTypes().IsEmpty()) {
+                        abstract->SetConcreteTypes(tint::Vector{
+                            build(kFrexpVecF32Names[width - 2], vec_f32, vec_i32),
+                            build(kFrexpVecF16Names[width - 2], vec_f16, vec_i32),
+                        });
+                    }
                     return abstract;
                 },  //
                 TINT_ICE_ON_NO_MATCH);
@@ -178,6 +190,8 @@ Struct* CreateFrexpResult(Manager& types, SymbolTable& symbols, const Type* ty)
 }
 
 Struct* CreateAtomicCompareExchangeResult(Manager& types, SymbolTable& symbols, const Type* ty) {
+    // Hold the lock so that finding and creating the structure is atomic.
+    auto lock = types.Lock();
     auto build = [&](core::BuiltinType name) {
         auto symbol = symbols.Register(tint::ToString(name));
         if (auto* existing = types.Find<type::Struct>(symbol)) {
@@ -42,6 +42,7 @@
 #include "src/tint/utils/containers/unique_allocator.h"
 #include "src/tint/utils/math/hash.h"
 #include "src/tint/utils/symbol/symbol.h"
+#include "src/tint/utils/system/optional_mutex.h"
 
 // Forward declarations
 namespace tint::core::type {
@@ -122,6 +123,16 @@ class Manager final {
         return out;
     }
 
+    /// Enables or disables locking of the manager, so that types and nodes can be created and
+    /// looked up concurrently from multiple threads while enabled.
+    /// @param thread_safe true to enable locking
+    void SetThreadSafe(bool thread_safe) { mutex_.SetEnabled(thread_safe); }
+
+    /// @returns a lock on the manager, which can be held across multiple calls that need to be
+    /// performed atomically when the manager is thread safe. Has no effect when the manager is not
+    /// thread safe.
+    [[nodiscard]] OptionalMutex::Guard Lock() const { return mutex_.Lock(); }
+
     /// Constructs or returns an existing type, unique node or node
     /// @param args the arguments used to construct the type, unique node or node.
     /// @tparam T a class deriving from core::type::Node, or a C-like type that's automatically
@@ -159,10 +170,13 @@ class Manager final {
         } else if constexpr (core::fluent_types::IsAtomic<T>) {
             return atomic<typename T::type>(std::forward<ARGS>(args)...);
         } else if constexpr (tint::traits::IsTypeOrDerived<T, Type>) {
+            auto lock = mutex_.Lock();
             return types_.Get<T>(std::forward<ARGS>(args)...);
         } else if constexpr (tint::traits::IsTypeOrDerived<T, UniqueNode>) {
+            auto lock = mutex_.Lock();
             return unique_nodes_.Get<T>(std::forward<ARGS>(args)...);
         } else {
+            auto lock = mutex_.Lock();
             return nodes_.Create<T>(std::forward<ARGS>(args)...);
         }
     }
@@ -174,6 +188,7 @@ class Manager final {
               typename _ = std::enable_if<tint::traits::IsTypeOrDerived<TYPE, Type>>,
               typename... ARGS>
     auto* Find(ARGS&&... args) const {
+        auto lock = mutex_.Lock();
         return types_.Find<TYPE>(std::forward<ARGS>(args)...);
     }
 
@@ -538,6 +553,8 @@ class Manager final {
     UniqueAllocator<UniqueNode> unique_nodes_;
     /// Non-unique nodes owned by the manager
     BlockAllocator<Node> nodes_;
+    /// Guards the allocators while the manager is thread safe
+    OptionalMutex mutex_;
 };
 
 }  // namespace tint::core::type
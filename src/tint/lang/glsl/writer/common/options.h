@@ -35,6 +35,7 @@
 #include "src/tint/api/options/binding_remapper.h"
 #include "src/tint/api/options/depth_range_offsets.h"
 #include "src/tint/api/options/external_texture.h"
+#include "src/tint/api/options/optimization_level.h"
 #include "src/tint/api/options/texture_builtins_from_uniform.h"
 #include "src/tint/lang/glsl/writer/common/version.h"
 #include "src/tint/lang/wgsl/sem/sampler_texture_pair.h"
@@ -64,6 +65,9 @@ struct Options {
     /// Set to `true` to disable the polyfills on integer division and modulo.
     bool disable_polyfill_integer_div_mod = false;
 
+    /// The level of optimization to apply to the IR before printing.
+    OptimizationLevel optimization_level = OptimizationLevel::kO0;
+
     /// The GLSL version to emit
     Version version;
 
@@ -96,6 +100,7 @@ struct Options {
                  disable_robustness,
                  disable_workgroup_init,
                  disable_polyfill_integer_div_mod,
+                 optimization_level,
                  version,
                  binding_map,
                  placeholder_binding_point,
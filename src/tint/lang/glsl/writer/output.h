@@ -32,6 +32,7 @@
 #include <utility>
 #include <vector>
 
+#include "src/tint/lang/core/ir/transform/optimize.h"
 #include "src/tint/lang/wgsl/ast/pipeline_stage.h"
 
 namespace tint::glsl::writer {
@@ -49,6 +50,9 @@ struct Output {
 
     /// The generated GLSL.
     std::string glsl = "";
+
+    /// The time taken by each IR optimization pass, when generating from the IR.
+    std::vector<core::ir::transform::PassTiming> pass_timings;
 };
 
 }  // namespace tint::glsl::writer
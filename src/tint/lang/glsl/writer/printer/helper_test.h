@@ -33,6 +33,7 @@
 #include "gtest/gtest.h"
 #include "src/tint/lang/core/ir/builder.h"
 #include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/lang/glsl/writer/common/options.h"
 #include "src/tint/lang/glsl/writer/common/version.h"
 #include "src/tint/lang/glsl/writer/printer/printer.h"
 #include "src/tint/lang/glsl/writer/raise/raise.h"
@@ -62,7 +63,12 @@ class GlslPrinterTestHelperBase : public BASE {
     /// Run the writer on the IR module and validate the result.
     /// @returns true if generation and validation succeeded
     bool Generate() {
-        if (auto raised = Raise(mod); raised != Success) {
+        // The printer tests check how individual instructions and functions are printed, and
+        // often don't use their results, only have constant operands or repeat the same
+        // instruction, so don't optimize them.
+        Options options;
+        options.optimization_level = OptimizationLevel::kO0;
+        if (auto raised = Raise(mod, options); raised != Success) {
             err_ = raised.Failure().reason.Str();
             return false;
         }
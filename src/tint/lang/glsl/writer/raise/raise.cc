@@ -27,16 +27,25 @@
 
 #include "src/tint/lang/glsl/writer/raise/raise.h"
 
+#include "src/tint/lang/core/ir/transform/optimize.h"
+
 namespace tint::glsl::writer {
 
-Result<SuccessType> Raise(core::ir::Module&) {
-    // #define RUN_TRANSFORM(name)
-    //     do {
-    //         auto result = core::ir::transform::name(module);
-    //         if (!result) {
-    //             return result;
-    //         }
-    //     } while (false)
+Result<SuccessType> Raise(core::ir::Module& module,
+                          const Options& options,
+                          std::vector<core::ir::transform::PassTiming>* timings) {
+#define RUN_TRANSFORM(name, ...)                   \
+    do {                                           \
+        auto result = name(module, ##__VA_ARGS__); \
+        if (result != Success) {                   \
+            return result;                         \
+        }                                          \
+    } while (false)
+
+    core::ir::transform::OptimizeConfig optimize_config;
+    optimize_config.level = options.optimization_level;
+    optimize_config.timings = timings;
+    RUN_TRANSFORM(core::ir::transform::Optimize, optimize_config);
 
     return Success;
 }
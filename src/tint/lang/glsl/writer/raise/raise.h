@@ -28,6 +28,10 @@
 #ifndef SRC_TINT_LANG_GLSL_WRITER_RAISE_RAISE_H_
 #define SRC_TINT_LANG_GLSL_WRITER_RAISE_RAISE_H_
 
+#include <vector>
+
+#include "src/tint/lang/core/ir/transform/optimize.h"
+#include "src/tint/lang/glsl/writer/common/options.h"
 #include "src/tint/utils/result/result.h"
 
 // Forward declarations
@@ -37,10 +41,14 @@ class Module;
 
 namespace tint::glsl::writer {
 
-/// Raise a core IR module to the MSL dialect of the IR.
-/// @param mod the core IR module to raise to MSL dialect
+/// Raise a core IR module to the GLSL dialect of the IR.
+/// @param module the core IR module to raise to GLSL dialect
+/// @param options the printer options
+/// @param timings if not null, the time taken by each IR optimization pass is appended to this list
 /// @returns success or failure
-Result<SuccessType> Raise(core::ir::Module& mod);
+Result<SuccessType> Raise(core::ir::Module& module,
+                          const Options& options,
+                          std::vector<core::ir::transform::PassTiming>* timings = nullptr);
 
 }  // namespace tint::glsl::writer
 
@@ -40,7 +40,7 @@ Result<Output> Generate(core::ir::Module& ir, const Options& options, const std:
     Output output;
 
     // Raise from core-dialect to GLSL-dialect.
-    if (auto res = Raise(ir); res != Success) {
+    if (auto res = Raise(ir, options, &output.pass_timings); res != Success) {
         return res.Failure();
     }
 
@@ -34,6 +34,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "src/tint/lang/core/ir/transform/optimize.h"
+
 namespace tint::msl::writer {
 
 /// The output produced when generating MSL.
@@ -68,6 +70,9 @@ struct Output {
     /// Indices into the array_length_from_uniform binding that are statically
     /// used.
     std::unordered_set<uint32_t> used_array_length_from_uniform_indices;
+
+    /// The time taken by each IR optimization pass, when generating from the IR.
+    std::vector<core::ir::transform::PassTiming> pass_timings;
 };
 
 }  // namespace tint::msl::writer
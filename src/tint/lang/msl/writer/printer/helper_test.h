@@ -80,7 +80,12 @@ class MslPrinterTestHelperBase : public BASE {
     /// Run the writer on the IR module and validate the result.
     /// @returns true if generation and validation succeeded
     bool Generate() {
-        if (auto raised = Raise(mod, {}); raised != Success) {
+        // The printer tests check how individual instructions and functions are printed, and
+        // often don't use their results, only have constant operands or repeat the same
+        // instruction, so don't optimize them.
+        Options options;
+        options.optimization_level = OptimizationLevel::kO0;
+        if (auto raised = Raise(mod, options); raised != Success) {
             err_ = raised.Failure().reason.Str();
             return false;
         }
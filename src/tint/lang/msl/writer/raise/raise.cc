@@ -35,6 +35,7 @@
 #include "src/tint/lang/core/ir/transform/conversion_polyfill.h"
 #include "src/tint/lang/core/ir/transform/demote_to_helper.h"
 #include "src/tint/lang/core/ir/transform/multiplanar_external_texture.h"
+#include "src/tint/lang/core/ir/transform/optimize.h"
 #include "src/tint/lang/core/ir/transform/preserve_padding.h"
 #include "src/tint/lang/core/ir/transform/robustness.h"
 #include "src/tint/lang/core/ir/transform/value_to_let.h"
@@ -45,7 +46,9 @@
 
 namespace tint::msl::writer {
 
-Result<SuccessType> Raise(core::ir::Module& module, const Options& options) {
+Result<SuccessType> Raise(core::ir::Module& module,
+                          const Options& options,
+                          std::vector<core::ir::transform::PassTiming>* timings) {
 #define RUN_TRANSFORM(name, ...)                   \
     do {                                           \
         auto result = name(module, ##__VA_ARGS__); \
@@ -88,6 +91,8 @@ Result<SuccessType> Raise(core::ir::Module& module, const Options& options) {
 
     if (!options.disable_robustness) {
         core::ir::transform::RobustnessConfig config{};
+        config.use_integer_range_analysis =
+            options.optimization_level != OptimizationLevel::kO0;
         RUN_TRANSFORM(core::ir::transform::Robustness, config);
     }
 
@@ -104,6 +109,14 @@ Result<SuccessType> Raise(core::ir::Module& module, const Options& options) {
     // DemoteToHelper must come before any transform that introduces non-core instructions.
     RUN_TRANSFORM(core::ir::transform::DemoteToHelper);
 
+    // Optimize must come after the transforms that create helper functions, so that they can be
+    // inlined, and before ValueToLet, as moving and reusing values can extend their lifetimes past
+    // the instructions that ValueToLet checks them against.
+    core::ir::transform::OptimizeConfig optimize_config;
+    optimize_config.level = options.optimization_level;
+    optimize_config.timings = timings;
+    RUN_TRANSFORM(core::ir::transform::Optimize, optimize_config);
+
     RUN_TRANSFORM(core::ir::transform::ValueToLet);
     RUN_TRANSFORM(raise::BuiltinPolyfill);
 
@@ -115,6 +115,10 @@ class SpirvWriterTestHelperBase : public BASE {
     /// storage class with OpConstantNull
     /// @returns true if generation and validation succeeded
     bool Generate(Options options = {}, bool zero_init_workgroup_memory = false) {
+        // The printer tests check how individual instructions and functions are printed, and
+        // often don't use their results, only have constant operands or repeat the same
+        // instruction, so don't optimize them.
+        options.optimization_level = OptimizationLevel::kO0;
         auto raised = Raise(mod, options);
         if (raised != Success) {
             err_ = raised.Failure().reason.Str();
@@ -31,6 +31,7 @@
 #include <unordered_map>
 
 #include "src/tint/api/common/binding_point.h"
+#include "src/tint/api/options/optimization_level.h"
 #include "src/tint/utils/reflection/reflection.h"
 
 namespace tint::spirv::writer {
@@ -159,6 +160,9 @@ struct Options {
     /// Set to `true` to disable the polyfills on integer division and modulo.
     bool disable_polyfill_integer_div_mod = false;
 
+    /// The level of optimization to apply to the IR before printing.
+    OptimizationLevel optimization_level = OptimizationLevel::kO0;
+
     /// Reflect the fields of this class so that it can be used by tint::ForeachField()
     TINT_REFLECT(Options,
                  bindings,
@@ -173,7 +177,8 @@ struct Options {
                  pass_matrix_by_pointer,
                  experimental_require_subgroup_uniform_control_flow,
                  polyfill_dot_4x8_packed,
-                 disable_polyfill_integer_div_mod);
+                 disable_polyfill_integer_div_mod,
+                 optimization_level);
 };
 
 }  // namespace tint::spirv::writer
@@ -32,6 +32,8 @@
 #include <string>
 #include <vector>
 
+#include "src/tint/lang/core/ir/transform/optimize.h"
+
 namespace tint::spirv::writer {
 
 /// The output produced when generating SPIR-V.
@@ -51,6 +53,9 @@ struct Output {
 
     /// The generated SPIR-V.
     std::vector<uint32_t> spirv;
+
+    /// The time taken by each IR optimization pass, when generating from the IR.
+    std::vector<core::ir::transform::PassTiming> pass_timings;
 };
 
 }  // namespace tint::spirv::writer
@@ -40,6 +40,7 @@
 #include "src/tint/lang/core/ir/transform/demote_to_helper.h"
 #include "src/tint/lang/core/ir/transform/direct_variable_access.h"
 #include "src/tint/lang/core/ir/transform/multiplanar_external_texture.h"
+#include "src/tint/lang/core/ir/transform/optimize.h"
 #include "src/tint/lang/core/ir/transform/preserve_padding.h"
 #include "src/tint/lang/core/ir/transform/robustness.h"
 #include "src/tint/lang/core/ir/transform/std140.h"
@@ -56,7 +57,9 @@
 
 namespace tint::spirv::writer {
 
-Result<SuccessType> Raise(core::ir::Module& module, const Options& options) {
+Result<SuccessType> Raise(core::ir::Module& module,
+                          const Options& options,
+                          std::vector<core::ir::transform::PassTiming>* timings) {
 #define RUN_TRANSFORM(name, ...)         \
     do {                                 \
         auto result = name(__VA_ARGS__); \
@@ -102,6 +105,8 @@ Result<SuccessType> Raise(core::ir::Module& module, const Options& options) {
         }
         config.disable_runtime_sized_array_index_clamping =
             options.disable_runtime_sized_array_index_clamping;
+        config.use_integer_range_analysis =
+            options.optimization_level != OptimizationLevel::kO0;
         RUN_TRANSFORM(core::ir::transform::Robustness, module, config);
     }
 
@@ -147,6 +152,16 @@ Result<SuccessType> Raise(core::ir::Module& module, const Options& options) {
                   raise::ShaderIOConfig{options.clamp_frag_depth, options.emit_vertex_point_size,
                                         !options.use_storage_input_output_16});
     RUN_TRANSFORM(core::ir::transform::Std140, module);
+
+    // Optimize must come after the transforms that create helper functions, so that they can be
+    // inlined, and before VarForDynamicIndex, as constant propagation can turn dynamic indices into
+    // constant ones.
+    core::ir::transform::OptimizeConfig optimize_config;
+    optimize_config.level = options.optimization_level;
+    optimize_config.promote_vars_to_values = true;
+    optimize_config.timings = timings;
+    RUN_TRANSFORM(core::ir::transform::Optimize, module, optimize_config);
+
     RUN_TRANSFORM(raise::VarForDynamicIndex, module);
 
     return Success;
@@ -29,7 +29,9 @@
 #define SRC_TINT_LANG_SPIRV_WRITER_RAISE_RAISE_H_
 
 #include <string>
+#include <vector>
 
+#include "src/tint/lang/core/ir/transform/optimize.h"
 #include "src/tint/lang/spirv/writer/common/options.h"
 #include "src/tint/utils/diagnostic/diagnostic.h"
 #include "src/tint/utils/result/result.h"
@@ -44,8 +46,11 @@ namespace tint::spirv::writer {
 /// Raise a core IR module to the SPIR-V dialect of the IR.
 /// @param module the core IR module to raise to SPIR-V dialect
 /// @param options the SPIR-V writer options
+/// @param timings if not null, the time taken by each IR optimization pass is appended to this list
 /// @returns success or failure
-Result<SuccessType> Raise(core::ir::Module& module, const Options& options);
+Result<SuccessType> Raise(core::ir::Module& module,
+                          const Options& options,
+                          std::vector<core::ir::transform::PassTiming>* timings = nullptr);
 
 }  // namespace tint::spirv::writer
 
@@ -36,7 +36,6 @@
 #include "src/tint/lang/core/type/bool.h"
 #include "src/tint/lang/wgsl/program/clone_context.h"
 #include "src/tint/lang/wgsl/program/program_builder.h"
-#include "src/tint/lang/wgsl/resolver/resolve.h"
 #include "src/tint/utils/rtti/switch.h"
 
 using namespace tint::core::fluent_types;  // NOLINT
@@ -46,79 +45,44 @@ TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::FoldConstants);
 namespace tint::ast::transform {
 namespace {
 
-struct State {
-    enum class Splat {
-        kAllowed,
-        kDisallowed,
+enum class Splat {
+    kAllowed,
+    kDisallowed,
+};
+
+const ast::Expression* Constant(program::CloneContext& ctx, const core::constant::Value* c) {
+    auto& b = *ctx.dst;
+    auto composite = [&](Splat splat) -> const ast::Expression* {
+        auto ty = FoldConstants::CreateASTTypeFor(ctx, c->Type());
+        if (c->AllZero()) {
+            return b.Call(ty);
+        }
+        if (splat == Splat::kAllowed && c->Is<core::constant::Splat>()) {
+            return b.Call(ty, Constant(ctx, c->Index(0)));
+        }
+
+        Vector<const ast::Expression*, 8> els;
+        for (size_t i = 0, n = c->NumElements(); i < n; i++) {
+            els.Push(Constant(ctx, c->Index(i)));
+        }
+        return b.Call(ty, std::move(els));
     };
 
-    const ast::Expression* Constant(const core::constant::Value* c) {
-        auto composite = [&](Splat splat) -> const ast::Expression* {
-            auto ty = FoldConstants::CreateASTTypeFor(ctx, c->Type());
-            if (c->AllZero()) {
-                return b.Call(ty);
-            }
-            if (splat == Splat::kAllowed && c->Is<core::constant::Splat>()) {
-                return b.Call(ty, Constant(c->Index(0)));
-            }
-
-            Vector<const ast::Expression*, 8> els;
-            for (size_t i = 0, n = c->NumElements(); i < n; i++) {
-                els.Push(Constant(c->Index(i)));
-            }
-            return b.Call(ty, std::move(els));
-        };
-
-        return tint::Switch(
-            c->Type(),  //
-            [&](const core::type::AbstractFloat*) { return b.Expr(c->ValueAs<AFloat>()); },
-            [&](const core::type::AbstractInt*) { return b.Expr(c->ValueAs<AInt>()); },
-            [&](const core::type::I32*) { return b.Expr(c->ValueAs<i32>()); },
-            [&](const core::type::U32*) { return b.Expr(c->ValueAs<u32>()); },
-            [&](const core::type::F32*) { return b.Expr(c->ValueAs<f32>()); },
-            [&](const core::type::F16*) { return b.Expr(c->ValueAs<f16>()); },
-            [&](const core::type::Bool*) { return b.Expr(c->ValueAs<bool>()); },
-            [&](const core::type::Array*) { return composite(Splat::kDisallowed); },
-            [&](const core::type::Vector*) { return composite(Splat::kAllowed); },
-            [&](const core::type::Matrix*) { return composite(Splat::kDisallowed); },
-            [&](const core::type::Struct*) { return composite(Splat::kDisallowed); },
-            TINT_ICE_ON_NO_MATCH);
-    }
-
-    Transform::ApplyResult Run() {
-        ctx.ReplaceAll([&](const Expression* expr) -> const Expression* {
-            auto& sem = ctx.src->Sem();
-            auto* ve = sem.Get<sem::ValueExpression>(expr);
-
-            // No value expression SEM node found
-            if (!ve) {
-                return nullptr;
-            }
-
-            auto* cv = ve->ConstantValue();
-
-            // No constant value for this expression
-            if (!cv) {
-                return nullptr;
-            }
-
-            if (cv->Type()->HoldsAbstract() && !cv->Type()->is_float_scalar() &&
-                !cv->Type()->is_signed_integer_scalar() &&
-                !cv->Type()->is_unsigned_integer_scalar()) {
-                return nullptr;
-            }
-
-            return Constant(cv);
-        });
-
-        ctx.Clone();
-        return resolver::Resolve(b);
-    }
-
-    const Program& src;
-    ProgramBuilder b;
-    program::CloneContext ctx{&b, &src, /* auto_clone_symbols */ true};
-};
+    return tint::Switch(
+        c->Type(),  //
+        [&](const core::type::AbstractFloat*) { return b.Expr(c->ValueAs<AFloat>()); },
+        [&](const core::type::AbstractInt*) { return b.Expr(c->ValueAs<AInt>()); },
+        [&](const core::type::I32*) { return b.Expr(c->ValueAs<i32>()); },
+        [&](const core::type::U32*) { return b.Expr(c->ValueAs<u32>()); },
+        [&](const core::type::F32*) { return b.Expr(c->ValueAs<f32>()); },
+        [&](const core::type::F16*) { return b.Expr(c->ValueAs<f16>()); },
+        [&](const core::type::Bool*) { return b.Expr(c->ValueAs<bool>()); },
+        [&](const core::type::Array*) { return composite(Splat::kDisallowed); },
+        [&](const core::type::Vector*) { return composite(Splat::kAllowed); },
+        [&](const core::type::Matrix*) { return composite(Splat::kDisallowed); },
+        [&](const core::type::Struct*) { return composite(Splat::kDisallowed); },
+        TINT_ICE_ON_NO_MATCH);
+}
 
 }  // namespace
 
@@ -126,9 +90,33 @@ FoldConstants::FoldConstants() = default;
 
 FoldConstants::~FoldConstants() = default;
 
-Transform::ApplyResult FoldConstants::Apply(const Program& src, const DataMap&, DataMap&) const {
-    State s{src, {}};
-    return s.Run();
+bool FoldConstants::Fuse(program::CloneContext& ctx, const DataMap&, DataMap&) const {
+    ctx.ReplaceAll([&ctx](const Expression* expr) -> const Expression* {
+        auto& sem = ctx.src->Sem();
+        auto* ve = sem.Get<sem::ValueExpression>(expr);
+
+        // No value expression SEM node found
+        if (!ve) {
+            return nullptr;
+        }
+
+        auto* cv = ve->ConstantValue();
+
+        // No constant value for this expression
+        if (!cv) {
+            return nullptr;
+        }
+
+        if (cv->Type()->HoldsAbstract() && !cv->Type()->is_float_scalar() &&
+            !cv->Type()->is_signed_integer_scalar() &&
+            !cv->Type()->is_unsigned_integer_scalar()) {
+            return nullptr;
+        }
+
+        return Constant(ctx, cv);
+    });
+
+    return true;
 }
 
 }  // namespace tint::ast::transform
@@ -44,7 +44,7 @@ namespace tint::ast::transform {
 /// const a = false;
 /// const b = 0.841470;
 /// ```
-class FoldConstants final : public Castable<FoldConstants, Transform> {
+class FoldConstants final : public Castable<FoldConstants, FusableTransform> {
   public:
     /// Constructor
     FoldConstants();
@@ -52,13 +52,8 @@ class FoldConstants final : public Castable<FoldConstants, Transform> {
     /// Destructor
     ~FoldConstants() override;
 
-    /// @copydoc Transform::Apply
-    ApplyResult Apply(const Program& program,
-                      const DataMap& inputs,
-                      DataMap& outpus) const override;
-
-  private:
-    const ast::Expression* Constant(const core::constant::Value* c);
+    /// @copydoc FusableTransform::Fuse
+    bool Fuse(program::CloneContext& ctx, const DataMap& inputs, DataMap& outputs) const override;
 };
 
 }  // namespace tint::ast::transform
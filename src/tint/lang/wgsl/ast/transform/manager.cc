@@ -30,6 +30,7 @@
 #include "src/tint/lang/wgsl/program/clone_context.h"
 #include "src/tint/lang/wgsl/program/program_builder.h"
 #include "src/tint/lang/wgsl/resolver/resolve.h"
+#include "src/tint/utils/containers/vector.h"
 
 /// If set to 1 then the transform::Manager will dump the WGSL of the program
 /// before and after each transform. Helpful for debugging bad output.
@@ -43,11 +44,36 @@
 #endif  // TINT_PRINT_PROGRAM_FOR_EACH_TRANSFORM
 
 namespace tint::ast::transform {
+namespace {
+
+/// Applies the fusable transforms @p transforms to @p program with a single clone and resolve.
+Transform::ApplyResult ApplyFused(VectorRef<const FusableTransform*> transforms,
+                                  const Program& program,
+                                  const DataMap& inputs,
+                                  DataMap& outputs) {
+    ProgramBuilder b;
+    program::CloneContext ctx{&b, &program, /* auto_clone_symbols */ true};
+    bool changed = false;
+    for (auto* transform : transforms) {
+        changed |= transform->Fuse(ctx, inputs, outputs);
+    }
+    if (!changed) {
+        return Transform::SkipTransform;
+    }
+
+    ctx.Clone();
+    return resolver::Resolve(b);
+}
+
+}  // namespace
 
 Manager::Manager() = default;
 Manager::~Manager() = default;
 
-Program Manager::Run(const Program& program_in, const DataMap& inputs, DataMap& outputs) const {
+Program Manager::Run(const Program& program_in,
+                     const DataMap& inputs,
+                     DataMap& outputs,
+                     std::vector<TransformTiming>* timings) const {
     const Program* program = &program_in;
 
 #if TINT_PRINT_PROGRAM_FOR_EACH_TRANSFORM
@@ -72,17 +98,41 @@ Program Manager::Run(const Program& program_in, const DataMap& inputs, DataMap&
 
     TINT_IF_PRINT_PROGRAM(print_program("Input of", nullptr));
 
-    for (const auto& transform : transforms_) {
-        if (auto result = transform->Apply(*program, inputs, outputs)) {
+    for (size_t i = 0; i < transforms_.size();) {
+        const Transform* transform = transforms_[i++].get();
+
+        // Consecutive fusable transforms are applied together, with a single clone of the program.
+        Vector<const FusableTransform*, 4> fused;
+        if (auto* fusable = transform->As<FusableTransform>()) {
+            fused.Push(fusable);
+            while (i < transforms_.size() && transforms_[i]->Is<FusableTransform>()) {
+                transform = transforms_[i++].get();
+                fused.Push(transform->As<FusableTransform>());
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto result = fused.Length() > 1 ? ApplyFused(fused, *program, inputs, outputs)
+                                         : transform->Apply(*program, inputs, outputs);
+        if (timings) {
+            TransformTiming timing{fused.IsEmpty() ? transform->TypeInfo().name
+                                                   : fused[0]->TypeInfo().name,
+                                   std::chrono::steady_clock::now() - start};
+            for (size_t f = 1; f < fused.Length(); f++) {
+                timing.name += std::string(" + ") + fused[f]->TypeInfo().name;
+            }
+            timings->push_back(std::move(timing));
+        }
+        if (result) {
             output.emplace(std::move(result.value()));
             program = &output.value();
 
             if (!program->IsValid()) {
-                TINT_IF_PRINT_PROGRAM(print_program("Invalid output of", transform.get()));
+                TINT_IF_PRINT_PROGRAM(print_program("Invalid output of", transform));
                 break;
             }
 
-            TINT_IF_PRINT_PROGRAM(print_program("Output of", transform.get()));
+            TINT_IF_PRINT_PROGRAM(print_program("Output of", transform));
         } else {
             TINT_IF_PRINT_PROGRAM(std::cout << "Skipped " << transform->TypeInfo().name
                                             << std::endl);
@@ -28,7 +28,9 @@
 #ifndef SRC_TINT_LANG_WGSL_AST_TRANSFORM_MANAGER_H_
 #define SRC_TINT_LANG_WGSL_AST_TRANSFORM_MANAGER_H_
 
+#include <chrono>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -38,10 +40,20 @@
 
 namespace tint::ast::transform {
 
+/// The time taken by a single transform run by the Manager.
+struct TransformTiming {
+    /// The type name of the transform. The transforms of a fused group are timed together, and
+    /// their names are joined with " + ".
+    std::string name;
+    /// The time that the transform took to run
+    std::chrono::nanoseconds duration{};
+};
+
 /// A collection of Transforms that act as a single Transform.
 /// The inner transforms will execute in the appended order.
 /// If any inner transform fails the manager will return immediately and
 /// the error can be retrieved with the Output's diagnostics.
+/// Consecutive FusableTransforms are applied with a single clone and resolve of the program.
 class Manager {
   public:
     /// Constructor
@@ -66,8 +78,12 @@ class Manager {
     /// @param program the source program to transform
     /// @param inputs optional extra transform-specific input data
     /// @param outputs optional extra transform-specific output data
+    /// @param timings if not null, the time taken by each transform is appended to this list
     /// @returns the transformed program
-    Program Run(const Program& program, const DataMap& inputs, DataMap& outputs) const;
+    Program Run(const Program& program,
+                const DataMap& inputs,
+                DataMap& outputs,
+                std::vector<TransformTiming>* timings = nullptr) const;
 
   private:
     std::vector<std::unique_ptr<Transform>> transforms_;
@@ -28,6 +28,8 @@
 #include "src/tint/lang/wgsl/ast/transform/manager.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "src/tint/lang/wgsl/ast/transform/transform.h"
@@ -56,6 +58,26 @@ class AST_AddFunction final : public ast::transform::Transform {
     }
 };
 
+class AST_FusableAddFunction final : public ast::transform::FusableTransform {
+  public:
+    AST_FusableAddFunction(std::string name, Vector<GenerationID, 4>& sources)
+        : name_(std::move(name)), sources_(sources) {}
+
+    bool Fuse(program::CloneContext& ctx, const DataMap&, DataMap&) const override {
+        sources_.Push(ctx.src->ID());
+        ctx.dst->Func(ctx.dst->Sym(name_), {}, ctx.dst->ty.void_(), {});
+        return true;
+    }
+
+  private:
+    std::string name_;
+    Vector<GenerationID, 4>& sources_;
+};
+
+class AST_FusableNoOp final : public ast::transform::FusableTransform {
+    bool Fuse(program::CloneContext&, const DataMap&, DataMap&) const override { return false; }
+};
+
 Program MakeAST() {
     ProgramBuilder b;
     b.Func(b.Sym("main"), {}, b.ty.void_(), {});
@@ -77,5 +99,88 @@ TEST_F(TransformManagerTest, AST_AlwaysClone) {
     EXPECT_EQ(result.AST().Functions()[0]->name->symbol.Name(), "main");
 }
 
+// Test that consecutive fusable transforms are applied with a single clone of the program.
+TEST_F(TransformManagerTest, AST_FuseConsecutive) {
+    Program ast = MakeAST();
+
+    Vector<GenerationID, 4> sources;
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_FusableAddFunction>("a", sources);
+    manager.Add<AST_FusableNoOp>();
+    manager.Add<AST_FusableAddFunction>("b", sources);
+
+    auto result = manager.Run(ast, {}, outputs);
+    EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+    ASSERT_EQ(sources.Length(), 2u);
+    EXPECT_EQ(sources[0], ast.ID());
+    EXPECT_EQ(sources[1], ast.ID());
+    ASSERT_EQ(result.AST().Functions().Length(), 3u);
+    EXPECT_EQ(result.AST().Functions()[0]->name->symbol.Name(), "a");
+    EXPECT_EQ(result.AST().Functions()[1]->name->symbol.Name(), "b");
+    EXPECT_EQ(result.AST().Functions()[2]->name->symbol.Name(), "main");
+}
+
+// Test that a non-fusable transform splits a run of fusable transforms.
+TEST_F(TransformManagerTest, AST_FuseSplitByTransform) {
+    Program ast = MakeAST();
+
+    Vector<GenerationID, 4> sources;
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_FusableAddFunction>("a", sources);
+    manager.Add<AST_AddFunction>();
+    manager.Add<AST_FusableAddFunction>("b", sources);
+
+    auto result = manager.Run(ast, {}, outputs);
+    EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+    ASSERT_EQ(sources.Length(), 2u);
+    EXPECT_EQ(sources[0], ast.ID());
+    EXPECT_NE(sources[1], ast.ID());
+    ASSERT_EQ(result.AST().Functions().Length(), 4u);
+    EXPECT_EQ(result.AST().Functions()[0]->name->symbol.Name(), "b");
+    EXPECT_EQ(result.AST().Functions()[1]->name->symbol.Name(), "ast_func");
+    EXPECT_EQ(result.AST().Functions()[2]->name->symbol.Name(), "a");
+    EXPECT_EQ(result.AST().Functions()[3]->name->symbol.Name(), "main");
+}
+
+// Test that an AST program is cloned if all the fused transforms are skipped.
+TEST_F(TransformManagerTest, AST_FuseAllSkipped) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_FusableNoOp>();
+    manager.Add<AST_FusableNoOp>();
+
+    auto result = manager.Run(ast, {}, outputs);
+    EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+    EXPECT_NE(result.ID(), ast.ID());
+    ASSERT_EQ(result.AST().Functions().Length(), 1u);
+    EXPECT_EQ(result.AST().Functions()[0]->name->symbol.Name(), "main");
+}
+
+// Test that the time of each transform is reported, with fused transforms timed together.
+TEST_F(TransformManagerTest, AST_Timings) {
+    Program ast = MakeAST();
+
+    Vector<GenerationID, 4> sources;
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_NoOp>();
+    manager.Add<AST_FusableAddFunction>("a", sources);
+    manager.Add<AST_FusableNoOp>();
+    manager.Add<AST_AddFunction>();
+
+    std::vector<TransformTiming> timings;
+    auto result = manager.Run(ast, {}, outputs, &timings);
+    EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+    ASSERT_EQ(timings.size(), 3u);
+    EXPECT_EQ(timings[0].name, "tint::ast::transform::Transform");
+    EXPECT_EQ(timings[1].name,
+              "tint::ast::transform::FusableTransform + tint::ast::transform::FusableTransform");
+    EXPECT_EQ(timings[2].name, "tint::ast::transform::Transform");
+}
+
 }  // namespace
 }  // namespace tint::ast::transform
@@ -46,6 +46,7 @@
 using namespace tint::core::fluent_types;  // NOLINT
 
 TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::Transform);
+TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::FusableTransform);
 
 namespace tint::ast::transform {
 
@@ -191,4 +192,20 @@ Type Transform::CreateASTTypeFor(program::CloneContext& ctx, const core::type::T
     return Type{};
 }
 
+FusableTransform::FusableTransform() = default;
+FusableTransform::~FusableTransform() = default;
+
+Transform::ApplyResult FusableTransform::Apply(const Program& src,
+                                               const DataMap& inputs,
+                                               DataMap& outputs) const {
+    ProgramBuilder b;
+    program::CloneContext ctx{&b, &src, /* auto_clone_symbols */ true};
+    if (!Fuse(ctx, inputs, outputs)) {
+        return SkipTransform;
+    }
+
+    ctx.Clone();
+    return resolver::Resolve(b);
+}
+
 }  // namespace tint::ast::transform
@@ -112,6 +112,36 @@ class Transform : public Castable<Transform> {
     static void RemoveStatement(program::CloneContext& ctx, const Statement* stmt);
 };
 
+/// Base class for transforms that can share a single clone of the program with other fusable
+/// transforms.
+/// The Manager applies a run of consecutive fusable transforms with a single CloneContext, so
+/// that the run costs one clone and one resolve, instead of one of each per transform. Every
+/// transform in the run sees the program as it was before the run, so a fusable transform must
+/// only make edits that are still correct when the other transforms of the run have been applied,
+/// and must not register ReplaceAll() handlers for node types handled by another fusable
+/// transform.
+class FusableTransform : public Castable<FusableTransform, Transform> {
+  public:
+    /// Constructor
+    FusableTransform();
+    /// Destructor
+    ~FusableTransform() override;
+
+    /// Registers the edits of the transform with @p ctx, without cloning the program.
+    /// @param ctx the clone context, which clones from the input program
+    /// @param inputs optional extra transform-specific input data
+    /// @param outputs optional extra transform-specific output data
+    /// @returns true if edits were registered, or false if the transform does not need to run.
+    virtual bool Fuse(program::CloneContext& ctx,
+                      const DataMap& inputs,
+                      DataMap& outputs) const = 0;
+
+    /// @copydoc Transform::Apply
+    ApplyResult Apply(const Program& program,
+                      const DataMap& inputs,
+                      DataMap& outputs) const override;
+};
+
 }  // namespace tint::ast::transform
 
 #endif  // SRC_TINT_LANG_WGSL_AST_TRANSFORM_TRANSFORM_H_
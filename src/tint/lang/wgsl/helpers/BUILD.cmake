@@ -47,6 +47,8 @@ tint_add_target(tint_lang_wgsl_helpers lib
   lang/wgsl/helpers/check_supported_extensions.h
   lang/wgsl/helpers/flatten_bindings.cc
   lang/wgsl/helpers/flatten_bindings.h
+  lang/wgsl/helpers/for_each_entry_point.cc
+  lang/wgsl/helpers/for_each_entry_point.h
 )
 
 tint_target_add_dependencies(tint_lang_wgsl_helpers lib
@@ -72,6 +74,7 @@ tint_target_add_dependencies(tint_lang_wgsl_helpers lib
   tint_utils_result
   tint_utils_rtti
   tint_utils_symbol
+  tint_utils_system
   tint_utils_text
   tint_utils_traits
 )
@@ -84,6 +87,7 @@ tint_add_target(tint_lang_wgsl_helpers_test test
   lang/wgsl/helpers/append_vector_test.cc
   lang/wgsl/helpers/check_supported_extensions_test.cc
   lang/wgsl/helpers/flatten_bindings_test.cc
+  lang/wgsl/helpers/for_each_entry_point_test.cc
 )
 
 tint_target_add_dependencies(tint_lang_wgsl_helpers_test test
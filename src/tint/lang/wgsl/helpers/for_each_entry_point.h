@@ -0,0 +1,65 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_LANG_WGSL_HELPERS_FOR_EACH_ENTRY_POINT_H_
+#define SRC_TINT_LANG_WGSL_HELPERS_FOR_EACH_ENTRY_POINT_H_
+
+#include <functional>
+#include <string>
+
+#include "src/tint/lang/wgsl/program/program.h"
+#include "src/tint/utils/containers/vector.h"
+
+namespace tint::wgsl {
+
+/// The function called by ForEachEntryPoint() for each entry point.
+/// The first parameter is the index of the entry point in the list passed to ForEachEntryPoint().
+/// The second parameter is the program holding just that entry point and the declarations it uses.
+using EntryPointCallback = std::function<void(size_t index, Program&& program)>;
+
+/// Creates a program for each of the entry points in @p entry_points, holding just that entry point
+/// and the declarations it uses, and passes it to @p callback.
+/// The programs are cloned from @p program, and the callbacks are called, concurrently on up to
+/// @p num_threads threads. @p program is only read, so its types, constants and symbols are shared
+/// by all the threads, while each entry point program owns its own copies. Code generation from
+/// a single entry point program, including any IR built from it, can therefore be done in the
+/// callback without synchronization.
+/// @param program a valid program
+/// @param entry_points the names of the entry points
+/// @param num_threads the maximum number of threads that call @p callback, including the calling
+/// thread. A value of 0 or 1 calls @p callback for each entry point in order on the calling thread.
+/// @param callback the function called with the program of each entry point. Blocks until all the
+/// calls have returned.
+void ForEachEntryPoint(const Program& program,
+                       VectorRef<std::string> entry_points,
+                       uint32_t num_threads,
+                       const EntryPointCallback& callback);
+
+}  // namespace tint::wgsl
+
+#endif  // SRC_TINT_LANG_WGSL_HELPERS_FOR_EACH_ENTRY_POINT_H_
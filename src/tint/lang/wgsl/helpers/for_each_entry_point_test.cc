@@ -0,0 +1,113 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/wgsl/helpers/for_each_entry_point.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/tint/lang/wgsl/program/program_builder.h"
+#include "src/tint/lang/wgsl/resolver/resolve.h"
+
+namespace tint::wgsl {
+namespace {
+
+using namespace tint::core::number_suffixes;  // NOLINT
+
+class ForEachEntryPointTest : public ::testing::TestWithParam<uint32_t> {
+  protected:
+    /// @returns a program with @p count compute entry points, each of which uses its own private
+    /// variable and a shared helper function.
+    Program MakeProgram(size_t count) {
+        ProgramBuilder b;
+        b.Func("helper", {}, b.ty.i32(), Vector{b.Return(1_i)});
+        for (size_t i = 0; i < count; i++) {
+            auto var = "v" + std::to_string(i);
+            b.GlobalVar(var, b.ty.i32(), core::AddressSpace::kPrivate);
+            b.Func("main" + std::to_string(i), {}, b.ty.void_(),
+                   Vector{b.Assign(var, b.Call("helper"))},
+                   Vector{b.Stage(ast::PipelineStage::kCompute), b.WorkgroupSize(1_i)});
+        }
+        return resolver::Resolve(b);
+    }
+};
+
+TEST_P(ForEachEntryPointTest, EachEntryPoint) {
+    constexpr size_t kCount = 8;
+    Program program = MakeProgram(kCount);
+    ASSERT_TRUE(program.IsValid()) << program.Diagnostics();
+
+    Vector<std::string, kCount> entry_points;
+    for (size_t i = 0; i < kCount; i++) {
+        entry_points.Push("main" + std::to_string(kCount - 1 - i));
+    }
+
+    std::vector<Program> programs(kCount);
+    ForEachEntryPoint(program, entry_points, GetParam(),
+                      [&](size_t index, Program&& ep_program) {
+                          programs[index] = std::move(ep_program);
+                      });
+
+    for (size_t i = 0; i < kCount; i++) {
+        auto& ep_program = programs[i];
+        ASSERT_TRUE(ep_program.IsValid()) << ep_program.Diagnostics();
+        EXPECT_NE(ep_program.ID(), program.ID());
+
+        auto& globals = ep_program.AST().GlobalVariables();
+        ASSERT_EQ(globals.Length(), 1u);
+        EXPECT_EQ(globals[0]->name->symbol.Name(), "v" + std::to_string(kCount - 1 - i));
+
+        auto& functions = ep_program.AST().Functions();
+        ASSERT_EQ(functions.Length(), 2u);
+        EXPECT_EQ(functions[0]->name->symbol.Name(), "helper");
+        EXPECT_EQ(functions[1]->name->symbol.Name(), entry_points[i]);
+    }
+}
+
+TEST_P(ForEachEntryPointTest, MissingEntryPoint) {
+    Program program = MakeProgram(2);
+    ASSERT_TRUE(program.IsValid()) << program.Diagnostics();
+
+    std::vector<Program> programs(3);
+    ForEachEntryPoint(program, Vector<std::string, 3>{"main0", "missing", "main1"}, GetParam(),
+                      [&](size_t index, Program&& ep_program) {
+                          programs[index] = std::move(ep_program);
+                      });
+
+    EXPECT_TRUE(programs[0].IsValid()) << programs[0].Diagnostics();
+    EXPECT_FALSE(programs[1].IsValid());
+    EXPECT_EQ(programs[1].Diagnostics().Str(), "error: entry point 'missing' not found");
+    EXPECT_TRUE(programs[2].IsValid()) << programs[2].Diagnostics();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForEachEntryPointTest, ForEachEntryPointTest, testing::Values(1u, 2u, 4u));
+
+}  // namespace
+}  // namespace tint::wgsl
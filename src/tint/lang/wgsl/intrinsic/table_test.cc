@@ -702,6 +702,16 @@ TEST_F(WgslIntrinsicTableTest, MatchUnaryOp_Runtime) {
     EXPECT_TRUE(result->return_type->Is<core::type::I32>());
 }
 
+TEST_F(WgslIntrinsicTableTest, MatchUnaryOp_CachedConstantThenRuntime) {
+    auto* ai = create<core::type::AbstractInt>();
+    auto constant = table.Lookup(core::UnaryOp::kNegation, ai, core::EvaluationStage::kConstant);
+    auto runtime = table.Lookup(core::UnaryOp::kNegation, ai, core::EvaluationStage::kRuntime);
+    ASSERT_EQ(constant, Success);
+    ASSERT_EQ(runtime, Success);
+    EXPECT_EQ(constant->return_type, ai);
+    EXPECT_TRUE(runtime->return_type->Is<core::type::I32>());
+}
+
 TEST_F(WgslIntrinsicTableTest, MatchBinaryOp) {
     auto* i32 = create<core::type::I32>();
     auto* vec3i = create<core::type::Vector>(i32, 3u);
@@ -41,6 +41,8 @@ if(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
 # Condition: TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER
 ################################################################################
 tint_add_target(tint_lang_wgsl_ls lib
+  lang/wgsl/ls/analyzer.cc
+  lang/wgsl/ls/analyzer.h
   lang/wgsl/ls/cancel_request.cc
   lang/wgsl/ls/change_configuration.cc
   lang/wgsl/ls/change_watched_files.cc
@@ -121,6 +123,7 @@ if(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
 tint_add_target(tint_lang_wgsl_ls_test test
   lang/wgsl/ls/definition_test.cc
   lang/wgsl/ls/diagnostics_test.cc
+  lang/wgsl/ls/document_test.cc
   lang/wgsl/ls/helpers_test.cc
   lang/wgsl/ls/helpers_test.h
   lang/wgsl/ls/hover_test.cc
@@ -171,4 +174,56 @@ if(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
   )
 endif(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
 
+endif(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
+if(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
+################################################################################
+# Target:    tint_lang_wgsl_ls_bench
+# Kind:      bench
+# Condition: TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER
+################################################################################
+tint_add_target(tint_lang_wgsl_ls_bench bench
+  lang/wgsl/ls/document_bench.cc
+)
+
+tint_target_add_dependencies(tint_lang_wgsl_ls_bench bench
+  tint_api_common
+  tint_cmd_bench_bench
+  tint_lang_core
+  tint_lang_core_constant
+  tint_lang_core_type
+  tint_lang_wgsl
+  tint_lang_wgsl_ast
+  tint_lang_wgsl_program
+  tint_lang_wgsl_sem
+  tint_utils_containers
+  tint_utils_diagnostic
+  tint_utils_ice
+  tint_utils_id
+  tint_utils_macros
+  tint_utils_math
+  tint_utils_memory
+  tint_utils_reflection
+  tint_utils_result
+  tint_utils_rtti
+  tint_utils_symbol
+  tint_utils_text
+  tint_utils_traits
+)
+
+tint_target_add_external_dependencies(tint_lang_wgsl_ls_bench bench
+  "google-benchmark"
+)
+
+if(TINT_BUILD_TINTD)
+  tint_target_add_external_dependencies(tint_lang_wgsl_ls_bench bench
+    "langsvr"
+  )
+endif(TINT_BUILD_TINTD)
+
+if(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
+  tint_target_add_dependencies(tint_lang_wgsl_ls_bench bench
+    tint_lang_wgsl_ls
+  )
+endif(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
+
 endif(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
\ No newline at end of file
@@ -0,0 +1,164 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/wgsl/ls/analyzer.h"
+
+#include <utility>
+
+#include "src/tint/lang/wgsl/reader/reader.h"
+
+namespace tint::wgsl::ls {
+
+Analyzer::Analyzer(std::chrono::milliseconds debounce, Callback on_analyzed)
+    : debounce_(debounce), on_analyzed_(std::move(on_analyzed)), worker_([this] { Run(); }) {}
+
+Analyzer::~Analyzer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+void Analyzer::Open(const std::string& uri, std::string content, int64_t version) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Document doc;
+    doc.content = std::move(content);
+    doc.version = version;
+    doc.generation = next_generation_++;
+    doc.state = State::kPending;
+    documents_.Replace(uri, std::move(doc));
+    Analyze(lock, uri, *documents_.Get(uri));
+}
+
+bool Analyzer::Change(const std::string& uri,
+                      int64_t version,
+                      const std::function<void(std::string&)>& edit) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto doc = documents_.Get(uri);
+        if (!doc) {
+            return false;
+        }
+        edit(doc->content);
+        doc->version = version;
+        doc->generation = next_generation_++;
+        doc->state = State::kPending;
+        doc->deadline = std::chrono::steady_clock::now() + debounce_;
+    }
+    cv_.notify_all();
+    return true;
+}
+
+void Analyzer::Close(const std::string& uri) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        documents_.Remove(uri);
+    }
+    cv_.notify_all();
+}
+
+std::shared_ptr<File> Analyzer::Get(const std::string& uri) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        auto doc = documents_.Get(uri);
+        if (!doc) {
+            return nullptr;
+        }
+        switch (doc->state) {
+            case State::kIdle:
+                return doc->file;
+            case State::kPending:
+                // Don't wait for the debounce period, a request needs the result now.
+                Analyze(lock, uri, *doc);
+                break;
+            case State::kAnalyzing:
+                cv_.wait(lock);
+                break;
+        }
+    }
+}
+
+void Analyzer::Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        // Find the pending document with the earliest deadline.
+        const std::string* uri = nullptr;
+        Document* next = nullptr;
+        for (auto& it : documents_) {
+            if (it.value.state == State::kPending &&
+                (!next || it.value.deadline < next->deadline)) {
+                uri = &it.key.Value();
+                next = &it.value;
+            }
+        }
+
+        if (!next) {
+            cv_.wait(lock);
+        } else if (next->deadline > std::chrono::steady_clock::now()) {
+            cv_.wait_until(lock, next->deadline);
+        } else {
+            Analyze(lock, std::string(*uri), *next);
+        }
+    }
+}
+
+void Analyzer::Analyze(std::unique_lock<std::mutex>& lock, const std::string& uri, Document& doc) {
+    if (doc.file && doc.file->source->content.data == doc.content) {
+        // The edits since the last analysis have not changed the content, so the last File, along
+        // with the results cached on it, is still valid. It now holds the latest version.
+        doc.file->version.store(doc.version);
+        doc.state = State::kIdle;
+        cv_.notify_all();
+        return;
+    }
+
+    doc.state = State::kAnalyzing;
+    auto source = std::make_unique<Source::File>(uri, doc.content);
+    auto version = doc.version;
+    auto generation = doc.generation;
+
+    // Parse and resolve without holding the lock, so that changes can continue to be applied.
+    lock.unlock();
+    auto program = wgsl::reader::Parse(source.get());
+    auto file = std::make_shared<File>(std::move(source), version, std::move(program));
+    lock.lock();
+
+    // Drop the result if the document was closed or changed while it was being analyzed. The
+    // newer content is already pending.
+    auto current = documents_.Get(uri);
+    if (current && current->generation == generation) {
+        current->file = std::move(file);
+        current->state = State::kIdle;
+        on_analyzed_(*current->file);
+    }
+    cv_.notify_all();
+}
+
+}  // namespace tint::wgsl::ls
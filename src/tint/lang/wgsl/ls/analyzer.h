@@ -0,0 +1,151 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_LANG_WGSL_LS_ANALYZER_H_
+#define SRC_TINT_LANG_WGSL_LS_ANALYZER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "src/tint/lang/wgsl/ls/file.h"
+#include "src/tint/utils/containers/hashmap.h"
+
+namespace tint::wgsl::ls {
+
+/// Analyzer holds the content of the open documents, and parses and resolves them into Files on a
+/// worker thread.
+///
+/// Analysis is debounced: a changed document is only analyzed once it has not been changed for
+/// the debounce period, so a burst of edits results in a single analysis. An analysis that is
+/// superseded by a newer change, or by the document being closed, is dropped when it completes.
+/// Get() does not wait for the debounce period, and analyzes the document on the calling thread
+/// if the worker has not yet started on it.
+class Analyzer {
+  public:
+    /// The function called with each newly analyzed File that has not been superseded.
+    /// Called with the analyzer's lock held, from either the worker thread or the thread calling
+    /// Open() or Get(). The callback must not call back into the Analyzer.
+    using Callback = std::function<void(File&)>;
+
+    /// Constructor
+    /// @param debounce the time a document must be left unchanged before it is analyzed
+    /// @param on_analyzed the function called with each new, non-stale analysis
+    Analyzer(std::chrono::milliseconds debounce, Callback on_analyzed);
+
+    /// Destructor. Stops and joins the worker thread.
+    ~Analyzer();
+
+    /// Opens the document @p uri, replacing any existing document with the same URI, and analyzes
+    /// it on the calling thread.
+    /// @param uri the document URI
+    /// @param content the document content
+    /// @param version the document version
+    void Open(const std::string& uri, std::string content, int64_t version);
+
+    /// Applies @p edit to the content of the document @p uri, and schedules its analysis on the
+    /// worker thread.
+    /// @param uri the document URI
+    /// @param version the new version of the document
+    /// @param edit a function that modifies the document content in place
+    /// @returns false if the document is not open
+    bool Change(const std::string& uri,
+                int64_t version,
+                const std::function<void(std::string&)>& edit);
+
+    /// Closes the document @p uri, dropping any pending or in-flight analysis.
+    /// @param uri the document URI
+    void Close(const std::string& uri);
+
+    /// @returns the File of the latest version of the document @p uri, or nullptr if the document
+    /// is not open. If the latest version has not yet been analyzed, then Get() either analyzes it
+    /// on the calling thread, or blocks until the worker thread has finished analyzing it.
+    /// @param uri the document URI
+    std::shared_ptr<File> Get(const std::string& uri);
+
+  private:
+    /// The analysis state of a Document
+    enum class State {
+        /// The file of the document is up to date
+        kIdle,
+        /// The document has changed, and is waiting to be analyzed
+        kPending,
+        /// The document is being analyzed
+        kAnalyzing,
+    };
+
+    /// Document holds the latest content of an open document, and the latest File analyzed from it
+    struct Document {
+        /// The latest content of the document
+        std::string content;
+        /// The latest version of the document
+        int64_t version = 0;
+        /// A number that uniquely identifies the latest content, across all documents
+        uint64_t generation = 0;
+        /// The analysis state of the document
+        State state = State::kIdle;
+        /// The time after which a pending analysis can be started by the worker
+        std::chrono::steady_clock::time_point deadline;
+        /// The most recently analyzed File of the document
+        std::shared_ptr<File> file;
+    };
+
+    /// The worker thread's entry point
+    void Run();
+
+    /// Analyzes the pending document @p doc with the URI @p uri.
+    /// @p lock is released while the document is parsed and resolved. The result is dropped if the
+    /// document was changed or closed in the meantime.
+    void Analyze(std::unique_lock<std::mutex>& lock, const std::string& uri, Document& doc);
+
+    /// The debounce period
+    const std::chrono::milliseconds debounce_;
+    /// The analysis callback
+    const Callback on_analyzed_;
+    /// The mutex guarding all the fields below
+    std::mutex mutex_;
+    /// Signalled when a document is changed or analyzed, or when the analyzer is stopping
+    std::condition_variable cv_;
+    /// Map of URI to Document
+    Hashmap<std::string, Document, 8> documents_;
+    /// The generation of the next document change
+    uint64_t next_generation_ = 1;
+    /// True when the worker thread has been asked to exit
+    bool stopping_ = false;
+    /// The worker thread
+    std::thread worker_;
+};
+
+}  // namespace tint::wgsl::ls
+
+#endif  // SRC_TINT_LANG_WGSL_LS_ANALYZER_H_
@@ -33,6 +33,9 @@ namespace lsp = langsvr::lsp;
 namespace tint::wgsl::ls {
 
 langsvr::Result<langsvr::SuccessType> Server::Handle(const lsp::CancelRequestNotification&) {
+    // Requests are handled in the order they are received, so a request has always been responded
+    // to by the time its cancellation is received. Analyses made stale by newer edits are dropped
+    // by the Analyzer, without needing a cancellation.
     return langsvr::Success;
 }
 
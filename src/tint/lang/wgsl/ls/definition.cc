@@ -37,8 +37,8 @@ typename lsp::TextDocumentDefinitionRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentDefinitionRequest& r) {
     typename lsp::TextDocumentDefinitionRequest::SuccessType result = lsp::Null{};
 
-    if (auto file = files_.Get(r.text_document.uri)) {
-        if (auto def = (*file)->Definition(Conv(r.position))) {
+    if (auto file = GetFile(r.text_document.uri)) {
+        if (auto def = file->Definition(Conv(r.position))) {
             lsp::Location loc;
             loc.range = Conv(def->definition);
             loc.uri = r.text_document.uri;
@@ -27,7 +27,8 @@
 
 #include "src/tint/lang/wgsl/ls/server.h"
 
-#include "src/tint/lang/wgsl/reader/reader.h"
+#include <string>
+#include <vector>
 
 namespace lsp = langsvr::lsp;
 
@@ -51,40 +52,37 @@ std::vector<size_t> LineOffsets(std::string_view str) {
 
 langsvr::Result<langsvr::SuccessType> Server::Handle(
     const lsp::TextDocumentDidOpenNotification& n) {
-    auto source = std::make_unique<Source::File>(n.text_document.uri, n.text_document.text);
-    auto program = wgsl::reader::Parse(source.get());
-    auto file =
-        std::make_shared<File>(std::move(source), n.text_document.version, std::move(program));
-    files_.Add(n.text_document.uri, file);
-    return PublishDiagnostics(*file);
+    // The document is analyzed immediately, which publishes its diagnostics.
+    analyzer_.Open(n.text_document.uri, n.text_document.text, n.text_document.version);
+    return langsvr::Success;
 }
 
 langsvr::Result<langsvr::SuccessType> Server::Handle(
     const lsp::TextDocumentDidCloseNotification& n) {
-    files_.Remove(n.text_document.uri);
+    analyzer_.Close(n.text_document.uri);
     return langsvr::Success;
 }
 
 langsvr::Result<langsvr::SuccessType> Server::Handle(
     const lsp::TextDocumentDidChangeNotification& n) {
-    auto file = files_.Get(n.text_document.uri);
-    if (!file) {
+    // The edits are applied now, but the document is re-analyzed on the analyzer's worker thread,
+    // which publishes the new diagnostics.
+    bool found = analyzer_.Change(
+        n.text_document.uri, n.text_document.version, [&](std::string& content) {
+            for (auto& change : n.content_changes) {
+                if (auto* edit = change.Get<lsp::TextDocumentContentChangePartial>()) {
+                    std::vector<size_t> line_offsets = LineOffsets(content);
+                    size_t start =
+                        line_offsets[edit->range.start.line] + edit->range.start.character;
+                    size_t end = line_offsets[edit->range.end.line] + edit->range.end.character;
+                    content.replace(start, end - start, edit->text);
+                }
+            }
+        });
+    if (!found) {
         return langsvr::Failure{"document not found"};
     }
-
-    auto content = (*file)->source->content.data;
-    for (auto& change : n.content_changes) {
-        if (auto* edit = change.Get<lsp::TextDocumentContentChangePartial>()) {
-            std::vector<size_t> line_offsets = LineOffsets(content);
-            size_t start = line_offsets[edit->range.start.line] + edit->range.start.character;
-            size_t end = line_offsets[edit->range.end.line] + edit->range.end.character;
-            content = content.substr(0, start) + edit->text + content.substr(end);
-        }
-    }
-    auto source = std::make_unique<Source::File>(n.text_document.uri, content);
-    auto program = wgsl::reader::Parse(source.get());
-    *file = std::make_shared<File>(std::move(source), n.text_document.version, std::move(program));
-    return PublishDiagnostics(**file);
+    return langsvr::Success;
 }
 
 }  // namespace tint::wgsl::ls
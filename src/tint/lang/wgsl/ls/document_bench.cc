@@ -0,0 +1,158 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "langsvr/lsp/lsp.h"
+#include "langsvr/session.h"
+#include "src/tint/cmd/bench/bench.h"
+#include "src/tint/lang/wgsl/ls/server.h"
+
+namespace tint::wgsl::ls {
+namespace {
+
+namespace lsp = langsvr::lsp;
+
+/// The statement typed into the document, one character per edit.
+constexpr std::string_view kTypedStatement = "    let typed = buf[i] + vec4<f32>(1.0f);";
+
+/// @returns a synthetic WGSL document with @p num_functions functions, followed by an empty
+/// function `edited`. The line between the braces of `edited` is returned in @p edit_line.
+std::string LargeWGSL(int64_t num_functions, lsp::Uinteger& edit_line) {
+    std::string wgsl = "@group(0) @binding(0) var<storage, read_write> buf : array<vec4<f32>>;\n";
+    lsp::Uinteger lines = 1;
+    for (int64_t f = 0; f < num_functions; f++) {
+        wgsl += "fn kernel_" + std::to_string(f) + "(i : u32) -> vec4<f32> {\n";
+        wgsl += "  var acc = vec4<f32>();\n";
+        for (int s = 0; s < 16; s++) {
+            wgsl += "  acc = fma(buf[i + " + std::to_string(s) + "u], acc, acc); // accumulate\n";
+        }
+        wgsl += "  return acc;\n}\n";
+        lines += 20;
+    }
+    wgsl += "fn edited(i : u32) {\n\n}\n";
+    edit_line = lines + 1;
+    return wgsl;
+}
+
+/// Client holds a language server, and a client session connected to it.
+struct Client {
+    Client() : server(server_session) {
+        server_session.SetSender([&](std::string_view msg) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return client_session.Receive(msg);
+        });
+        client_session.SetSender([&](std::string_view msg) { return server_session.Receive(msg); });
+        client_session.Register([&](const lsp::TextDocumentPublishDiagnosticsNotification&) {
+            return langsvr::Success;
+        });
+    }
+
+    std::mutex mutex;
+    langsvr::Session server_session;
+    langsvr::Session client_session;
+    Server server;
+};
+
+/// Types kTypedStatement into a large document, one character per change notification, as an
+/// editor would. After every @p keystrokes_per_request changes, the semantic tokens and the
+/// document symbols are requested, as an editor does to refresh its highlighting and outline.
+/// The reported time is the time per keystroke.
+void TypeStatement(benchmark::State& state, int64_t keystrokes_per_request) {
+    lsp::Uinteger edit_line = 0;
+    auto wgsl = LargeWGSL(state.range(0), edit_line);
+    const std::string uri = "bench.wgsl";
+
+    Client client;
+
+    auto request = [&] {
+        lsp::TextDocumentSemanticTokensFullRequest tokens{};
+        tokens.text_document.uri = uri;
+        auto tokens_res = client.client_session.Send(tokens);
+        lsp::TextDocumentDocumentSymbolRequest symbols{};
+        symbols.text_document.uri = uri;
+        auto symbols_res = client.client_session.Send(symbols);
+        if (tokens_res != langsvr::Success || symbols_res != langsvr::Success) {
+            state.SkipWithError("request failed");
+            return;
+        }
+        benchmark::DoNotOptimize(tokens_res->get());
+        benchmark::DoNotOptimize(symbols_res->get());
+    };
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        lsp::TextDocumentDidOpenNotification open{};
+        open.text_document.uri = uri;
+        open.text_document.text = wgsl;
+        (void)client.client_session.Send(open);
+        state.ResumeTiming();
+
+        int64_t keystrokes = 0;
+        for (lsp::Uinteger column = 0; column < kTypedStatement.size(); column++) {
+            lsp::TextDocumentContentChangePartial edit{};
+            edit.range = lsp::Range{{edit_line, column}, {edit_line, column}};
+            edit.text = kTypedStatement.substr(column, 1);
+            lsp::TextDocumentDidChangeNotification change{};
+            change.text_document.uri = uri;
+            change.text_document.version = static_cast<lsp::Integer>(column + 1);
+            change.content_changes.push_back(edit);
+            (void)client.client_session.Send(change);
+            if (++keystrokes % keystrokes_per_request == 0) {
+                request();
+            }
+        }
+        request();
+
+        state.PauseTiming();
+        lsp::TextDocumentDidCloseNotification close{};
+        close.text_document.uri = uri;
+        (void)client.client_session.Send(close);
+        state.ResumeTiming();
+    }
+
+    state.counters["Keystroke"] =
+        benchmark::Counter(static_cast<double>(kTypedStatement.size()),
+                           benchmark::Counter::kIsIterationInvariantRate |
+                               benchmark::Counter::kInvert);
+}
+
+BENCHMARK_CAPTURE(TypeStatement, RequestPerKeystroke, 1)
+    ->Arg(64)
+    ->Arg(256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(TypeStatement, RequestPerWord, 6)
+    ->Arg(64)
+    ->Arg(256)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace tint::wgsl::ls
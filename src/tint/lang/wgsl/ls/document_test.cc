@@ -0,0 +1,140 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "langsvr/lsp/lsp.h"
+#include "langsvr/lsp/primitives.h"
+#include "langsvr/lsp/printer.h"
+#include "src/tint/lang/wgsl/ls/helpers_test.h"
+
+namespace tint::wgsl::ls {
+namespace {
+
+namespace lsp = langsvr::lsp;
+
+using LsDocumentTest = LsTest;
+
+/// @returns a notification that replaces the range @p range of the document @p uri with @p text.
+lsp::TextDocumentDidChangeNotification Change(std::string_view uri,
+                                              lsp::Integer version,
+                                              lsp::Range range,
+                                              std::string_view text) {
+    lsp::TextDocumentContentChangePartial edit{};
+    edit.range = range;
+    edit.text = text;
+    lsp::TextDocumentDidChangeNotification notification{};
+    notification.text_document.uri = uri;
+    notification.text_document.version = version;
+    notification.content_changes.push_back(edit);
+    return notification;
+}
+
+TEST_F(LsDocumentTest, ChangeAppliedBeforeRequest) {
+    auto uri = OpenDocument("fn a() {}\n");
+
+    // Type 'bc' after 'a', one character at a time.
+    EXPECT_EQ(client_session_.Send(Change(uri, 1, lsp::Range{{0, 4}, {0, 4}}, "b")),
+              langsvr::Success);
+    EXPECT_EQ(client_session_.Send(Change(uri, 2, lsp::Range{{0, 5}, {0, 5}}, "c")),
+              langsvr::Success);
+
+    lsp::TextDocumentDocumentSymbolRequest req{};
+    req.text_document.uri = uri;
+    auto future = client_session_.Send(req);
+    ASSERT_EQ(future, langsvr::Success);
+    auto res = future->get();
+    ASSERT_TRUE(res.Is<std::vector<lsp::DocumentSymbol>>());
+    auto& symbols = *res.Get<std::vector<lsp::DocumentSymbol>>();
+    ASSERT_EQ(symbols.size(), 1u);
+    EXPECT_EQ(symbols[0].name, "abc");
+    EXPECT_EQ(symbols[0].selection_range, (lsp::Range{{0, 3}, {0, 6}}));
+}
+
+TEST_F(LsDocumentTest, ChangePublishesDiagnostics) {
+    auto uri = OpenDocument("const C = 1;\n");
+    ASSERT_EQ(diagnostics_.Length(), 1u);
+    EXPECT_TRUE(diagnostics_[0].diagnostics.empty());
+
+    // Replace '1' with 'X'.
+    EXPECT_EQ(client_session_.Send(Change(uri, 1, lsp::Range{{0, 10}, {0, 11}}, "X")),
+              langsvr::Success);
+
+    // A request waits for the analysis of the change, which publishes its diagnostics.
+    lsp::TextDocumentDocumentSymbolRequest req{};
+    req.text_document.uri = uri;
+    auto future = client_session_.Send(req);
+    ASSERT_EQ(future, langsvr::Success);
+    future->get();
+
+    ASSERT_GE(diagnostics_.Length(), 2u);
+    auto& notification = diagnostics_.Back();
+    EXPECT_EQ(notification.uri, uri);
+    ASSERT_EQ(notification.diagnostics.size(), 1u);
+    EXPECT_EQ(notification.diagnostics[0].message, "unresolved value 'X'");
+    EXPECT_EQ(notification.diagnostics[0].severity, lsp::DiagnosticSeverity::kError);
+}
+
+TEST_F(LsDocumentTest, UnchangedContentKeepsFileWithNewVersion) {
+    auto uri = OpenDocument("fn a() {}\n");
+    auto file = server_.GetFile(uri);
+    ASSERT_NE(file, nullptr);
+
+    // Type 'b' after 'a', then delete it again.
+    EXPECT_EQ(client_session_.Send(Change(uri, 1, lsp::Range{{0, 4}, {0, 4}}, "b")),
+              langsvr::Success);
+    EXPECT_EQ(client_session_.Send(Change(uri, 2, lsp::Range{{0, 4}, {0, 5}}, "")),
+              langsvr::Success);
+
+    auto latest = server_.GetFile(uri);
+    EXPECT_EQ(latest, file);
+    EXPECT_EQ(latest->version.load(), 2);
+}
+
+TEST_F(LsDocumentTest, CloseDropsPendingChange) {
+    auto uri = OpenDocument("fn a() {}\n");
+    EXPECT_EQ(client_session_.Send(Change(uri, 1, lsp::Range{{0, 3}, {0, 4}}, "b")),
+              langsvr::Success);
+
+    lsp::TextDocumentDidCloseNotification close{};
+    close.text_document.uri = uri;
+    EXPECT_EQ(client_session_.Send(close), langsvr::Success);
+
+    lsp::TextDocumentDocumentSymbolRequest req{};
+    req.text_document.uri = uri;
+    auto future = client_session_.Send(req);
+    ASSERT_EQ(future, langsvr::Success);
+    EXPECT_TRUE(future->get().Is<lsp::Null>());
+}
+
+}  // namespace
+}  // namespace tint::wgsl::ls
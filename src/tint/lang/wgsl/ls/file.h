@@ -28,14 +28,17 @@
 #ifndef SRC_TINT_LANG_WGSL_LS_FILE_H_
 #define SRC_TINT_LANG_WGSL_LS_FILE_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <vector>
 
+#include "langsvr/lsp/lsp.h"
 #include "src/tint/lang/wgsl/ast/node.h"
 #include "src/tint/lang/wgsl/ls/utils.h"
 #include "src/tint/lang/wgsl/program/program.h"
@@ -52,11 +55,19 @@ class File {
     /// The source file
     std::unique_ptr<Source::File> source;
     /// The current version of the file. Incremented with each change.
-    int64_t version = 0;
+    /// Updated by the Analyzer's worker thread when a change leaves the content unchanged, while
+    /// the thread handling the LSP requests may be reading it.
+    std::atomic<int64_t> version = 0;
     /// The parsed and resolved Program
     Program program;
     /// A source-ordered list of AST nodes.
     std::vector<const ast::Node*> nodes;
+    /// The semantic tokens of the file, built by the first semantic tokens request.
+    /// Only accessed by the thread handling the LSP requests.
+    std::optional<langsvr::lsp::SemanticTokens> sem_tokens;
+    /// The document symbols of the file, built by the first document symbol request.
+    /// Only accessed by the thread handling the LSP requests.
+    std::optional<std::vector<langsvr::lsp::DocumentSymbol>> symbols;
 
     /// Constructor
     File(std::unique_ptr<Source::File>&& source_, int64_t version_, Program program_);
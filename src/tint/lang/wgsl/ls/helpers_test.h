@@ -29,6 +29,7 @@
 #ifndef SRC_TINT_LANG_WGSL_LS_HELPERS_TEST_H_
 #define SRC_TINT_LANG_WGSL_LS_HELPERS_TEST_H_
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -51,8 +52,11 @@ class LsTestImpl : public BASE {
     /// Registers a langsvr::lsp::TextDocumentPublishDiagnosticsNotification handler for the client
     /// session, so that diagnostic notifications are added to #diagnostics_.
     LsTestImpl() {
-        server_session_.SetSender(
-            [&](std::string_view msg) { return client_session_.Receive(msg); });
+        // Diagnostics are sent from the server's analyzer thread, so serialize the messages.
+        server_session_.SetSender([&](std::string_view msg) {
+            std::lock_guard<std::mutex> lock(server_sender_mutex_);
+            return client_session_.Receive(msg);
+        });
         client_session_.SetSender(
             [&](std::string_view msg) { return server_session_.Receive(msg); });
 
@@ -78,11 +82,14 @@ class LsTestImpl : public BASE {
         return uri;
     }
 
+    std::mutex server_sender_mutex_;
     langsvr::Session server_session_;
     langsvr::Session client_session_;
-    Server server_{server_session_};
     int next_document_id_ = 0;
     Vector<langsvr::lsp::TextDocumentPublishDiagnosticsNotification, 4> diagnostics_;
+    // Declared last, so that the server's analyzer thread is stopped before the other fields are
+    // destructed.
+    Server server_{server_session_};
 };
 
 using LsTest = LsTestImpl<testing::Test>;
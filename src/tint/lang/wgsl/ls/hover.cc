@@ -182,12 +182,12 @@ void Constant(const core::constant::Value* val, std::vector<lsp::MarkedString>&
 
 typename lsp::TextDocumentHoverRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentHoverRequest& r) {
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
 
-    auto* node = (*file)->NodeAt<CastableBase, File::UnwrapMode::kNoUnwrap>(Conv(r.position));
+    auto* node = file->NodeAt<CastableBase, File::UnwrapMode::kNoUnwrap>(Conv(r.position));
     if (!node) {
         return lsp::Null{};
     }
@@ -224,7 +224,7 @@ Server::Handle(const lsp::TextDocumentHoverRequest& r) {
             range = Conv(expr->Declaration()->source.range);
         },
         [&](const sem::BuiltinEnumExpression<wgsl::BuiltinFn>* fn) {
-            if (auto* call = (*file)->NodeAt<sem::Call>(Conv(r.position))) {
+            if (auto* call = file->NodeAt<sem::Call>(Conv(r.position))) {
                 Call(str(fn->Value()), call, strings);
             } else {
                 strings.push_back(WGSL(str(fn->Value())));
@@ -41,13 +41,13 @@ namespace tint::wgsl::ls {
 
 typename lsp::TextDocumentInlayHintRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentInlayHintRequest& r) {
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
 
     std::vector<lsp::InlayHint> hints;
-    auto& program = (*file)->program;
+    auto& program = file->program;
     for (auto* decl : program.AST().TypeDecls()) {
         if (auto* str = program.Sem().Get<sem::Struct>(decl)) {
             if (!str->UsedAs(core::AddressSpace::kStorage) &&
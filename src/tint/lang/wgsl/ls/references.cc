@@ -38,9 +38,9 @@ typename lsp::TextDocumentReferencesRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentReferencesRequest& r) {
     typename lsp::TextDocumentReferencesRequest::SuccessType result = lsp::Null{};
 
-    if (auto file = files_.Get(r.text_document.uri)) {
+    if (auto file = GetFile(r.text_document.uri)) {
         std::vector<lsp::Location> out;
-        for (auto& ref : (*file)->References(Conv(r.position), r.context.include_declaration)) {
+        for (auto& ref : file->References(Conv(r.position), r.context.include_declaration)) {
             lsp::Location loc;
             loc.range = Conv(ref);
             loc.uri = r.text_document.uri;
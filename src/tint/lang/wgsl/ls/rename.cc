@@ -46,12 +46,12 @@ typename lsp::TextDocumentPrepareRenameRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentPrepareRenameRequest& r) {
     typename lsp::TextDocumentPrepareRenameRequest::SuccessType result = lsp::Null{};
 
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
 
-    auto def = (*file)->Definition(Conv(r.position));
+    auto def = file->Definition(Conv(r.position));
     if (!def) {
         return lsp::Null{};
     }
@@ -64,17 +64,17 @@ Server::Handle(const lsp::TextDocumentPrepareRenameRequest& r) {
 
 typename lsp::TextDocumentRenameRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentRenameRequest& r) {
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
 
-    if (!(*file)->Definition(Conv(r.position))) {
+    if (!file->Definition(Conv(r.position))) {
         return lsp::Null{};
     }
 
     std::vector<lsp::TextEdit> changes;
-    for (auto& ref : (*file)->References(Conv(r.position), /* include_declaration */ true)) {
+    for (auto& ref : file->References(Conv(r.position), /* include_declaration */ true)) {
         lsp::TextEdit edit;
         edit.range = Conv(ref);
         edit.new_text = r.new_name;
@@ -116,31 +116,36 @@ std::vector<Token> Tokens(File& file) {
     return tokens;
 }
 
+/// @returns the tokens @p tokens encoded as a SemanticTokens.
+lsp::SemanticTokens Encode(const std::vector<Token>& tokens) {
+    lsp::SemanticTokens out;
+    // https://microsoft.github.io/language-server-protocol/specifications/lsp/3.17/specification/#textDocument_semanticTokens
+    Token last;
+    for (auto tok : tokens) {
+        if (last.position.line != tok.position.line) {
+            last.position.character = 0;
+        }
+        out.data.push_back(tok.position.line - last.position.line);
+        out.data.push_back(tok.position.character - last.position.character);
+        out.data.push_back(tok.length);
+        out.data.push_back(static_cast<langsvr::lsp::Uinteger>(tok.kind));
+        out.data.push_back(0);  // modifiers
+        last = tok;
+    }
+    return out;
+}
+
 }  // namespace
 
 typename lsp::TextDocumentSemanticTokensFullRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentSemanticTokensFullRequest& r) {
     typename lsp::TextDocumentSemanticTokensFullRequest::SuccessType result;
 
-    if (auto file = files_.Get(r.text_document.uri)) {
-        lsp::SemanticTokens out;
-        // https://microsoft.github.io/language-server-protocol/specifications/lsp/3.17/specification/#textDocument_semanticTokens
-        Token last;
-
-        auto tokens = Tokens(**file);
-        for (auto tok : tokens) {
-            if (last.position.line != tok.position.line) {
-                last.position.character = 0;
-            }
-            out.data.push_back(tok.position.line - last.position.line);
-            out.data.push_back(tok.position.character - last.position.character);
-            out.data.push_back(tok.length);
-            out.data.push_back(static_cast<langsvr::lsp::Uinteger>(tok.kind));
-            out.data.push_back(0);  // modifiers
-            last = tok;
+    if (auto file = GetFile(r.text_document.uri)) {
+        if (!file->sem_tokens) {
+            file->sem_tokens = Encode(Tokens(*file));
         }
-
-        result = out;
+        result = *file->sem_tokens;
     }
 
     return result;
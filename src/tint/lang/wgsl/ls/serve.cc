@@ -28,6 +28,7 @@
 #include "src/tint/lang/wgsl/ls/serve.h"
 
 #include <stdio.h>
+#include <mutex>
 #include <string>
 
 #include "langsvr/content_stream.h"
@@ -89,8 +90,11 @@ Result<SuccessType> Serve(langsvr::Reader& reader, langsvr::Writer& writer) {
     std::this_thread::sleep_for(std::chrono::seconds(10));
 #endif
 
+    // Diagnostics are sent from the analyzer's worker thread, so writes must be serialized.
+    std::mutex writer_mutex;
     langsvr::Session session;
     session.SetSender([&](std::string_view response) {  //
+        std::lock_guard<std::mutex> lock(writer_mutex);
         LOG("<< %s", std::string(response).c_str());
         return langsvr::WriteContent(writer, response);
     });
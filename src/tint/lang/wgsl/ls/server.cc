@@ -37,7 +37,9 @@ namespace lsp = langsvr::lsp;
 
 namespace tint::wgsl::ls {
 
-Server::Server(langsvr::Session& session) : session_(session) {
+Server::Server(langsvr::Session& session, std::chrono::milliseconds analysis_debounce)
+    : session_(session),
+      analyzer_(analysis_debounce, [this](File& file) { (void)PublishDiagnostics(file); }) {
     session.Register([&](const lsp::InitializeRequest&) {
         lsp::InitializeResult result;
         result.capabilities.definition_provider = true;
@@ -28,6 +28,7 @@
 #ifndef SRC_TINT_LANG_WGSL_LS_SERVER_H_
 #define SRC_TINT_LANG_WGSL_LS_SERVER_H_
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -35,8 +36,8 @@
 #include "langsvr/lsp/lsp.h"
 #include "langsvr/session.h"
 
+#include "src/tint/lang/wgsl/ls/analyzer.h"
 #include "src/tint/lang/wgsl/ls/file.h"
-#include "src/tint/utils/containers/hashmap.h"
 #include "src/tint/utils/text/string_stream.h"
 
 namespace tint::wgsl::ls {
@@ -44,9 +45,16 @@ namespace tint::wgsl::ls {
 /// The language server state object.
 class Server {
   public:
+    /// The default time that a changed document must be left unchanged before it is re-analyzed.
+    static constexpr std::chrono::milliseconds kDefaultAnalysisDebounce{50};
+
     /// Constructor
-    /// @param session the LSP session.
-    explicit Server(langsvr::Session& session);
+    /// @param session the LSP session. Diagnostics are sent from a worker thread, so the session's
+    /// sender must be thread-safe.
+    /// @param analysis_debounce the time that a changed document must be left unchanged before it
+    /// is re-analyzed.
+    explicit Server(langsvr::Session& session,
+                    std::chrono::milliseconds analysis_debounce = kDefaultAnalysisDebounce);
 
     /// Destructor
     ~Server();
@@ -136,6 +144,10 @@ class Server {
     langsvr::Result<langsvr::SuccessType>  //
     PublishDiagnostics(File& file);
 
+    /// @returns the File for the latest version of the document @p uri, or nullptr if the document
+    /// is not open. Blocks until any pending analysis of the document has completed.
+    std::shared_ptr<File> GetFile(const std::string& uri) { return analyzer_.Get(uri); }
+
     /// Logger is a string-stream like utility for logging to the client.
     /// Append message content with '<<'. The message is sent when the logger is destructed.
     struct Logger {
@@ -158,10 +170,12 @@ class Server {
 
     /// The LSP session.
     langsvr::Session& session_;
-    /// Map of URI to File.
-    Hashmap<std::string, std::shared_ptr<File>, 8> files_;
     /// True if the server has been asked to shutdown.
     bool shutting_down_ = false;
+    /// The open documents, analyzed in the background.
+    /// Declared last, so that the analyzer's worker thread is stopped before the other fields are
+    /// destructed.
+    Analyzer analyzer_;
 };
 
 }  // namespace tint::wgsl::ls
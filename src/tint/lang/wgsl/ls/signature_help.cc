@@ -171,15 +171,15 @@ void PrintOverload(StyledText& ss,
 
 typename lsp::TextDocumentSignatureHelpRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentSignatureHelpRequest& r) {
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
 
-    auto& program = (*file)->program;
+    auto& program = file->program;
     auto pos = Conv(r.position);
 
-    auto call = (*file)->NodeAt<sem::Call>(pos);
+    auto call = file->NodeAt<sem::Call>(pos);
     if (!call) {
         return lsp::Null{};
     }
@@ -39,54 +39,65 @@ namespace tint::wgsl::ls {
 
 namespace lsp = langsvr::lsp;
 
+namespace {
+
+/// @returns the document symbols of the file @p file.
+std::vector<lsp::DocumentSymbol> Symbols(File& file) {
+    std::vector<lsp::DocumentSymbol> symbols;
+    for (auto* decl : file.program.AST().Functions()) {
+        lsp::DocumentSymbol sym;
+        sym.range = Conv(decl->source.range);
+        sym.selection_range = Conv(decl->name->source.range);
+        sym.kind = lsp::SymbolKind::kFunction;
+        sym.name = decl->name->symbol.NameView();
+        symbols.push_back(sym);
+    }
+    for (auto* decl : file.program.AST().GlobalVariables()) {
+        lsp::DocumentSymbol sym;
+        sym.range = Conv(decl->source.range);
+        sym.selection_range = Conv(decl->name->source.range);
+        sym.kind =
+            decl->Is<ast::Const>() ? lsp::SymbolKind::kConstant : lsp::SymbolKind::kVariable;
+        sym.name = decl->name->symbol.NameView();
+        symbols.push_back(sym);
+    }
+    for (auto* decl : file.program.AST().TypeDecls()) {
+        Switch(
+            decl,  //
+            [&](const ast::Struct* str) {
+                lsp::DocumentSymbol sym;
+                sym.range = Conv(str->source.range);
+                sym.selection_range = Conv(decl->name->source.range);
+                sym.kind = lsp::SymbolKind::kStruct;
+                sym.name = decl->name->symbol.NameView();
+                symbols.push_back(sym);
+            },
+            [&](const ast::Alias* str) {
+                lsp::DocumentSymbol sym;
+                sym.range = Conv(str->source.range);
+                sym.selection_range = Conv(decl->name->source.range);
+                // TODO(bclayton): Is there a better symbol kind?
+                sym.kind = lsp::SymbolKind::kObject;
+                sym.name = decl->name->symbol.NameView();
+                symbols.push_back(sym);
+            });
+    }
+    return symbols;
+}
+
+}  // namespace
+
 typename lsp::TextDocumentDocumentSymbolRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentDocumentSymbolRequest& r) {
     typename lsp::TextDocumentDocumentSymbolRequest::SuccessType result = lsp::Null{};
 
-    std::vector<lsp::DocumentSymbol> symbols;
-    if (auto file = files_.Get(r.text_document.uri)) {
-        for (auto* decl : (*file)->program.AST().Functions()) {
-            lsp::DocumentSymbol sym;
-            sym.range = Conv(decl->source.range);
-            sym.selection_range = Conv(decl->name->source.range);
-            sym.kind = lsp::SymbolKind::kFunction;
-            sym.name = decl->name->symbol.NameView();
-            symbols.push_back(sym);
+    if (auto file = GetFile(r.text_document.uri)) {
+        if (!file->symbols) {
+            file->symbols = Symbols(*file);
         }
-        for (auto* decl : (*file)->program.AST().GlobalVariables()) {
-            lsp::DocumentSymbol sym;
-            sym.range = Conv(decl->source.range);
-            sym.selection_range = Conv(decl->name->source.range);
-            sym.kind =
-                decl->Is<ast::Const>() ? lsp::SymbolKind::kConstant : lsp::SymbolKind::kVariable;
-            sym.name = decl->name->symbol.NameView();
-            symbols.push_back(sym);
+        if (!file->symbols->empty()) {
+            result = *file->symbols;
         }
-        for (auto* decl : (*file)->program.AST().TypeDecls()) {
-            Switch(
-                decl,  //
-                [&](const ast::Struct* str) {
-                    lsp::DocumentSymbol sym;
-                    sym.range = Conv(str->source.range);
-                    sym.selection_range = Conv(decl->name->source.range);
-                    sym.kind = lsp::SymbolKind::kStruct;
-                    sym.name = decl->name->symbol.NameView();
-                    symbols.push_back(sym);
-                },
-                [&](const ast::Alias* str) {
-                    lsp::DocumentSymbol sym;
-                    sym.range = Conv(str->source.range);
-                    sym.selection_range = Conv(decl->name->source.range);
-                    // TODO(bclayton): Is there a better symbol kind?
-                    sym.kind = lsp::SymbolKind::kObject;
-                    sym.name = decl->name->symbol.NameView();
-                    symbols.push_back(sym);
-                });
-        }
-    }
-
-    if (!symbols.empty()) {
-        result = std::move(symbols);
     }
 
     return result;
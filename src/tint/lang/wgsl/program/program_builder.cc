@@ -41,6 +41,8 @@ using namespace tint::core::number_suffixes;  // NOLINT
 
 namespace tint {
 
+thread_local ProgramBuilder::ThreadSemNodeAllocator ProgramBuilder::thread_sem_nodes_;
+
 ProgramBuilder::ProgramBuilder() = default;
 
 ProgramBuilder::ProgramBuilder(ProgramBuilder&& rhs)
@@ -72,6 +74,19 @@ ProgramBuilder ProgramBuilder::Wrap(const Program& program) {
     return builder;
 }
 
+ProgramBuilder::SemNodeAllocatorScope::SemNodeAllocatorScope(const ProgramBuilder& builder,
+                                                             SemNodeAllocator& allocator)
+    : previous_builder_(thread_sem_nodes_.builder),
+      previous_allocator_(thread_sem_nodes_.allocator) {
+    thread_sem_nodes_.builder = &builder;
+    thread_sem_nodes_.allocator = &allocator;
+}
+
+ProgramBuilder::SemNodeAllocatorScope::~SemNodeAllocatorScope() {
+    thread_sem_nodes_.builder = previous_builder_;
+    thread_sem_nodes_.allocator = previous_allocator_;
+}
+
 void ProgramBuilder::AssertNotMoved() const {
     if (TINT_UNLIKELY(moved_)) {
         TINT_ICE() << "Attempting to use ProgramBuilder after it has been moved";
@@ -129,6 +129,29 @@ class ProgramBuilder : public ast::Builder {
         return sem_nodes_;
     }
 
+    /// SemNodeAllocatorScope is a RAII helper that makes create() place the sem::Nodes that the
+    /// calling thread creates for a ProgramBuilder into another allocator, for the lifetime of the
+    /// scope. This allows multiple threads to create semantic nodes for the same ProgramBuilder
+    /// concurrently. The nodes must be appended to SemNodes() before the ProgramBuilder is used to
+    /// build a Program.
+    class SemNodeAllocatorScope {
+      public:
+        /// Constructor
+        /// @param builder the ProgramBuilder
+        /// @param allocator the allocator for the sem::Nodes created by the calling thread
+        SemNodeAllocatorScope(const ProgramBuilder& builder, SemNodeAllocator& allocator);
+
+        /// Destructor. Restores the allocator that was used before the scope.
+        ~SemNodeAllocatorScope();
+
+      private:
+        SemNodeAllocatorScope(const SemNodeAllocatorScope&) = delete;
+        SemNodeAllocatorScope& operator=(const SemNodeAllocatorScope&) = delete;
+
+        const ProgramBuilder* previous_builder_;
+        SemNodeAllocator* previous_allocator_;
+    };
+
     /// @returns a reference to the program's AST root Module
     ast::Module& AST() {
         AssertNotMoved();
@@ -160,6 +183,9 @@ class ProgramBuilder : public ast::Builder {
                            T>*
     create(ARGS&&... args) {
         AssertNotMoved();
+        if (thread_sem_nodes_.builder == this) {
+            return thread_sem_nodes_.allocator->Create<T>(std::forward<ARGS>(args)...);
+        }
         return sem_nodes_.Create<T>(std::forward<ARGS>(args)...);
     }
 
@@ -208,6 +234,14 @@ class ProgramBuilder : public ast::Builder {
     void AssertNotMoved() const;
 
   private:
+    /// The allocator used by create() for the sem::Nodes of a ProgramBuilder, when created by the
+    /// current thread. Set by SemNodeAllocatorScope.
+    struct ThreadSemNodeAllocator {
+        const ProgramBuilder* builder = nullptr;
+        SemNodeAllocator* allocator = nullptr;
+    };
+    static thread_local ThreadSemNodeAllocator thread_sem_nodes_;
+
     SemNodeAllocator sem_nodes_;
     sem::Info sem_;
 };
@@ -28,6 +28,8 @@
 #ifndef SRC_TINT_LANG_WGSL_READER_OPTIONS_H_
 #define SRC_TINT_LANG_WGSL_READER_OPTIONS_H_
 
+#include <cstdint>
+
 #include "src/tint/lang/wgsl/common/allowed_features.h"
 #include "src/tint/utils/reflection/reflection.h"
 
@@ -38,8 +40,12 @@ struct Options {
     /// The extensions and language features that are allowed to be used.
     AllowedFeatures allowed_features{};
 
+    /// The number of threads used to resolve the bodies of functions. Values greater than 1 enable
+    /// parallel resolving, which produces the same program and diagnostics as a single thread.
+    uint32_t resolver_threads = 1;
+
     /// Reflect the fields of this class so that it can be used by tint::ForeachField().
-    TINT_REFLECT(Options, allowed_features);
+    TINT_REFLECT(Options, allowed_features, resolver_threads);
 };
 
 }  // namespace tint::wgsl::reader
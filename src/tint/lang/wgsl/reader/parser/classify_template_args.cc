@@ -29,34 +29,32 @@
 
 #include <vector>
 
-#include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/ice/ice.h"
 
 namespace tint::wgsl::reader {
 
 namespace {
 
-/// If the token at index @p idx is a '>>', '>=' or '>>=', then the token is split into two, with
-/// the first being '>', otherwise MaybeSplit() will be a no-op.
-/// @param tokens the vector of tokens
-/// @param idx the index of the token to (maybe) split
-void MaybeSplit(std::vector<Token>& tokens, size_t idx) {
-    Token* token = &tokens[idx];
-    switch (token->type()) {
+/// If the token @p token is a '>>', '>=' or '>>=', then the token is split into two, with the
+/// first being '>', otherwise MaybeSplit() will be a no-op.
+/// @param token the token to (maybe) split
+/// @param next the placeholder token that follows @p token
+void MaybeSplit(Token& token, Token& next) {
+    switch (token.type()) {
         case Token::Type::kShiftRight:  //  '>>'
-            TINT_ASSERT(token[1].type() == Token::Type::kPlaceholder);
-            token[0].SetType(Token::Type::kGreaterThan);
-            token[1].SetType(Token::Type::kGreaterThan);
+            TINT_ASSERT(next.type() == Token::Type::kPlaceholder);
+            token.SetType(Token::Type::kGreaterThan);
+            next.SetType(Token::Type::kGreaterThan);
             break;
         case Token::Type::kGreaterThanEqual:  //  '>='
-            TINT_ASSERT(token[1].type() == Token::Type::kPlaceholder);
-            token[0].SetType(Token::Type::kGreaterThan);
-            token[1].SetType(Token::Type::kEqual);
+            TINT_ASSERT(next.type() == Token::Type::kPlaceholder);
+            token.SetType(Token::Type::kGreaterThan);
+            next.SetType(Token::Type::kEqual);
             break;
         case Token::Type::kShiftRightEqual:  // '>>='
-            TINT_ASSERT(token[1].type() == Token::Type::kPlaceholder);
-            token[0].SetType(Token::Type::kGreaterThan);
-            token[1].SetType(Token::Type::kGreaterThanEqual);
+            TINT_ASSERT(next.type() == Token::Type::kPlaceholder);
+            token.SetType(Token::Type::kGreaterThan);
+            next.SetType(Token::Type::kGreaterThanEqual);
             break;
         default:
             break;
@@ -65,89 +63,86 @@ void MaybeSplit(std::vector<Token>& tokens, size_t idx) {
 
 }  // namespace
 
-void ClassifyTemplateArguments(std::vector<Token>& tokens) {
-    const size_t count = tokens.size();
-
-    // The current expression nesting depth.
-    // Each '(', '[' increments the depth.
-    // Each ')', ']' decrements the depth.
-    uint64_t expr_depth = 0;
-
-    // A stack of '<' tokens.
-    // Used to pair '<' and '>' tokens at the same expression depth.
-    struct StackEntry {
-        Token* token;         // A pointer to the opening '<' token
-        uint64_t expr_depth;  // The value of 'expr_depth' for the opening '<'
-    };
-    Vector<StackEntry, 16> stack;
-
-    for (size_t i = 0; i < count - 1; i++) {
-        switch (tokens[i].type()) {
-            case Token::Type::kIdentifier:
-            case Token::Type::kVar: {
-                auto& next = tokens[i + 1];
-                if (next.type() == Token::Type::kLessThan) {
-                    // ident '<'
-                    // Push this '<' to the stack, along with the current nesting expr_depth.
-                    stack.Push(StackEntry{&tokens[i + 1], expr_depth});
-                    i++;  // Skip the '<'
-                }
-                break;
+size_t TemplateArgClassifier::Classify(Token& token, Token& next, size_t index) {
+    switch (token.type()) {
+        case Token::Type::kIdentifier:
+        case Token::Type::kVar: {
+            if (next.type() == Token::Type::kLessThan) {
+                // ident '<'
+                // Push this '<' to the stack, along with the current nesting expr_depth.
+                stack_.Push(StackEntry{&next, index + 1, expr_depth_});
+                return 2;  // Skip the '<'
             }
-            case Token::Type::kGreaterThan:       // '>'
-            case Token::Type::kShiftRight:        // '>>'
-            case Token::Type::kGreaterThanEqual:  // '>='
-            case Token::Type::kShiftRightEqual:   // '>>='
-                if (!stack.IsEmpty() && stack.Back().expr_depth == expr_depth) {
-                    // '<' and '>' at same expr_depth, and no terminating tokens in-between.
-                    // Consider both as a template argument list.
-                    MaybeSplit(tokens, i);
-                    stack.Pop().token->SetType(Token::Type::kTemplateArgsLeft);
-                    tokens[i].SetType(Token::Type::kTemplateArgsRight);
-                }
-                break;
-
-            case Token::Type::kParenLeft:    // '('
-            case Token::Type::kBracketLeft:  // '['
-                // Entering a nested expression
-                expr_depth++;
-                break;
-
-            case Token::Type::kParenRight:    // ')'
-            case Token::Type::kBracketRight:  // ']'
-                // Exiting a nested expression
-                // Pop the stack until we return to the current expression expr_depth
-                while (!stack.IsEmpty() && stack.Back().expr_depth == expr_depth) {
-                    stack.Pop();
-                }
-                if (expr_depth > 0) {
-                    expr_depth--;
-                }
-                break;
-
-            case Token::Type::kSemicolon:  // ';'
-            case Token::Type::kBraceLeft:  // '{'
-            case Token::Type::kEqual:      // '='
-            case Token::Type::kColon:      // ':'
-                // Expression terminating tokens. No opening template list can hold these tokens, so
-                // clear the stack and expression depth.
-                expr_depth = 0;
-                stack.Clear();
-                break;
-
-            case Token::Type::kOrOr:    // '||'
-            case Token::Type::kAndAnd:  // '&&'
-                // Treat 'a < b || c > d' as a logical binary operator of two comparison operators
-                // instead of a single template argument 'b||c'.
-                // Use parentheses around 'b||c' to parse as a template argument list.
-                while (!stack.IsEmpty() && stack.Back().expr_depth == expr_depth) {
-                    stack.Pop();
-                }
-                break;
-
-            default:
-                break;
+            break;
         }
+        case Token::Type::kGreaterThan:       // '>'
+        case Token::Type::kShiftRight:        // '>>'
+        case Token::Type::kGreaterThanEqual:  // '>='
+        case Token::Type::kShiftRightEqual:   // '>>='
+            if (!stack_.IsEmpty() && stack_.Back().expr_depth == expr_depth_) {
+                // '<' and '>' at same expr_depth, and no terminating tokens in-between.
+                // Consider both as a template argument list.
+                MaybeSplit(token, next);
+                stack_.Pop().token->SetType(Token::Type::kTemplateArgsLeft);
+                token.SetType(Token::Type::kTemplateArgsRight);
+            }
+            break;
+
+        case Token::Type::kParenLeft:    // '('
+        case Token::Type::kBracketLeft:  // '['
+            // Entering a nested expression
+            expr_depth_++;
+            break;
+
+        case Token::Type::kParenRight:    // ')'
+        case Token::Type::kBracketRight:  // ']'
+            // Exiting a nested expression
+            // Pop the stack until we return to the current expression expr_depth
+            while (!stack_.IsEmpty() && stack_.Back().expr_depth == expr_depth_) {
+                stack_.Pop();
+            }
+            if (expr_depth_ > 0) {
+                expr_depth_--;
+            }
+            break;
+
+        case Token::Type::kSemicolon:  // ';'
+        case Token::Type::kBraceLeft:  // '{'
+        case Token::Type::kEqual:      // '='
+        case Token::Type::kColon:      // ':'
+            // Expression terminating tokens. No opening template list can hold these tokens, so
+            // clear the stack and expression depth.
+            expr_depth_ = 0;
+            stack_.Clear();
+            break;
+
+        case Token::Type::kOrOr:    // '||'
+        case Token::Type::kAndAnd:  // '&&'
+            // Treat 'a < b || c > d' as a logical binary operator of two comparison operators
+            // instead of a single template argument 'b||c'.
+            // Use parentheses around 'b||c' to parse as a template argument list.
+            while (!stack_.IsEmpty() && stack_.Back().expr_depth == expr_depth_) {
+                stack_.Pop();
+            }
+            break;
+
+        default:
+            break;
+    }
+    return 1;
+}
+
+std::optional<size_t> TemplateArgClassifier::FirstPendingIndex() const {
+    if (stack_.IsEmpty()) {
+        return std::nullopt;
+    }
+    return stack_.Front().index;
+}
+
+void ClassifyTemplateArguments(std::vector<Token>& tokens) {
+    TemplateArgClassifier classifier;
+    for (size_t i = 0; i + 1 < tokens.size();) {
+        i += classifier.Classify(tokens[i], tokens[i + 1], i);
     }
 }
 
@@ -28,12 +28,54 @@
 #ifndef SRC_TINT_LANG_WGSL_READER_PARSER_CLASSIFY_TEMPLATE_ARGS_H_
 #define SRC_TINT_LANG_WGSL_READER_PARSER_CLASSIFY_TEMPLATE_ARGS_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 #include "src/tint/lang/wgsl/reader/parser/token.h"
+#include "src/tint/utils/containers/vector.h"
 
 namespace tint::wgsl::reader {
 
+/// TemplateArgClassifier classifies template argument list tokens one token at a time, so that
+/// tokens can be classified as they are lexed.
+/// A '<' token that may open a template argument list is held by pointer until it has been
+/// classified, so tokens must not be moved or destroyed while they are pending.
+class TemplateArgClassifier {
+  public:
+    /// Classifies the token @p token, which is immediately followed by @p next.
+    /// @param token the token to classify
+    /// @param next the token that follows @p token
+    /// @param index the position of @p token in the token stream
+    /// @returns 2 if @p next was also consumed by the classification, otherwise 1.
+    size_t Classify(Token& token, Token& next, size_t index);
+
+    /// @returns the stream position of the outermost '<' token that may still be classified as a
+    /// template argument list, or std::nullopt if there are no pending '<' tokens. Tokens before
+    /// this position will not be modified by further calls to Classify().
+    std::optional<size_t> FirstPendingIndex() const;
+
+  private:
+    /// An entry of the stack of '<' tokens.
+    struct StackEntry {
+        Token* token;         // A pointer to the opening '<' token
+        size_t index;         // The stream position of the opening '<' token
+        uint64_t expr_depth;  // The value of 'expr_depth_' for the opening '<'
+    };
+
+    /// The current expression nesting depth.
+    /// Each '(', '[' increments the depth.
+    /// Each ')', ']' decrements the depth.
+    uint64_t expr_depth_ = 0;
+
+    /// A stack of '<' tokens.
+    /// Used to pair '<' and '>' tokens at the same expression depth.
+    Vector<StackEntry, 16> stack_;
+};
+
+/// Classifies all the template argument list tokens of @p tokens.
+/// @param tokens the tokens to classify
 void ClassifyTemplateArguments(std::vector<Token>& tokens);
 
 }  // namespace tint::wgsl::reader
@@ -25,6 +25,10 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
+#include <deque>
+#include <vector>
+
 #include "gmock/gmock.h"
 
 #include "src/tint/lang/wgsl/reader/parser/classify_template_args.h"
@@ -57,6 +61,40 @@ TEST_P(WGSLParserClassifyTemplateArgsTest, Classify) {
     EXPECT_THAT(types, testing::ContainerEq(params.tokens));
 }
 
+TEST_P(WGSLParserClassifyTemplateArgsTest, ClassifyIncrementally) {
+    auto& params = GetParam();
+    Source::File file("", params.wgsl);
+    Lexer l(&file);
+
+    // Classify the tokens as they are lexed, checking that tokens before the first pending '<'
+    // are never modified once they have been classified.
+    std::deque<Token> tokens;
+    std::vector<T> settled;
+    TemplateArgClassifier classifier;
+    size_t num_classified = 0;
+    while (tokens.empty() || (!tokens.back().IsEof() && !tokens.back().IsError())) {
+        tokens.emplace_back(l.Next());
+        while (num_classified + 1 < tokens.size()) {
+            num_classified +=
+                classifier.Classify(tokens[num_classified], tokens[num_classified + 1],
+                                    num_classified);
+        }
+        size_t num_settled = classifier.FirstPendingIndex().value_or(num_classified);
+        for (size_t i = 0; i < settled.size(); i++) {
+            EXPECT_EQ(tokens[i].type(), settled[i]);
+        }
+        for (size_t i = settled.size(); i < std::min(num_settled, num_classified); i++) {
+            settled.push_back(tokens[i].type());
+        }
+    }
+
+    std::vector<T> types;
+    for (auto& t : tokens) {
+        types.push_back(t.type());
+    }
+    EXPECT_THAT(types, testing::ContainerEq(params.tokens));
+}
+
 INSTANTIATE_TEST_SUITE_P(NonTemplate,
                          WGSLParserClassifyTemplateArgsTest,
                          testing::ValuesIn(std::vector<Case>{
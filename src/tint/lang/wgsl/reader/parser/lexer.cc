@@ -27,7 +27,6 @@
 
 #include "src/tint/lang/wgsl/reader/parser/lexer.h"
 
-#include <cctype>
 #include <charconv>
 #include <cmath>
 #include <cstring>
@@ -41,6 +40,7 @@
 #include "src/tint/lang/core/number.h"
 #include "src/tint/utils/ice/ice.h"
 #include "src/tint/utils/strconv/parse_num.h"
+#include "src/tint/utils/text/ascii.h"
 #include "src/tint/utils/text/unicode.h"
 
 using namespace tint::core::fluent_types;  // NOLINT
@@ -117,23 +117,30 @@ std::vector<Token> Lexer::Lex() {
     tokens.reserve(kDefaultListSize);
 
     while (true) {
-        tokens.emplace_back(next());
+        tokens.emplace_back(Next());
         if (tokens.back().IsEof() || tokens.back().IsError()) {
             break;
         }
-
-        // If the token can be split, we insert a placeholder element(s) into the stream to hold the
-        // split character.
-        size_t num_placeholders = tokens.back().NumPlaceholders();
-        for (size_t i = 0; i < num_placeholders; i++) {
-            auto src = tokens.back().source();
-            src.range.begin.column++;
-            tokens.emplace_back(Token::Type::kPlaceholder, src);
-        }
     }
     return tokens;
 }
 
+Token Lexer::Next() {
+    // If the last token can be split, emit placeholder element(s) to hold the split character.
+    if (num_placeholders_ > 0) {
+        num_placeholders_--;
+        placeholder_source_.range.begin.column++;
+        return {Token::Type::kPlaceholder, placeholder_source_};
+    }
+
+    Token token = next();
+    num_placeholders_ = token.NumPlaceholders();
+    if (num_placeholders_ > 0) {
+        placeholder_source_ = token.source();
+    }
+    return token;
+}
+
 std::string_view Lexer::line() const {
     if (file_->content.lines.size() == 0) {
         static const char* empty_string = "";
@@ -191,20 +198,24 @@ Token Lexer::next() {
         return std::move(t.value());
     }
 
-    if (auto t = try_hex_float(); t.has_value() && !t->IsUninitialized()) {
-        return std::move(t.value());
-    }
+    // Numeric literals start with a digit, or with a '.' followed by a digit. Identifiers and
+    // punctuation make up most of the tokens, so skip the numeric literal scanners for them.
+    if (is_digit(at(pos())) || (matches(pos(), '.') && is_digit(at(pos() + 1)))) {
+        if (auto t = try_hex_float(); t.has_value() && !t->IsUninitialized()) {
+            return std::move(t.value());
+        }
 
-    if (auto t = try_hex_integer(); t.has_value() && !t->IsUninitialized()) {
-        return std::move(t.value());
-    }
+        if (auto t = try_hex_integer(); t.has_value() && !t->IsUninitialized()) {
+            return std::move(t.value());
+        }
 
-    if (auto t = try_float(); t.has_value() && !t->IsUninitialized()) {
-        return std::move(t.value());
-    }
+        if (auto t = try_float(); t.has_value() && !t->IsUninitialized()) {
+            return std::move(t.value());
+        }
 
-    if (auto t = try_integer(); t.has_value() && !t->IsUninitialized()) {
-        return std::move(t.value());
+        if (auto t = try_integer(); t.has_value() && !t->IsUninitialized()) {
+            return std::move(t.value());
+        }
     }
 
     if (auto t = try_ident(); t.has_value() && !t->IsUninitialized()) {
@@ -236,10 +247,13 @@ bool Lexer::is_null() const {
 }
 
 bool Lexer::is_digit(char ch) const {
-    return std::isdigit(static_cast<unsigned char>(ch));
+    return ch >= '0' && ch <= '9';
+}
+bool Lexer::is_non_ascii(char ch) const {
+    return (static_cast<uint8_t>(ch) & 0x80) != 0;
 }
 bool Lexer::is_hex(char ch) const {
-    return std::isxdigit(static_cast<unsigned char>(ch));
+    return is_digit(ch) || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F');
 }
 
 bool Lexer::matches(uint32_t pos, std::string_view sub_string) {
@@ -265,6 +279,16 @@ std::optional<Token> Lexer::skip_blankspace_and_comments() {
                 continue;
             }
 
+            // Fast path for runs of ASCII blankspace.
+            if (auto n = ascii::SpanBlankspace(line().substr(pos())); n > 0) {
+                advance(static_cast<uint32_t>(n));
+                continue;
+            }
+            if (!is_non_ascii(at(pos()))) {
+                // Any other ASCII character is not blankspace.
+                break;
+            }
+
             bool is_blankspace;
             uint32_t blankspace_size;
             if (!read_blankspace(line(), pos(), &is_blankspace, &blankspace_size)) {
@@ -298,12 +322,12 @@ std::optional<Token> Lexer::skip_blankspace_and_comments() {
 std::optional<Token> Lexer::skip_comment() {
     if (matches(pos(), "//")) {
         // Line comment: ignore everything until the end of line.
-        while (!is_eol()) {
-            if (is_null()) {
-                return Token{Token::Type::kError, begin_source(), "null character found"};
-            }
-            advance();
+        auto rest = line().substr(pos());
+        if (auto null = rest.find('\0'); null != std::string_view::npos) {
+            advance(static_cast<uint32_t>(null));
+            return Token{Token::Type::kError, begin_source(), "null character found"};
         }
+        advance(static_cast<uint32_t>(rest.size()));
         return {};
     }
 
@@ -332,8 +356,11 @@ std::optional<Token> Lexer::skip_comment() {
             } else if (is_null()) {
                 return Token{Token::Type::kError, begin_source(), "null character found"};
             } else {
-                // Anything else: skip and update source location.
+                // Anything else: skip up to the next character that may open or close a nested
+                // comment, or is a null character.
                 advance();
+                auto skip = ascii::FindFirstOf(line().substr(pos()), '/', '*', '\0');
+                advance(static_cast<uint32_t>(skip));
             }
         }
         if (depth > 0) {
@@ -396,7 +423,7 @@ std::optional<Token> Lexer::try_float() {
         exponent_value_position = end;
 
         bool has_digits = false;
-        while (end < length() && isdigit(at(end))) {
+        while (end < length() && is_digit(at(end))) {
             has_digits = true;
             end++;
         }
@@ -679,7 +706,7 @@ std::optional<Token> Lexer::try_hex_float() {
         // Allow overflow (in uint64_t) when the floating point value magnitude is
         // zero.
         bool has_exponent_digits = false;
-        while (end < length() && isdigit(at(end))) {
+        while (end < length() && is_digit(at(end))) {
             has_exponent_digits = true;
             auto prev_exponent = input_exponent;
             input_exponent = (input_exponent * 10) + dec_value(at(end));
@@ -999,6 +1026,12 @@ std::optional<Token> Lexer::try_ident() {
     }
 
     while (!is_eol()) {
+        // Fast path for runs of ASCII identifier characters, which are all XID_Continue.
+        advance(static_cast<uint32_t>(ascii::SpanIdentifier(line().substr(pos()))));
+        if (is_eol() || !is_non_ascii(at(pos()))) {
+            break;
+        }
+
         // Must continue with an XID_Continue unicode character
         auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
         auto [code_point, n] = tint::utf8::Decode(utf8, line().size() - pos());
@@ -46,6 +46,12 @@ class Lexer {
     /// @return the token list.
     std::vector<Token> Lex();
 
+    /// Lexes the next token from the input stream. Tokens that can be split are followed by
+    /// placeholder tokens, as with Lex(). Once an end of file or error token has been returned,
+    /// Next() must not be called again.
+    /// @return the next token
+    Token Next();
+
   private:
     /// Returns the next token in the input stream.
     /// @return Token
@@ -112,6 +118,9 @@ class Lexer {
     /// @returns true if 'ch' is a decimal digit
     bool is_digit(char ch) const;
     /// @param ch a character
+    /// @returns true if 'ch' is not an ASCII character (it is part of a multi-byte UTF-8 sequence)
+    bool is_non_ascii(char ch) const;
+    /// @param ch a character
     /// @returns true if 'ch' is a hexadecimal digit
     bool is_hex(char ch) const;
     /// @returns true if string at `pos` matches `substr`
@@ -122,6 +131,10 @@ class Lexer {
     Source::File const* const file_;
     /// The current location within the input
     Source::Location location_;
+    /// The number of placeholder tokens still to be returned by Next()
+    size_t num_placeholders_ = 0;
+    /// The source of the last placeholder token returned by Next()
+    Source placeholder_source_;
 };
 
 }  // namespace tint::wgsl::reader
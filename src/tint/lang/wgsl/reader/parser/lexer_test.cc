@@ -69,6 +69,18 @@ TEST_F(LexerTest, Empty) {
     EXPECT_TRUE(list[0].IsEof());
 }
 
+TEST_F(LexerTest, Next_MatchesLex) {
+    Source::File file("", "a >>= b >> c;\n  x-- && y >= z;");
+    auto list = Lexer(&file).Lex();
+
+    Lexer l(&file);
+    for (auto& expected : list) {
+        auto t = l.Next();
+        EXPECT_EQ(t.type(), expected.type()) << t.to_name();
+        EXPECT_EQ(t.source().range, expected.source().range) << t.to_name();
+    }
+}
+
 TEST_F(LexerTest, Skips_Blankspace_Basic) {
     Source::File file("", "\t\r\n\t    ident\t\n\t  \r ");
     Lexer l(&file);
@@ -303,6 +315,35 @@ text // nested line comments are ignored /* more text
     }
 }
 
+TEST_F(LexerTest, Skips_LongRuns) {
+    // Runs of blankspace, comment text and identifier characters that are longer than the vector
+    // width used by the lexer's ASCII fast paths.
+    Source::File file("", R"(/* a block comment with a long run of text, a '/', a '*' and a
+nested /* comment */ spread over more than one line of text ******* ///// */
+                                            an_identifier_that_is_longer_than_thirty_two_bytes
+// a line comment with a long run of text after the start of the comment
+)");
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(2u, list.size());
+
+    {
+        auto& t = list[0];
+        EXPECT_TRUE(t.IsIdentifier());
+        EXPECT_EQ(t.source().range.begin.line, 3u);
+        EXPECT_EQ(t.source().range.begin.column, 45u);
+        EXPECT_EQ(t.source().range.end.line, 3u);
+        EXPECT_EQ(t.source().range.end.column, 95u);
+        EXPECT_EQ(t.to_str(), "an_identifier_that_is_longer_than_thirty_two_bytes");
+    }
+
+    {
+        auto& t = list[1];
+        EXPECT_TRUE(t.IsEof());
+    }
+}
+
 TEST_F(LexerTest, Skips_Comments_Block_Unterminated) {
     // I had to break up the /* because otherwise the clang readability check
     // errored out saying it could not find the end of a multi-line comment.
@@ -696,6 +737,14 @@ INSTANTIATE_TEST_SUITE_P(
                     "\xf0\x9d\x96\x99\xf0\x9d\x96\x8e\xf0\x9d\x96\x8b\xf0\x9d\x96\x8e"
                     "\xf0\x9d\x96\x8a\xf0\x9d\x96\x97\x31\x32\x33",
                     43},
+        UnicodeCase{// "abcédef"
+                    "abc\xc3\xa9"
+                    "def",
+                    8},
+        UnicodeCase{// "a_long_ascii_prefix_before_the_unicode_éa_long_ascii_suffix_after_it"
+                    "a_long_ascii_prefix_before_the_unicode_\xc3\xa9"
+                    "a_long_ascii_suffix_after_it",
+                    69},
     }));
 
 using InvalidUnicodeIdentifierTest = testing::TestWithParam<const char*>;
@@ -27,6 +27,7 @@
 
 #include "src/tint/lang/wgsl/reader/parser/parser.h"
 
+#include <algorithm>
 #include <limits>
 #include <utility>
 
@@ -270,6 +271,8 @@ void Parser::deprecated(const Source& source, std::string_view msg) {
 }
 
 const Token& Parser::next() {
+    fill_tokens(next_token_idx_);
+
     // If the next token is already an error or the end of file, stay there.
     if (tokens_[next_token_idx_].IsEof() || tokens_[next_token_idx_].IsError()) {
         return tokens_[next_token_idx_];
@@ -281,6 +284,7 @@ const Token& Parser::next() {
             break;
         }
         next_token_idx_++;
+        fill_tokens(next_token_idx_);
     }
     last_source_idx_ = next_token_idx_;
 
@@ -291,7 +295,7 @@ const Token& Parser::next() {
 }
 
 const Token& Parser::peek(size_t count) {
-    for (size_t idx = next_token_idx_; idx < tokens_.size(); idx++) {
+    for (size_t idx = next_token_idx_; fill_tokens(idx); idx++) {
         if (tokens_[idx].IsPlaceholder()) {
             continue;
         }
@@ -301,7 +305,7 @@ const Token& Parser::peek(size_t count) {
         count--;
     }
     // Walked off the end of the token list, return last token.
-    return tokens_[tokens_.size() - 1];
+    return tokens_.Back();
 }
 
 bool Parser::peek_is(Token::Type tok, size_t idx) {
@@ -312,7 +316,7 @@ void Parser::split_token(Token::Type lhs, Token::Type rhs) {
     if (TINT_UNLIKELY(next_token_idx_ == 0)) {
         TINT_ICE() << "attempt to update placeholder at beginning of tokens";
     }
-    if (TINT_UNLIKELY(next_token_idx_ >= tokens_.size())) {
+    if (TINT_UNLIKELY(!fill_tokens(next_token_idx_))) {
         TINT_ICE() << "attempt to update placeholder past end of tokens";
     }
     if (TINT_UNLIKELY(!tokens_[next_token_idx_].IsPlaceholder())) {
@@ -327,9 +331,59 @@ Source Parser::last_source() const {
 }
 
 void Parser::InitializeLex() {
-    Lexer l{file_};
-    tokens_ = l.Lex();
-    ClassifyTemplateArguments(tokens_);
+    lexer_.emplace(file_);
+    template_args_ = {};
+    tokens_.Clear();
+    num_released_tokens_ = 0;
+    num_classified_tokens_ = 0;
+    num_ready_tokens_ = 0;
+    lexed_all_tokens_ = false;
+    next_token_idx_ = 0;
+    last_source_idx_ = 0;
+
+    // Ensure there is always a token for last_source().
+    fill_tokens(0);
+}
+
+bool Parser::lex_tokens(size_t idx) {
+    while (idx >= num_ready_tokens_ && !lexed_all_tokens_) {
+        auto& token = tokens_.Push(lexer_->Next());
+        if (token.IsEof() || token.IsError()) {
+            lexed_all_tokens_ = true;
+        }
+
+        // Classify every token that is followed by another token.
+        while (num_classified_tokens_ + 1 < tokens_.Length()) {
+            size_t i = num_classified_tokens_;
+            num_classified_tokens_ +=
+                template_args_.Classify(tokens_[i], tokens_[i + 1], num_released_tokens_ + i);
+        }
+
+        if (lexed_all_tokens_) {
+            // Any '<' still pending will never be closed.
+            num_ready_tokens_ = tokens_.Length();
+        } else if (auto pending = template_args_.FirstPendingIndex()) {
+            // Tokens from the pending '<' onwards may still be modified by the classifier.
+            num_ready_tokens_ = std::min(num_classified_tokens_, *pending - num_released_tokens_);
+        } else {
+            num_ready_tokens_ = num_classified_tokens_;
+        }
+    }
+    return idx < tokens_.Length();
+}
+
+void Parser::release_tokens() {
+    // Keep the last token returned by next(), as it is used by last_source().
+    size_t count = last_source_idx_;
+    if (count == 0) {
+        return;
+    }
+    tokens_.PopFront(count);
+    num_released_tokens_ += count;
+    num_classified_tokens_ -= count;
+    num_ready_tokens_ -= count;
+    next_token_idx_ -= count;
+    last_source_idx_ = 0;
 }
 
 bool Parser::Parse() {
@@ -343,10 +397,15 @@ bool Parser::Parse() {
 void Parser::translation_unit() {
     bool after_global_decl = false;
     while (continue_parsing()) {
+        // Nothing before the next declaration is referenced again, so the tokens can be released.
+        release_tokens();
+
+        // Note: parsing the declaration may release `p`, so copy the source here.
         auto& p = peek();
         if (p.IsEof()) {
             break;
         }
+        const Source source = p.source();
 
         auto ed = global_directive(after_global_decl);
         if (!ed.matched && !ed.errored) {
@@ -356,12 +415,12 @@ void Parser::translation_unit() {
             }
 
             if (!gd.matched && !gd.errored) {
-                AddError(p, "unexpected token");
+                AddError(source, "unexpected token");
             }
         }
 
         if (builder_.Diagnostics().NumErrors() >= max_errors_) {
-            AddError(Source{{}, p.source().file},
+            AddError(Source{{}, source.file},
                      "stopping after " + std::to_string(max_errors_) + " errors");
             break;
         }
@@ -639,14 +698,20 @@ Maybe<Void> Parser::global_decl() {
         return AddError(next(), "expected declaration after attributes");
     }
 
+    // The token might itself be an error.
+    if (handle_error(peek())) {
+        return Failure::kErrored;
+    }
+
     // We have a statement outside of a function?
-    auto& t = peek();
+    // Note: parsing the statement may release the tokens before it, so copy the source here.
+    const Source source = peek().source();
     auto stat = without_diag([&] { return statement(); });
     if (stat.matched) {
         // Attempt to jump to the next '}' - the function might have just been
         // missing an opening line.
         sync_to(Token::Type::kBraceRight, true);
-        return AddError(t, "statement found outside of function body");
+        return AddError(source, "statement found outside of function body");
     }
     if (!stat.errored) {
         // No match, no error - the parser might not have progressed.
@@ -654,11 +719,6 @@ Maybe<Void> Parser::global_decl() {
         next();
     }
 
-    // The token might itself be an error.
-    if (handle_error(t)) {
-        return Failure::kErrored;
-    }
-
     // Exhausted all attempts to make sense of where we're at.
     // Return a no-match
 
@@ -1255,6 +1315,9 @@ Expect<Parser::StatementList> Parser::expect_statements() {
     StatementList stmts;
 
     while (continue_parsing()) {
+        // Statements do not reference the tokens of earlier statements, so they can be released.
+        release_tokens();
+
         auto stmt = statement();
         if (stmt.errored) {
             errored = true;
@@ -1699,6 +1762,8 @@ Maybe<const ast::CaseStatement*> Parser::switch_body() {
     }
 
     auto& t = next();
+    // Note: parsing the case body may release `t`, so copy the source here.
+    const Source source = t.source();
 
     CaseSelectorList selector_list;
     if (t.Is(Token::Type::kCase)) {
@@ -1710,7 +1775,7 @@ Maybe<const ast::CaseStatement*> Parser::switch_body() {
         selector_list = std::move(selectors.value);
     } else {
         // Push the default case selector
-        selector_list.Push(create<ast::CaseSelector>(t.source()));
+        selector_list.Push(create<ast::CaseSelector>(source));
     }
 
     // Consume the optional colon if present.
@@ -1722,7 +1787,7 @@ Maybe<const ast::CaseStatement*> Parser::switch_body() {
         return Failure::kErrored;
     }
 
-    return create<ast::CaseStatement>(t.source(), selector_list, body.value);
+    return create<ast::CaseStatement>(source, selector_list, body.value);
 }
 
 // case_selectors
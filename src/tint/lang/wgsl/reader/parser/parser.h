@@ -29,6 +29,7 @@
 #define SRC_TINT_LANG_WGSL_READER_PARSER_PARSER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -37,8 +38,11 @@
 
 #include "src/tint/lang/core/access.h"
 #include "src/tint/lang/wgsl/program/program_builder.h"
+#include "src/tint/lang/wgsl/reader/parser/classify_template_args.h"
 #include "src/tint/lang/wgsl/reader/parser/detail.h"
+#include "src/tint/lang/wgsl/reader/parser/lexer.h"
 #include "src/tint/lang/wgsl/reader/parser/token.h"
+#include "src/tint/lang/wgsl/reader/parser/token_queue.h"
 #include "src/tint/lang/wgsl/resolver/resolve.h"
 #include "src/tint/utils/diagnostic/formatter.h"
 #include "src/tint/utils/text/styled_text.h"
@@ -306,8 +310,8 @@ class Parser {
     explicit Parser(Source::File const* file);
     ~Parser();
 
-    /// Reads tokens from the source file. This will be called automatically
-    /// by |parse|.
+    /// Prepares the lexer for reading tokens from the source file. Tokens are then lexed on demand,
+    /// as the parser looks ahead. This will be called automatically by |parse|.
     void InitializeLex();
 
     /// Run the parser
@@ -842,6 +846,21 @@ class Parser {
     /// @returns true if `t` is an error, otherwise false.
     bool handle_error(const Token& t);
 
+    /// Lexes tokens until the token at `idx` in #tokens_ can be handed to the parser, or the end of
+    /// the input has been reached.
+    /// @param idx the index of the token in #tokens_
+    /// @returns true if the token at `idx` is available, false if `idx` is past the end of file
+    bool fill_tokens(size_t idx) { return idx < num_ready_tokens_ || lex_tokens(idx); }
+
+    /// Lexes and classifies tokens until the token at `idx` in #tokens_ is ready.
+    /// @param idx the index of the token in #tokens_
+    /// @returns true if the token at `idx` is available, false if `idx` is past the end of file
+    bool lex_tokens(size_t idx);
+
+    /// Releases the tokens that precede the last token returned by next(). Must only be called
+    /// where the parser holds no references to these tokens.
+    void release_tokens();
+
     /// @returns true if #synchronized_ is true and the number of reported errors
     /// is less than #max_errors_.
     bool continue_parsing() {
@@ -911,7 +930,21 @@ class Parser {
     }
 
     Source::File const* const file_;
-    std::vector<Token> tokens_;
+    /// The lexer, which produces tokens as the parser requests them
+    std::optional<Lexer> lexer_;
+    /// Classifies template argument tokens as they are lexed
+    TemplateArgClassifier template_args_;
+    /// The window of lexed tokens
+    TokenQueue tokens_;
+    /// The number of tokens released from the front of #tokens_
+    size_t num_released_tokens_ = 0;
+    /// The number of tokens at the front of #tokens_ that have been passed to #template_args_
+    size_t num_classified_tokens_ = 0;
+    /// The number of tokens at the front of #tokens_ that have been fully classified, and so can be
+    /// handed to the parser
+    size_t num_ready_tokens_ = 0;
+    /// True once the lexer has produced an end of file or error token
+    bool lexed_all_tokens_ = false;
     size_t next_token_idx_ = 0;
     size_t last_source_idx_ = 0;
     bool synchronized_ = true;
@@ -25,6 +25,8 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <string>
+
 #include "src/tint/lang/wgsl/reader/parser/helper_test.h"
 
 namespace tint::wgsl::reader {
@@ -69,6 +71,24 @@ fn foo() -> S {
     ASSERT_EQ(1u, program.AST().TypeDecls().Length());
 }
 
+TEST_F(WGSLParserTest, Parses_ManyStatements) {
+    // Tokens are released between statements, so build a function body that is much larger than
+    // the parser's token lookahead.
+    std::string wgsl = "fn f() -> i32 {\n  var a : array<vec2<i32>, 4>;\n";
+    for (size_t i = 0; i < 1000; i++) {
+        wgsl += "  a[" + std::to_string(i % 4) + "] = vec2<i32>(a[0].x >> 1, a[1].y << 1);\n";
+        wgsl += "  switch (a[0].x) { case 1, 2: { a[1].x--; } default: {} }\n";
+    }
+    wgsl += "  return a[3].x;\n}\n";
+
+    auto p = parser(wgsl);
+    ASSERT_TRUE(p->Parse()) << p->error();
+
+    Program program = p->program();
+    ASSERT_EQ(1u, program.AST().Functions().Length());
+    EXPECT_EQ(2002u, program.AST().Functions()[0]->body->statements.Length());
+}
+
 TEST_F(WGSLParserTest, HandlesError) {
     auto p = parser(R"(
 fn main() ->  {  // missing return type
@@ -184,6 +204,16 @@ TEST_F(WGSLParserTest, Peek_MultiplePlaceholder) {
         << "expected: < got: " << p->peek(2).to_name();
 }
 
+TEST_F(WGSLParserTest, Peek_TemplateList) {
+    auto p = parser("a < b > c; d < e;");
+    EXPECT_TRUE(p->peek_is(Token::Type::kIdentifier));
+    EXPECT_TRUE(p->peek_is(Token::Type::kTemplateArgsLeft, 1));
+    EXPECT_TRUE(p->peek_is(Token::Type::kTemplateArgsRight, 3));
+    EXPECT_TRUE(p->peek_is(Token::Type::kLessThan, 7));
+    EXPECT_TRUE(p->peek_is(Token::Type::kSemicolon, 9));
+    EXPECT_TRUE(p->peek_is(Token::Type::kEOF, 10));
+}
+
 TEST_F(WGSLParserTest, Peek_PastEnd) {
     auto p = parser(">");
     EXPECT_TRUE(p->peek_is(Token::Type::kGreaterThan));
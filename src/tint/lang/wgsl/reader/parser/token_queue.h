@@ -0,0 +1,143 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_LANG_WGSL_READER_PARSER_TOKEN_QUEUE_H_
+#define SRC_TINT_LANG_WGSL_READER_PARSER_TOKEN_QUEUE_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "src/tint/lang/wgsl/reader/parser/token.h"
+
+namespace tint::wgsl::reader {
+
+/// TokenQueue is a first-in, first-out queue of tokens, used as the parser's lookahead window.
+/// Tokens are stored in fixed-size blocks, which are recycled as tokens are popped from the front.
+/// References to a token remain valid until the token is popped.
+class TokenQueue {
+  public:
+    /// Constructor
+    TokenQueue() = default;
+
+    /// Destructor
+    ~TokenQueue() { Clear(); }
+
+    TokenQueue(const TokenQueue&) = delete;
+    TokenQueue& operator=(const TokenQueue&) = delete;
+
+    /// @returns the number of tokens in the queue
+    size_t Length() const { return length_; }
+
+    /// @returns true if the queue holds no tokens
+    bool IsEmpty() const { return length_ == 0; }
+
+    /// @param idx the index of the token, where 0 is the front of the queue
+    /// @returns the token at @p idx
+    Token& operator[](size_t idx) {
+        size_t i = head_ + idx;
+        return blocks_[i / kBlockSize]->Get(i % kBlockSize);
+    }
+
+    /// @param idx the index of the token, where 0 is the front of the queue
+    /// @returns the token at @p idx
+    const Token& operator[](size_t idx) const {
+        size_t i = head_ + idx;
+        return blocks_[i / kBlockSize]->Get(i % kBlockSize);
+    }
+
+    /// @returns the token at the back of the queue
+    Token& Back() { return (*this)[length_ - 1]; }
+
+    /// Appends a token to the back of the queue.
+    /// @param token the token to append
+    /// @returns the appended token
+    Token& Push(Token&& token) {
+        size_t i = head_ + length_;
+        if (i / kBlockSize == blocks_.size()) {
+            blocks_.push_back(spare_ ? std::move(spare_) : std::make_unique<Block>());
+        }
+        auto* slot = blocks_[i / kBlockSize]->Slot(i % kBlockSize);
+        auto* t = new (slot) Token(std::move(token));
+        length_++;
+        return *t;
+    }
+
+    /// Removes tokens from the front of the queue.
+    /// @param count the number of tokens to remove
+    void PopFront(size_t count) {
+        for (size_t n = 0; n < count; n++) {
+            (*this)[0].~Token();
+            length_--;
+            if (++head_ == kBlockSize) {
+                // Keep the emptied block for reuse by Push().
+                spare_ = std::move(blocks_.front());
+                blocks_.erase(blocks_.begin());
+                head_ = 0;
+            }
+        }
+    }
+
+    /// Removes all tokens from the queue.
+    void Clear() { PopFront(length_); }
+
+  private:
+    /// The number of tokens held by each block
+    static constexpr size_t kBlockSize = 64;
+
+    /// Uninitialized storage for kBlockSize tokens
+    struct Block {
+        /// @param i the index of the token in the block
+        /// @returns a pointer to the storage of the token at @p i
+        void* Slot(size_t i) { return &storage[i * sizeof(Token)]; }
+        /// @param i the index of the token in the block
+        /// @returns the token at @p i
+        Token& Get(size_t i) { return *std::launder(reinterpret_cast<Token*>(Slot(i))); }
+        /// @param i the index of the token in the block
+        /// @returns the token at @p i
+        const Token& Get(size_t i) const {
+            return *std::launder(reinterpret_cast<const Token*>(&storage[i * sizeof(Token)]));
+        }
+        /// The token storage
+        alignas(Token) std::byte storage[sizeof(Token) * kBlockSize];
+    };
+
+    /// The blocks of the queue, in order
+    std::vector<std::unique_ptr<Block>> blocks_;
+    /// An emptied block, kept to avoid reallocating blocks as the window moves through the input
+    std::unique_ptr<Block> spare_;
+    /// The index of the front token in the first block
+    size_t head_ = 0;
+    /// The number of tokens in the queue
+    size_t length_ = 0;
+};
+
+}  // namespace tint::wgsl::reader
+
+#endif  // SRC_TINT_LANG_WGSL_READER_PARSER_TOKEN_QUEUE_H_
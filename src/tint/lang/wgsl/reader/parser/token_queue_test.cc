@@ -0,0 +1,104 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/wgsl/reader/parser/token_queue.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace tint::wgsl::reader {
+namespace {
+
+using TokenQueueTest = testing::Test;
+
+Token Ident(size_t i) {
+    return Token(Token::Type::kIdentifier, Source{}, "t" + std::to_string(i));
+}
+
+TEST_F(TokenQueueTest, Empty) {
+    TokenQueue q;
+    EXPECT_TRUE(q.IsEmpty());
+    EXPECT_EQ(q.Length(), 0u);
+}
+
+TEST_F(TokenQueueTest, PushAndIndex) {
+    TokenQueue q;
+    for (size_t i = 0; i < 200; i++) {
+        q.Push(Ident(i));
+        EXPECT_EQ(q.Back().to_str(), "t" + std::to_string(i));
+    }
+    ASSERT_EQ(q.Length(), 200u);
+    for (size_t i = 0; i < 200; i++) {
+        EXPECT_EQ(q[i].to_str(), "t" + std::to_string(i));
+    }
+}
+
+TEST_F(TokenQueueTest, PopFront) {
+    TokenQueue q;
+    for (size_t i = 0; i < 200; i++) {
+        q.Push(Ident(i));
+    }
+    q.PopFront(150);
+    ASSERT_EQ(q.Length(), 50u);
+    for (size_t i = 0; i < 50; i++) {
+        EXPECT_EQ(q[i].to_str(), "t" + std::to_string(150 + i));
+    }
+    q.PopFront(50);
+    EXPECT_TRUE(q.IsEmpty());
+}
+
+TEST_F(TokenQueueTest, ReferencesRemainValid) {
+    TokenQueue q;
+    for (size_t i = 0; i < 1000; i++) {
+        q.Push(Ident(i));
+        if (i % 3 == 2) {
+            q.PopFront(1);
+        }
+    }
+    Token& front = q[0];
+    Token& back = q.Back();
+    for (size_t i = 1000; i < 1100; i++) {
+        q.Push(Ident(i));
+    }
+    EXPECT_EQ(front.to_str(), "t333");
+    EXPECT_EQ(back.to_str(), "t999");
+}
+
+TEST_F(TokenQueueTest, Clear) {
+    TokenQueue q;
+    for (size_t i = 0; i < 100; i++) {
+        q.Push(Ident(i));
+    }
+    q.Clear();
+    EXPECT_TRUE(q.IsEmpty());
+    q.Push(Ident(7));
+    EXPECT_EQ(q[0].to_str(), "t7");
+}
+
+}  // namespace
+}  // namespace tint::wgsl::reader
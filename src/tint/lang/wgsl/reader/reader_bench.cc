@@ -25,6 +25,8 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <cstdint>
+#include <fstream>
 #include <string>
 
 #include "src/tint/cmd/bench/bench.h"
@@ -33,6 +35,140 @@
 namespace tint::wgsl::reader {
 namespace {
 
+/// @returns a synthetic WGSL program with @p num_functions functions, each with a long body of
+/// vector and array arithmetic, resembling the generated kernels of ML inference workloads.
+std::string LargeWGSL(int64_t num_functions) {
+    std::string wgsl = "@group(0) @binding(0) var<storage, read_write> buf : array<vec4<f32>>;\n";
+    for (int64_t f = 0; f < num_functions; f++) {
+        auto fn = "kernel_" + std::to_string(f);
+        wgsl += "fn " + fn + "(i : u32) -> vec4<f32> {\n";
+        wgsl += "  var acc = vec4<f32>();\n";
+        wgsl += "  var w : array<vec4<f32>, 4>;\n";
+        for (int s = 0; s < 32; s++) {
+            auto idx = std::to_string(s % 4);
+            wgsl += "  w[" + idx + "] = buf[(i + " + std::to_string(s) + "u) >> 1u] * " +
+                    std::to_string(s) + ".5f;\n";
+            wgsl += "  acc = fma(w[" + idx + "], vec4<f32>(acc.x), acc); // accumulate\n";
+        }
+        wgsl += "  return acc;\n}\n";
+    }
+    return wgsl;
+}
+
+/// @returns a synthetic WGSL program with @p num_functions functions in the style of hand-written
+/// or machine-translated shaders: each function is preceded by a block comment, statements are
+/// deeply indented, identifiers are long and most lines carry a trailing line comment. The bulk of
+/// the input is blankspace, comments and identifiers rather than punctuation.
+std::string LargeCommentedWGSL(int64_t num_functions) {
+    std::string wgsl = "// Generated from a multi-stage convolution network.\n";
+    wgsl += "@group(0) @binding(0) var<storage, read_write> input_activations : array<f32>;\n";
+    const std::string indent(16, ' ');
+    for (int64_t f = 0; f < num_functions; f++) {
+        auto fn = "convolution_layer_" + std::to_string(f) + "_accumulate_partial_products";
+        wgsl += "/*\n * " + fn + "\n *\n";
+        wgsl += " * Accumulates the partial products of one output channel. The loop below is\n";
+        wgsl += " * fully unrolled by the generator; see the /* nested */ notes per tap.\n";
+        wgsl += " */\n";
+        wgsl += "fn " + fn + "(output_channel_index : u32) -> f32 {\n";
+        wgsl += indent + "var accumulated_partial_product_sum : f32 = 0.0f;\n";
+        for (int s = 0; s < 32; s++) {
+            auto tap = "filter_tap_" + std::to_string(s) + "_weighted_activation";
+            wgsl += indent + "let " + tap + " = input_activations[output_channel_index + " +
+                    std::to_string(s) + "u] * " + std::to_string(s) + ".25f;  // tap " +
+                    std::to_string(s) + " of the 32 tap filter kernel\n";
+            wgsl += indent + "accumulated_partial_product_sum = accumulated_partial_product_sum" +
+                    " + " + tap + ";\n";
+        }
+        wgsl += indent + "return accumulated_partial_product_sum;\n}\n\n";
+    }
+    return wgsl;
+}
+
+/// @returns a synthetic WGSL program with @p num_functions functions, each calling a wide mix of
+/// math builtins on scalars and vectors, in the style of lighting and procedural noise shaders.
+std::string LargeMathWGSL(int64_t num_functions) {
+    std::string wgsl;
+    for (int64_t f = 0; f < num_functions; f++) {
+        auto fn = "shade_" + std::to_string(f);
+        wgsl += "fn " + fn + "(p : vec3<f32>, n : vec3<f32>, t : f32) -> vec4<f32> {\n";
+        wgsl += "  var c = vec3<f32>();\n";
+        for (int s = 0; s < 8; s++) {
+            auto k = std::to_string(s) + ".5f";
+            wgsl += "  let l" + std::to_string(s) + " = normalize(vec3<f32>(sin(t * " + k +
+                    "), cos(t), " + k + ") - p);\n";
+            wgsl += "  let d" + std::to_string(s) + " = max(dot(n, l" + std::to_string(s) +
+                    "), 0.0f);\n";
+            wgsl += "  let h" + std::to_string(s) + " = fract(sin(dot(floor(p * " + k +
+                    "), vec3<f32>(12.9898f, 78.233f, 37.719f))) * 43758.5453f);\n";
+            wgsl += "  c += mix(abs(cross(n, l" + std::to_string(s) + ")), vec3<f32>(h" +
+                    std::to_string(s) + "), smoothstep(0.0f, 1.0f, pow(d" + std::to_string(s) +
+                    ", 16.0f)));\n";
+            wgsl += "  c = clamp(c * inverseSqrt(length(c) + 1.0f), vec3<f32>(0.0f), ";
+            wgsl += "vec3<f32>(exp2(-d" + std::to_string(s) + ")));\n";
+        }
+        wgsl += "  return vec4<f32>(sqrt(c), min(t, 1.0f));\n}\n";
+    }
+    return wgsl;
+}
+
+#if TINT_BUILD_IS_LINUX
+/// Resets the peak resident set size of the process to its current resident set size.
+void ResetPeakRSS() {
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+/// @returns the peak resident set size of the process in bytes, or 0 if it could not be read.
+double PeakRSS() {
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stod(line.substr(6)) * 1024;
+        }
+    }
+    return 0;
+}
+#endif
+
+void ParseLargeWGSL(benchmark::State& state, std::string (*generate)(int64_t)) {
+    Source::File file("large.wgsl", generate(state.range(0)));
+#if TINT_BUILD_IS_LINUX
+    ResetPeakRSS();
+#endif
+    for (auto _ : state) {
+        auto program = Parse(&file);
+        if (program.Diagnostics().ContainsErrors()) {
+            state.SkipWithError(program.Diagnostics().Str());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file.content.data.size()));
+#if TINT_BUILD_IS_LINUX
+    state.counters["PeakRSS"] =
+        benchmark::Counter(PeakRSS(), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+#endif
+}
+
+void LowerLargeWGSL(benchmark::State& state, std::string (*generate)(int64_t)) {
+    Source::File file("large.wgsl", generate(state.range(0)));
+    auto program = Parse(&file);
+    if (program.Diagnostics().ContainsErrors()) {
+        state.SkipWithError(program.Diagnostics().Str());
+        return;
+    }
+#if TINT_BUILD_IS_LINUX
+    ResetPeakRSS();
+#endif
+    for (auto _ : state) {
+        auto ir = ProgramToLoweredIR(program);
+        if (ir != Success) {
+            state.SkipWithError(ir.Failure().reason.Str());
+        }
+    }
+#if TINT_BUILD_IS_LINUX
+    state.counters["PeakRSS"] =
+        benchmark::Counter(PeakRSS(), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+#endif
+}
+
 void ParseWGSL(benchmark::State& state, std::string input_name) {
     auto res = bench::LoadInputFile(input_name);
     if (res != Success) {
@@ -48,6 +184,26 @@ void ParseWGSL(benchmark::State& state, std::string input_name) {
 }
 
 TINT_BENCHMARK_PROGRAMS(ParseWGSL);
+BENCHMARK_CAPTURE(ParseLargeWGSL, Arithmetic, LargeWGSL)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(ParseLargeWGSL, Commented, LargeCommentedWGSL)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(ParseLargeWGSL, Math, LargeMathWGSL)
+    ->Arg(64)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(LowerLargeWGSL, Arithmetic, LargeWGSL)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(4096)
+    ->Unit(benchmark::kMillisecond);
 
 }  // namespace
 }  // namespace tint::wgsl::reader
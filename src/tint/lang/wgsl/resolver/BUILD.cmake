@@ -81,6 +81,7 @@ tint_target_add_dependencies(tint_lang_wgsl_resolver lib
   tint_utils_result
   tint_utils_rtti
   tint_utils_symbol
+  tint_utils_system
   tint_utils_text
   tint_utils_traits
 )
@@ -191,9 +192,60 @@ tint_target_add_external_dependencies(tint_lang_wgsl_resolver_test test
 
 if(TINT_BUILD_WGSL_READER)
   tint_target_add_sources(tint_lang_wgsl_resolver_test test
+    "lang/wgsl/resolver/parallel_test.cc"
     "lang/wgsl/resolver/uniformity_test.cc"
   )
   tint_target_add_dependencies(tint_lang_wgsl_resolver_test test
     tint_lang_wgsl_reader
   )
 endif(TINT_BUILD_WGSL_READER)
+if(TINT_BUILD_WGSL_READER)
+################################################################################
+# Target:    tint_lang_wgsl_resolver_bench
+# Kind:      bench
+# Condition: TINT_BUILD_WGSL_READER
+################################################################################
+tint_add_target(tint_lang_wgsl_resolver_bench bench
+  lang/wgsl/resolver/uniformity_bench.cc
+)
+
+tint_target_add_dependencies(tint_lang_wgsl_resolver_bench bench
+  tint_api_common
+  tint_cmd_bench_bench
+  tint_lang_core
+  tint_lang_core_constant
+  tint_lang_core_ir
+  tint_lang_core_type
+  tint_lang_wgsl
+  tint_lang_wgsl_ast
+  tint_lang_wgsl_common
+  tint_lang_wgsl_features
+  tint_lang_wgsl_program
+  tint_lang_wgsl_resolver
+  tint_lang_wgsl_sem
+  tint_utils_containers
+  tint_utils_diagnostic
+  tint_utils_ice
+  tint_utils_id
+  tint_utils_macros
+  tint_utils_math
+  tint_utils_memory
+  tint_utils_reflection
+  tint_utils_result
+  tint_utils_rtti
+  tint_utils_symbol
+  tint_utils_text
+  tint_utils_traits
+)
+
+tint_target_add_external_dependencies(tint_lang_wgsl_resolver_bench bench
+  "google-benchmark"
+)
+
+if(TINT_BUILD_WGSL_READER)
+  tint_target_add_dependencies(tint_lang_wgsl_resolver_bench bench
+    tint_lang_wgsl_reader
+  )
+endif(TINT_BUILD_WGSL_READER)
+
+endif(TINT_BUILD_WGSL_READER)
\ No newline at end of file
@@ -581,6 +581,9 @@ struct DependencyAnalysis {
         // Traverse the named globals to build the dependency graph
         DetermineDependencies();
 
+        // Record the user-declared functions called by each function
+        GatherCalledFunctions();
+
         // Sort the globals into dependency order
         SortGlobals();
 
@@ -652,6 +655,25 @@ struct DependencyAnalysis {
         }
     }
 
+    /// Populates DependencyGraph::called_functions from the function dependencies of each function.
+    void GatherCalledFunctions() {
+        for (auto* global : declaration_order_) {
+            auto* func = global->node->As<ast::Function>();
+            if (!func) {
+                continue;
+            }
+            Vector<const ast::Function*, 4> callees;
+            for (auto* dep : global->deps) {
+                if (auto* callee = dep->node->As<ast::Function>()) {
+                    callees.Push(callee);
+                }
+            }
+            if (!callees.IsEmpty()) {
+                graph_.called_functions.Add(func, std::move(callees));
+            }
+        }
+    }
+
     /// Performs a depth-first traversal of `root`'s dependencies, calling `enter`
     /// as the function decends into each dependency and `exit` when bubbling back
     /// up towards the root.
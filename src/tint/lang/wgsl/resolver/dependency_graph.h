@@ -222,6 +222,10 @@ struct DependencyGraph {
     /// the same symbol, and X is declared in a sub-scope of the scope that
     /// declares Y.
     Hashmap<const ast::Variable*, const ast::Node*, 16> shadows;
+
+    /// Map of ast::Function to the module-scope functions that it directly calls, in the order of
+    /// first use. Functions that do not call any user-declared function have no entry.
+    Hashmap<const ast::Function*, Vector<const ast::Function*, 4>, 16> called_functions;
 };
 
 }  // namespace tint::resolver
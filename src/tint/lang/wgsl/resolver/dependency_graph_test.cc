@@ -1786,6 +1786,24 @@ TEST_F(ResolverDependencyGraphTraversalTest, InferredType) {
     Build();
 }
 
+TEST_F(ResolverDependencyGraphTraversalTest, CalledFunctions) {
+    // fn a() {}
+    // fn b() { a(); a(); }
+    // fn c() { b(); a(); }
+    auto* a = Func("a", tint::Empty, ty.void_(), tint::Empty);
+    auto* b = Func("b", tint::Empty, ty.void_(), Vector{CallStmt(Call("a")), CallStmt(Call("a"))});
+    auto* c = Func("c", tint::Empty, ty.void_(), Vector{CallStmt(Call("b")), CallStmt(Call("a"))});
+
+    auto graph = Build();
+    EXPECT_FALSE(graph.called_functions.Contains(a));
+    auto b_callees = graph.called_functions.Get(b);
+    ASSERT_TRUE(b_callees);
+    EXPECT_THAT(*b_callees, ElementsAre(a));
+    auto c_callees = graph.called_functions.Get(c);
+    ASSERT_TRUE(c_callees);
+    EXPECT_THAT(*c_callees, ElementsAre(b, a));
+}
+
 // Reproduces an unbalanced stack push / pop bug in
 // DependencyAnalysis::SortGlobals(), found by clusterfuzz.
 // See: crbug.com/chromium/1273451
@@ -0,0 +1,328 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// GEN_BUILD:CONDITION(tint_build_wgsl_reader)
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/tint/lang/wgsl/ast/function.h"
+#include "src/tint/lang/wgsl/ast/identifier.h"
+#include "src/tint/lang/wgsl/ast/identifier_expression.h"
+#include "src/tint/lang/wgsl/ast/module.h"
+#include "src/tint/lang/wgsl/program/program.h"
+#include "src/tint/lang/wgsl/reader/reader.h"
+#include "src/tint/lang/wgsl/sem/call.h"
+#include "src/tint/lang/wgsl/sem/function.h"
+#include "src/tint/lang/wgsl/sem/variable.h"
+#include "src/tint/utils/text/string_stream.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace tint::resolver {
+namespace {
+
+class ResolverParallelTest : public testing::Test {
+  protected:
+    /// Parses and resolves @p src with @p num_threads resolver threads.
+    /// @returns the program
+    Program Parse(const std::string& src, uint32_t num_threads) {
+        wgsl::reader::Options options;
+        options.allowed_features = wgsl::AllowedFeatures::Everything();
+        options.resolver_threads = num_threads;
+        files_.push_back(std::make_unique<Source::File>("test.wgsl", src));
+        return wgsl::reader::Parse(files_.back().get(), options);
+    }
+
+    /// @returns a textual dump of the semantic information of @p program that is built up
+    /// incrementally by the resolver
+    static std::string Dump(const Program& program) {
+        StringStream ss;
+        auto loc = [](const Source& source) {
+            return std::to_string(source.range.begin.line) + ":" +
+                   std::to_string(source.range.begin.column);
+        };
+        auto name = [](const sem::Function* fn) { return fn->Declaration()->name->symbol.Name(); };
+        for (auto* decl : program.AST().Functions()) {
+            auto* fn = program.Sem().Get(decl);
+            ss << "fn " << name(fn) << "\n  call sites:";
+            for (auto* call : fn->CallSites()) {
+                ss << " " << loc(call->Declaration()->source);
+            }
+            ss << "\n  transitively called:";
+            for (auto* callee : fn->TransitivelyCalledFunctions()) {
+                ss << " " << name(callee);
+            }
+            ss << "\n  ancestor entry points:";
+            for (auto* ep : fn->AncestorEntryPoints()) {
+                ss << " " << name(ep);
+            }
+            ss << "\n  referenced globals:";
+            for (auto* global : fn->TransitivelyReferencedGlobals()) {
+                ss << " " << global->Declaration()->name->symbol.Name();
+            }
+            ss << "\n  texture sampler pairs:";
+            for (auto pair : fn->TextureSamplerPairs()) {
+                ss << " (" << (pair.first ? pair.first->Declaration()->name->symbol.Name() : "")
+                   << ", " << (pair.second ? pair.second->Declaration()->name->symbol.Name() : "")
+                   << ")";
+            }
+            ss << "\n";
+        }
+        for (auto* global : program.AST().GlobalVariables()) {
+            auto* var = program.Sem().Get(global);
+            ss << "var " << global->name->symbol.Name() << "\n  users:";
+            for (auto* user : var->Users()) {
+                ss << " " << loc(user->Declaration()->source);
+            }
+            ss << "\n";
+        }
+        ss << "nodes:";
+        for (auto* node : program.SemNodes().Objects()) {
+            if (auto* var = node->As<sem::Variable>(); var && var->Declaration()) {
+                ss << " " << var->Declaration()->name->symbol.Name();
+            }
+            if (auto* expr = node->As<sem::ValueExpression>()) {
+                ss << " " << loc(expr->Declaration()->source) << ":"
+                   << expr->Type()->FriendlyName();
+            }
+        }
+        return ss.str();
+    }
+
+  private:
+    std::vector<std::unique_ptr<Source::File>> files_;
+};
+
+TEST_F(ResolverParallelTest, MatchesSerial) {
+    StringStream src;
+    src << R"(
+struct S {
+  a : i32,
+  b : f32,
+}
+
+@group(0) @binding(0) var<storage, read_write> buf : array<i32>;
+@group(0) @binding(1) var t : texture_2d<f32>;
+@group(0) @binding(2) var smp : sampler;
+
+override o : i32 = 4;
+var<private> p : i32;
+var<workgroup> wg : array<i32, o>;
+
+fn sample(tex : texture_2d<f32>, s : sampler) -> vec4f {
+  return textureSample(tex, s, vec2f());
+}
+
+fn f0(x : i32) -> i32 {
+  var v = S(x, 1.0);
+  p += v.a;
+  return v.a + buf[0] + o;
+}
+)";
+    constexpr int kNumFunctions = 32;
+    for (int i = 1; i < kNumFunctions; i++) {
+        src << "\nfn f" << i << "(x : i32) -> i32 {\n"
+            << "  let y = f" << (i - 1) << "(x) + f" << (i / 3) << "(x + " << i << ");\n"
+            << "  buf[" << i << "] = y;\n"
+            << "  return y * " << i << ";\n"
+            << "}\n";
+    }
+    src << R"(
+@fragment
+fn frag() -> @location(0) vec4f {
+  return sample(t, smp) + vec4f(f32(f7(1)));
+}
+
+@compute @workgroup_size(1)
+fn comp() {
+  wg[0] = f)"
+        << (kNumFunctions - 1) << R"((2) + f3(p);
+}
+)";
+
+    auto serial = Parse(src.str(), 1);
+    ASSERT_TRUE(serial.IsValid()) << serial.Diagnostics();
+    auto expected = Dump(serial);
+
+    for (uint32_t num_threads : {2u, 4u, 8u}) {
+        auto parallel = Parse(src.str(), num_threads);
+        ASSERT_TRUE(parallel.IsValid()) << parallel.Diagnostics();
+        EXPECT_EQ(Dump(parallel), expected) << "num_threads: " << num_threads;
+    }
+}
+
+TEST_F(ResolverParallelTest, TextureSamplerPairsMatchSerial) {
+    StringStream src;
+    src << R"(
+@group(0) @binding(0) var t0 : texture_2d<f32>;
+@group(0) @binding(1) var t1 : texture_2d<f32>;
+@group(0) @binding(2) var s0 : sampler;
+@group(0) @binding(3) var s1 : sampler;
+
+fn sample(t : texture_2d<f32>, s : sampler, unused_t : texture_2d<f32>, unused_s : sampler) -> f32 {
+  return textureSample(t, s, vec2f()).x;
+}
+)";
+    // A caller adds the unused parameters of sample() to the pairs of sample() when it passes a
+    // texture or sampler that is not already paired. f0 adds 'unused_s' before f1 adds 'unused_t',
+    // which the later callers see in that order.
+    constexpr int kNumFunctions = 16;
+    for (int i = 0; i < kNumFunctions; i++) {
+        src << "\nfn f" << i << "() -> f32 {\n"
+            << "  return sample(t0, s0, t" << (i % 3 == 0 ? 0 : 1) << ", s"
+            << (i % 3 == 1 ? 0 : 1) << ");\n"
+            << "}\n";
+    }
+    src << "\n@fragment\nfn frag() -> @location(0) vec4f {\n  return vec4f(";
+    for (int i = 0; i < kNumFunctions; i++) {
+        src << (i ? " + " : "") << "f" << i << "()";
+    }
+    src << ");\n}\n";
+
+    auto serial = Parse(src.str(), 1);
+    ASSERT_TRUE(serial.IsValid()) << serial.Diagnostics();
+    auto expected = Dump(serial);
+
+    for (uint32_t num_threads : {2u, 4u, 8u}) {
+        auto parallel = Parse(src.str(), num_threads);
+        ASSERT_TRUE(parallel.IsValid()) << parallel.Diagnostics();
+        EXPECT_EQ(Dump(parallel), expected) << "num_threads: " << num_threads;
+    }
+}
+
+TEST_F(ResolverParallelTest, BuiltinStructSymbolsAreDeterministic) {
+    StringStream src;
+    constexpr int kNumFunctions = 16;
+    for (int i = 0; i < kNumFunctions; i++) {
+        src << "\nfn f" << i << "(x : vec" << (i % 3 + 2) << "f) -> f32 {\n"
+            << "  return modf(x).whole.x + frexp(x.x + " << i << ").fract;\n"
+            << "}\n";
+    }
+
+    auto symbols = [](const Program& program) {
+        StringStream ss;
+        for (auto* name : {"__modf_result_vec2_f32", "__modf_result_vec3_f32",
+                           "__modf_result_vec4_f32", "__frexp_result_f32", "fract", "whole"}) {
+            ss << name << ":" << program.Symbols().Get(name).value() << " ";
+        }
+        return ss.str();
+    };
+
+    auto first = Parse(src.str(), 4);
+    ASSERT_TRUE(first.IsValid()) << first.Diagnostics();
+    auto expected = symbols(first);
+
+    for (int run = 0; run < 8; run++) {
+        auto parallel = Parse(src.str(), 4);
+        ASSERT_TRUE(parallel.IsValid()) << parallel.Diagnostics();
+        EXPECT_EQ(symbols(parallel), expected) << "run: " << run;
+    }
+}
+
+TEST_F(ResolverParallelTest, DiagnosticsMatchSerial) {
+    auto src = R"(
+@diagnostic(off, chromium.unreachable_code)
+fn a() {
+  return;
+  let x = 1;
+}
+
+fn b() {
+  return;
+  let x = 1;
+}
+
+fn c() {
+  b();
+  return;
+  let y = 2;
+}
+
+fn d() {
+  let z : i32 = 1.5;
+}
+
+fn e() {
+  let z : u32 = 1i;
+}
+
+const bad : i32 = 1.5;
+)";
+
+    auto serial = Parse(src, 1);
+    EXPECT_FALSE(serial.IsValid());
+    EXPECT_EQ(serial.Diagnostics().Str(),
+              R"(test.wgsl:10:3 warning: code is unreachable
+  let x = 1;
+  ^^^^^
+
+test.wgsl:16:3 warning: code is unreachable
+  let y = 2;
+  ^^^^^
+
+test.wgsl:20:17 error: cannot convert value of type 'abstract-float' to type 'i32'
+  let z : i32 = 1.5;
+                ^^^
+)");
+
+    for (uint32_t num_threads : {2u, 4u}) {
+        auto parallel = Parse(src, num_threads);
+        EXPECT_FALSE(parallel.IsValid());
+        EXPECT_EQ(parallel.Diagnostics().Str(), serial.Diagnostics().Str())
+            << "num_threads: " << num_threads;
+    }
+}
+
+TEST_F(ResolverParallelTest, ModuleScopeErrorBeforeFunctionErrors) {
+    auto src = R"(
+fn a() {
+  return;
+  let x = 1;
+}
+
+const bad : i32 = 1.5;
+
+fn b() {
+  let z : i32 = 1.5;
+}
+)";
+
+    auto serial = Parse(src, 1);
+    EXPECT_FALSE(serial.IsValid());
+
+    auto parallel = Parse(src, 4);
+    EXPECT_FALSE(parallel.IsValid());
+    EXPECT_EQ(parallel.Diagnostics().Str(), serial.Diagnostics().Str());
+}
+
+}  // namespace
+}  // namespace tint::resolver
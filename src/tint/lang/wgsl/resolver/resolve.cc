@@ -33,8 +33,10 @@
 
 namespace tint::resolver {
 
-Program Resolve(ProgramBuilder& builder, const wgsl::AllowedFeatures& allowed_features) {
-    Resolver resolver(&builder, std::move(allowed_features));
+Program Resolve(ProgramBuilder& builder,
+                const wgsl::AllowedFeatures& allowed_features,
+                uint32_t num_threads) {
+    Resolver resolver(&builder, std::move(allowed_features), num_threads);
     resolver.Resolve();
     return Program(std::move(builder));
 }
@@ -29,8 +29,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <initializer_list>
 #include <iomanip>
 #include <limits>
+#include <optional>
 #include <string_view>
 #include <utility>
 
@@ -108,6 +110,7 @@
 #include "src/tint/utils/macros/defer.h"
 #include "src/tint/utils/macros/scoped_assignment.h"
 #include "src/tint/utils/math/math.h"
+#include "src/tint/utils/system/thread_pool.h"
 #include "src/tint/utils/text/string.h"
 #include "src/tint/utils/text/string_stream.h"
 #include "src/tint/utils/text/styled_text.h"
@@ -127,19 +130,45 @@ constexpr size_t kMaxNestDepthOfCompositeType = 255;
 
 }  // namespace
 
-Resolver::Resolver(ProgramBuilder* builder, const wgsl::AllowedFeatures& allowed_features)
+Resolver::Resolver(ProgramBuilder* builder,
+                   const wgsl::AllowedFeatures& allowed_features,
+                   uint32_t num_threads)
     : b(*builder),
       diagnostics_(builder->Diagnostics()),
       const_eval_(builder->constants, diagnostics_),
       intrinsic_table_{builder->Types(), builder->Symbols()},
-      sem_(builder),
+      sem_(builder, diagnostics_),
       validator_(builder,
+                 diagnostics_,
                  sem_,
                  enabled_extensions_,
                  allowed_features_,
                  atomic_composite_info_,
                  valid_type_storage_layouts_),
-      allowed_features_(allowed_features) {}
+      allowed_features_(allowed_features),
+      num_threads_(num_threads) {}
+
+Resolver::Resolver(Resolver& parent, diag::List& diagnostics)
+    : b(parent.b),
+      diagnostics_(diagnostics),
+      const_eval_(parent.b.constants, diagnostics_),
+      intrinsic_table_{parent.b.Types(), parent.b.Symbols()},
+      sem_(&parent.b, diagnostics_),
+      validator_(&parent.b,
+                 diagnostics_,
+                 sem_,
+                 enabled_extensions_,
+                 allowed_features_,
+                 atomic_composite_info_,
+                 valid_type_storage_layouts_),
+      allowed_features_(parent.allowed_features_),
+      enabled_extensions_(parent.enabled_extensions_),
+      atomic_composite_info_(parent.atomic_composite_info_),
+      valid_type_storage_layouts_(parent.valid_type_storage_layouts_),
+      nest_depth_(parent.nest_depth_),
+      parent_(&parent) {
+    marked_.Resize(parent.marked_.Length());
+}
 
 Resolver::~Resolver() = default;
 
@@ -188,9 +217,29 @@ bool Resolver::Resolve() {
 bool Resolver::ResolveInternal() {
     Mark(&b.AST());
 
+    // When resolving in parallel, Function() only resolves the function header, and the bodies are
+    // resolved by ResolveFunctionBodies() once all the module-scope declarations are resolved.
+    // Each function is given its own segment of semantic nodes, which its body is added to.
+    const bool parallel = num_threads_ > 1;
+    std::optional<ProgramBuilder::SemNodeAllocatorScope> segment_scope;
+    auto begin_segment = [&] {
+        segments_.Push(std::make_unique<Segment>());
+        segment_ = segments_.Back().get();
+        segment_scope.reset();
+        segment_scope.emplace(b, segment_->sem_nodes);
+    };
+
     // Process all module-scope declarations in dependency order.
     Vector<const ast::DiagnosticControl*, 4> diagnostic_controls;
+    bool ok = true;
+    bool new_segment = parallel;
     for (auto* decl : dependencies_.ordered_globals) {
+        const bool is_function = decl->Is<ast::Function>();
+        if (parallel && (new_segment || is_function)) {
+            begin_segment();
+        }
+        new_segment = is_function;
+
         Mark(decl);
         if (!Switch<bool>(
                 decl,  //
@@ -205,10 +254,23 @@ bool Resolver::ResolveInternal() {
                 [&](const ast::Variable* var) { return GlobalVariable(var); },
                 [&](const ast::ConstAssert* ca) { return ConstAssert(ca); },  //
                 TINT_ICE_ON_NO_MATCH)) {
-            return false;
+            ok = false;
+            break;
         }
     }
 
+    if (parallel) {
+        segment_scope.reset();
+        segment_ = nullptr;
+        if (!ResolveFunctionBodies()) {
+            ok = false;
+        }
+    }
+
+    if (!ok) {
+        return false;
+    }
+
     if (!AllocateOverridableConstantIds()) {
         return false;
     }
@@ -241,6 +303,183 @@ bool Resolver::ResolveInternal() {
     return result;
 }
 
+bool Resolver::ResolveFunctionBodies() {
+    // Assign each function to a wave. Functions are resolved after the functions that they call,
+    // as the caller's semantic information is derived from that of the callee.
+    Hashmap<const ast::Function*, uint32_t, 32> function_waves;
+    uint32_t num_waves = 0;
+    for (auto& pf : parallel_functions_) {
+        auto* decl = pf->func->Declaration();
+        if (auto callees = dependencies_.called_functions.Get(decl)) {
+            for (auto* callee : *callees) {
+                if (auto callee_wave = function_waves.Get(callee)) {
+                    pf->wave = std::max(pf->wave, *callee_wave + 1);
+                }
+            }
+        }
+        function_waves.Add(decl, pf->wave);
+        num_waves = std::max(num_waves, pf->wave + 1);
+    }
+
+    // Builtin structures register their symbols when they are first used, so register the symbols
+    // up front to number them the same way regardless of the order the bodies are resolved in.
+    RegisterBuiltinStructSymbols();
+
+    // Enable the locks of the state that is shared between the threads.
+    b.Types().SetThreadSafe(true);
+    b.constants.SetThreadSafe(true);
+    b.Symbols().SetThreadSafe(true);
+    call_targets_mutex_.SetEnabled(true);
+
+    // Each thread of the pool resolves function bodies with its own resolver.
+    struct Worker {
+        explicit Worker(Resolver& parent) : resolver(parent, diagnostics) {}
+        diag::List diagnostics;
+        Resolver resolver;
+    };
+    ThreadPool pool(std::min<size_t>(num_threads_, parallel_functions_.Length()));
+    Vector<std::unique_ptr<Worker>, 8> workers;
+    for (size_t i = 0; i < pool.NumThreads(); i++) {
+        workers.Push(std::make_unique<Worker>(*this));
+    }
+
+    // The index of the first function whose body failed to resolve. Functions declared after it
+    // would not have been resolved by a serial resolve, so they are skipped.
+    size_t num_functions = parallel_functions_.Length();
+    for (uint32_t wave = 0; wave < num_waves; wave++) {
+        Vector<ParallelFunction*, 32> functions;
+        for (size_t i = 0; i < num_functions; i++) {
+            if (parallel_functions_[i]->wave == wave) {
+                functions.Push(parallel_functions_[i].get());
+            }
+        }
+        pool.ParallelFor(functions.Length(), [&](size_t index, size_t thread) {
+            workers[thread]->resolver.ResolveFunctionBody(*functions[index]);
+        });
+        for (auto* pf : functions) {
+            alias_analysis_infos_[pf->func] = std::move(pf->alias_analysis);
+        }
+        for (size_t i = 0; i < num_functions; i++) {
+            auto& pf = parallel_functions_[i];
+            if (pf->wave == wave && !pf->ok) {
+                num_functions = i;
+                break;
+            }
+        }
+    }
+
+    for (auto& worker : workers) {
+        marked_ |= worker->resolver.marked_;
+    }
+    workers.Clear();
+
+    b.Types().SetThreadSafe(false);
+    b.constants.SetThreadSafe(false);
+    b.Symbols().SetThreadSafe(false);
+    call_targets_mutex_.SetEnabled(false);
+
+    // Apply the deferred updates and gather the semantic nodes in declaration order.
+    for (auto& segment : segments_) {
+        for (auto& update : segment->shared_updates) {
+            update();
+        }
+        b.SemNodes().Append(std::move(segment->sem_nodes));
+    }
+    segments_.Clear();
+
+    // Interleave the diagnostics of the function bodies with those of the module-scope
+    // declarations, dropping any diagnostics that follow the first function body that failed.
+    bool ok = true;
+    diag::List diagnostics;
+    {
+        auto module_diag = diagnostics_.begin();
+        size_t module_diag_index = 0;
+        for (auto& pf : parallel_functions_) {
+            for (; module_diag_index < pf->diagnostics_offset; module_diag_index++, ++module_diag) {
+                diagnostics.Add(*module_diag);
+            }
+            diagnostics.Add(pf->diagnostics);
+            if (!pf->ok) {
+                ok = false;
+                break;
+            }
+        }
+        if (ok) {
+            for (; module_diag != diagnostics_.end(); ++module_diag) {
+                diagnostics.Add(*module_diag);
+            }
+        }
+    }
+    diagnostics_ = std::move(diagnostics);
+    parallel_functions_.Clear();
+
+    return ok;
+}
+
+void Resolver::RegisterBuiltinStructSymbols() {
+    bool modf = false;
+    bool frexp = false;
+    bool atomic_compare_exchange = false;
+    for (auto& it : dependencies_.resolved_identifiers) {
+        auto fn = it.value.BuiltinFn();
+        auto ty = it.value.BuiltinType();
+        modf |= fn == wgsl::BuiltinFn::kModf ||
+                (ty >= core::BuiltinType::kModfResultAbstract &&
+                 ty <= core::BuiltinType::kModfResultVec4F32);
+        frexp |= fn == wgsl::BuiltinFn::kFrexp ||
+                 (ty >= core::BuiltinType::kFrexpResultAbstract &&
+                  ty <= core::BuiltinType::kFrexpResultVec4F32);
+        atomic_compare_exchange |= fn == wgsl::BuiltinFn::kAtomicCompareExchangeWeak ||
+                                   ty == core::BuiltinType::kAtomicCompareExchangeResultI32 ||
+                                   ty == core::BuiltinType::kAtomicCompareExchangeResultU32;
+    }
+    auto register_structs = [&](core::BuiltinType first, core::BuiltinType last,
+                                std::initializer_list<const char*> members) {
+        for (auto i = static_cast<uint32_t>(first); i <= static_cast<uint32_t>(last); i++) {
+            b.Symbols().Register(tint::ToString(static_cast<core::BuiltinType>(i)));
+        }
+        for (auto* member : members) {
+            b.Symbols().Register(member);
+        }
+    };
+    if (modf) {
+        register_structs(core::BuiltinType::kModfResultAbstract,
+                         core::BuiltinType::kModfResultVec4F32, {"fract", "whole"});
+    }
+    if (frexp) {
+        register_structs(core::BuiltinType::kFrexpResultAbstract,
+                         core::BuiltinType::kFrexpResultVec4F32, {"fract", "exp"});
+    }
+    if (atomic_compare_exchange) {
+        register_structs(core::BuiltinType::kAtomicCompareExchangeResultI32,
+                         core::BuiltinType::kAtomicCompareExchangeResultU32,
+                         {"old_value", "exchanged"});
+    }
+}
+
+void Resolver::ResolveFunctionBody(ParallelFunction& pf) {
+    ProgramBuilder::SemNodeAllocatorScope sem_nodes(b, pf.segment->sem_nodes);
+    TINT_SCOPED_ASSIGNMENT(current_function_, pf.func);
+    TINT_SCOPED_ASSIGNMENT(segment_, pf.segment);
+
+    auto* func = pf.func;
+    on_transitively_reference_global_.Push([func](const sem::GlobalVariable* ref) {  //
+        func->AddDirectlyReferencedGlobal(ref);
+    });
+    TINT_DEFER(on_transitively_reference_global_.Pop());
+
+    validator_.DiagnosticFilters() = pf.diagnostic_filters;
+
+    pf.ok = FunctionBody(func);
+
+    pf.diagnostics = std::move(diagnostics_);
+    diagnostics_ = diag::List{};
+    if (auto it = alias_analysis_infos_.find(func); it != alias_analysis_infos_.end()) {
+        pf.alias_analysis = std::move(it->second);
+        alias_analysis_infos_.erase(it);
+    }
+}
+
 sem::Variable* Resolver::Variable(const ast::Variable* v, bool is_global) {
     Mark(v->name);
 
@@ -996,6 +1235,32 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
     validator_.DiagnosticFilters().Push();
     TINT_DEFER(validator_.DiagnosticFilters().Pop());
 
+    if (!FunctionHeader(func)) {
+        return nullptr;
+    }
+
+    if (num_threads_ > 1 && decl->body) {
+        // The body is resolved by ResolveFunctionBodies(), with the diagnostic filters that are
+        // currently in scope.
+        auto pf = std::make_unique<ParallelFunction>();
+        pf->func = func;
+        pf->segment = segment_;
+        pf->diagnostic_filters = validator_.DiagnosticFilters();
+        pf->diagnostics_offset = diagnostics_.Count();
+        parallel_functions_.Push(std::move(pf));
+        return func;
+    }
+
+    if (!FunctionBody(func)) {
+        return nullptr;
+    }
+
+    return func;
+}
+
+bool Resolver::FunctionHeader(sem::Function* func) {
+    auto* decl = func->Declaration();
+
     for (auto* attribute : decl->attributes) {
         Mark(attribute);
         bool ok = Switch(
@@ -1017,11 +1282,11 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
                 return false;
             });
         if (!ok) {
-            return nullptr;
+            return false;
         }
     }
     if (!validator_.NoDuplicateAttributes(decl->attributes)) {
-        return nullptr;
+        return false;
     }
 
     // Resolve all the parameters
@@ -1035,13 +1300,13 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
                 auto name = param->name->symbol.NameView();
                 AddError(param->source) << "redefinition of parameter '" << name << "'";
                 AddNote(added.value) << "previous definition is here";
-                return nullptr;
+                return false;
             }
         }
 
         auto* p = Parameter(param, decl, parameter_index++);
         if (!p) {
-            return nullptr;
+            return false;
         }
 
         func->AddParameter(p);
@@ -1069,7 +1334,7 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
     if (auto ty = decl->return_type) {
         return_type = Type(ty);
         if (!return_type) {
-            return nullptr;
+            return false;
         }
     } else {
         return_type = b.create<core::type::Void>();
@@ -1133,10 +1398,10 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
                 case kSuccess:
                     break;
                 case kErrored:
-                    return nullptr;
+                    return false;
                 case kInvalid:
                     ErrorInvalidAttribute(attribute, StyledText{} << "entry point return types");
-                    return nullptr;
+                    return false;
             }
         }
     } else {
@@ -1150,7 +1415,7 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
                            return false;
                        });
             if (!ok) {
-                return nullptr;
+                return false;
             }
         }
     }
@@ -1159,7 +1424,7 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
         if (!ApplyAddressSpaceUsageToType(core::AddressSpace::kUndefined, str, decl->source)) {
             AddNote(decl->source) << "while instantiating return type for "
                                   << decl->name->symbol.NameView();
-            return nullptr;
+            return false;
         }
 
         switch (decl->PipelineStage()) {
@@ -1183,17 +1448,23 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
         entry_points_.Push(func);
     }
 
+    return true;
+}
+
+bool Resolver::FunctionBody(sem::Function* func) {
+    auto* decl = func->Declaration();
+
     if (decl->body) {
         Mark(decl->body);
         if (TINT_UNLIKELY(current_compound_statement_)) {
             AddICE("Resolver::Function() called with a current compound statement",
                    decl->body->source);
-            return nullptr;
+            return false;
         }
         auto* body = StatementScope(decl->body, b.create<sem::FunctionBlockStatement>(func),
                                     [&] { return Statements(decl->body->statements); });
         if (!body) {
-            return nullptr;
+            return false;
         }
         func->Behaviors() = body->Behaviors();
         if (func->Behaviors().Contains(sem::Behavior::kReturn)) {
@@ -1207,24 +1478,26 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
     }
 
     if (!validator_.NoDuplicateAttributes(decl->return_type_attributes)) {
-        return nullptr;
+        return false;
     }
 
     auto stage = current_function_ ? current_function_->Declaration()->PipelineStage()
                                    : ast::PipelineStage::kNone;
     if (!validator_.Function(func, stage)) {
-        return nullptr;
+        return false;
     }
 
     // If this is an entry point, mark all transitively called functions as being
     // used by this entry point.
     if (decl->IsEntryPoint()) {
-        for (auto* f : func->TransitivelyCalledFunctions()) {
-            const_cast<sem::Function*>(f)->AddAncestorEntryPoint(func);
-        }
+        UpdateShared([func] {
+            for (auto* f : func->TransitivelyCalledFunctions()) {
+                const_cast<sem::Function*>(f)->AddAncestorEntryPoint(func);
+            }
+        });
     }
 
-    return func;
+    return true;
 }
 
 bool Resolver::Statements(VectorRef<const ast::Statement*> stmts) {
@@ -1629,9 +1902,11 @@ core::type::Type* Resolver::Type(const ast::Expression* ast) {
     }
 
     if (auto* arr = type->As<sem::Array>()) {
-        for (auto* ref : referenced_overrides) {
-            arr->AddTransitivelyReferencedOverride(ref);
-        }
+        UpdateSharedType([arr, refs = std::move(referenced_overrides)] {
+            for (auto* ref : refs) {
+                arr->AddTransitivelyReferencedOverride(ref);
+            }
+        });
     }
 
     return type;
@@ -1736,7 +2011,7 @@ bool Resolver::AliasAnalysis(const sem::Call* call) {
     };
 
     auto& args = call->Arguments();
-    auto& target_info = alias_analysis_infos_[target];
+    auto& target_info = AliasAnalysisOf(target);
     auto& caller_info = alias_analysis_infos_[current_function_];
 
     // Track the set of root identifiers that are read and written by arguments passed in this
@@ -1806,6 +2081,17 @@ bool Resolver::AliasAnalysis(const sem::Call* call) {
     return true;
 }
 
+const Resolver::AliasAnalysisInfo& Resolver::AliasAnalysisOf(const sem::Function* func) {
+    if (parent_) {
+        // The alias analysis of functions resolved by earlier waves is held by the parent.
+        auto it = parent_->alias_analysis_infos_.find(func);
+        if (it != parent_->alias_analysis_infos_.end()) {
+            return it->second;
+        }
+    }
+    return alias_analysis_infos_[func];
+}
+
 const core::type::Type* Resolver::ConcreteType(const core::type::Type* ty,
                                                const core::type::Type* target_ty,
                                                const Source& source) {
@@ -2110,7 +2396,9 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
         // Is this overload a constructor or conversion?
         if (match->info->flags.Contains(OverloadFlag::kIsConstructor)) {
             // Type constructor
-            target_sem = constructors_.GetOrAdd(match.Get(), [&] {
+            auto& shared = Shared();
+            auto lock = shared.call_targets_mutex_.Lock();
+            target_sem = shared.constructors_.GetOrAdd(match.Get(), [&] {
                 auto params = Transform(match->parameters, [&](auto& p, size_t i) {
                     return b.create<sem::Parameter>(nullptr, static_cast<uint32_t>(i), p.type,
                                                     p.usage);
@@ -2120,7 +2408,9 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
             });
         } else {
             // Type conversion
-            target_sem = converters_.GetOrAdd(match.Get(), [&] {
+            auto& shared = Shared();
+            auto lock = shared.call_targets_mutex_.Lock();
+            target_sem = shared.converters_.GetOrAdd(match.Get(), [&] {
                 auto* param = b.create<sem::Parameter>(nullptr, 0u, match->parameters[0].type,
                                                        match->parameters[0].usage);
                 return b.create<sem::ValueConversion>(match->return_type, param, overload_stage);
@@ -2210,16 +2500,22 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
                                     Vector{m->type()});
             },
             [&](const sem::Array* arr) -> sem::Call* {
-                auto* call_target = array_ctors_.GetOrAdd(
-                    ArrayConstructorSig{{arr, args.Length(), args_stage}},
-                    [&]() -> sem::ValueConstructor* {
-                        auto params = tint::Transform(args, [&](auto, size_t i) {
-                            return b.create<sem::Parameter>(nullptr,  // declaration
-                                                            static_cast<uint32_t>(i),  // index
-                                                            arr->ElemType());
+                sem::CallTarget* call_target = nullptr;
+                {
+                    auto& shared = Shared();
+                    auto lock = shared.call_targets_mutex_.Lock();
+                    call_target = shared.array_ctors_.GetOrAdd(
+                        ArrayConstructorSig{{arr, args.Length(), args_stage}},
+                        [&]() -> sem::ValueConstructor* {
+                            auto params = tint::Transform(args, [&](auto, size_t i) {
+                                return b.create<sem::Parameter>(nullptr,  // declaration
+                                                                static_cast<uint32_t>(i),  // index
+                                                                arr->ElemType());
+                            });
+                            return b.create<sem::ValueConstructor>(arr, std::move(params),
+                                                                   args_stage);
                         });
-                        return b.create<sem::ValueConstructor>(arr, std::move(params), args_stage);
-                    });
+                }
 
                 if (TINT_UNLIKELY(!MaybeMaterializeAndLoadArguments(args, call_target))) {
                     return nullptr;
@@ -2232,19 +2528,25 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
                 return arr_or_str_init(arr, call_target);
             },
             [&](const core::type::Struct* str) -> sem::Call* {
-                auto* call_target = struct_ctors_.GetOrAdd(
-                    StructConstructorSig{{str, args.Length(), args_stage}},
-                    [&]() -> sem::ValueConstructor* {
-                        Vector<sem::Parameter*, 8> params;
-                        params.Resize(std::min(args.Length(), str->Members().Length()));
-                        for (size_t i = 0, n = params.Length(); i < n; i++) {
-                            params[i] =
-                                b.create<sem::Parameter>(nullptr,                     // declaration
-                                                         static_cast<uint32_t>(i),    // index
-                                                         str->Members()[i]->Type());  // type
-                        }
-                        return b.create<sem::ValueConstructor>(str, std::move(params), args_stage);
-                    });
+                sem::CallTarget* call_target = nullptr;
+                {
+                    auto& shared = Shared();
+                    auto lock = shared.call_targets_mutex_.Lock();
+                    call_target = shared.struct_ctors_.GetOrAdd(
+                        StructConstructorSig{{str, args.Length(), args_stage}},
+                        [&]() -> sem::ValueConstructor* {
+                            Vector<sem::Parameter*, 8> params;
+                            params.Resize(std::min(args.Length(), str->Members().Length()));
+                            for (size_t i = 0, n = params.Length(); i < n; i++) {
+                                params[i] = b.create<sem::Parameter>(
+                                    nullptr,                     // declaration
+                                    static_cast<uint32_t>(i),    // index
+                                    str->Members()[i]->Type());  // type
+                            }
+                            return b.create<sem::ValueConstructor>(str, std::move(params),
+                                                                   args_stage);
+                        });
+                }
 
                 if (TINT_UNLIKELY(!MaybeMaterializeAndLoadArguments(args, call_target))) {
                     return nullptr;
@@ -2385,8 +2687,7 @@ sem::Call* Resolver::BuiltinCall(const ast::CallExpression* expr,
         return nullptr;
     }
 
-    // De-duplicate builtins that are identical.
-    auto* target = builtins_.GetOrAdd(std::make_pair(overload.Get(), fn), [&] {
+    auto create_builtin = [&] {
         auto params = Transform(overload->parameters, [&](auto& p, size_t i) {
             return b.create<sem::Parameter>(nullptr, static_cast<uint32_t>(i), p.type, p.usage);
         });
@@ -2405,7 +2706,15 @@ sem::Call* Resolver::BuiltinCall(const ast::CallExpression* expr,
                                                   : core::EvaluationStage::kRuntime;
         return b.create<sem::BuiltinFn>(fn, overload->return_type, std::move(params), eval_stage,
                                         supported_stages, *overload->info);
-    });
+    };
+
+    // De-duplicate builtins that are identical.
+    sem::BuiltinFn* target = nullptr;
+    {
+        auto& shared = Shared();
+        auto lock = shared.call_targets_mutex_.Lock();
+        target = shared.builtins_.GetOrAdd(std::make_pair(overload.Get(), fn), create_builtin);
+    }
 
     if (fn == wgsl::BuiltinFn::kTintMaterialize) {
         args[0] = Materialize(args[0]);
@@ -2462,7 +2771,13 @@ sem::Call* Resolver::BuiltinCall(const ast::CallExpression* expr,
         if (!validator_.TextureBuiltinFn(call)) {
             return nullptr;
         }
-        CollectTextureSamplerPairs(target, call->Arguments());
+        if (current_function_) {
+            // The pairs are deferred so that they are added in the same order as a serial resolve.
+            auto& shared = Shared();
+            UpdateShared([&shared, caller = current_function_, target, call] {
+                shared.CollectTextureSamplerPairs(caller, target, call->Arguments());
+            });
+        }
     }
 
     switch (fn) {
@@ -3052,7 +3367,8 @@ size_t Resolver::NestDepth(const core::type::Type* ty) const {
         });
 }
 
-void Resolver::CollectTextureSamplerPairs(const sem::BuiltinFn* builtin,
+void Resolver::CollectTextureSamplerPairs(sem::Function* caller,
+                                          const sem::BuiltinFn* builtin,
                                           VectorRef<const sem::ValueExpression*> args) const {
     // Collect a texture/sampler pair for this builtin.
     const auto& signature = builtin->Signature();
@@ -3072,7 +3388,7 @@ void Resolver::CollectTextureSamplerPairs(const sem::BuiltinFn* builtin,
                                                      ->As<sem::VariableUser>()
                                                      ->Variable()
                                                : nullptr;
-            current_function_->AddTextureSamplerPair(texture, sampler);
+            caller->AddTextureSamplerPair(texture, sampler);
         }
     }
 }
@@ -3092,7 +3408,7 @@ sem::Call* Resolver::FunctionCall(const ast::CallExpression* expr,
                                      current_statement_,
                                      /* constant_value */ nullptr, has_side_effects);
 
-    target->AddCallSite(call);
+    UpdateShared([target, call] { target->AddCallSite(call); });
 
     call->Behaviors() = arg_behaviors + target->Behaviors();
 
@@ -3120,13 +3436,19 @@ sem::Call* Resolver::FunctionCall(const ast::CallExpression* expr,
         }
 
         // Note: Validation *must* be performed before calling this method.
-        CollectTextureSamplerPairs(target, call->Arguments());
+        // The pairs of the callee are only complete once the updates of the functions resolved
+        // before this one have been applied, so the collection is deferred when in parallel.
+        auto& shared = Shared();
+        UpdateShared([&shared, caller = current_function_, target, call] {
+            shared.CollectTextureSamplerPairs(caller, target, call->Arguments());
+        });
     }
 
     return call;
 }
 
-void Resolver::CollectTextureSamplerPairs(sem::Function* func,
+void Resolver::CollectTextureSamplerPairs(sem::Function* caller,
+                                          sem::Function* func,
                                           VectorRef<const sem::ValueExpression*> args) const {
     // Map all texture/sampler pairs from the target function to the
     // current function. These can only be global or parameter
@@ -3148,7 +3470,7 @@ void Resolver::CollectTextureSamplerPairs(sem::Function* func,
             sampler = args[param->Index()]->UnwrapLoad()->As<sem::VariableUser>()->Variable();
             texture_sampler_set.Add(sampler);
         }
-        current_function_->AddTextureSamplerPair(texture, sampler);
+        caller->AddTextureSamplerPair(texture, sampler);
     }
 
     // Add any possible texture/sampler not essentially passed to builtins from the function param.
@@ -3162,16 +3484,16 @@ void Resolver::CollectTextureSamplerPairs(sem::Function* func,
             auto* user = args[i]->UnwrapLoad()->As<sem::VariableUser>();
             auto* texture = user->Variable();
             if (!texture_sampler_set.Contains(texture)) {
-                current_function_->AddTextureSamplerPair(texture, nullptr);
-                func->AddTextureSamplerPair(param, nullptr);
+                caller->AddTextureSamplerPair(texture, nullptr);
+                UpdateShared([func, param] { func->AddTextureSamplerPair(param, nullptr); });
                 texture_sampler_set.Add(texture);
             }
         } else if (param->Type()->Is<core::type::Sampler>()) {
             auto* user = args[i]->UnwrapLoad()->As<sem::VariableUser>();
             auto* sampler = user->Variable();
             if (!texture_sampler_set.Contains(sampler)) {
-                current_function_->AddTextureSamplerPair(nullptr, sampler);
-                func->AddTextureSamplerPair(nullptr, param);
+                caller->AddTextureSamplerPair(nullptr, sampler);
+                UpdateShared([func, param] { func->AddTextureSamplerPair(nullptr, param); });
                 texture_sampler_set.Add(sampler);
             }
         }
@@ -3253,7 +3575,7 @@ sem::Expression* Resolver::Identifier(const ast::IdentifierExpression* expr) {
     auto* ident = expr->identifier;
     Mark(ident);
 
-    auto resolved = dependencies_.resolved_identifiers.Get(ident);
+    auto resolved = Dependencies().resolved_identifiers.Get(ident);
     if (!resolved) {
         StringStream err;
         err << "identifier '" << ident->symbol.NameView() << "' was not resolved";
@@ -3325,7 +3647,11 @@ sem::Expression* Resolver::Identifier(const ast::IdentifierExpression* expr) {
                     }
                 }
 
-                variable->AddUser(user);
+                if (variable->Is<sem::GlobalVariable>()) {
+                    UpdateShared([variable, user] { variable->AddUser(user); });
+                } else {
+                    variable->AddUser(user);
+                }
                 return user;
             },
             [&](const core::type::Type* ty) -> sem::TypeExpression* {
@@ -4879,7 +5205,7 @@ bool Resolver::ApplyAddressSpaceUsageToType(core::AddressSpace address_space,
             return true;  // Already applied
         }
 
-        str->AddUsage(address_space);
+        UpdateSharedType([str, address_space] { str->AddUsage(address_space); });
 
         for (auto* member : str->Members()) {
             auto decl = member->Declaration();
@@ -5027,7 +5353,7 @@ bool Resolver::CheckNotTemplated(const char* use, const ast::Identifier* ident)
     if (TINT_UNLIKELY(ident->Is<ast::TemplatedIdentifier>())) {
         AddError(ident->source) << use << " " << style::Code(ident->symbol.NameView())
                                 << " does not take template arguments";
-        if (auto resolved = dependencies_.resolved_identifiers.Get(ident)) {
+        if (auto resolved = Dependencies().resolved_identifiers.Get(ident)) {
             if (auto* ast_node = resolved->Node()) {
                 sem_.NoteDeclarationSource(ast_node);
             }
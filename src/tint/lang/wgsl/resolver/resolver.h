@@ -51,6 +51,7 @@
 #include "src/tint/lang/wgsl/sem/struct.h"
 #include "src/tint/utils/containers/bitset.h"
 #include "src/tint/utils/containers/unique_vector.h"
+#include "src/tint/utils/system/optional_mutex.h"
 #include "src/tint/utils/text/styled_text.h"
 
 // Forward declarations
@@ -99,7 +100,12 @@ class Resolver {
     /// Constructor
     /// @param builder the program builder
     /// @param allowed_features the extensions and features that are allowed to be used
-    explicit Resolver(ProgramBuilder* builder, const wgsl::AllowedFeatures& allowed_features);
+    /// @param num_threads the number of threads used to resolve function bodies. If greater than 1,
+    /// the bodies of functions that do not call each other are resolved concurrently. The resulting
+    /// semantic information and diagnostics match those of a single-threaded resolve.
+    explicit Resolver(ProgramBuilder* builder,
+                      const wgsl::AllowedFeatures& allowed_features,
+                      uint32_t num_threads = 1);
 
     /// Destructor
     ~Resolver();
@@ -137,10 +143,73 @@ class Resolver {
     const Validator* GetValidatorForTesting() const { return &validator_; }
 
   private:
+    struct AliasAnalysisInfo;
+    struct Segment;
+    struct ParallelFunction;
+
+    /// Constructs a resolver used by a worker thread of ResolveFunctionBodies()
+    /// @param parent the resolver that owns the module state
+    /// @param diagnostics the diagnostic list for the worker
+    Resolver(Resolver& parent, diag::List& diagnostics);
+
     /// Resolves the program, without creating final the semantic nodes.
     /// @returns true on success, false on error
     bool ResolveInternal();
 
+    /// Resolves the bodies of the functions in #parallel_functions_ using #num_threads_ threads,
+    /// then merges the semantic nodes, shared updates and diagnostics in declaration order.
+    /// @returns true if all the function bodies resolved without error
+    bool ResolveFunctionBodies();
+
+    /// Registers the symbols of the builtin structures (the result types of modf(), frexp() and
+    /// atomicCompareExchangeWeak()) that are referenced by the module, before the function bodies
+    /// are resolved in parallel.
+    void RegisterBuiltinStructSymbols();
+
+    /// Resolves the body of the function of @p pf on a worker thread of ResolveFunctionBodies().
+    /// @param pf the function, which holds the results of the resolve on return
+    void ResolveFunctionBody(ParallelFunction& pf);
+
+    /// Resolves the attributes, parameters and return type of the function @p func.
+    /// @returns true on success, false on error
+    bool FunctionHeader(sem::Function* func);
+
+    /// Resolves and validates the body of the function @p func, after FunctionHeader().
+    /// @returns true on success, false on error
+    bool FunctionBody(sem::Function* func);
+
+    /// @returns the resolver that holds the state shared by all the function bodies of the module
+    Resolver& Shared() { return parent_ ? *parent_ : *this; }
+
+    /// @returns the dependency graph of the module
+    const DependencyGraph& Dependencies() const {
+        return parent_ ? parent_->dependencies_ : dependencies_;
+    }
+
+    /// Applies @p update to semantic nodes that are shared between functions. When resolving in
+    /// parallel, the update is deferred to the current Segment so that the updates are applied in
+    /// declaration order once all function bodies have been resolved.
+    template <typename F>
+    void UpdateShared(F&& update) const {
+        if (segment_) {
+            segment_->shared_updates.Push(std::forward<F>(update));
+        } else {
+            update();
+        }
+    }
+
+    /// Applies @p update to a type, which may be shared between functions. Worker resolvers defer
+    /// the update to the current Segment, as the module resolver applies the update immediately
+    /// because later declarations may depend on it.
+    template <typename F>
+    void UpdateSharedType(F&& update) const {
+        if (parent_) {
+            segment_->shared_updates.Push(std::forward<F>(update));
+        } else {
+            update();
+        }
+    }
+
     /// Creates the nodes and adds them to the sem::Info mappings of the
     /// ProgramBuilder.
     void CreateSemanticNodes() const;
@@ -322,6 +391,9 @@ class Resolver {
     /// @returns true is the call arguments are free from aliasing issues, false otherwise.
     bool AliasAnalysis(const sem::Call* call);
 
+    /// @returns the alias analysis of the resolved function @p func
+    const AliasAnalysisInfo& AliasAnalysisOf(const sem::Function* func);
+
     /// If `expr` is of a reference type, then Load will create and return a sem::Load node wrapping
     /// `expr`. If `expr` is not of a reference type, then Load will just return `expr`.
     const sem::ValueExpression* Load(const sem::ValueExpression* expr);
@@ -405,10 +477,12 @@ class Resolver {
     bool Statements(VectorRef<const ast::Statement*>);
 
     // CollectTextureSamplerPairs() collects all the texture/sampler pairs from the target function
-    // / builtin, and records these on the current function by calling AddTextureSamplerPair().
-    void CollectTextureSamplerPairs(sem::Function* func,
+    // / builtin, and records these on the calling function by calling AddTextureSamplerPair().
+    void CollectTextureSamplerPairs(sem::Function* caller,
+                                    sem::Function* func,
                                     VectorRef<const sem::ValueExpression*> args) const;
-    void CollectTextureSamplerPairs(const sem::BuiltinFn* builtin,
+    void CollectTextureSamplerPairs(sem::Function* caller,
+                                    const sem::BuiltinFn* builtin,
                                     VectorRef<const sem::ValueExpression*> args) const;
 
     /// Resolves the WorkgroupSize for the given function, assigning it to
@@ -692,6 +766,38 @@ class Resolver {
         Hashset<const sem::Variable*, 4> parameter_reads;
     };
 
+    /// Segment holds the semantic nodes allocated while resolving a contiguous run of module-scope
+    /// declarations when resolving in parallel, along with the updates to semantic nodes that are
+    /// shared between functions. Segments are merged in declaration order once all the function
+    /// bodies have been resolved.
+    struct Segment {
+        /// The semantic nodes created for the declarations of the segment
+        ProgramBuilder::SemNodeAllocator sem_nodes;
+        /// The deferred updates to shared semantic nodes
+        Vector<std::function<void()>, 8> shared_updates;
+    };
+
+    /// ParallelFunction holds the state of a function whose body is resolved by
+    /// ResolveFunctionBodies().
+    struct ParallelFunction {
+        /// The function
+        sem::Function* func = nullptr;
+        /// The segment holding the function's semantic nodes
+        Segment* segment = nullptr;
+        /// The diagnostic filters in scope for the function body
+        DiagnosticFilterStack diagnostic_filters;
+        /// The number of module diagnostics raised before the function body
+        size_t diagnostics_offset = 0;
+        /// The function is resolved after all the functions with a lower wave
+        uint32_t wave = 0;
+        /// The diagnostics raised by the function body
+        diag::List diagnostics;
+        /// The alias analysis of the function body
+        AliasAnalysisInfo alias_analysis;
+        /// True if the function body resolved without error
+        bool ok = false;
+    };
+
     ProgramBuilder& b;
     diag::List& diagnostics_;
     core::constant::Eval const_eval_;
@@ -721,6 +827,14 @@ class Resolver {
     Hashmap<std::pair<core::intrinsic::Overload, wgsl::BuiltinFn>, sem::BuiltinFn*, 64> builtins_;
     Hashmap<core::intrinsic::Overload, sem::ValueConstructor*, 16> constructors_;
     Hashmap<core::intrinsic::Overload, sem::ValueConversion*, 16> converters_;
+    uint32_t num_threads_ = 1;
+    Resolver* parent_ = nullptr;
+    /// Guards #builtins_, #constructors_, #converters_, #array_ctors_ and #struct_ctors_ while
+    /// function bodies are resolved in parallel
+    OptionalMutex call_targets_mutex_;
+    Segment* segment_ = nullptr;
+    Vector<std::unique_ptr<Segment>, 32> segments_;
+    Vector<std::unique_ptr<ParallelFunction>, 32> parallel_functions_;
 };
 
 }  // namespace tint::resolver
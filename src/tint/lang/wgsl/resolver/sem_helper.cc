@@ -40,7 +40,8 @@
 
 namespace tint::resolver {
 
-SemHelper::SemHelper(ProgramBuilder* builder) : builder_(builder) {}
+SemHelper::SemHelper(ProgramBuilder* builder, diag::List& diagnostics)
+    : builder_(builder), diagnostics_(diagnostics) {}
 
 SemHelper::~SemHelper() = default;
 
@@ -228,14 +229,14 @@ void SemHelper::NoteDeclarationSource(const ast::Node* node) const {
 }
 
 diag::Diagnostic& SemHelper::AddError(const Source& source) const {
-    return builder_->Diagnostics().AddError(diag::System::Resolver, source);
+    return diagnostics_.AddError(diag::System::Resolver, source);
 }
 
 diag::Diagnostic& SemHelper::AddWarning(const Source& source) const {
-    return builder_->Diagnostics().AddWarning(diag::System::Resolver, source);
+    return diagnostics_.AddWarning(diag::System::Resolver, source);
 }
 
 diag::Diagnostic& SemHelper::AddNote(const Source& source) const {
-    return builder_->Diagnostics().AddNote(diag::System::Resolver, source);
+    return diagnostics_.AddNote(diag::System::Resolver, source);
 }
 }  // namespace tint::resolver
@@ -49,7 +49,8 @@ class SemHelper {
   public:
     /// Constructor
     /// @param builder the program builder
-    explicit SemHelper(ProgramBuilder* builder);
+    /// @param diagnostics the diagnostic list that errors, warnings and notes are added to
+    SemHelper(ProgramBuilder* builder, diag::List& diagnostics);
     ~SemHelper();
 
     /// Get is a helper for obtaining the semantic node for the given AST node.
@@ -301,6 +302,7 @@ class SemHelper {
     diag::Diagnostic& AddNote(const Source& source) const;
 
     ProgramBuilder* builder_;
+    diag::List& diagnostics_;
 };
 
 }  // namespace tint::resolver
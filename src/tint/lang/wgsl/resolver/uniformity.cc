@@ -27,6 +27,7 @@
 
 #include "src/tint/lang/wgsl/resolver/uniformity.h"
 
+#include <algorithm>
 #include <limits>
 #include <string>
 #include <utility>
@@ -49,9 +50,9 @@
 #include "src/tint/lang/wgsl/sem/value_conversion.h"
 #include "src/tint/lang/wgsl/sem/variable.h"
 #include "src/tint/lang/wgsl/sem/while_statement.h"
+#include "src/tint/utils/containers/bitset.h"
 #include "src/tint/utils/containers/map.h"
 #include "src/tint/utils/containers/scope_stack.h"
-#include "src/tint/utils/containers/unique_vector.h"
 #include "src/tint/utils/macros/defer.h"
 #include "src/tint/utils/memory/block_allocator.h"
 #include "src/tint/utils/rtti/switch.h"
@@ -110,12 +111,16 @@ struct ParameterTag {
     wgsl::DiagnosticSeverity severity = wgsl::DiagnosticSeverity::kUndefined;
 };
 
+struct FunctionInfo;
+
 /// Node represents a node in the graph of control flow and value nodes within the analysis of a
 /// single function.
 struct Node {
     /// Constructor
+    /// @param f the function that owns the node
+    /// @param i the index of the node within the function
     /// @param a the corresponding AST node
-    explicit Node(const ast::Node* a) : ast(a) {}
+    Node(FunctionInfo* f, uint32_t i, const ast::Node* a) : ast(a), function(f), index(i) {}
 
 #if TINT_DUMP_UNIFORMITY_GRAPH
     /// The node tag.
@@ -144,18 +149,23 @@ struct Node {
     /// The function call argument index, if applicable.
     uint32_t arg_index = 0xffffffffu;
 
-    /// The set of edges from this node to other nodes in the graph.
-    UniqueVector<Node*, 4> edges;
+    /// The function that owns this node.
+    FunctionInfo* const function;
+
+    /// The index of this node within the function, used to index per-node analysis state.
+    const uint32_t index;
+
+    /// The unique edges from this node to other nodes in the graph, in the order they were first
+    /// added. This is a view into FunctionInfo::edges, and is only populated once the function's
+    /// graph has been built.
+    Slice<Node*> edges;
 
     /// The node that this node was visited from, or nullptr if not visited.
     Node* visited_from = nullptr;
 
     /// Add an edge to the `to` node.
     /// @param to the destination node
-    void AddEdge(Node* to) {
-        TINT_ASSERT(to != nullptr);
-        edges.Add(to);
-    }
+    void AddEdge(Node* to);
 };
 
 /// ParameterInfo holds information about the uniformity requirements and effects for a particular
@@ -242,6 +252,14 @@ struct FunctionInfo {
     /// The control flow graph.
     BlockAllocator<Node> nodes;
 
+    /// The edges of the control flow graph, grouped by source node. Node::edges are views into
+    /// this array.
+    Vector<Node*, 64> edges;
+
+    /// The edges added to the graph while processing the function body, in the order they were
+    /// added. These are moved to #edges by BuildEdges().
+    Vector<std::pair<Node*, Node*>, 64> pending_edges;
+
     /// Special `RequiredToBeUniform` nodes.
     Node* required_to_be_uniform_error = nullptr;
     Node* required_to_be_uniform_warning = nullptr;
@@ -307,7 +325,7 @@ struct FunctionInfo {
     /// @returns the new node
     Node* CreateNode([[maybe_unused]] std::initializer_list<std::string_view> tag_list,
                      const ast::Node* ast = nullptr) {
-        auto* node = nodes.Create(ast);
+        auto* node = nodes.Create(this, static_cast<uint32_t>(nodes.Count()), ast);
 
 #if TINT_DUMP_UNIFORMITY_GRAPH
         // Make the tag unique and set it.
@@ -328,6 +346,48 @@ struct FunctionInfo {
         return node;
     }
 
+    /// Moves #pending_edges into #edges, removing duplicate edges, and points each node's edges
+    /// at its range of #edges.
+    void BuildEdges() {
+        auto pending = std::move(pending_edges);
+
+        // Count the edges of each node, then bucket the edges by source node. The bucketing is
+        // stable, so each node's edges keep the order in which they were added.
+        Vector<uint32_t, 64> offsets;
+        offsets.Resize(nodes.Count() + 1, 0u);
+        for (auto& edge : pending) {
+            offsets[edge.first->index + 1]++;
+        }
+        for (size_t i = 1; i < offsets.Length(); i++) {
+            offsets[i] += offsets[i - 1];
+        }
+        edges.Resize(pending.Length());
+        {
+            auto next = offsets;
+            for (auto& edge : pending) {
+                edges[next[edge.first->index]++] = edge.second;
+            }
+        }
+
+        // Remove duplicate edges, keeping the first, and compact the array.
+        // `seen[to]` holds the index + 1 of the last node found to have an edge to `to`.
+        Vector<uint32_t, 64> seen;
+        seen.Resize(nodes.Count(), 0u);
+        uint32_t count = 0;
+        for (auto* node : nodes.Objects()) {
+            uint32_t start = count;
+            for (uint32_t i = offsets[node->index]; i < offsets[node->index + 1]; i++) {
+                auto* to = edges[i];
+                if (seen[to->index] != node->index + 1) {
+                    seen[to->index] = node->index + 1;
+                    edges[count++] = to;
+                }
+            }
+            node->edges = edges.Slice().Offset(start).Truncate(count - start);
+        }
+        edges.Resize(count);
+    }
+
     /// Reset the visited status of every node in the graph.
     void ResetVisited() {
         for (auto* node : nodes.Objects()) {
@@ -346,6 +406,11 @@ struct FunctionInfo {
     BlockAllocator<LoopSwitchInfo> loop_switch_info_allocator;
 };
 
+void Node::AddEdge(Node* to) {
+    TINT_ASSERT(to != nullptr);
+    function->pending_edges.Push({this, to});
+}
+
 /// UniformityGraph is used to analyze the uniformity requirements and effects of functions in a
 /// module.
 class UniformityGraph {
@@ -391,12 +456,27 @@ class UniformityGraph {
     const sem::Info& sem_;
     diag::List& diagnostics_;
 
+    /// Allocator of FunctionInfos. FunctionInfos must not move once created, as their nodes refer
+    /// back to them.
+    BlockAllocator<FunctionInfo> function_infos_;
+
     /// Map of analyzed function results.
-    Hashmap<const ast::Function*, FunctionInfo, 8> functions_;
+    Hashmap<const ast::Function*, FunctionInfo*, 8> functions_;
 
     /// The function currently being analyzed.
     FunctionInfo* current_function_;
 
+    /// Per-node and per-component state used by ComputeReachability(), kept across functions to
+    /// reuse the allocations.
+    Vector<uint32_t, 64> dfs_index_;
+    Vector<uint32_t, 64> low_link_;
+    Vector<uint32_t, 64> component_;
+    Vector<Node*, 64> component_nodes_;
+    Vector<uint32_t, 64> component_offsets_;
+    Vector<Node*, 64> scc_stack_;
+    Vector<std::pair<Node*, uint32_t>, 64> dfs_stack_;
+    Vector<Bitset<64>, 64> component_reachable_;
+
     /// Create a new node.
     /// @param tag_list a string list that will be used to identify the node for debugging purposes
     /// @param ast the optional AST node that this node corresponds to
@@ -431,13 +511,16 @@ class UniformityGraph {
     /// @param func the function to process
     /// @returns true if there are no uniformity issues, false otherwise
     bool ProcessFunction(const ast::Function* func) {
-        current_function_ = &functions_.Add(func, FunctionInfo(func, b)).value;
+        current_function_ = function_infos_.Create(func, b);
+        functions_.Add(func, current_function_);
 
         // Process function body.
         if (func->body) {
             ProcessStatement(current_function_->cf_start, func->body);
         }
 
+        current_function_->BuildEdges();
+
 #if TINT_DUMP_UNIFORMITY_GRAPH
         // Dump the graph for this function as a subgraph.
         std::cout << "\nsubgraph cluster_" << current_function_->name << " {\n";
@@ -451,35 +534,72 @@ class UniformityGraph {
         std::cout << "\n}\n";
 #endif
 
+        // The nodes whose reachability determines the function's tags. Each parameter has a value
+        // node and, for pointers, a node for the initial contents.
+        static constexpr size_t kMayBeNonUniformTarget = 0;
+        static constexpr size_t kCFStartTarget = 1;
+        auto param_value_target = [](size_t index) { return 2 + index * 2; };
+        auto param_contents_target = [](size_t index) { return 3 + index * 2; };
+        Vector<Node*, 16> targets;
+        targets.Resize(2 + func->params.Length() * 2);
+        targets[kMayBeNonUniformTarget] = current_function_->may_be_non_uniform;
+        targets[kCFStartTarget] = current_function_->cf_start;
+        for (size_t i = 0; i < func->params.Length(); i++) {
+            auto& param_info = current_function_->parameters[i];
+            if (param_info.ptr_input_contents) {
+                targets[param_value_target(i)] = param_info.value;
+                targets[param_contents_target(i)] = param_info.ptr_input_contents;
+            } else {
+                targets[param_value_target(i)] = current_function_->variables.Get(param_info.sem);
+            }
+        }
+
+        // Collapse the graph into its strongly connected components, and find the targets that
+        // are reachable from each of the nodes that we traverse from.
+        Vector<Node*, 8> sources{
+            current_function_->required_to_be_uniform_error,
+            current_function_->required_to_be_uniform_warning,
+            current_function_->required_to_be_uniform_info,
+        };
+        if (current_function_->value_return) {
+            sources.Push(current_function_->value_return);
+        }
+        for (auto& param_info : current_function_->parameters) {
+            if (param_info.ptr_output_contents) {
+                sources.Push(param_info.ptr_output_contents);
+            }
+        }
+        ComputeReachability(sources, targets);
+
         /// Helper to generate a tag for the uniformity requirements of the parameter at `index`.
-        auto get_param_tag = [&](UniqueVector<Node*, 4>& reachable, size_t index) {
-            auto* param = sem_.Get(func->params[index]);
-            auto& param_info = current_function_->parameters[index];
-            if (param->Type()->Is<core::type::Pointer>()) {
+        auto get_param_tag = [&](const Bitset<64>& reachable, size_t index) {
+            if (current_function_->parameters[index].ptr_input_contents) {
                 // For pointers, we distinguish between requiring uniformity of the contents versus
                 // the pointer itself.
-                if (reachable.Contains(param_info.ptr_input_contents)) {
+                if (reachable[param_contents_target(index)]) {
                     return ParameterTag::ParameterContentsRequiredToBeUniform;
-                } else if (reachable.Contains(param_info.value)) {
+                } else if (reachable[param_value_target(index)]) {
                     return ParameterTag::ParameterValueRequiredToBeUniform;
                 }
-            } else if (reachable.Contains(current_function_->variables.Get(param))) {
+            } else if (reachable[param_value_target(index)]) {
                 // For non-pointers, the requirement is always on the value.
                 return ParameterTag::ParameterValueRequiredToBeUniform;
             }
             return ParameterTag::ParameterNoRestriction;
         };
 
-        // Look at which nodes are reachable from "RequiredToBeUniform".
+        // Look at which nodes are reachable from "RequiredToBeUniform". The requirements of each
+        // severity include those of the more severe ones, so the reachable sets are accumulated.
         {
-            UniqueVector<Node*, 4> reachable;
+            Bitset<64> reachable;
+            reachable.Resize(targets.Length());
             auto traverse = [&](wgsl::DiagnosticSeverity severity) {
-                Traverse(current_function_->RequiredToBeUniform(severity), &reachable);
-                if (reachable.Contains(current_function_->may_be_non_uniform)) {
+                reachable |= ReachableFrom(current_function_->RequiredToBeUniform(severity));
+                if (reachable[kMayBeNonUniformTarget]) {
                     MakeError(*current_function_, current_function_->may_be_non_uniform, severity);
                     return false;
                 }
-                if (reachable.Contains(current_function_->cf_start)) {
+                if (reachable[kCFStartTarget]) {
                     if (current_function_->callsite_tag.tag == CallSiteTag::CallSiteNoRestriction) {
                         current_function_->callsite_tag = {CallSiteTag::CallSiteRequiredToBeUniform,
                                                            severity};
@@ -507,11 +627,8 @@ class UniformityGraph {
 
         // If "Value_return" exists, look at which nodes are reachable from it.
         if (current_function_->value_return) {
-            current_function_->ResetVisited();
-
-            UniqueVector<Node*, 4> reachable;
-            Traverse(current_function_->value_return, &reachable);
-            if (reachable.Contains(current_function_->may_be_non_uniform)) {
+            auto& reachable = ReachableFrom(current_function_->value_return);
+            if (reachable[kMayBeNonUniformTarget]) {
                 current_function_->function_tag = ReturnValueMayBeNonUniform;
             }
 
@@ -522,19 +639,15 @@ class UniformityGraph {
             }
         }
 
-        // Traverse the graph for each pointer parameter.
+        // Look at which nodes are reachable from each pointer parameter's output contents.
         for (size_t i = 0; i < func->params.Length(); i++) {
             auto& param_info = current_function_->parameters[i];
             if (param_info.ptr_output_contents == nullptr) {
                 continue;
             }
 
-            // Reset "visited" state for all nodes.
-            current_function_->ResetVisited();
-
-            UniqueVector<Node*, 4> reachable;
-            Traverse(param_info.ptr_output_contents, &reachable);
-            if (reachable.Contains(current_function_->may_be_non_uniform)) {
+            auto& reachable = ReachableFrom(param_info.ptr_output_contents);
+            if (reachable[kMayBeNonUniformTarget]) {
                 param_info.pointer_may_become_non_uniform = true;
             }
 
@@ -555,6 +668,109 @@ class UniformityGraph {
         return true;
     }
 
+    /// Collapses the strongly connected components of the current function's graph that are
+    /// reachable from @p sources, and determines which of @p targets are reachable from each
+    /// component. Every node of a component reaches the same set of nodes, so this answers all
+    /// the reachability queries of the function with a single pass over its graph, after which
+    /// ReachableFrom() can be used to look up the targets reachable from any of @p sources.
+    /// @param sources the nodes to find the reachable targets of
+    /// @param targets the nodes to test the reachability of. Null entries are ignored.
+    void ComputeReachability(VectorRef<Node*> sources, VectorRef<Node*> targets) {
+        static constexpr uint32_t kNoComponent = std::numeric_limits<uint32_t>::max();
+
+        size_t num_nodes = current_function_->nodes.Count();
+        dfs_index_.Clear();
+        dfs_index_.Resize(num_nodes, 0u);
+        low_link_.Resize(num_nodes);
+        component_.Clear();
+        component_.Resize(num_nodes, kNoComponent);
+        component_nodes_.Clear();
+        component_offsets_.Clear();
+        component_offsets_.Push(0);
+
+        // Find the strongly connected components with an iterative form of Tarjan's algorithm.
+        // Components are numbered in the order that they are completed, which means that a
+        // component can only have edges to components with a lower number.
+        uint32_t next_dfs_index = 1;
+        auto visit = [&](Node* node) {
+            dfs_index_[node->index] = next_dfs_index;
+            low_link_[node->index] = next_dfs_index;
+            next_dfs_index++;
+            scc_stack_.Push(node);
+            dfs_stack_.Push({node, 0u});
+        };
+        for (auto* source : sources) {
+            if (dfs_index_[source->index] != 0) {
+                continue;
+            }
+            visit(source);
+            while (!dfs_stack_.IsEmpty()) {
+                auto& top = dfs_stack_.Back();
+                auto* node = top.first;
+                if (top.second < node->edges.Length()) {
+                    auto* to = node->edges[top.second++];
+                    if (dfs_index_[to->index] == 0) {
+                        visit(to);
+                    } else if (component_[to->index] == kNoComponent) {
+                        // `to` is still on the SCC stack, so is part of the current component.
+                        low_link_[node->index] =
+                            std::min(low_link_[node->index], dfs_index_[to->index]);
+                    }
+                    continue;
+                }
+
+                dfs_stack_.Pop();
+                if (low_link_[node->index] == dfs_index_[node->index]) {
+                    // `node` is the root of a component. Pop the component's nodes from the stack.
+                    auto id = static_cast<uint32_t>(component_offsets_.Length() - 1);
+                    Node* member = nullptr;
+                    do {
+                        member = scc_stack_.Pop();
+                        component_[member->index] = id;
+                        component_nodes_.Push(member);
+                    } while (member != node);
+                    component_offsets_.Push(static_cast<uint32_t>(component_nodes_.Length()));
+                }
+                if (!dfs_stack_.IsEmpty()) {
+                    auto* parent = dfs_stack_.Back().first;
+                    low_link_[parent->index] =
+                        std::min(low_link_[parent->index], low_link_[node->index]);
+                }
+            }
+        }
+
+        // Seed each component with the targets that it contains, then propagate the reachable
+        // targets up the acyclic graph of components. Components are visited in completion order,
+        // so the components that a component has edges to are always complete.
+        size_t num_components = component_offsets_.Length() - 1;
+        component_reachable_.Clear();
+        component_reachable_.Resize(num_components);
+        for (auto& reachable : component_reachable_) {
+            reachable.Resize(targets.Length());
+        }
+        for (size_t i = 0; i < targets.Length(); i++) {
+            if (targets[i] && component_[targets[i]->index] != kNoComponent) {
+                component_reachable_[component_[targets[i]->index]][i] = true;
+            }
+        }
+        for (uint32_t id = 0; id < num_components; id++) {
+            auto& reachable = component_reachable_[id];
+            for (uint32_t i = component_offsets_[id]; i < component_offsets_[id + 1]; i++) {
+                for (auto* to : component_nodes_[i]->edges) {
+                    if (auto to_id = component_[to->index]; to_id != id) {
+                        reachable |= component_reachable_[to_id];
+                    }
+                }
+            }
+        }
+    }
+
+    /// @param source one of the source nodes passed to the last call to ComputeReachability()
+    /// @returns the set of targets that are reachable from @p source
+    const Bitset<64>& ReachableFrom(Node* source) const {
+        return component_reachable_[component_[source->index]];
+    }
+
     /// Process a statement, returning the new control flow node.
     /// @param cf the input control flow node
     /// @param stmt the statement to process d
@@ -1637,9 +1853,9 @@ class UniformityGraph {
                 // functions in dependency order.
                 auto info = functions_.Get(func->Declaration());
                 TINT_ASSERT(info);
-                callsite_tag = info->callsite_tag;
-                function_tag = info->function_tag;
-                func_info = info.value;
+                func_info = *info;
+                callsite_tag = func_info->callsite_tag;
+                function_tag = func_info->function_tag;
             },
             [&](const sem::ValueConstructor*) {
                 callsite_tag = {CallSiteTag::CallSiteNoRestriction};
@@ -1745,20 +1961,16 @@ class UniformityGraph {
         return {cf_after, result};
     }
 
-    /// Traverse a graph starting at `source`, inserting all visited nodes into `reachable` and
-    /// recording which node they were reached from.
+    /// Traverse a graph starting at `source`, recording which node each visited node was reached
+    /// from. This is only used to build the paths shown by diagnostics.
     /// @param source the starting node
-    /// @param reachable the set of reachable nodes to populate, if required
-    void Traverse(Node* source, UniqueVector<Node*, 4>* reachable = nullptr) {
+    void Traverse(Node* source) {
         Vector<Node*, 8> to_visit{source};
 
         while (!to_visit.IsEmpty()) {
             auto* node = to_visit.Back();
             to_visit.Pop();
 
-            if (reachable) {
-                reachable->Add(node);
-            }
             for (auto* to : node->edges) {
                 if (to->visited_from == nullptr) {
                     to->visited_from = node;
@@ -1796,7 +2008,7 @@ class UniformityGraph {
         } else if (auto* user = target->As<sem::Function>()) {
             // This is a call to a user-defined function, so inspect the functions called by that
             // function and look for one whose node has an edge from the RequiredToBeUniform node.
-            auto target_info = functions_.Get(user->Declaration());
+            auto* target_info = *functions_.Get(user->Declaration());
             for (auto* call_node : target_info->RequiredToBeUniform(severity)->edges) {
                 if (call_node->type == Node::kRegular) {
                     auto* child_call = call_node->ast->As<ast::CallExpression>();
@@ -1974,7 +2186,7 @@ class UniformityGraph {
             auto* user_func = target->As<sem::Function>();
             if (user_func) {
                 // Recurse into the called function to show the reason for the requirement.
-                auto next_function = functions_.Get(user_func->Declaration());
+                auto* next_function = *functions_.Get(user_func->Declaration());
                 auto& param_info = next_function->parameters[cause->arg_index];
                 MakeError(*next_function,
                           is_value ? param_info.value : param_info.ptr_input_contents, severity);
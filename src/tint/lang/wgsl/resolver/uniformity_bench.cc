@@ -0,0 +1,121 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// GEN_BUILD:CONDITION(tint_build_wgsl_reader)
+
+#include <cstdint>
+#include <string>
+
+#include "src/tint/cmd/bench/bench.h"
+#include "src/tint/lang/wgsl/program/program_builder.h"
+#include "src/tint/lang/wgsl/reader/reader.h"
+#include "src/tint/lang/wgsl/resolver/dependency_graph.h"
+#include "src/tint/lang/wgsl/resolver/uniformity.h"
+
+namespace tint::resolver {
+namespace {
+
+/// @returns a synthetic WGSL program with a call chain of @p num_functions functions. Each function
+/// takes pointer parameters, loops over conditional writes through them, and conditionally calls a
+/// barrier, so that the analysis has to propagate parameter and call site requirements all the way
+/// up the chain.
+std::string CallChainWGSL(int64_t num_functions) {
+    std::string wgsl = "@group(0) @binding(0) var<storage, read_write> buf : array<u32>;\n";
+    wgsl += "fn f0(p : ptr<function, u32>, q : ptr<function, u32>, x : u32) -> u32 {\n";
+    wgsl += "  return x + *p;\n}\n";
+    for (int64_t f = 1; f < num_functions; f++) {
+        auto fn = "f" + std::to_string(f);
+        auto callee = "f" + std::to_string(f - 1);
+        wgsl += "fn " + fn + "(p : ptr<function, u32>, q : ptr<function, u32>, x : u32) -> u32 {\n";
+        wgsl += "  var acc = x;\n";
+        wgsl += "  for (var i = 0u; i < 16u; i++) {\n";
+        wgsl += "    if (acc > i) {\n";
+        wgsl += "      *p = *q + i;\n";
+        wgsl += "    } else {\n";
+        wgsl += "      *q = " + callee + "(p, q, acc);\n";
+        wgsl += "      continue;\n";
+        wgsl += "    }\n";
+        wgsl += "    acc += *p;\n";
+        wgsl += "    buf[i] = acc;\n";
+        wgsl += "  }\n";
+        wgsl += "  if (x == 0u) {\n";
+        wgsl += "    workgroupBarrier();\n";
+        wgsl += "  }\n";
+        wgsl += "  return acc + " + callee + "(q, p, x);\n";
+        wgsl += "}\n";
+    }
+    wgsl += "@compute @workgroup_size(64)\n";
+    wgsl += "fn main() {\n";
+    wgsl += "  var a = 1u;\n";
+    wgsl += "  var b = 2u;\n";
+    wgsl += "  buf[0] = f" + std::to_string(num_functions - 1) + "(&a, &b, 3u);\n";
+    wgsl += "}\n";
+    return wgsl;
+}
+
+/// Runs the uniformity analysis on @p program in a loop, excluding the cost of parsing and
+/// resolving the program.
+void AnalyzeProgram(benchmark::State& state, const Program& program) {
+    diag::List diagnostics;
+    DependencyGraph dependency_graph;
+    if (!DependencyGraph::Build(program.AST(), diagnostics, dependency_graph)) {
+        state.SkipWithError(diagnostics.Str());
+        return;
+    }
+    auto builder = ProgramBuilder::Wrap(program);
+    for (auto _ : state) {
+        if (!AnalyzeUniformity(builder, dependency_graph)) {
+            state.SkipWithError(builder.Diagnostics().Str());
+        }
+    }
+}
+
+void AnalyzeUniformityWGSL(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadProgram(input_name);
+    if (res != Success) {
+        state.SkipWithError(res.Failure().reason.Str());
+        return;
+    }
+    AnalyzeProgram(state, res->program);
+}
+
+void AnalyzeUniformityCallChain(benchmark::State& state) {
+    Source::File file("call_chain.wgsl", CallChainWGSL(state.range(0)));
+    auto program = wgsl::reader::Parse(&file);
+    if (!program.IsValid()) {
+        state.SkipWithError(program.Diagnostics().Str());
+        return;
+    }
+    AnalyzeProgram(state, program);
+}
+
+TINT_BENCHMARK_PROGRAMS(AnalyzeUniformityWGSL);
+BENCHMARK(AnalyzeUniformityCallChain)->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace tint::resolver
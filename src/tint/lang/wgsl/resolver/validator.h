@@ -113,12 +113,14 @@ class Validator {
   public:
     /// Constructor
     /// @param builder the program builder
+    /// @param diagnostics the diagnostic list that errors and warnings are added to
     /// @param helper the SEM helper to validate with
     /// @param enabled_extensions all the extensions declared in current module
     /// @param allowed_features the allowed extensions and features
     /// @param atomic_composite_info atomic composite info of the module
     /// @param valid_type_storage_layouts a set of validated type layouts by address space
     Validator(ProgramBuilder* builder,
+              diag::List& diagnostics,
               SemHelper& helper,
               const wgsl::Extensions& enabled_extensions,
               const wgsl::AllowedFeatures& allowed_features,
@@ -79,8 +79,12 @@ class Info {
     Info& operator=(Info&& rhs);
 
     /// @param highest_node_id the last allocated (numerically highest) AST node identifier.
+    /// @note does not modify the Info if it already has room for @p highest_node_id, so semantic
+    /// nodes can be added for distinct AST nodes from multiple threads once reserved.
     void Reserve(ast::NodeID highest_node_id) {
-        nodes_.Resize(std::max(highest_node_id.value + 1, static_cast<uint32_t>(nodes_.Length())));
+        if (highest_node_id.value >= nodes_.Length()) {
+            nodes_.Resize(highest_node_id.value + 1);
+        }
     }
 
     /// Get looks up the semantic information for the AST node `ast_node`.
@@ -46,6 +46,7 @@ tint_add_target(tint_lang_wgsl_writer_ir_to_program lib
 
 tint_target_add_dependencies(tint_lang_wgsl_writer_ir_to_program lib
   tint_api_common
+  tint_api_options
   tint_lang_core
   tint_lang_core_constant
   tint_lang_core_intrinsic
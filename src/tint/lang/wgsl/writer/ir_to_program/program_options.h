@@ -28,6 +28,7 @@
 #ifndef SRC_TINT_LANG_WGSL_WRITER_IR_TO_PROGRAM_PROGRAM_OPTIONS_H_
 #define SRC_TINT_LANG_WGSL_WRITER_IR_TO_PROGRAM_PROGRAM_OPTIONS_H_
 
+#include "src/tint/api/options/optimization_level.h"
 #include "src/tint/lang/wgsl/common/allowed_features.h"
 
 namespace tint::wgsl::writer {
@@ -38,6 +39,8 @@ struct ProgramOptions {
     bool allow_non_uniform_derivatives = false;
     /// The extensions and language features that are allowed to be used in the generated WGSL.
     wgsl::AllowedFeatures allowed_features = {};
+    /// The level of optimization to apply to the IR before producing the program.
+    OptimizationLevel optimization_level = OptimizationLevel::kO0;
 };
 
 }  // namespace tint::wgsl::writer
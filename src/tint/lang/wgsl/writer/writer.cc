@@ -30,6 +30,7 @@
 #include <memory>
 #include <utility>
 
+#include "src/tint/lang/core/ir/transform/optimize.h"
 #include "src/tint/lang/wgsl/program/program.h"
 #include "src/tint/lang/wgsl/writer/ast_printer/ast_printer.h"
 #include "src/tint/lang/wgsl/writer/ir_to_program/ir_to_program.h"
@@ -68,6 +69,12 @@ Result<Output> Generate(const Program& program, const Options& options) {
 }
 
 Result<Output> WgslFromIR(core::ir::Module& module, const ProgramOptions& options) {
+    core::ir::transform::OptimizeConfig optimize_config;
+    optimize_config.level = options.optimization_level;
+    if (auto res = core::ir::transform::Optimize(module, optimize_config); res != Success) {
+        return res.Failure();
+    }
+
     // core-dialect -> WGSL-dialect
     if (auto res = Raise(module); res != Success) {
         return res.Failure();
@@ -43,6 +43,9 @@
 namespace tint::wgsl::writer {
 namespace {
 
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
 /// Class used for IR to Program tests
 class WgslIRWriterTest : public core::ir::IRTestHelper {
   public:
@@ -1019,5 +1022,141 @@ fn f(a : bool, b : bool, c : bool) -> bool {
 )");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Optimization level
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(WgslIRWriterTest, WgslFromIR_OptimizationLevel) {
+    auto* v = b.Var("v", ty.ptr<storage, i32, read_write>());
+    v->SetBindingPoint(0, 0);
+    mod.root_block->Append(v);
+
+    auto* fn =
+        b.Function("f", ty.void_(), core::ir::Function::PipelineStage::kCompute, {{1, 1, 1}});
+    b.Append(fn->Block(), [&] {
+        b.Store(v, b.Add<i32>(1_i, 2_i));
+        b.Return(fn);
+    });
+
+    ProgramOptions options;
+    options.optimization_level = OptimizationLevel::kO1;
+    auto output = WgslFromIR(mod, options);
+    ASSERT_EQ(output, Success) << output.Failure();
+    EXPECT_EQ(output->wgsl, R"(@group(0) @binding(0) var<storage, read_write> v : i32;
+
+@compute @workgroup_size(1, 1, 1)
+fn f() {
+  v = 3i;
+}
+)");
+}
+
+/// A parameterized test case for an optimization that is only run by the optimizing pipeline.
+struct DefaultOptionsCase {
+    /// The name of the optimization.
+    std::string name;
+    /// Builds the body of the compute shader `f`, using the storage buffer `v` of type i32.
+    void (*build)(core::ir::Builder& b, core::ir::Var* v);
+    /// The expected WGSL of `f`, and of any functions it calls.
+    std::string wgsl;
+};
+
+inline std::ostream& operator<<(std::ostream& out, const DefaultOptionsCase& c) {
+    return out << c.name;
+}
+
+using WgslIRWriterDefaultOptionsTest = core::ir::IRTestParamHelper<DefaultOptionsCase>;
+TEST_P(WgslIRWriterDefaultOptionsTest, WgslFromIR_DoesNotOptimize) {
+    auto params = GetParam();
+
+    auto* v = b.Var("v", ty.ptr<storage, i32, read_write>());
+    v->SetBindingPoint(0, 0);
+    mod.root_block->Append(v);
+
+    auto* ep =
+        b.Function("f", ty.void_(), core::ir::Function::PipelineStage::kCompute, {{1, 1, 1}});
+    b.Append(ep->Block(), [&] {
+        params.build(b, v);
+        b.Return(ep);
+    });
+
+    // The default options do not run the optimizing pipeline.
+    auto output = WgslFromIR(mod, ProgramOptions{});
+    ASSERT_EQ(output, Success) << output.Failure();
+    EXPECT_EQ(output->wgsl,
+              "@group(0) @binding(0) var<storage, read_write> v : i32;\n\n" + params.wgsl);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    WgslIRWriterDefaultOptionsTest,
+    testing::Values(
+        DefaultOptionsCase{"DeadCodeElimination",
+                           [](core::ir::Builder& b, core::ir::Var* v) {
+                               b.Let("unused", b.Multiply<i32>(b.Load(v), 2_i));
+                           },
+                           R"(@compute @workgroup_size(1, 1, 1)
+fn f() {
+  let unused = (v * 2i);
+}
+)"},
+        DefaultOptionsCase{"ConstantPropagation",
+                           [](core::ir::Builder& b, core::ir::Var* v) {
+                               b.Store(v, b.Add<i32>(1_i, 2_i));
+                           },
+                           R"(@compute @workgroup_size(1, 1, 1)
+fn f() {
+  v = (1i + 2i);
+}
+)"},
+        DefaultOptionsCase{"CommonSubexpressionElimination",
+                           [](core::ir::Builder& b, core::ir::Var* v) {
+                               auto* p = b.Load(v);
+                               b.Store(v, b.Multiply<i32>(p, 2_i));
+                               b.Store(v, b.Multiply<i32>(p, 2_i));
+                           },
+                           R"(@compute @workgroup_size(1, 1, 1)
+fn f() {
+  let v_1 = v;
+  v = (v_1 * 2i);
+  v = (v_1 * 2i);
+}
+)"},
+        DefaultOptionsCase{"Inlining",
+                           [](core::ir::Builder& b, core::ir::Var* v) {
+                               auto* add_one = b.Function("add_one", b.ir.Types().i32());
+                               auto* p = b.FunctionParam("p", b.ir.Types().i32());
+                               add_one->SetParams({p});
+                               b.Append(add_one->Block(),
+                                        [&] { b.Return(add_one, b.Add<i32>(p, 1_i)); });
+                               b.Store(v, b.Call(add_one, b.Load(v)));
+                           },
+                           R"(@compute @workgroup_size(1, 1, 1)
+fn f() {
+  v = add_one(v);
+}
+
+fn add_one(p : i32) -> i32 {
+  return (p + 1i);
+}
+)"},
+        DefaultOptionsCase{"LoopInvariantCodeMotion",
+                           [](core::ir::Builder& b, core::ir::Var* v) {
+                               auto* p = b.Load(v);
+                               auto* loop = b.Loop();
+                               b.Append(loop->Body(), [&] {
+                                   b.Store(v, b.Multiply<i32>(p, 2_i));
+                                   b.ExitLoop(loop);
+                               });
+                           },
+                           R"(@compute @workgroup_size(1, 1, 1)
+fn f() {
+  let v_1 = v;
+  loop {
+    v = (v_1 * 2i);
+    break;
+  }
+}
+)"}));
+
 }  // namespace
 }  // namespace tint::wgsl::writer
@@ -114,6 +114,16 @@ class Bitset {
         return word & mask;
     }
 
+    /// Sets each bit that is set in @p other.
+    /// @param other the bitset to merge into this bitset. Must have the same length as this bitset.
+    /// @returns this bitset
+    Bitset& operator|=(const Bitset& other) {
+        for (size_t i = 0, n = vec_.Length(); i < n; i++) {
+            vec_[i] |= other.vec_[i];
+        }
+        return *this;
+    }
+
     /// @returns true iff the all bits are unset (0)
     bool AllBitsZero() const {
         for (auto word : vec_) {
@@ -154,5 +154,22 @@ TEST(Bitset, ShinkGrowMisalignedClears_Spill) {
     }
 }
 
+TEST(Bitset, Or) {
+    Bitset<64> a;
+    Bitset<64> b;
+    a.Resize(200);
+    b.Resize(200);
+    a[3] = true;
+    a[100] = true;
+    b[3] = true;
+    b[150] = true;
+    b[199] = true;
+    a |= b;
+    for (size_t i = 0; i < 200; i++) {
+        EXPECT_EQ(a[i], i == 3 || i == 100 || i == 150 || i == 199) << "bit: " << i;
+        EXPECT_EQ(b[i], i == 3 || i == 150 || i == 199) << "bit: " << i;
+    }
+}
+
 }  // namespace
 }  // namespace tint
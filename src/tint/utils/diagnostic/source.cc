@@ -32,6 +32,7 @@
 #include <utility>
 
 #include "src/tint/utils/ice/ice.h"
+#include "src/tint/utils/text/ascii.h"
 #include "src/tint/utils/text/string_stream.h"
 #include "src/tint/utils/text/unicode.h"
 
@@ -93,6 +94,12 @@ std::vector<std::string_view> SplitLines(std::string_view str) {
 
     size_t lineStart = 0;
     for (size_t i = 0; i < str.size();) {
+        // Skip over the ASCII characters that cannot begin a line break.
+        i += ascii::FindLineBreakOrNonASCII(str.substr(i));
+        if (i == str.size()) {
+            break;
+        }
+
         bool is_line_break{};
         size_t line_break_size{};
         // We don't handle decode errors from ParseLineBreak. Instead, we rely on
@@ -227,6 +227,39 @@ class BlockAllocator {
     /// @returns the total number of allocated objects.
     size_t Count() const { return data.count; }
 
+    /// Moves all the objects owned by @p other to this BlockAllocator, appending them to the end
+    /// of the object list. The objects are not moved in memory, so existing pointers to the objects
+    /// remain valid. @p other is empty after the call.
+    /// @param other the BlockAllocator to take the objects of
+    void Append(BlockAllocator&& other) {
+        if (this == &other || other.data.block.root == nullptr) {
+            return;
+        }
+
+        // Link the blocks. New allocations will come from the current block of `other`.
+        if (data.block.current) {
+            data.block.current->next = other.data.block.root;
+        } else {
+            data.block.root = other.data.block.root;
+        }
+        data.block.current = other.data.block.current;
+        data.block.current_offset = other.data.block.current_offset;
+
+        // Link the object pointer lists
+        if (auto* first = other.data.pointers.root) {
+            if (data.pointers.current) {
+                data.pointers.current->next = first;
+                first->prev = data.pointers.current;
+            } else {
+                data.pointers.root = first;
+            }
+            data.pointers.current = other.data.pointers.current;
+        }
+
+        data.count += other.data.count;
+        other.data = {};
+    }
+
   private:
     BlockAllocator(const BlockAllocator&) = delete;
     BlockAllocator& operator=(const BlockAllocator&) = delete;
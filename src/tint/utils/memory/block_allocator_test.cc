@@ -200,5 +200,61 @@ TEST_F(BlockAllocatorTest, AddWhileIterating) {
     }
 }
 
+TEST_F(BlockAllocatorTest, Append) {
+    using Allocator = BlockAllocator<int>;
+
+    for (int n_a : {0, 1, 40, 20000}) {
+        for (int n_b : {0, 1, 40, 20000}) {
+            Allocator a;
+            Allocator b;
+            std::vector<int*> expected;
+            for (int i = 0; i < n_a; i++) {
+                expected.push_back(a.Create(i));
+            }
+            for (int i = 0; i < n_b; i++) {
+                expected.push_back(b.Create(n_a + i));
+            }
+
+            a.Append(std::move(b));
+            EXPECT_EQ(b.Count(), 0u);
+            EXPECT_EQ(b.Objects().begin(), b.Objects().end());
+
+            // Objects created after the append are added to the end of the list.
+            expected.push_back(a.Create(n_a + n_b));
+
+            EXPECT_EQ(a.Count(), expected.size());
+            size_t i = 0;
+            for (int* p : a.Objects()) {
+                ASSERT_LT(i, expected.size());
+                EXPECT_EQ(p, expected[i]);
+                EXPECT_EQ(*p, static_cast<int>(i));
+                i++;
+            }
+            EXPECT_EQ(i, expected.size());
+        }
+    }
+}
+
+TEST_F(BlockAllocatorTest, AppendObjectLifetime) {
+    using Allocator = BlockAllocator<LifetimeCounter>;
+
+    size_t count = 0;
+    {
+        Allocator a;
+        {
+            Allocator b;
+            a.Create(&count);
+            b.Create(&count);
+            b.Create(&count);
+            a.Append(std::move(b));
+            EXPECT_EQ(count, 3u);
+        }
+        EXPECT_EQ(count, 3u);
+        a.Create(&count);
+        EXPECT_EQ(count, 4u);
+    }
+    EXPECT_EQ(count, 0u);
+}
+
 }  // namespace
 }  // namespace tint
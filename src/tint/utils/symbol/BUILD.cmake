@@ -53,6 +53,7 @@ tint_target_add_dependencies(tint_utils_symbol lib
   tint_utils_math
   tint_utils_memory
   tint_utils_rtti
+  tint_utils_system
   tint_utils_text
   tint_utils_traits
 )
@@ -75,6 +76,7 @@ tint_target_add_dependencies(tint_utils_symbol_test test
   tint_utils_memory
   tint_utils_rtti
   tint_utils_symbol
+  tint_utils_system
   tint_utils_text
   tint_utils_traits
 )
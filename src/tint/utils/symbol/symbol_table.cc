@@ -42,6 +42,7 @@ SymbolTable& SymbolTable::operator=(SymbolTable&&) = default;
 Symbol SymbolTable::Register(std::string_view name) {
     TINT_ASSERT(!name.empty());
 
+    auto lock = mutex_.Lock();
     auto& it = name_to_symbol_.GetOrAddZeroEntry(name);
     if (it.value) {
         return Symbol{it.value, generation_id_, it.key};
@@ -54,6 +55,7 @@ Symbol SymbolTable::Register(std::string_view name) {
 }
 
 Symbol SymbolTable::Get(std::string_view name) const {
+    auto lock = mutex_.Lock();
     if (auto* entry = name_to_symbol_.GetEntry(name)) {
         return Symbol{entry->value, generation_id_, entry->key};
     }
@@ -68,6 +70,7 @@ Symbol SymbolTable::New(std::string_view prefix_view /* = "" */) {
         prefix = std::string(prefix_view);
     }
 
+    auto lock = mutex_.Lock();
     auto& it = name_to_symbol_.GetOrAddZeroEntry(prefix);
     if (it.value == 0) {
         // prefix is a unique name
@@ -33,6 +33,7 @@
 #include "src/tint/utils/containers/hashmap.h"
 #include "src/tint/utils/memory/bump_allocator.h"
 #include "src/tint/utils/symbol/symbol.h"
+#include "src/tint/utils/system/optional_mutex.h"
 
 namespace tint {
 
@@ -86,6 +87,11 @@ class SymbolTable {
     /// value
     Symbol New(std::string_view name = "");
 
+    /// Enables or disables locking of the symbol table, so that Register(), Get() and New() can be
+    /// called concurrently from multiple threads while enabled.
+    /// @param thread_safe true to enable locking
+    void SetThreadSafe(bool thread_safe) { mutex_.SetEnabled(thread_safe); }
+
     /// Foreach calls the callback function `F` for each symbol in the table.
     /// @param callback must be a function or function-like object with the
     /// signature: `void(Symbol)`
@@ -113,6 +119,8 @@ class SymbolTable {
     tint::GenerationID generation_id_;
 
     tint::BumpAllocator name_allocator_;
+
+    OptionalMutex mutex_;
 };
 
 /// @param symbol_table the SymbolTable
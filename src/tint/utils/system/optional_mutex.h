@@ -0,0 +1,68 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_UTILS_SYSTEM_OPTIONAL_MUTEX_H_
+#define SRC_TINT_UTILS_SYSTEM_OPTIONAL_MUTEX_H_
+
+#include <memory>
+#include <mutex>
+
+namespace tint {
+
+/// OptionalMutex is a recursive mutex that only exists while it is enabled.
+/// It is used to guard structures that are almost always used from a single thread, but may be
+/// temporarily shared between threads. While disabled, Lock() does nothing.
+class OptionalMutex {
+  public:
+    /// The lock type returned by Lock()
+    using Guard = std::unique_lock<std::recursive_mutex>;
+
+    /// Enables or disables the mutex.
+    /// @param enabled true if Lock() should acquire the mutex
+    /// @note must not be called while the mutex is locked, or while other threads are using the
+    /// guarded structure.
+    void SetEnabled(bool enabled) {
+        if (enabled != IsEnabled()) {
+            mutex_ = enabled ? std::make_unique<std::recursive_mutex>() : nullptr;
+        }
+    }
+
+    /// @returns true if the mutex is enabled
+    bool IsEnabled() const { return mutex_ != nullptr; }
+
+    /// @returns a lock that holds the mutex until it is destructed, or an empty lock if the mutex
+    /// is not enabled.
+    [[nodiscard]] Guard Lock() const { return mutex_ ? Guard(*mutex_) : Guard(); }
+
+  private:
+    std::unique_ptr<std::recursive_mutex> mutex_;
+};
+
+}  // namespace tint
+
+#endif  // SRC_TINT_UTILS_SYSTEM_OPTIONAL_MUTEX_H_
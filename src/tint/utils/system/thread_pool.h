@@ -0,0 +1,98 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_UTILS_SYSTEM_THREAD_POOL_H_
+#define SRC_TINT_UTILS_SYSTEM_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tint {
+
+/// ThreadPool is a fixed size pool of threads that is used to run the iterations of a loop
+/// concurrently.
+class ThreadPool {
+  public:
+    /// The function called by ParallelFor() for each loop index.
+    /// The first parameter is the loop index. The second parameter is the index of the thread that
+    /// is making the call, in the range [0, NumThreads()).
+    using Task = std::function<void(size_t index, size_t thread)>;
+
+    /// Constructor
+    /// @param num_threads the number of threads that run tasks, including the thread that calls
+    /// ParallelFor(). A value of 0 is treated as 1.
+    explicit ThreadPool(size_t num_threads);
+
+    /// Destructor. Blocks until all the threads of the pool have exited.
+    ~ThreadPool();
+
+    /// @returns the number of threads that run tasks, including the thread that calls
+    /// ParallelFor()
+    size_t NumThreads() const { return threads_.size() + 1; }
+
+    /// Calls @p task once for each index in [0, count), spreading the calls across the threads of
+    /// the pool. The calling thread also runs tasks, as thread 0.
+    /// Blocks until all the calls have returned.
+    /// @param count the number of loop iterations
+    /// @param task the function to call for each loop index
+    void ParallelFor(size_t count, const Task& task);
+
+  private:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// The entry point of the pool's threads
+    /// @param thread the thread index
+    void Worker(size_t thread);
+
+    /// Runs tasks of the current loop until all the loop indices have been claimed.
+    /// @param thread the thread index
+    void RunTasks(size_t thread);
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    /// Incremented for each call to ParallelFor()
+    uint64_t generation_ = 0;
+    /// The number of pool threads that have not yet finished the current loop
+    size_t busy_ = 0;
+    bool shutdown_ = false;
+    const Task* task_ = nullptr;
+    size_t count_ = 0;
+    std::atomic<size_t> next_index_{0};
+};
+
+}  // namespace tint
+
+#endif  // SRC_TINT_UTILS_SYSTEM_THREAD_POOL_H_
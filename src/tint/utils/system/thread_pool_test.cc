@@ -0,0 +1,101 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/utils/system/thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace tint {
+namespace {
+
+TEST(ThreadPool, NumThreads) {
+    EXPECT_EQ(ThreadPool(0).NumThreads(), 1u);
+    EXPECT_EQ(ThreadPool(1).NumThreads(), 1u);
+    EXPECT_EQ(ThreadPool(4).NumThreads(), 4u);
+}
+
+TEST(ThreadPool, ParallelFor_Empty) {
+    ThreadPool pool(4);
+    size_t calls = 0;
+    pool.ParallelFor(0, [&](size_t, size_t) { calls++; });
+    EXPECT_EQ(calls, 0u);
+}
+
+TEST(ThreadPool, ParallelFor_SingleThread) {
+    ThreadPool pool(1);
+    std::vector<size_t> indices;
+    pool.ParallelFor(5, [&](size_t index, size_t thread) {
+        EXPECT_EQ(thread, 0u);
+        indices.push_back(index);
+    });
+    EXPECT_EQ(indices, (std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(ThreadPool, ParallelFor_CallsEachIndexOnce) {
+    ThreadPool pool(4);
+    constexpr size_t kCount = 1000;
+    std::vector<std::atomic<int>> calls(kCount);
+    std::atomic<bool> bad_thread{false};
+    pool.ParallelFor(kCount, [&](size_t index, size_t thread) {
+        calls[index]++;
+        if (thread >= pool.NumThreads()) {
+            bad_thread = true;
+        }
+    });
+    for (size_t i = 0; i < kCount; i++) {
+        EXPECT_EQ(calls[i], 1) << "index: " << i;
+    }
+    EXPECT_FALSE(bad_thread);
+}
+
+TEST(ThreadPool, ParallelFor_Repeated) {
+    ThreadPool pool(3);
+    std::atomic<size_t> sum{0};
+    for (size_t n = 0; n < 100; n++) {
+        pool.ParallelFor(n, [&](size_t index, size_t) { sum += index; });
+    }
+    // Sum of (n * (n - 1) / 2) for n in [0, 100)
+    EXPECT_EQ(sum, 161700u);
+}
+
+TEST(ThreadPool, ParallelFor_PerThreadState) {
+    ThreadPool pool(4);
+    std::vector<size_t> per_thread(pool.NumThreads());
+    pool.ParallelFor(100, [&](size_t, size_t thread) { per_thread[thread]++; });
+    size_t total = 0;
+    for (auto count : per_thread) {
+        total += count;
+    }
+    EXPECT_EQ(total, 100u);
+}
+
+}  // namespace
+}  // namespace tint
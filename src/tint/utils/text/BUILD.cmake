@@ -39,6 +39,8 @@
 # Kind:      lib
 ################################################################################
 tint_add_target(tint_utils_text lib
+  utils/text/ascii.cc
+  utils/text/ascii.h
   utils/text/base64.cc
   utils/text/base64.h
   utils/text/string.cc
@@ -91,6 +93,7 @@ endif(TINT_BUILD_IS_WIN)
 # Kind:      test
 ################################################################################
 tint_add_target(tint_utils_text_test test
+  utils/text/ascii_test.cc
   utils/text/base64_test.cc
   utils/text/string_stream_test.cc
   utils/text/string_test.cc
@@ -0,0 +1,247 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/utils/text/ascii.h"
+
+#include <cstdint>
+
+// AVX2 is only used when the compiler is already targeting it, so there is no runtime dispatch.
+// SSE2 is part of the x86-64 baseline.
+#if defined(__AVX2__)
+#define TINT_ASCII_AVX2 1
+#else
+#define TINT_ASCII_AVX2 0
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TINT_ASCII_SSE2 1
+#else
+#define TINT_ASCII_SSE2 0
+#endif
+
+#if TINT_ASCII_AVX2
+#include <immintrin.h>
+#elif TINT_ASCII_SSE2
+#include <emmintrin.h>
+#endif
+
+#if TINT_ASCII_SSE2 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace tint::ascii {
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+// Byte predicates, overloaded for a single byte and for each vector width.
+// The vector overloads return a lane mask with all bits set for matching bytes.
+////////////////////////////////////////////////////////////////////////////////
+
+inline bool Eq(uint8_t c, char x) {
+    return c == static_cast<uint8_t>(x);
+}
+inline bool InRange(uint8_t c, char lo, char hi) {
+    return c >= static_cast<uint8_t>(lo) && c <= static_cast<uint8_t>(hi);
+}
+inline bool NonASCII(uint8_t c) {
+    return (c & 0x80) != 0;
+}
+inline bool Or(bool a, bool b) {
+    return a || b;
+}
+
+#if TINT_ASCII_SSE2
+// Note: SSE2 only has signed byte comparisons. Bytes 0x80..0xff compare as negative, so they never
+// fall within a range of (positive) ASCII characters.
+inline __m128i Eq(__m128i v, char x) {
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(x));
+}
+inline __m128i InRange(__m128i v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(hi + 1))));
+}
+inline __m128i NonASCII(__m128i v) {
+    return _mm_cmplt_epi8(v, _mm_setzero_si128());
+}
+inline __m128i Or(__m128i a, __m128i b) {
+    return _mm_or_si128(a, b);
+}
+
+/// @returns the index of the lowest set bit of @p mask, which must not be zero.
+inline size_t LowestSetBit(uint32_t mask) {
+#if defined(__clang__) || defined(__GNUC__)
+    return static_cast<size_t>(__builtin_ctz(mask));
+#elif defined(_MSC_VER)
+    unsigned long index = 0;  // NOLINT(runtime/int)
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    size_t index = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+#endif  // TINT_ASCII_SSE2
+
+#if TINT_ASCII_AVX2
+inline __m256i Eq(__m256i v, char x) {
+    return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(x));
+}
+inline __m256i InRange(__m256i v, char lo, char hi) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), v));
+}
+inline __m256i NonASCII(__m256i v) {
+    return _mm256_cmpgt_epi8(_mm256_setzero_si256(), v);
+}
+inline __m256i Or(__m256i a, __m256i b) {
+    return _mm256_or_si256(a, b);
+}
+#endif  // TINT_ASCII_AVX2
+
+/// Scan returns the index of the first byte of @p str where `match(byte) == FIND`, or `str.size()`
+/// if there is no such byte.
+/// @param str the string to scan
+/// @param match the predicate, which is called with either a single byte or a vector of bytes
+template <bool FIND, typename MATCH>
+size_t Scan(std::string_view str, const MATCH& match) {
+    auto* data = reinterpret_cast<const uint8_t*>(str.data());
+    const size_t size = str.size();
+    size_t i = 0;
+
+#if TINT_ASCII_AVX2
+    for (; i + 32 <= size; i += 32) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(match(v)));
+        if (!FIND) {
+            mask = ~mask;
+        }
+        if (mask != 0) {
+            return i + LowestSetBit(mask);
+        }
+    }
+#endif
+
+#if TINT_ASCII_SSE2
+    for (; i + 16 <= size; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(match(v)));
+        if (!FIND) {
+            mask ^= 0xffff;
+        }
+        if (mask != 0) {
+            return i + LowestSetBit(mask);
+        }
+    }
+#endif
+
+    for (; i < size; i++) {
+        if (match(data[i]) == FIND) {
+            return i;
+        }
+    }
+    return size;
+}
+
+struct IsBlankspace {
+    template <typename T>
+    auto operator()(T v) const {
+        return Or(Eq(v, ' '), Eq(v, '\t'));
+    }
+};
+
+struct IsIdentifier {
+    template <typename T>
+    auto operator()(T v) const {
+        return Or(Or(InRange(v, 'a', 'z'), InRange(v, 'A', 'Z')),
+                  Or(InRange(v, '0', '9'), Eq(v, '_')));
+    }
+};
+
+struct IsDecimalDigit {
+    template <typename T>
+    auto operator()(T v) const {
+        return InRange(v, '0', '9');
+    }
+};
+
+struct IsHexDigit {
+    template <typename T>
+    auto operator()(T v) const {
+        return Or(InRange(v, '0', '9'), Or(InRange(v, 'a', 'f'), InRange(v, 'A', 'F')));
+    }
+};
+
+struct IsLineBreakOrNonASCII {
+    template <typename T>
+    auto operator()(T v) const {
+        // '\n', '\v', '\f' and '\r' are contiguous.
+        return Or(InRange(v, '\n', '\r'), NonASCII(v));
+    }
+};
+
+struct IsOneOf {
+    char a;
+    char b;
+    char c;
+    template <typename T>
+    auto operator()(T v) const {
+        return Or(Eq(v, a), Or(Eq(v, b), Eq(v, c)));
+    }
+};
+
+}  // namespace
+
+size_t SpanBlankspace(std::string_view str) {
+    return Scan</* FIND */ false>(str, IsBlankspace{});
+}
+
+size_t SpanIdentifier(std::string_view str) {
+    return Scan</* FIND */ false>(str, IsIdentifier{});
+}
+
+size_t SpanDecimalDigits(std::string_view str) {
+    return Scan</* FIND */ false>(str, IsDecimalDigit{});
+}
+
+size_t SpanHexDigits(std::string_view str) {
+    return Scan</* FIND */ false>(str, IsHexDigit{});
+}
+
+size_t FindLineBreakOrNonASCII(std::string_view str) {
+    return Scan</* FIND */ true>(str, IsLineBreakOrNonASCII{});
+}
+
+size_t FindFirstOf(std::string_view str, char a, char b, char c) {
+    return Scan</* FIND */ true>(str, IsOneOf{a, b, c});
+}
+
+}  // namespace tint::ascii
@@ -0,0 +1,74 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_UTILS_TEXT_ASCII_H_
+#define SRC_TINT_UTILS_TEXT_ASCII_H_
+
+#include <cstddef>
+#include <string_view>
+
+/// Fast scanning of runs of ASCII characters.
+///
+/// Each function inspects the string a vector register at a time when the target supports SSE2 or
+/// AVX2, and a byte at a time otherwise. Bytes outside of the ASCII range (0x80..0xff) are never
+/// part of a span, so callers can use these as a fast path and fall back to a full UTF-8 decode
+/// where the span stops on a non-ASCII byte.
+namespace tint::ascii {
+
+/// @param str the string to scan
+/// @returns the number of leading bytes of @p str that are a space (0x20) or horizontal tab (0x09)
+size_t SpanBlankspace(std::string_view str);
+
+/// @param str the string to scan
+/// @returns the number of leading bytes of @p str that are in the set `[A-Za-z0-9_]`
+size_t SpanIdentifier(std::string_view str);
+
+/// @param str the string to scan
+/// @returns the number of leading bytes of @p str that are in the set `[0-9]`
+size_t SpanDecimalDigits(std::string_view str);
+
+/// @param str the string to scan
+/// @returns the number of leading bytes of @p str that are in the set `[0-9A-Fa-f]`
+size_t SpanHexDigits(std::string_view str);
+
+/// @param str the string to scan
+/// @returns the index of the first byte of @p str that is an ASCII line break (line feed,
+/// vertical tab, form feed or carriage return) or is not ASCII, or `str.size()` if there is none.
+size_t FindLineBreakOrNonASCII(std::string_view str);
+
+/// @param str the string to scan
+/// @param a the first byte to search for
+/// @param b the second byte to search for
+/// @param c the third byte to search for
+/// @returns the index of the first byte of @p str that is equal to @p a, @p b or @p c, or
+/// `str.size()` if there is none.
+size_t FindFirstOf(std::string_view str, char a, char b, char c);
+
+}  // namespace tint::ascii
+
+#endif  // SRC_TINT_UTILS_TEXT_ASCII_H_
@@ -0,0 +1,102 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/utils/text/ascii.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace tint::ascii {
+namespace {
+
+// Long enough to cover the 32-byte, 16-byte and single byte loops of the scanner.
+static constexpr size_t kLength = 71;
+
+/// Places every possible byte value at every position of a string of @p filler bytes, and checks
+/// that @p scan returns the position of that byte when @p stops returns true for it.
+template <typename SCAN, typename STOPS>
+void CheckScan(char filler, SCAN&& scan, STOPS&& stops) {
+    for (size_t len = 0; len <= kLength; len++) {
+        EXPECT_EQ(scan(std::string(len, filler)), len);
+    }
+    for (int value = 0; value < 256; value++) {
+        auto byte = static_cast<char>(value);
+        for (size_t pos = 0; pos < kLength; pos++) {
+            std::string str(kLength, filler);
+            str[pos] = byte;
+            size_t expect = stops(static_cast<uint8_t>(value)) ? pos : kLength;
+            ASSERT_EQ(scan(str), expect) << "byte: " << value << " pos: " << pos;
+        }
+    }
+}
+
+TEST(AsciiTest, SpanBlankspace) {
+    CheckScan(' ', SpanBlankspace, [](uint8_t c) { return c != ' ' && c != '\t'; });
+    CheckScan('\t', SpanBlankspace, [](uint8_t c) { return c != ' ' && c != '\t'; });
+}
+
+TEST(AsciiTest, SpanIdentifier) {
+    auto stops = [](uint8_t c) {
+        return !((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                 c == '_');
+    };
+    CheckScan('a', SpanIdentifier, stops);
+    CheckScan('_', SpanIdentifier, stops);
+    EXPECT_EQ(SpanIdentifier("abc_XYZ_019 = 1;"), 11u);
+    EXPECT_EQ(SpanIdentifier("abc\xc3\xa9"), 3u);
+}
+
+TEST(AsciiTest, SpanDecimalDigits) {
+    CheckScan('7', SpanDecimalDigits, [](uint8_t c) { return !(c >= '0' && c <= '9'); });
+    EXPECT_EQ(SpanDecimalDigits("0123456789abc"), 10u);
+}
+
+TEST(AsciiTest, SpanHexDigits) {
+    auto stops = [](uint8_t c) {
+        return !((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'));
+    };
+    CheckScan('f', SpanHexDigits, stops);
+    EXPECT_EQ(SpanHexDigits("0123456789abcdefABCDEFg"), 22u);
+}
+
+TEST(AsciiTest, FindLineBreakOrNonASCII) {
+    CheckScan('x', FindLineBreakOrNonASCII,
+              [](uint8_t c) { return (c >= '\n' && c <= '\r') || c >= 0x80; });
+    EXPECT_EQ(FindLineBreakOrNonASCII("abc\r\ndef"), 3u);
+    EXPECT_EQ(FindLineBreakOrNonASCII("a\tb\xc2\x85"), 3u);
+}
+
+TEST(AsciiTest, FindFirstOf) {
+    auto scan = [](std::string_view str) { return FindFirstOf(str, '/', '*', '\0'); };
+    CheckScan('x', scan, [](uint8_t c) { return c == '/' || c == '*' || c == 0; });
+    EXPECT_EQ(scan("comment */"), 8u);
+}
+
+}  // namespace
+}  // namespace tint::ascii